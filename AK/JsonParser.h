@@ -6,31 +6,24 @@
 
 #pragma once
 
-#include <AK/GenericLexer.h>
+#include <AK/JsonPullParser.h>
 #include <AK/JsonValue.h>
 
 namespace AK {
 
-class JsonParser : private GenericLexer {
+// Parses a whole JSON document into a JsonValue tree.
+// Use JsonPullParser directly to read a document without building the tree.
+class JsonParser {
 public:
     explicit JsonParser(StringView input)
-        : GenericLexer(input)
+        : m_parser(input)
     {
     }
 
     ErrorOr<JsonValue> parse();
 
 private:
-    ErrorOr<JsonValue> parse_helper();
-
-    ErrorOr<String> consume_and_unescape_string();
-    ErrorOr<JsonValue> parse_array();
-    ErrorOr<JsonValue> parse_object();
-    ErrorOr<JsonValue> parse_number();
-    ErrorOr<JsonValue> parse_string();
-    ErrorOr<JsonValue> parse_false();
-    ErrorOr<JsonValue> parse_true();
-    ErrorOr<JsonValue> parse_null();
+    JsonPullParser m_parser;
 };
 
 }
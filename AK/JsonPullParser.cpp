@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/FloatingPointStringConversions.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonPullParser.h>
+#include <AK/StringBuilder.h>
+
+namespace AK {
+
+constexpr bool is_space(int ch)
+{
+    return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
+}
+
+String JsonPullParser::Token::to_string() const
+{
+    VERIFY(type == TokenType::Key || type == TokenType::String);
+    if (!has_escapes)
+        return text;
+
+    // The escape sequences were validated while lexing.
+    StringBuilder builder;
+    GenericLexer lexer { text };
+    while (!lexer.is_eof()) {
+        builder.append(lexer.consume_until('\\'));
+        if (lexer.is_eof())
+            break;
+        lexer.ignore();
+        switch (char ch = lexer.consume()) {
+        case 'n':
+            builder.append('\n');
+            break;
+        case 'r':
+            builder.append('\r');
+            break;
+        case 't':
+            builder.append('\t');
+            break;
+        case 'b':
+            builder.append('\b');
+            break;
+        case 'f':
+            builder.append('\f');
+            break;
+        case 'u':
+            builder.append_code_point(AK::StringUtils::convert_to_uint_from_hex(lexer.consume(4)).value());
+            break;
+        default:
+            builder.append(ch);
+            break;
+        }
+    }
+    return builder.to_string();
+}
+
+ErrorOr<JsonValue> JsonPullParser::Token::to_number_value() const
+{
+    VERIFY(type == TokenType::Number);
+
+    auto parse_double = [&]() -> ErrorOr<JsonValue> {
+#ifdef KERNEL
+#    error JsonPullParser is currently not available for the Kernel because it disallows floating point. \
+       If you want to make this KERNEL compatible you can just make this function fail with an error in KERNEL mode.
+#endif
+        char const* start = text.characters_without_null_termination();
+        auto parse_result = parse_first_floating_point(start, start + text.length());
+        if (!parse_result.parsed_value())
+            return Error::from_string_literal("JsonParser: Invalid floating point");
+        return JsonValue(parse_result.value);
+    };
+
+    bool negative = text.starts_with('-');
+    bool all_zero = true;
+    for (auto ch : text.substring_view(negative ? 1 : 0)) {
+        if (!is_ascii_digit(ch))
+            return parse_double();
+        if (ch != '0')
+            all_zero = false;
+    }
+
+    // Negative zero is always a double
+    if (negative && all_zero)
+        return JsonValue(-0.0);
+
+    if (auto unsigned_number = text.to_uint<u64>(); unsigned_number.has_value()) {
+        if (*unsigned_number <= NumericLimits<u32>::max())
+            return JsonValue((u32)*unsigned_number);
+        return JsonValue(*unsigned_number);
+    }
+    if (auto signed_number = text.to_int<i64>(); signed_number.has_value()) {
+        if (*signed_number >= NumericLimits<i32>::min())
+            return JsonValue((i32)*signed_number);
+        return JsonValue(*signed_number);
+    }
+
+    // It's possible the value is out of range for 64-bit integers
+    return parse_double();
+}
+
+ErrorOr<JsonPullParser::Token> JsonPullParser::next_token()
+{
+    if (m_peeked_token.has_value())
+        return m_peeked_token.release_value();
+    return lex_next();
+}
+
+ErrorOr<JsonPullParser::Token> JsonPullParser::peek_token()
+{
+    if (!m_peeked_token.has_value())
+        m_peeked_token = TRY(lex_next());
+    return *m_peeked_token;
+}
+
+ErrorOr<JsonPullParser::Token> JsonPullParser::lex_next()
+{
+    ignore_while(is_space);
+    switch (m_expect) {
+    case Expect::Value:
+        return lex_value();
+    case Expect::FirstValueOrArrayEnd:
+        if (consume_specific(']'))
+            return end_container(TokenType::ArrayEnd);
+        return lex_value();
+    case Expect::FirstKeyOrObjectEnd:
+        if (consume_specific('}'))
+            return end_container(TokenType::ObjectEnd);
+        return lex_key();
+    case Expect::Key:
+        return lex_key();
+    case Expect::CommaOrEnd: {
+        bool in_object = m_containers.last() == Container::Object;
+        if (consume_specific(in_object ? '}' : ']'))
+            return end_container(in_object ? TokenType::ObjectEnd : TokenType::ArrayEnd);
+        if (!consume_specific(','))
+            return Error::from_string_literal("JsonParser: Expected ','");
+        ignore_while(is_space);
+        if (in_object)
+            return lex_key();
+        if (next_is(']'))
+            return Error::from_string_literal("JsonParser: Unexpected ']'");
+        return lex_value();
+    }
+    case Expect::EndOfInput:
+        if (!is_eof())
+            return Error::from_string_literal("JsonParser: Didn't consume all input");
+        return Token {};
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<JsonPullParser::Token> JsonPullParser::lex_value()
+{
+    switch (peek()) {
+    case '{':
+        ignore();
+        TRY(m_containers.try_append(Container::Object));
+        m_expect = Expect::FirstKeyOrObjectEnd;
+        return Token { .type = TokenType::ObjectStart };
+    case '[':
+        ignore();
+        TRY(m_containers.try_append(Container::Array));
+        m_expect = Expect::FirstValueOrArrayEnd;
+        return Token { .type = TokenType::ArrayStart };
+    case '"':
+        return lex_string(TokenType::String);
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        return lex_number();
+    case 'f':
+        return lex_literal("false"sv, TokenType::False);
+    case 't':
+        return lex_literal("true"sv, TokenType::True);
+    case 'n':
+        return lex_literal("null"sv, TokenType::Null);
+    }
+    return Error::from_string_literal("JsonParser: Unexpected character");
+}
+
+ErrorOr<JsonPullParser::Token> JsonPullParser::lex_key()
+{
+    if (next_is('}'))
+        return Error::from_string_literal("JsonParser: Unexpected '}'");
+    auto token = TRY(lex_string(TokenType::Key));
+    ignore_while(is_space);
+    if (!consume_specific(':'))
+        return Error::from_string_literal("JsonParser: Expected ':'");
+    m_expect = Expect::Value;
+    return token;
+}
+
+ErrorOr<JsonPullParser::Token> JsonPullParser::lex_string(TokenType type)
+{
+    if (!consume_specific('"'))
+        return Error::from_string_literal("JsonParser: Expected '\"'");
+
+    auto start = tell();
+    bool has_escapes = false;
+    for (;;) {
+        if (is_eof())
+            return Error::from_string_literal("JsonParser: Expected '\"'");
+        char ch = consume();
+        if (ch == '"')
+            break;
+        if (is_ascii_c0_control(ch))
+            return Error::from_string_literal("JsonParser: Error while parsing string");
+        if (ch != '\\')
+            continue;
+
+        has_escapes = true;
+        if (is_eof())
+            return Error::from_string_literal("JsonParser: Error while parsing string");
+        switch (consume()) {
+        case '"':
+        case '\\':
+        case '/':
+        case 'n':
+        case 'r':
+        case 't':
+        case 'b':
+        case 'f':
+            break;
+        case 'u':
+            if (tell_remaining() < 4)
+                return Error::from_string_literal("JsonParser: EOF while parsing Unicode escape");
+            if (!AK::StringUtils::convert_to_uint_from_hex(consume(4)).has_value())
+                return Error::from_string_literal("JsonParser: Error while parsing Unicode escape");
+            break;
+        default:
+            return Error::from_string_literal("JsonParser: Error while parsing string");
+        }
+    }
+
+    if (type == TokenType::String)
+        did_lex_value();
+    return Token { .type = type, .text = m_input.substring_view(start, tell() - start - 1), .has_escapes = has_escapes };
+}
+
+ErrorOr<JsonPullParser::Token> JsonPullParser::lex_number()
+{
+    auto start = tell();
+
+    if (consume_specific('-') && !is_ascii_digit(peek()))
+        return Error::from_string_literal("JsonParser: Unexpected '-' without further digits");
+
+    // Leading zeros are not allowed, however we can have a '.' or 'e' with valid digits after just a zero.
+    if (peek() == '0' && is_ascii_digit(peek(1)))
+        return Error::from_string_literal("JsonParser: Cannot have leading zeros");
+    ignore_while(is_ascii_digit);
+
+    if (next_is('.')) {
+        if (!is_ascii_digit(peek(1)))
+            return Error::from_string_literal("JsonParser: Must have digits after decimal point");
+        ignore();
+        ignore_while(is_ascii_digit);
+    }
+
+    if (next_is('e') || next_is('E')) {
+        char next = peek(1);
+        if (!is_ascii_digit(next) && ((next != '+' && next != '-') || !is_ascii_digit(peek(2))))
+            return Error::from_string_literal("JsonParser: Must have digits after exponent with an optional sign inbetween");
+        ignore(is_ascii_digit(next) ? 1 : 2);
+        ignore_while(is_ascii_digit);
+    }
+
+    did_lex_value();
+    return Token { .type = TokenType::Number, .text = m_input.substring_view(start, tell() - start) };
+}
+
+ErrorOr<JsonPullParser::Token> JsonPullParser::lex_literal(StringView literal, TokenType type)
+{
+    if (!consume_specific(literal)) {
+        if (type == TokenType::False)
+            return Error::from_string_literal("JsonParser: Expected 'false'");
+        if (type == TokenType::True)
+            return Error::from_string_literal("JsonParser: Expected 'true'");
+        return Error::from_string_literal("JsonParser: Expected 'null'");
+    }
+    did_lex_value();
+    return Token { .type = type };
+}
+
+JsonPullParser::Token JsonPullParser::end_container(TokenType type)
+{
+    m_containers.take_last();
+    did_lex_value();
+    return Token { .type = type };
+}
+
+void JsonPullParser::did_lex_value()
+{
+    m_expect = m_containers.is_empty() ? Expect::EndOfInput : Expect::CommaOrEnd;
+}
+
+ErrorOr<JsonValue> JsonPullParser::read_value()
+{
+    auto token = TRY(next_token());
+    return read_value_starting_with(token);
+}
+
+ErrorOr<JsonValue> JsonPullParser::read_value_starting_with(Token const& token)
+{
+    switch (token.type) {
+    case TokenType::ObjectStart: {
+        JsonObject object;
+        for (;;) {
+            auto key = TRY(next_token());
+            if (key.type == TokenType::ObjectEnd)
+                break;
+            auto value = TRY(read_value());
+            object.set(key.to_string(), move(value));
+        }
+        return JsonValue { move(object) };
+    }
+    case TokenType::ArrayStart: {
+        JsonArray array;
+        for (;;) {
+            auto element = TRY(next_token());
+            if (element.type == TokenType::ArrayEnd)
+                break;
+            array.append(TRY(read_value_starting_with(element)));
+        }
+        return JsonValue { move(array) };
+    }
+    case TokenType::String:
+        return JsonValue { token.to_string() };
+    case TokenType::Number:
+        return token.to_number_value();
+    case TokenType::True:
+        return JsonValue { true };
+    case TokenType::False:
+        return JsonValue { false };
+    case TokenType::Null:
+        return JsonValue { JsonValue::Type::Null };
+    case TokenType::ObjectEnd:
+    case TokenType::ArrayEnd:
+    case TokenType::Key:
+    case TokenType::EndOfInput:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<void> JsonPullParser::skip_value()
+{
+    size_t depth = 0;
+    do {
+        auto token = TRY(next_token());
+        if (token.type == TokenType::ObjectStart || token.type == TokenType::ArrayStart)
+            ++depth;
+        else if (token.type == TokenType::ObjectEnd || token.type == TokenType::ArrayEnd)
+            --depth;
+    } while (depth != 0);
+    return {};
+}
+
+ErrorOr<String> JsonPullParser::read_string()
+{
+    auto token = TRY(next_token());
+    if (token.type != TokenType::String)
+        return Error::from_string_literal("JsonPullParser: Expected string");
+    return token.to_string();
+}
+
+ErrorOr<bool> JsonPullParser::read_bool()
+{
+    auto token = TRY(next_token());
+    if (token.type != TokenType::True && token.type != TokenType::False)
+        return Error::from_string_literal("JsonPullParser: Expected boolean");
+    return token.type == TokenType::True;
+}
+
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Concepts.h>
+#include <AK/GenericLexer.h>
+#include <AK/JsonValue.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// Parses JSON one token at a time, without building a JsonValue tree.
+//
+// Keys, strings and numbers are returned as views into the input, so the input has to outlive the tokens.
+// The read_*() helpers can be used to read a document straight into a struct, skipping the members that
+// aren't needed. Unlike JsonParser, next_token() and skip_value() don't use up any stack for nesting depth;
+// read_value() still recurses once per level, just like JsonParser.
+class JsonPullParser : private GenericLexer {
+public:
+    enum class TokenType : u8 {
+        ObjectStart,
+        ObjectEnd,
+        ArrayStart,
+        ArrayEnd,
+        Key,
+        String,
+        Number,
+        True,
+        False,
+        Null,
+        EndOfInput,
+    };
+
+    struct Token {
+        TokenType type { TokenType::EndOfInput };
+        // For keys and strings, the text between the quotes, with any escape sequences still in it.
+        // For numbers, the number as written.
+        StringView text {};
+        bool has_escapes { false };
+
+        // Only valid for keys and strings.
+        String to_string() const;
+        // Only valid for numbers, and converts them like JsonParser does.
+        ErrorOr<JsonValue> to_number_value() const;
+        template<Arithmetic T>
+        ErrorOr<T> to_number() const;
+    };
+
+    explicit JsonPullParser(StringView input)
+        : GenericLexer(input)
+    {
+    }
+
+    ErrorOr<Token> next_token();
+    ErrorOr<Token> peek_token();
+
+    // Reads the next value as a tree, which is what JsonParser does. This recurses once per level of nesting.
+    ErrorOr<JsonValue> read_value();
+    ErrorOr<void> skip_value();
+
+    ErrorOr<String> read_string();
+    ErrorOr<bool> read_bool();
+    template<Arithmetic T>
+    ErrorOr<T> read_number()
+    {
+        auto token = TRY(next_token());
+        if (token.type != TokenType::Number)
+            return Error::from_string_literal("JsonPullParser: Expected number");
+        return token.to_number<T>();
+    }
+
+    // Calls the callback with the key of each member, which has to read or skip exactly one value.
+    template<typename Callback>
+    ErrorOr<void> read_object(Callback callback)
+    {
+        if (TRY(next_token()).type != TokenType::ObjectStart)
+            return Error::from_string_literal("JsonPullParser: Expected object");
+        for (;;) {
+            auto token = TRY(next_token());
+            if (token.type == TokenType::ObjectEnd)
+                return {};
+            VERIFY(token.type == TokenType::Key);
+            if (!token.has_escapes) {
+                TRY(callback(token.text));
+            } else {
+                auto key = token.to_string();
+                TRY(callback(key.view()));
+            }
+        }
+    }
+
+    // Calls the callback for each element, which has to read or skip exactly one value.
+    template<typename Callback>
+    ErrorOr<void> read_array(Callback callback)
+    {
+        if (TRY(next_token()).type != TokenType::ArrayStart)
+            return Error::from_string_literal("JsonPullParser: Expected array");
+        for (;;) {
+            if (TRY(peek_token()).type == TokenType::ArrayEnd) {
+                (void)TRY(next_token());
+                return {};
+            }
+            TRY(callback());
+        }
+    }
+
+private:
+    enum class Container : u8 {
+        Object,
+        Array,
+    };
+
+    enum class Expect : u8 {
+        Value,
+        FirstValueOrArrayEnd,
+        FirstKeyOrObjectEnd,
+        Key,
+        CommaOrEnd,
+        EndOfInput,
+    };
+
+    ErrorOr<Token> lex_next();
+    ErrorOr<Token> lex_value();
+    ErrorOr<Token> lex_key();
+    ErrorOr<Token> lex_string(TokenType);
+    ErrorOr<Token> lex_number();
+    ErrorOr<Token> lex_literal(StringView, TokenType);
+    Token end_container(TokenType);
+    void did_lex_value();
+
+    ErrorOr<JsonValue> read_value_starting_with(Token const&);
+
+    Vector<Container, 16> m_containers;
+    Expect m_expect { Expect::Value };
+    Optional<Token> m_peeked_token;
+};
+
+template<Arithmetic T>
+ErrorOr<T> JsonPullParser::Token::to_number() const
+{
+    VERIFY(type == TokenType::Number);
+    if constexpr (IsIntegral<T>) {
+        Optional<T> value;
+        if constexpr (IsSigned<T>)
+            value = text.to_int<T>();
+        else
+            value = text.to_uint<T>();
+        if (value.has_value())
+            return value.release_value();
+    }
+    // Fractions, exponents and out of range values are converted like JsonValue does.
+    auto value = TRY(to_number_value());
+    return value.to_number<T>();
+}
+
+}
+
+using AK::JsonPullParser;
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// The format of /sys/kernel/processes_binary, which has the same information as the JSON in /sys/kernel/processes,
+// but is much cheaper to generate and to read.
+//
+// The file starts with a ProcessStatisticsHeader, which is followed by a sequence of records. Each record starts
+// with a ProcessStatisticsRecordHeader, followed by the fixed-size fields for its type, and then by its strings.
+// Strings are UTF-8 without a terminator, in the order of their lengths in the fixed-size fields. Records are
+// padded to a multiple of 8 bytes. Thread records belong to the process record before them.
+//
+// New fields are only ever appended to the fixed-size fields, and readers skip records of types they don't know,
+// so readers built against older versions of this header keep working. The version is only bumped for changes
+// that would break them, and readers reject versions they don't know.
+constexpr u32 process_statistics_magic = 0x53544150; // "PATS" in little-endian
+constexpr u32 process_statistics_version = 1;
+constexpr size_t process_statistics_record_alignment = 8;
+
+struct ProcessStatisticsHeader {
+    u32 magic;
+    u16 version;
+    // The size of this header, which is where the first record starts.
+    u16 size;
+    u64 total_time;
+    u64 total_time_kernel;
+};
+
+struct ProcessStatisticsRecordHeader {
+    enum class Type : u16 {
+        Process,
+        Thread,
+    };
+
+    Type type;
+    // The size of the record header and the fixed-size fields, which is where the strings start.
+    u16 fixed_size;
+    // The size of the whole record, including strings and padding.
+    u32 size;
+};
+
+struct ProcessStatisticsProcessRecord {
+    i32 pid;
+    i32 pgid;
+    i32 pgp;
+    i32 sid;
+    u32 uid;
+    u32 gid;
+    i32 ppid;
+    u32 nfds;
+    u64 amount_virtual;
+    u64 amount_resident;
+    u64 amount_shared;
+    u64 amount_dirty_private;
+    u64 amount_clean_inode;
+    u64 amount_purgeable_volatile;
+    u64 amount_purgeable_nonvolatile;
+    u8 kernel;
+    u8 dumpable;
+    u16 name_length;
+    u16 executable_length;
+    u16 tty_length;
+    u16 pledge_length;
+    u16 veil_length;
+};
+
+struct ProcessStatisticsThreadRecord {
+    i32 tid;
+    u32 cpu;
+    u32 priority;
+    u32 times_scheduled;
+    u64 time_user;
+    u64 time_kernel;
+    u32 syscall_count;
+    u32 inode_faults;
+    u32 zero_faults;
+    u32 cow_faults;
+    u64 unix_socket_read_bytes;
+    u64 unix_socket_write_bytes;
+    u64 ipv4_socket_read_bytes;
+    u64 ipv4_socket_write_bytes;
+    u64 file_read_bytes;
+    u64 file_write_bytes;
+    u16 name_length;
+    u16 state_length;
+};
+
+}
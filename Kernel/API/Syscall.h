@@ -57,6 +57,7 @@ enum class NeedsBigProcessLock {
     S(clock_settime, NeedsBigProcessLock::No)               \
     S(close, NeedsBigProcessLock::No)                       \
     S(connect, NeedsBigProcessLock::No)                     \
+    S(copy_file_range, NeedsBigProcessLock::No)             \
     S(create_inode_watcher, NeedsBigProcessLock::Yes)       \
     S(create_thread, NeedsBigProcessLock::Yes)              \
     S(dbgputstr, NeedsBigProcessLock::No)                   \
@@ -415,6 +416,15 @@ struct SC_symlink_params {
     StringArgument linkpath;
 };
 
+struct SC_copy_file_range_params {
+    int fd_in;
+    off_t* offset_in;
+    int fd_out;
+    off_t* offset_out;
+    size_t length;
+    unsigned flags;
+};
+
 struct SC_rename_params {
     StringArgument old_path;
     StringArgument new_path;
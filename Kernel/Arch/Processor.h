@@ -21,6 +21,13 @@ enum class InterruptsState {
 InterruptsState processor_interrupts_state();
 void restore_processor_interrupts_state(InterruptsState);
 
+struct TLBShootdownStatistics {
+    u64 requests { 0 };
+    u64 ipis_sent { 0 };
+    u64 processors_skipped { 0 };
+    u64 full_flushes { 0 };
+};
+
 }
 
 #if ARCH(X86_64) || ARCH(I386)
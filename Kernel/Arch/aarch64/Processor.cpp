@@ -54,6 +54,11 @@ void Processor::flush_tlb(Memory::PageDirectory const*, VirtualAddress vaddr, si
     flush_tlb_local(vaddr, page_count);
 }
 
+TLBShootdownStatistics Processor::tlb_shootdown_statistics()
+{
+    return {};
+}
+
 u32 Processor::clear_critical()
 {
     TODO_AARCH64();
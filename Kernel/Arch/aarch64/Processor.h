@@ -24,6 +24,7 @@ class PageDirectory;
 
 class Thread;
 class Processor;
+struct TLBShootdownStatistics;
 
 // FIXME This needs to go behind some sort of platform abstraction
 //       it is used between Thread and Processor.
@@ -89,6 +90,7 @@ public:
 
     static void flush_tlb_local(VirtualAddress vaddr, size_t page_count);
     static void flush_tlb(Memory::PageDirectory const*, VirtualAddress, size_t);
+    static TLBShootdownStatistics tlb_shootdown_statistics();
 
     ALWAYS_INLINE u32 id() const
     {
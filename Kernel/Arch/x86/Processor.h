@@ -30,6 +30,7 @@ namespace Kernel {
 class ProcessorInfo;
 struct ProcessorMessage;
 struct ProcessorMessageEntry;
+struct TLBShootdownStatistics;
 
 #if ARCH(X86_64)
 #    define MSR_EFER 0xc0000080
@@ -106,6 +107,9 @@ class Processor {
     bool m_in_scheduler;
     Atomic<bool> m_halt_requested;
 
+    // The page directory that is currently loaded on this processor, see Processor::smp_flush_tlb().
+    Atomic<FlatPtr> m_active_cr3;
+
     DeferredCallEntry* m_pending_deferred_calls; // in reverse order
     DeferredCallEntry* m_free_deferred_call_pool_entry;
     DeferredCallEntry m_deferred_call_pool[5];
@@ -189,6 +193,9 @@ public:
 
     static void flush_tlb_local(VirtualAddress vaddr, size_t page_count);
     static void flush_tlb(Memory::PageDirectory const*, VirtualAddress, size_t);
+    static TLBShootdownStatistics tlb_shootdown_statistics();
+
+    void activate_cr3(FlatPtr cr3);
 
     Descriptor& get_gdt_entry(u16 selector);
     void flush_gdt();
@@ -381,7 +388,7 @@ public:
     bool smp_process_pending_messages();
 
     static void smp_unicast(u32 cpu, Function<void()>, bool async);
-    static void smp_broadcast_flush_tlb(Memory::PageDirectory const*, VirtualAddress, size_t);
+    static void smp_flush_tlb(Memory::PageDirectory const*, VirtualAddress, size_t);
     static u32 smp_wake_n_idle_processors(u32 wake_count);
 
     static void deferred_call_queue(Function<void()> callback);
@@ -6,6 +6,7 @@
  */
 
 #include <AK/Singleton.h>
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/Memory/PageDirectory.h>
 #include <Kernel/Thread.h>
 
@@ -40,13 +41,13 @@ LockRefPtr<PageDirectory> PageDirectory::find_current()
 
 void activate_kernel_page_directory(PageDirectory const& pgd)
 {
-    write_cr3(pgd.cr3());
+    Processor::current().activate_cr3(pgd.cr3());
 }
 
 void activate_page_directory(PageDirectory const& pgd, Thread* current_thread)
 {
     current_thread->regs().cr3 = pgd.cr3();
-    write_cr3(pgd.cr3());
+    Processor::current().activate_cr3(pgd.cr3());
 }
 
 }
@@ -43,6 +43,14 @@ READONLY_AFTER_INIT static bool volatile s_smp_enabled;
 static Atomic<ProcessorMessage*> s_message_pool;
 Atomic<u32> Processor::s_idle_cpu_mask { 0 };
 
+// Beyond this many pages, reloading CR3 is cheaper than invalidating each page on its own.
+static constexpr size_t full_tlb_flush_threshold = 32;
+
+static Atomic<u64> s_tlb_shootdown_requests;
+static Atomic<u64> s_tlb_shootdown_ipis_sent;
+static Atomic<u64> s_tlb_shootdown_processors_skipped;
+static Atomic<u64> s_full_tlb_flushes;
+
 // The compiler can't see the calls to these functions inside assembly.
 // Declare them, to avoid dead code warnings.
 extern "C" void context_first_init(Thread* from_thread, Thread* to_thread, TrapFrame* trap) __attribute__((used));
@@ -1002,6 +1010,13 @@ void Processor::check_invoke_scheduler()
 
 void Processor::flush_tlb_local(VirtualAddress vaddr, size_t page_count)
 {
+    // NOTE: Kernel mappings are global and survive a CR3 reload, so those always get invalidated page by page.
+    if (page_count > full_tlb_flush_threshold && Memory::is_user_address(vaddr)) {
+        s_full_tlb_flushes.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        flush_entire_tlb_local();
+        return;
+    }
+
     auto ptr = vaddr.as_ptr();
     while (page_count > 0) {
         // clang-format off
@@ -1017,12 +1032,30 @@ void Processor::flush_tlb_local(VirtualAddress vaddr, size_t page_count)
 
 void Processor::flush_tlb(Memory::PageDirectory const* page_directory, VirtualAddress vaddr, size_t page_count)
 {
-    if (s_smp_enabled && (!Memory::is_user_address(vaddr) || Process::current().thread_count() > 1))
-        smp_broadcast_flush_tlb(page_directory, vaddr, page_count);
+    if (s_smp_enabled)
+        smp_flush_tlb(page_directory, vaddr, page_count);
     else
         flush_tlb_local(vaddr, page_count);
 }
 
+TLBShootdownStatistics Processor::tlb_shootdown_statistics()
+{
+    return {
+        .requests = s_tlb_shootdown_requests.load(AK::MemoryOrder::memory_order_relaxed),
+        .ipis_sent = s_tlb_shootdown_ipis_sent.load(AK::MemoryOrder::memory_order_relaxed),
+        .processors_skipped = s_tlb_shootdown_processors_skipped.load(AK::MemoryOrder::memory_order_relaxed),
+        .full_flushes = s_full_tlb_flushes.load(AK::MemoryOrder::memory_order_relaxed),
+    };
+}
+
+void Processor::activate_cr3(FlatPtr cr3)
+{
+    // This store has to be globally visible before we start caching translations from the
+    // new page directory, otherwise we could miss a shootdown in Processor::smp_flush_tlb().
+    m_active_cr3.store(cr3, AK::MemoryOrder::memory_order_seq_cst);
+    write_cr3(cr3);
+}
+
 void Processor::smp_return_to_pool(ProcessorMessage& msg)
 {
     ProcessorMessage* next = nullptr;
@@ -1317,17 +1350,62 @@ void Processor::smp_unicast(u32 cpu, Function<void()> callback, bool async)
     smp_unicast_message(cpu, msg, async);
 }
 
-void Processor::smp_broadcast_flush_tlb(Memory::PageDirectory const* page_directory, VirtualAddress vaddr, size_t page_count)
+void Processor::smp_flush_tlb(Memory::PageDirectory const* page_directory, VirtualAddress vaddr, size_t page_count)
 {
+    auto& current_processor = Processor::current();
+    bool is_user_range = Memory::is_user_address(vaddr);
+    s_tlb_shootdown_requests.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+
+    // Make sure our page table updates are visible before looking at which page directory each processor
+    // has loaded. Any processor that activates this page directory after this point will see the new entries.
+    AK::atomic_thread_fence(AK::MemoryOrder::memory_order_seq_cst);
+
+    // User mappings are only cached by processors that currently have the page directory loaded,
+    // since switching to another one flushes all of them. Kernel mappings are shared by everyone.
+    u64 target_mask = 0;
+    u32 target_count = 0;
+    for_each(
+        [&](Processor& proc) {
+            if (&proc == &current_processor)
+                return;
+            if (is_user_range && proc.m_active_cr3.load(AK::MemoryOrder::memory_order_seq_cst) != page_directory->cr3())
+                return;
+            target_mask |= 1ull << proc.id();
+            ++target_count;
+        });
+    s_tlb_shootdown_processors_skipped.fetch_add(count() - 1 - target_count, AK::MemoryOrder::memory_order_relaxed);
+
+    bool flush_locally = !is_user_range || read_cr3() == page_directory->cr3();
+    if (target_count == 0) {
+        if (flush_locally)
+            flush_tlb_local(vaddr, page_count);
+        return;
+    }
+
     auto& msg = smp_get_from_pool();
     msg.async = false;
     msg.type = ProcessorMessage::FlushTlb;
     msg.flush_tlb.page_directory = page_directory;
     msg.flush_tlb.ptr = vaddr.as_ptr();
     msg.flush_tlb.page_count = page_count;
-    smp_broadcast_message(msg);
+    msg.refs.store(target_count, AK::MemoryOrder::memory_order_release);
+
+    dbgln_if(SMP_DEBUG, "SMP[{}]: Flush {} pages at {} on cpus: {:b}", current_processor.id(), page_count, vaddr, target_mask);
+
+    for_each(
+        [&](Processor& proc) {
+            if (!(target_mask & (1ull << proc.id())))
+                return;
+            // Processors that already had messages queued will pick this one up without another IPI.
+            if (proc.smp_enqueue_message(msg)) {
+                APIC::the().send_ipi(proc.id());
+                s_tlb_shootdown_ipis_sent.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            }
+        });
+
     // While the other processors handle this request, we'll flush ours
-    flush_tlb_local(vaddr, page_count);
+    if (flush_locally)
+        flush_tlb_local(vaddr, page_count);
     // Now wait until everybody is done as well
     smp_broadcast_wait_sync(msg);
 }
@@ -1621,7 +1699,7 @@ extern "C" void enter_thread_context(Thread* from_thread, Thread* to_thread)
 #endif
 
     if (from_regs.cr3 != to_regs.cr3)
-        write_cr3(to_regs.cr3);
+        processor.activate_cr3(to_regs.cr3);
 
     to_thread->set_cpu(processor.id());
 
@@ -33,6 +33,8 @@ public:
     virtual StringView class_name() const = 0;
     virtual Inode& root_inode() = 0;
     virtual bool supports_watchers() const { return false; }
+    // Whether Inode::copy_bytes_from() should try copy_bytes_from_locked() between inodes of this file system.
+    virtual bool supports_copy_bytes_from_locked() const { return false; }
 
     bool is_readonly() const { return m_readonly; }
 
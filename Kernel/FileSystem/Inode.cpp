@@ -119,6 +119,56 @@ ErrorOr<size_t> Inode::read_bytes(off_t offset, size_t length, UserOrKernelBuffe
     return read_bytes_locked(offset, length, buffer, open_description);
 }
 
+ErrorOr<size_t> Inode::copy_bytes_from(Inode& source, off_t source_offset, off_t offset, size_t length)
+{
+    // Large enough for the per-call overhead of read_bytes() and write_bytes() not to matter.
+    static constexpr size_t copy_buffer_size = 1 * MiB;
+
+    size_t ncopied = 0;
+    if (&source != this && &source.fs() == &fs() && fs().supports_copy_bytes_from_locked()) {
+        // Always lock the inode with the lower address first, so that copies in opposite directions can't deadlock.
+        bool this_first = this < &source;
+        MutexLocker first_locker(this_first ? m_inode_lock : source.m_inode_lock, this_first ? Mutex::Mode::Exclusive : Mutex::Mode::Shared);
+        MutexLocker second_locker(this_first ? source.m_inode_lock : m_inode_lock, this_first ? Mutex::Mode::Shared : Mutex::Mode::Exclusive);
+        TRY(prepare_to_write_data());
+        auto result = copy_bytes_from_locked(source, source_offset, offset, length);
+        if (result.is_error() && result.error().code() != ENOTSUP)
+            return result.release_error();
+        if (!result.is_error())
+            ncopied = result.value();
+    }
+    if (ncopied == length)
+        return ncopied;
+
+    auto buffer = TRY(KBuffer::try_create_with_size("Inode: Copy buffer"sv, min(length - ncopied, copy_buffer_size)));
+    auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer->data());
+    while (ncopied < length) {
+        // Copying can take a long time, so stop early like a short write if a signal arrives.
+        if (Thread::current()->has_unmasked_pending_signals()) {
+            if (ncopied > 0)
+                break;
+            return EINTR;
+        }
+        auto copy_bytes = [&]() -> ErrorOr<size_t> {
+            auto nread = TRY(source.read_bytes(source_offset + ncopied, min(length - ncopied, buffer->size()), kernel_buffer, nullptr));
+            if (nread == 0)
+                return 0;
+            return write_bytes(offset + ncopied, nread, kernel_buffer, nullptr);
+        };
+        auto result = copy_bytes();
+        if (result.is_error()) {
+            // Like a short write, report what was copied before the error.
+            if (ncopied > 0)
+                break;
+            return result.release_error();
+        }
+        if (result.value() == 0)
+            break;
+        ncopied += result.value();
+    }
+    return ncopied;
+}
+
 ErrorOr<void> Inode::update_timestamps([[maybe_unused]] Optional<time_t> atime, [[maybe_unused]] Optional<time_t> ctime, [[maybe_unused]] Optional<time_t> mtime)
 {
     return ENOTIMPL;
@@ -58,6 +58,11 @@ public:
     ErrorOr<size_t> write_bytes(off_t, size_t, UserOrKernelBuffer const& data, OpenFileDescription*);
     ErrorOr<size_t> read_bytes(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const;
 
+    // Copies up to `length` bytes from `source` into this inode without going through userspace,
+    // and returns how many were copied. Copying stops early at the end of `source`, or when the current thread
+    // has a pending signal.
+    ErrorOr<size_t> copy_bytes_from(Inode& source, off_t source_offset, off_t offset, size_t length);
+
     virtual ErrorOr<void> attach(OpenFileDescription&) { return {}; }
     virtual void detach(OpenFileDescription&) { }
     virtual void did_seek(OpenFileDescription&, off_t) { }
@@ -122,6 +127,12 @@ protected:
     virtual ErrorOr<size_t> write_bytes_locked(off_t, size_t, UserOrKernelBuffer const& data, OpenFileDescription*) = 0;
     virtual ErrorOr<size_t> read_bytes_locked(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const = 0;
 
+    // Called with this inode locked exclusively and `source` (an inode of the same file system) locked shared.
+    // File systems that can share data between their inodes override this and supports_copy_bytes_from_locked();
+    // it may copy fewer bytes than asked for, and the rest is copied through a kernel buffer. ENOTSUP copies
+    // everything through the buffer.
+    virtual ErrorOr<size_t> copy_bytes_from_locked(Inode&, off_t, off_t, size_t) { return ENOTSUP; }
+
 private:
     ErrorOr<bool> try_apply_flock(Process const&, OpenFileDescription const&, flock const&);
 
@@ -53,6 +53,23 @@ ErrorOr<size_t> InodeFile::write(OpenFileDescription& description, u64 offset, U
     return nwritten;
 }
 
+ErrorOr<size_t> InodeFile::copy_from(InodeFile& source, u64 source_offset, u64 offset, size_t count)
+{
+    if (Checked<off_t>::addition_would_overflow(source_offset, count) || Checked<off_t>::addition_would_overflow(offset, count))
+        return EOVERFLOW;
+
+    size_t ncopied = TRY(m_inode->copy_bytes_from(*source.m_inode, source_offset, offset, count));
+    if (ncopied > 0) {
+        // The data has been copied at this point, so a file system without timestamps mustn't make the copy fail.
+        (void)m_inode->update_timestamps({}, {}, kgettimeofday().to_truncated_seconds());
+        Thread::current()->did_file_read(ncopied);
+        Thread::current()->did_file_write(ncopied);
+        source.evaluate_block_conditions();
+        evaluate_block_conditions();
+    }
+    return ncopied;
+}
+
 ErrorOr<void> InodeFile::ioctl(OpenFileDescription& description, unsigned request, Userspace<void*> arg)
 {
     switch (request) {
@@ -37,6 +37,7 @@ UNMAP_AFTER_INIT NonnullLockRefPtr<SysFSGlobalKernelStatsDirectory> SysFSGlobalK
         list.append(SysFSMemoryStatus::must_create(*global_kernel_stats_directory));
         list.append(SysFSSystemStatistics::must_create(*global_kernel_stats_directory));
         list.append(SysFSOverallProcesses::must_create(*global_kernel_stats_directory));
+        list.append(SysFSOverallProcessesBinary::must_create(*global_kernel_stats_directory));
         list.append(SysFSCPUInformation::must_create(*global_kernel_stats_directory));
         list.append(SysFSKernelLog::must_create(*global_kernel_stats_directory));
         list.append(SysFSInterrupts::must_create(*global_kernel_stats_directory));
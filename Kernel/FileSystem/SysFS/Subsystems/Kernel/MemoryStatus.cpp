@@ -5,6 +5,7 @@
  */
 
 #include <AK/JsonObjectSerializer.h>
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/MemoryStatus.h>
 #include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Sections.h>
@@ -27,6 +28,8 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     get_kmalloc_stats(stats);
 
     auto system_memory = MM.get_system_memory_info();
+    auto huge_pages = MM.get_huge_page_statistics();
+    auto tlb_shootdowns = Processor::tlb_shootdown_statistics();
 
     auto json = TRY(JsonObjectSerializer<>::try_create(builder));
     TRY(json.add("kmalloc_allocated"sv, stats.bytes_allocated));
@@ -37,6 +40,14 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     TRY(json.add("physical_uncommitted"sv, system_memory.physical_pages_uncommitted));
     TRY(json.add("kmalloc_call_count"sv, stats.kmalloc_call_count));
     TRY(json.add("kfree_call_count"sv, stats.kfree_call_count));
+    TRY(json.add("huge_page_allocations"sv, huge_pages.allocations));
+    TRY(json.add("huge_page_allocation_failures"sv, huge_pages.allocation_failures));
+    TRY(json.add("huge_page_mappings"sv, huge_pages.mappings));
+    TRY(json.add("huge_page_splits"sv, huge_pages.splits));
+    TRY(json.add("tlb_shootdown_requests"sv, tlb_shootdowns.requests));
+    TRY(json.add("tlb_shootdown_ipis"sv, tlb_shootdowns.ipis_sent));
+    TRY(json.add("tlb_shootdown_processors_skipped"sv, tlb_shootdowns.processors_skipped));
+    TRY(json.add("tlb_full_flushes"sv, tlb_shootdowns.full_flushes));
     TRY(json.finish());
     return {};
 }
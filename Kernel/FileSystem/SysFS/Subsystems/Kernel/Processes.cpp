@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/JsonObjectSerializer.h>
 #include <AK/Try.h>
+#include <Kernel/API/ProcessStatistics.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Processes.h>
 #include <Kernel/Process.h>
 #include <Kernel/Scheduler.h>
@@ -24,6 +26,29 @@ UNMAP_AFTER_INIT NonnullLockRefPtr<SysFSOverallProcesses> SysFSOverallProcesses:
     return adopt_lock_ref_if_nonnull(new (nothrow) SysFSOverallProcesses(parent_directory)).release_nonnull();
 }
 
+static ErrorOr<void> build_pledge_string(Process const& process, StringBuilder& builder)
+{
+#define __ENUMERATE_PLEDGE_PROMISE(promise)    \
+    if (process.has_promised(Pledge::promise)) \
+        TRY(builder.try_append(#promise " "sv));
+    ENUMERATE_PLEDGE_PROMISES
+#undef __ENUMERATE_PLEDGE_PROMISE
+    return {};
+}
+
+static StringView veil_string(Process const& process)
+{
+    switch (process.veil_state()) {
+    case VeilState::None:
+        return "None"sv;
+    case VeilState::Dropped:
+        return "Dropped"sv;
+    case VeilState::Locked:
+        return "Locked"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 ErrorOr<void> SysFSOverallProcesses::try_generate(KBufferBuilder& builder)
 {
     auto json = TRY(JsonObjectSerializer<>::try_create(builder));
@@ -34,26 +59,9 @@ ErrorOr<void> SysFSOverallProcesses::try_generate(KBufferBuilder& builder)
 
         if (process.is_user_process()) {
             StringBuilder pledge_builder;
-
-#define __ENUMERATE_PLEDGE_PROMISE(promise)    \
-    if (process.has_promised(Pledge::promise)) \
-        TRY(pledge_builder.try_append(#promise " "sv));
-            ENUMERATE_PLEDGE_PROMISES
-#undef __ENUMERATE_PLEDGE_PROMISE
-
+            TRY(build_pledge_string(process, pledge_builder));
             TRY(process_object.add("pledge"sv, pledge_builder.string_view()));
-
-            switch (process.veil_state()) {
-            case VeilState::None:
-                TRY(process_object.add("veil"sv, "None"));
-                break;
-            case VeilState::Dropped:
-                TRY(process_object.add("veil"sv, "Dropped"));
-                break;
-            case VeilState::Locked:
-                TRY(process_object.add("veil"sv, "Locked"));
-                break;
-            }
+            TRY(process_object.add("veil"sv, veil_string(process)));
         } else {
             TRY(process_object.add("pledge"sv, ""sv));
             TRY(process_object.add("veil"sv, ""sv));
@@ -157,4 +165,148 @@ ErrorOr<void> SysFSOverallProcesses::try_generate(KBufferBuilder& builder)
     return {};
 }
 
+UNMAP_AFTER_INIT SysFSOverallProcessesBinary::SysFSOverallProcessesBinary(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullLockRefPtr<SysFSOverallProcessesBinary> SysFSOverallProcessesBinary::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_lock_ref_if_nonnull(new (nothrow) SysFSOverallProcessesBinary(parent_directory)).release_nonnull();
+}
+
+template<typename Fields, size_t string_count>
+static ErrorOr<void> append_record(KBufferBuilder& builder, ProcessStatisticsRecordHeader::Type type, Fields const& fields, Array<StringView, string_count> const& strings)
+{
+    constexpr size_t fixed_size = sizeof(ProcessStatisticsRecordHeader) + sizeof(Fields);
+    size_t size = fixed_size;
+    for (auto string : strings)
+        size += string.length();
+    auto padded_size = align_up_to(size, process_statistics_record_alignment);
+
+    ProcessStatisticsRecordHeader header {};
+    header.type = type;
+    header.fixed_size = fixed_size;
+    header.size = padded_size;
+    TRY(builder.append_bytes({ &header, sizeof(header) }));
+    TRY(builder.append_bytes({ &fields, sizeof(fields) }));
+    for (auto string : strings)
+        TRY(builder.append_bytes(string.bytes()));
+    static constexpr u8 padding[process_statistics_record_alignment] {};
+    TRY(builder.append_bytes({ padding, padded_size - size }));
+    return {};
+}
+
+// Longer strings are truncated, which only ever affects absurdly long paths.
+static StringView truncated_for_record(StringView string)
+{
+    return string.substring_view(0, min(string.length(), NumericLimits<u16>::max()));
+}
+
+ErrorOr<void> SysFSOverallProcessesBinary::try_generate(KBufferBuilder& builder)
+{
+    auto total_time_scheduled = Scheduler::get_total_time_scheduled();
+    ProcessStatisticsHeader header {};
+    header.magic = process_statistics_magic;
+    header.version = process_statistics_version;
+    header.size = sizeof(header);
+    header.total_time = total_time_scheduled.total;
+    header.total_time_kernel = total_time_scheduled.total_kernel;
+    TRY(builder.append_bytes({ &header, sizeof(header) }));
+
+    // Keep this in sync with SysFSOverallProcesses above, and with Core::ProcessStatisticsReader.
+    auto build_process = [&](Process const& process) -> ErrorOr<void> {
+        // Zero the whole record, so that no uninitialized padding makes it to userspace.
+        ProcessStatisticsProcessRecord record;
+        memset(&record, 0, sizeof(record));
+
+        StringBuilder pledge_builder;
+        StringView veil;
+        if (process.is_user_process()) {
+            TRY(build_pledge_string(process, pledge_builder));
+            veil = veil_string(process);
+        }
+
+        record.pid = process.pid().value();
+        record.pgid = process.tty() ? process.tty()->pgid().value() : 0;
+        record.pgp = process.pgid().value();
+        record.sid = process.sid().value();
+        auto credentials = process.credentials();
+        record.uid = credentials->uid().value();
+        record.gid = credentials->gid().value();
+        record.ppid = process.ppid().value();
+        OwnPtr<KString> tty_pseudo_name;
+        if (process.tty())
+            tty_pseudo_name = TRY(process.tty()->pseudo_name());
+        record.nfds = process.fds().with_shared([](auto& fds) { return fds.open_count(); });
+        OwnPtr<KString> executable_path;
+        if (process.executable())
+            executable_path = TRY(process.executable()->try_serialize_absolute_path());
+
+        TRY(process.address_space().with([&](auto& space) -> ErrorOr<void> {
+            record.amount_virtual = space->amount_virtual();
+            record.amount_resident = space->amount_resident();
+            record.amount_dirty_private = space->amount_dirty_private();
+            record.amount_clean_inode = TRY(space->amount_clean_inode());
+            record.amount_shared = space->amount_shared();
+            record.amount_purgeable_volatile = space->amount_purgeable_volatile();
+            record.amount_purgeable_nonvolatile = space->amount_purgeable_nonvolatile();
+            return {};
+        }));
+        record.dumpable = process.is_dumpable();
+        record.kernel = process.is_kernel_process();
+
+        Array strings {
+            truncated_for_record(process.name()),
+            truncated_for_record(executable_path ? executable_path->view() : ""sv),
+            truncated_for_record(tty_pseudo_name ? tty_pseudo_name->view() : ""sv),
+            truncated_for_record(pledge_builder.string_view()),
+            veil,
+        };
+        record.name_length = strings[0].length();
+        record.executable_length = strings[1].length();
+        record.tty_length = strings[2].length();
+        record.pledge_length = strings[3].length();
+        record.veil_length = strings[4].length();
+        TRY(append_record(builder, ProcessStatisticsRecordHeader::Type::Process, record, strings));
+
+        return process.try_for_each_thread([&](Thread const& thread) -> ErrorOr<void> {
+            ProcessStatisticsThreadRecord thread_record;
+            memset(&thread_record, 0, sizeof(thread_record));
+
+            SpinlockLocker locker(thread.get_lock());
+            thread_record.tid = thread.tid().value();
+            thread_record.times_scheduled = thread.times_scheduled();
+            thread_record.time_user = thread.time_in_user();
+            thread_record.time_kernel = thread.time_in_kernel();
+            thread_record.cpu = thread.cpu();
+            thread_record.priority = thread.priority();
+            thread_record.syscall_count = thread.syscall_count();
+            thread_record.inode_faults = thread.inode_faults();
+            thread_record.zero_faults = thread.zero_faults();
+            thread_record.cow_faults = thread.cow_faults();
+            thread_record.file_read_bytes = thread.file_read_bytes();
+            thread_record.file_write_bytes = thread.file_write_bytes();
+            thread_record.unix_socket_read_bytes = thread.unix_socket_read_bytes();
+            thread_record.unix_socket_write_bytes = thread.unix_socket_write_bytes();
+            thread_record.ipv4_socket_read_bytes = thread.ipv4_socket_read_bytes();
+            thread_record.ipv4_socket_write_bytes = thread.ipv4_socket_write_bytes();
+
+            Array thread_strings {
+                truncated_for_record(thread.name()),
+                truncated_for_record(thread.state_string()),
+            };
+            thread_record.name_length = thread_strings[0].length();
+            thread_record.state_length = thread_strings[1].length();
+            return append_record(builder, ProcessStatisticsRecordHeader::Type::Thread, thread_record, thread_strings);
+        });
+    };
+
+    // FIXME: Do we actually want to expose the colonel process in a Jail environment?
+    TRY(build_process(*Scheduler::colonel()));
+    return Process::for_each_in_same_jail([&](Process& process) -> ErrorOr<void> {
+        return build_process(process);
+    });
+}
+
 }
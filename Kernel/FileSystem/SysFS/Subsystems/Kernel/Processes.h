@@ -25,4 +25,16 @@ private:
     virtual ErrorOr<void> try_generate(KBufferBuilder& builder) override;
 };
 
+// The same information as SysFSOverallProcesses, in the binary format from Kernel/API/ProcessStatistics.h.
+class SysFSOverallProcessesBinary final : public SysFSGlobalInformation {
+public:
+    virtual StringView name() const override { return "processes_binary"sv; }
+
+    static NonnullLockRefPtr<SysFSOverallProcessesBinary> must_create(SysFSDirectory const& parent_directory);
+
+private:
+    explicit SysFSOverallProcessesBinary(SysFSDirectory const& parent_directory);
+    virtual ErrorOr<void> try_generate(KBufferBuilder& builder) override;
+};
+
 }
@@ -94,6 +94,12 @@ ErrorOr<NonnullOwnPtr<TmpFSInode::DataBlock>> TmpFSInode::DataBlock::create()
     return TRY(adopt_nonnull_own_or_enomem(new (nothrow) DataBlock(move(data_block_buffer_vmobject))));
 }
 
+ErrorOr<NonnullOwnPtr<TmpFSInode::DataBlock>> TmpFSInode::DataBlock::create_sharing(DataBlock& other)
+{
+    auto data_block_buffer_vmobject = TRY(other.vmobject().try_clone());
+    return TRY(adopt_nonnull_own_or_enomem(new (nothrow) DataBlock(static_ptr_cast<Memory::AnonymousVMObject>(data_block_buffer_vmobject))));
+}
+
 ErrorOr<void> TmpFSInode::ensure_allocated_blocks(size_t offset, size_t io_size)
 {
     VERIFY(m_inode_lock.is_locked());
@@ -168,6 +174,55 @@ ErrorOr<size_t> TmpFSInode::write_bytes_locked(off_t offset, size_t size, UserOr
     return nwritten;
 }
 
+ErrorOr<size_t> TmpFSInode::copy_bytes_from_locked(Inode& source, off_t source_offset, off_t offset, size_t length)
+{
+    VERIFY(m_inode_lock.is_locked());
+    VERIFY(!is_directory());
+    VERIFY(&source.fs() == &fs());
+    auto& source_inode = static_cast<TmpFSInode&>(source);
+
+    // Whole blocks are shared copy-on-write instead of being copied, which needs both offsets to be on a block
+    // boundary. The caller copies the rest, including a partial last block.
+    // Note: Sharing saves copying the data, but not memory: try_clone() commits as many pages as the block holds,
+    //       so that either copy can be written to later without running out of memory.
+    if (source_offset % DataBlock::block_size != 0 || offset % DataBlock::block_size != 0)
+        return ENOTSUP;
+    if (source_offset >= source_inode.m_metadata.size)
+        return 0;
+    size_t block_count = min<u64>(length, source_inode.m_metadata.size - source_offset) / DataBlock::block_size;
+    if (block_count == 0)
+        return ENOTSUP;
+
+    size_t source_block_index = source_offset / DataBlock::block_size;
+    size_t block_index = offset / DataBlock::block_size;
+    if (m_blocks.size() < block_index + block_count)
+        TRY(m_blocks.try_resize(block_index + block_count));
+
+    size_t ncopied = 0;
+    for (size_t i = 0; i < block_count; ++i) {
+        OwnPtr<DataBlock> block;
+        // Note: A missing block is a gap in the file, so the copy gets a gap there too.
+        if (source_block_index + i < source_inode.m_blocks.size() && source_inode.m_blocks[source_block_index + i]) {
+            auto block_or_error = DataBlock::create_sharing(*source_inode.m_blocks[source_block_index + i]);
+            if (block_or_error.is_error()) {
+                if (ncopied == 0)
+                    return block_or_error.release_error();
+                break;
+            }
+            block = block_or_error.release_value();
+        }
+        m_blocks[block_index + i] = move(block);
+        ncopied += DataBlock::block_size;
+    }
+
+    if (static_cast<off_t>(offset + ncopied) > m_metadata.size) {
+        m_metadata.size = offset + ncopied;
+        set_metadata_dirty(true);
+    }
+    did_modify_contents();
+    return ncopied;
+}
+
 ErrorOr<size_t> TmpFSInode::do_io_on_content_space(Memory::Region& mapping_region, size_t offset, size_t io_size, UserOrKernelBuffer& buffer, bool write)
 {
     VERIFY(m_inode_lock.is_locked());
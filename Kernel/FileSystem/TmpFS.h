@@ -28,6 +28,7 @@ public:
     virtual StringView class_name() const override { return "TmpFS"sv; }
 
     virtual bool supports_watchers() const override { return true; }
+    virtual bool supports_copy_bytes_from_locked() const override { return true; }
 
     virtual Inode& root_inode() override;
 
@@ -70,6 +71,7 @@ private:
     // ^Inode
     virtual ErrorOr<size_t> read_bytes_locked(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const override;
     virtual ErrorOr<size_t> write_bytes_locked(off_t, size_t, UserOrKernelBuffer const& buffer, OpenFileDescription*) override;
+    virtual ErrorOr<size_t> copy_bytes_from_locked(Inode& source, off_t source_offset, off_t offset, size_t length) override;
 
     ErrorOr<size_t> do_io_on_content_space(Memory::Region& mapping_region, size_t offset, size_t io_size, UserOrKernelBuffer& buffer, bool write);
 
@@ -95,6 +97,8 @@ private:
         using List = Vector<OwnPtr<DataBlock>>;
 
         static ErrorOr<NonnullOwnPtr<DataBlock>> create();
+        // The new block shares its pages with `other` until either of them is written to.
+        static ErrorOr<NonnullOwnPtr<DataBlock>> create_sharing(DataBlock& other);
 
         constexpr static size_t block_size = 128 * KiB;
 
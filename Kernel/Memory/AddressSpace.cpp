@@ -19,6 +19,17 @@
 
 namespace Kernel::Memory {
 
+// Large anonymous regions get placed on a huge page boundary, so that their physically
+// contiguous chunks can be mapped with a single page directory entry.
+static size_t preferred_alignment_for_anonymous_region(size_t size, size_t offset_in_vmobject, size_t alignment)
+{
+    if (!MemoryManager::huge_pages_supported() || alignment != PAGE_SIZE)
+        return alignment;
+    if (size < HUGE_PAGE_SIZE || offset_in_vmobject % HUGE_PAGE_SIZE != 0)
+        return alignment;
+    return HUGE_PAGE_SIZE;
+}
+
 ErrorOr<NonnullOwnPtr<AddressSpace>> AddressSpace::try_create(AddressSpace const* parent)
 {
     auto page_directory = TRY(PageDirectory::try_create_for_userspace());
@@ -78,10 +89,11 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
         auto new_regions = TRY(try_split_region_around_range(*region, range_to_unmap));
 
         // And finally we map the new region(s) using our page directory (they were just allocated and don't have one).
+        // The whole old region has just been invalidated, so the new mappings don't need another TLB flush.
         for (auto* new_region : new_regions) {
             // TODO: Ideally we should do this in a way that can be rolled back on failure, as failing here
             // leaves the caller in an undefined state.
-            TRY(new_region->map(page_directory()));
+            TRY(new_region->map(page_directory(), ShouldFlushTLB::No));
         }
 
         PerformanceManager::add_unmap_perf_event(Process::current(), range_to_unmap);
@@ -103,28 +115,50 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
 
     Vector<Region*, 2> new_regions;
 
-    for (auto* old_region : regions) {
-        // If it's a full match we can remove the entire old region.
-        if (old_region->range().intersect(range_to_unmap).size() == old_region->size()) {
-            deallocate_region(*old_region);
-            continue;
-        }
+    // We unmap all the old regions first, and then invalidate the TLB for all of them at once.
+    // The old regions have to stay alive until then, since their physical pages might still be
+    // reachable through stale TLB entries on other processors.
+    Vector<NonnullOwnPtr<Region>, 2> unmapped_regions;
+    TRY(unmapped_regions.try_ensure_capacity(regions.size()));
+    FlatPtr flush_start = NumericLimits<FlatPtr>::max();
+    FlatPtr flush_end = 0;
+    auto flush_unmapped_regions = [&] {
+        if (unmapped_regions.is_empty())
+            return;
+        MemoryManager::flush_tlb(&page_directory(), VirtualAddress { flush_start }, (flush_end - flush_start) / PAGE_SIZE);
+        unmapped_regions.clear();
+    };
+    ArmedScopeGuard flush_unmapped_regions_on_failure = [&] {
+        flush_unmapped_regions();
+    };
 
+    for (auto* old_region : regions) {
         // Remove the old region from our regions tree, since were going to add another region
-        // with the exact same start address.
+        // with the exact same start address (unless it's a full match, in which case we remove
+        // the entire old region).
         auto region = take_region(*old_region);
-        region->unmap();
+        region->unmap(ShouldFlushTLB::No);
+        flush_start = min(flush_start, region->range().base().get());
+        flush_end = max(flush_end, region->range().end().get());
+        unmapped_regions.unchecked_append(move(region));
+
+        if (old_region->range().intersect(range_to_unmap).size() == old_region->size())
+            continue;
 
         // Otherwise, split the regions and collect them for future mapping.
-        auto split_regions = TRY(try_split_region_around_range(*region, range_to_unmap));
+        auto split_regions = TRY(try_split_region_around_range(*old_region, range_to_unmap));
         TRY(new_regions.try_extend(split_regions));
     }
 
-    // And finally map the new region(s) into our page directory.
+    flush_unmapped_regions_on_failure.disarm();
+    flush_unmapped_regions();
+
+    // And finally map the new region(s) into our page directory. Their pages were all unmapped and
+    // invalidated above, so there's nothing left in the TLB that needs flushing.
     for (auto* new_region : new_regions) {
         // TODO: Ideally we should do this in a way that can be rolled back on failure, as failing here
         // leaves the caller in an undefined state.
-        TRY(new_region->map(page_directory()));
+        TRY(new_region->map(page_directory(), ShouldFlushTLB::No));
     }
 
     PerformanceManager::add_unmap_perf_event(Process::current(), range_to_unmap);
@@ -164,6 +198,7 @@ ErrorOr<Region*> AddressSpace::allocate_region(RandomizeVirtualAddress randomize
     auto vmobject = TRY(AnonymousVMObject::try_create_with_size(size, strategy));
     auto region = TRY(Region::create_unplaced(move(vmobject), 0, move(region_name), prot_to_region_access_flags(prot)));
     if (requested_address.is_null()) {
+        alignment = preferred_alignment_for_anonymous_region(size, 0, alignment);
         TRY(m_region_tree.place_anywhere(*region, randomize_virtual_address, size, alignment));
     } else {
         TRY(m_region_tree.place_specifically(*region, VirtualRange { requested_address, size }));
@@ -201,8 +236,12 @@ ErrorOr<Region*> AddressSpace::allocate_region_with_vmobject(RandomizeVirtualAdd
     if (!name.is_null())
         region_name = TRY(KString::try_create(name));
 
+    bool is_anonymous = vmobject->is_anonymous();
     auto region = TRY(Region::create_unplaced(move(vmobject), offset_in_vmobject, move(region_name), prot_to_region_access_flags(prot), Region::Cacheable::Yes, shared));
 
+    if (requested_address.is_null() && is_anonymous)
+        alignment = preferred_alignment_for_anonymous_region(size, offset_in_vmobject, alignment);
+
     if (requested_address.is_null())
         TRY(m_region_tree.place_anywhere(*region, randomize_virtual_address, size, alignment));
     else
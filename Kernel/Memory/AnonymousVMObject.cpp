@@ -146,8 +146,18 @@ AnonymousVMObject::AnonymousVMObject(FixedArray<RefPtr<PhysicalPage>>&& new_phys
 {
     if (strategy == AllocationStrategy::AllocateNow) {
         // Allocate all pages right now. We know we can get all because we committed the amount needed
-        for (size_t i = 0; i < page_count(); ++i)
-            physical_pages()[i] = m_unused_committed_pages->take_one();
+        for (size_t i = 0; i < page_count();) {
+            // Prefer physically contiguous 2 MiB chunks, so that regions can map them with huge pages.
+            if (i % PAGES_PER_HUGE_PAGE == 0 && page_count() - i >= PAGES_PER_HUGE_PAGE) {
+                auto huge_page = m_unused_committed_pages->try_take_huge_page();
+                if (!huge_page.is_empty()) {
+                    for (size_t j = 0; j < PAGES_PER_HUGE_PAGE; ++j)
+                        physical_pages()[i++] = huge_page.ptr_at(j);
+                    continue;
+                }
+            }
+            physical_pages()[i++] = m_unused_committed_pages->take_one();
+        }
     } else {
         auto& initial_page = (strategy == AllocationStrategy::Reserve) ? MM.lazy_committed_page() : MM.shared_zero_page();
         for (size_t i = 0; i < page_count(); ++i)
@@ -276,6 +286,29 @@ NonnullRefPtr<PhysicalPage> AnonymousVMObject::allocate_committed_page(Badge<Reg
     return m_unused_committed_pages->take_one();
 }
 
+bool AnonymousVMObject::try_allocate_committed_huge_page(Badge<Region>, size_t page_index)
+{
+    VERIFY(m_lock.is_locked_by_current_processor());
+    VERIFY(page_index % PAGES_PER_HUGE_PAGE == 0);
+
+    if (!m_unused_committed_pages.has_value() || page_index + PAGES_PER_HUGE_PAGE > page_count())
+        return false;
+
+    // Only take a huge page if none of the pages in the chunk have been faulted in yet.
+    for (size_t i = 0; i < PAGES_PER_HUGE_PAGE; ++i) {
+        if (!physical_pages()[page_index + i]->is_lazy_committed_page())
+            return false;
+    }
+
+    auto huge_page = m_unused_committed_pages->try_take_huge_page();
+    if (huge_page.is_empty())
+        return false;
+
+    for (size_t i = 0; i < PAGES_PER_HUGE_PAGE; ++i)
+        physical_pages()[page_index + i] = huge_page.ptr_at(i);
+    return true;
+}
+
 ErrorOr<void> AnonymousVMObject::ensure_cow_map()
 {
     if (m_cow_map.is_null())
@@ -561,7 +561,7 @@ PageTableEntry* MemoryManager::pte(PageDirectory& page_directory, VirtualAddress
 
     auto* pd = quickmap_pd(const_cast<PageDirectory&>(page_directory), page_directory_table_index);
     PageDirectoryEntry const& pde = pd[page_directory_index];
-    if (!pde.is_present())
+    if (!pde.is_present() || pde.is_huge())
         return nullptr;
 
     return &quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()))[page_table_index];
@@ -577,9 +577,13 @@ PageTableEntry* MemoryManager::ensure_pte(PageDirectory& page_directory, Virtual
 
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     auto& pde = pd[page_directory_index];
-    if (pde.is_present())
+    if (pde.is_present() && !pde.is_huge())
         return &quickmap_pt(PhysicalAddress(pde.page_table_base()))[page_table_index];
 
+    // If this address is covered by a huge page, we split it into a page table with
+    // identical mappings, so that the caller can modify the individual page.
+    auto const huge_pde = pde;
+
     bool did_purge = false;
     auto page_table_or_error = allocate_physical_page(ShouldZeroFill::Yes, &did_purge);
     if (page_table_or_error.is_error()) {
@@ -594,8 +598,26 @@ PageTableEntry* MemoryManager::ensure_pte(PageDirectory& page_directory, Virtual
         pd = quickmap_pd(page_directory, page_directory_table_index);
         VERIFY(&pde == &pd[page_directory_index]); // Sanity check
 
-        VERIFY(!pde.is_present()); // Should have not changed
+        VERIFY(pde.raw() == huge_pde.raw()); // Should have not changed
     }
+
+    if (huge_pde.is_present()) {
+        VERIFY(huge_pde.is_huge());
+        auto* page_table_entries = quickmap_pt(page_table->paddr());
+        for (size_t i = 0; i < PAGES_PER_HUGE_PAGE; ++i) {
+            auto& pte = page_table_entries[i];
+            pte.set_physical_page_base(huge_pde.page_table_base() + i * PAGE_SIZE);
+            pte.set_writable(huge_pde.is_writable());
+            pte.set_user_allowed(huge_pde.is_user_allowed());
+            pte.set_cache_disabled(huge_pde.is_cache_disabled());
+            pte.set_execute_disabled(huge_pde.is_execute_disabled());
+            pte.set_global(huge_pde.is_global());
+            pte.set_present(true);
+        }
+        pde.clear();
+        m_huge_page_splits.fetch_add(1, AK::memory_order_relaxed);
+    }
+
     pde.set_page_table_base(page_table->paddr().get());
     pde.set_user_allowed(true);
     pde.set_present(true);
@@ -618,6 +640,14 @@ void MemoryManager::release_pte(PageDirectory& page_directory, VirtualAddress va
 
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     PageDirectoryEntry& pde = pd[page_directory_index];
+    if (pde.is_present() && pde.is_huge()) {
+        // Huge pages are only mapped for chunks that lie entirely within a single region,
+        // and regions are always unmapped as a whole. The first release within the chunk
+        // therefore drops the whole mapping, and the remaining PTEs are already gone.
+        VERIFY(page_table_index == 0);
+        pde.clear();
+        return;
+    }
     if (pde.is_present()) {
         auto* page_table = quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()));
         auto& pte = page_table[page_table_index];
@@ -641,6 +671,35 @@ void MemoryManager::release_pte(PageDirectory& page_directory, VirtualAddress va
     }
 }
 
+PageDirectoryEntry* MemoryManager::ensure_huge_pde(PageDirectory& page_directory, VirtualAddress vaddr)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(page_directory.get_lock().is_locked_by_current_processor());
+    VERIFY(vaddr.get() % HUGE_PAGE_SIZE == 0);
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x1ff;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    auto* pd = quickmap_pd(page_directory, page_directory_table_index);
+    auto& pde = pd[page_directory_index];
+    if (pde.is_present() && !pde.is_huge()) {
+        // Some kernel page tables are set up during early boot and aren't backed by a PhysicalPage,
+        // so we leave those alone and let the caller map the chunk page by page instead.
+        if (&page_directory == &kernel_page_directory())
+            return nullptr;
+        // The caller owns every page in this 2 MiB chunk, so the page table can't be mapping anything
+        // else, and we can hand it back. Other processors may still walk it or hold translations from it
+        // until they've been flushed, so that has to happen first.
+        auto page_table_paddr = PhysicalAddress { pde.page_table_base() };
+        pde.clear();
+        flush_tlb(&page_directory, vaddr, PAGES_PER_HUGE_PAGE);
+        // NOTE: This matches the leaked ref in MemoryManager::ensure_pte()
+        get_physical_page_entry(page_table_paddr).allocated.physical_page.unref();
+    }
+    pde.clear();
+    m_huge_page_mappings.fetch_add(1, AK::memory_order_relaxed);
+    return &pde;
+}
+
 UNMAP_AFTER_INIT void MemoryManager::initialize(u32 cpu)
 {
     ProcessorSpecific<MemoryManagerData>::initialize();
@@ -758,7 +817,9 @@ ErrorOr<NonnullOwnPtr<Region>> MemoryManager::allocate_contiguous_kernel_region(
         name_kstring = TRY(KString::try_create(name));
     auto vmobject = TRY(AnonymousVMObject::try_create_physically_contiguous_with_size(size));
     auto region = TRY(Region::create_unplaced(move(vmobject), 0, move(name_kstring), access, cacheable));
-    TRY(m_global_data.with([&](auto& global_data) { return global_data.region_tree.place_anywhere(*region, RandomizeVirtualAddress::No, size); }));
+    // Large regions get placed on a huge page boundary, so they can be mapped with huge pages.
+    auto alignment = huge_pages_supported() && size >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : PAGE_SIZE;
+    TRY(m_global_data.with([&](auto& global_data) { return global_data.region_tree.place_anywhere(*region, RandomizeVirtualAddress::No, size, alignment); }));
     TRY(region->map(kernel_page_directory()));
     return region;
 }
@@ -939,6 +1000,41 @@ NonnullRefPtr<PhysicalPage> MemoryManager::allocate_committed_physical_page(Badg
     return page.release_nonnull();
 }
 
+NonnullRefPtrVector<PhysicalPage> MemoryManager::try_allocate_committed_huge_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill should_zero_fill)
+{
+    if (!huge_pages_supported())
+        return {};
+
+    auto pages = m_global_data.with([&](auto& global_data) -> NonnullRefPtrVector<PhysicalPage> {
+        VERIFY(global_data.system_memory_info.physical_pages_committed >= PAGES_PER_HUGE_PAGE);
+        for (auto& region : global_data.physical_regions) {
+            auto pages = region.take_contiguous_free_pages(PAGES_PER_HUGE_PAGE, HUGE_PAGE_SIZE);
+            if (pages.is_empty())
+                continue;
+            global_data.system_memory_info.physical_pages_committed -= PAGES_PER_HUGE_PAGE;
+            global_data.system_memory_info.physical_pages_used += PAGES_PER_HUGE_PAGE;
+            return pages;
+        }
+        return {};
+    });
+
+    if (pages.is_empty()) {
+        m_huge_page_allocation_failures.fetch_add(1, AK::memory_order_relaxed);
+        return {};
+    }
+    m_huge_page_allocations.fetch_add(1, AK::memory_order_relaxed);
+
+    if (should_zero_fill == ShouldZeroFill::Yes) {
+        InterruptDisabler disabler;
+        for (auto& page : pages) {
+            auto* ptr = quickmap_page(page);
+            memset(ptr, 0, PAGE_SIZE);
+            unquickmap_page();
+        }
+    }
+    return pages;
+}
+
 ErrorOr<NonnullRefPtr<PhysicalPage>> MemoryManager::allocate_physical_page(ShouldZeroFill should_zero_fill, bool* did_purge)
 {
     return m_global_data.with([&](auto&) -> ErrorOr<NonnullRefPtr<PhysicalPage>> {
@@ -1185,6 +1281,16 @@ NonnullRefPtr<PhysicalPage> CommittedPhysicalPageSet::take_one()
     return MM.allocate_committed_physical_page({}, MemoryManager::ShouldZeroFill::Yes);
 }
 
+NonnullRefPtrVector<PhysicalPage> CommittedPhysicalPageSet::try_take_huge_page()
+{
+    if (m_page_count < PAGES_PER_HUGE_PAGE)
+        return {};
+    auto pages = MM.try_allocate_committed_huge_page({}, MemoryManager::ShouldZeroFill::Yes);
+    if (!pages.is_empty())
+        m_page_count -= PAGES_PER_HUGE_PAGE;
+    return pages;
+}
+
 void CommittedPhysicalPageSet::uncommit_one()
 {
     VERIFY(m_page_count > 0);
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Concepts.h>
 #include <AK/HashTable.h>
@@ -37,6 +38,10 @@ constexpr FlatPtr page_round_down(FlatPtr x)
     return ((FlatPtr)(x)) & ~(PAGE_SIZE - 1);
 }
 
+// A huge page maps a naturally aligned 2 MiB block with a single page directory entry.
+constexpr size_t HUGE_PAGE_SIZE = 2 * MiB;
+constexpr size_t PAGES_PER_HUGE_PAGE = HUGE_PAGE_SIZE / PAGE_SIZE;
+
 inline FlatPtr virtual_to_low_physical(FlatPtr virtual_)
 {
     return virtual_ - physical_to_virtual_offset;
@@ -119,6 +124,10 @@ public:
     [[nodiscard]] NonnullRefPtr<PhysicalPage> take_one();
     void uncommit_one();
 
+    // Tries to take PAGES_PER_HUGE_PAGE physically contiguous pages, aligned to HUGE_PAGE_SIZE.
+    // Returns an empty vector if the set is too small or physical memory is too fragmented.
+    [[nodiscard]] NonnullRefPtrVector<PhysicalPage> try_take_huge_page();
+
     void operator=(CommittedPhysicalPageSet&&) = delete;
 
 private:
@@ -167,6 +176,7 @@ public:
     void uncommit_physical_pages(Badge<CommittedPhysicalPageSet>, size_t page_count);
 
     NonnullRefPtr<PhysicalPage> allocate_committed_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill = ShouldZeroFill::Yes);
+    NonnullRefPtrVector<PhysicalPage> try_allocate_committed_huge_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill = ShouldZeroFill::Yes);
     ErrorOr<NonnullRefPtr<PhysicalPage>> allocate_physical_page(ShouldZeroFill = ShouldZeroFill::Yes, bool* did_purge = nullptr);
     ErrorOr<NonnullRefPtrVector<PhysicalPage>> allocate_contiguous_physical_pages(size_t size);
     void deallocate_physical_page(PhysicalAddress);
@@ -191,6 +201,32 @@ public:
 
     SystemMemoryInfo get_system_memory_info();
 
+    static constexpr bool huge_pages_supported()
+    {
+#if ARCH(AARCH64)
+        return false;
+#else
+        return true;
+#endif
+    }
+
+    struct HugePageStatistics {
+        u64 allocations { 0 };
+        u64 allocation_failures { 0 };
+        u64 mappings { 0 };
+        u64 splits { 0 };
+    };
+
+    HugePageStatistics get_huge_page_statistics() const
+    {
+        return {
+            .allocations = m_huge_page_allocations.load(AK::memory_order_relaxed),
+            .allocation_failures = m_huge_page_allocation_failures.load(AK::memory_order_relaxed),
+            .mappings = m_huge_page_mappings.load(AK::memory_order_relaxed),
+            .splits = m_huge_page_splits.load(AK::memory_order_relaxed),
+        };
+    }
+
     template<IteratorFunction<VMObject&> Callback>
     static void for_each_vmobject(Callback callback)
     {
@@ -271,6 +307,7 @@ private:
 
     PageTableEntry* pte(PageDirectory&, VirtualAddress);
     PageTableEntry* ensure_pte(PageDirectory&, VirtualAddress);
+    PageDirectoryEntry* ensure_huge_pde(PageDirectory&, VirtualAddress);
     enum class IsLastPTERelease {
         Yes,
         No
@@ -289,6 +326,11 @@ private:
     PhysicalPageEntry* m_physical_page_entries { nullptr };
     size_t m_physical_page_entries_count { 0 };
 
+    Atomic<u64> m_huge_page_allocations { 0 };
+    Atomic<u64> m_huge_page_allocation_failures { 0 };
+    Atomic<u64> m_huge_page_mappings { 0 };
+    Atomic<u64> m_huge_page_splits { 0 };
+
     struct GlobalData {
         GlobalData();
 
@@ -75,13 +75,18 @@ OwnPtr<PhysicalRegion> PhysicalRegion::try_take_pages_from_beginning(unsigned pa
     return try_create(taken_lower, taken_upper);
 }
 
-NonnullRefPtrVector<PhysicalPage> PhysicalRegion::take_contiguous_free_pages(size_t count)
+NonnullRefPtrVector<PhysicalPage> PhysicalRegion::take_contiguous_free_pages(size_t count, size_t physical_alignment)
 {
     auto rounded_page_count = next_power_of_two(count);
     auto order = count_trailing_zeroes(rounded_page_count);
+    VERIFY(physical_alignment <= rounded_page_count * PAGE_SIZE);
 
     Optional<PhysicalAddress> page_base;
     for (auto& zone : m_usable_zones) {
+        // Buddy blocks are naturally aligned relative to the zone base, so only zones with
+        // a sufficiently aligned base can hand out blocks with the requested alignment.
+        if (zone.base().get() % physical_alignment)
+            continue;
         page_base = zone.allocate_block(order);
         if (page_base.has_value()) {
             if (zone.is_empty()) {
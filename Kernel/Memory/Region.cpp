@@ -249,6 +249,109 @@ bool Region::map_individual_page_impl(size_t page_index)
     return map_individual_page_impl(page_index, page);
 }
 
+Optional<size_t> Region::huge_page_chunk_containing(size_t page_index) const
+{
+    if constexpr (!MemoryManager::huge_pages_supported())
+        return {};
+
+    auto chunk_base = vaddr_from_page_index(page_index).get() & ~(HUGE_PAGE_SIZE - 1);
+    if (chunk_base < vaddr().get() || chunk_base - vaddr().get() + HUGE_PAGE_SIZE > size())
+        return {};
+
+    size_t chunk_page_index = (chunk_base - vaddr().get()) / PAGE_SIZE;
+    // The backing pages have to form a chunk of their own in the VMObject as well.
+    if ((first_page_index() + chunk_page_index) % PAGES_PER_HUGE_PAGE != 0)
+        return {};
+    return chunk_page_index;
+}
+
+bool Region::can_map_huge_page(size_t page_index) const
+{
+    auto chunk_page_index = huge_page_chunk_containing(page_index);
+    if (!chunk_page_index.has_value() || chunk_page_index.value() != page_index)
+        return false;
+
+    // NOTE: The PAT bit lives at a different position in huge page directory entries,
+    //       so write-combined regions always get mapped with individual pages.
+    if (!vmobject().is_anonymous() || !m_cacheable || m_write_combine || (!is_readable() && !is_writable()))
+        return false;
+
+    SpinlockLocker vmobject_locker(vmobject().m_lock);
+    auto first_page = physical_page(page_index);
+    if (!first_page || first_page->paddr().get() % HUGE_PAGE_SIZE != 0)
+        return false;
+
+    for (size_t i = 0; i < PAGES_PER_HUGE_PAGE; ++i) {
+        auto page = physical_page(page_index + i);
+        if (!page || page->is_shared_zero_page() || page->is_lazy_committed_page() || should_cow(page_index + i))
+            return false;
+        if (page->paddr() != first_page->paddr().offset(i * PAGE_SIZE))
+            return false;
+    }
+    return true;
+}
+
+bool Region::map_huge_page_impl(size_t page_index)
+{
+    VERIFY(m_page_directory->get_lock().is_locked_by_current_processor());
+
+    auto chunk_vaddr = vaddr_from_page_index(page_index);
+
+    bool user_allowed = chunk_vaddr.get() >= USER_RANGE_BASE && is_user_address(chunk_vaddr);
+    if (is_mmap() && !user_allowed) {
+        PANIC("About to map mmap'ed page at a kernel address");
+    }
+
+    PhysicalAddress paddr;
+    {
+        SpinlockLocker vmobject_locker(vmobject().m_lock);
+        paddr = physical_page(page_index)->paddr();
+    }
+
+    auto* pde = MM.ensure_huge_pde(*m_page_directory, chunk_vaddr);
+    if (!pde)
+        return false;
+
+    pde->set_page_table_base(paddr.get());
+    pde->set_huge(true);
+    pde->set_present(true);
+    pde->set_writable(is_writable());
+    if (Processor::current().has_nx())
+        pde->set_execute_disabled(!is_executable());
+    pde->set_user_allowed(user_allowed);
+    return true;
+}
+
+ErrorOr<bool> Region::try_fault_in_huge_page(size_t page_index_in_region)
+{
+    VERIFY(vmobject().is_anonymous());
+
+    auto chunk_page_index = huge_page_chunk_containing(page_index_in_region);
+    if (!chunk_page_index.has_value() || !m_cacheable || m_write_combine)
+        return false;
+
+    {
+        SpinlockLocker vmobject_locker(vmobject().m_lock);
+        auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject());
+        if (!anonymous_vmobject.try_allocate_committed_huge_page({}, translate_to_vmobject_page(chunk_page_index.value())))
+            return false;
+    }
+
+    // From here on, the pages of the chunk are no longer lazily committed, so the caller can't fall back
+    // to faulting in a single page anymore if mapping them fails.
+    SpinlockLocker page_lock(m_page_directory->get_lock());
+    bool success = true;
+    if (!can_map_huge_page(chunk_page_index.value()) || !map_huge_page_impl(chunk_page_index.value())) {
+        // The chunk can't be covered by a single entry after all, so fall back to mapping it page by page.
+        for (size_t i = 0; i < PAGES_PER_HUGE_PAGE && success; ++i)
+            success = map_individual_page_impl(chunk_page_index.value() + i);
+    }
+    MemoryManager::flush_tlb(m_page_directory, vaddr_from_page_index(chunk_page_index.value()), PAGES_PER_HUGE_PAGE);
+    if (!success)
+        return ENOMEM;
+    return true;
+}
+
 bool Region::remap_vmobject_page(size_t page_index, NonnullRefPtr<PhysicalPage> physical_page)
 {
     SpinlockLocker page_lock(m_page_directory->get_lock());
@@ -302,6 +405,10 @@ ErrorOr<void> Region::map(PageDirectory& page_directory, ShouldFlushTLB should_f
     set_page_directory(page_directory);
     size_t page_index = 0;
     while (page_index < page_count()) {
+        if (can_map_huge_page(page_index) && map_huge_page_impl(page_index)) {
+            page_index += PAGES_PER_HUGE_PAGE;
+            continue;
+        }
         if (!map_individual_page_impl(page_index))
             break;
         ++page_index;
@@ -315,10 +422,10 @@ ErrorOr<void> Region::map(PageDirectory& page_directory, ShouldFlushTLB should_f
     return ENOMEM;
 }
 
-void Region::remap()
+void Region::remap(ShouldFlushTLB should_flush_tlb)
 {
     VERIFY(m_page_directory);
-    auto result = map(*m_page_directory);
+    auto result = map(*m_page_directory, should_flush_tlb);
     if (result.is_error())
         TODO();
 }
@@ -368,6 +475,11 @@ PageFaultResponse Region::handle_fault(PageFault const& fault)
         SpinlockLocker vmobject_locker(vmobject().m_lock);
         auto& page_slot = physical_page_slot(page_index_in_region);
         if (page_slot->is_lazy_committed_page()) {
+            auto faulted_in_huge_page = try_fault_in_huge_page(page_index_in_region);
+            if (faulted_in_huge_page.is_error())
+                return PageFaultResponse::OutOfMemory;
+            if (faulted_in_huge_page.value())
+                return PageFaultResponse::Continue;
             auto page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
             VERIFY(m_vmobject->is_anonymous());
             page_slot = static_cast<AnonymousVMObject&>(*m_vmobject).allocate_committed_page({});
@@ -408,6 +520,16 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
     if (current_thread != nullptr)
         current_thread->did_zero_fault();
 
+    if (page_in_slot_at_time_of_fault.is_lazy_committed_page()) {
+        auto faulted_in_huge_page = try_fault_in_huge_page(page_index_in_region);
+        if (faulted_in_huge_page.is_error()) {
+            dmesgln("MM: handle_zero_fault was unable to map a huge page");
+            return PageFaultResponse::OutOfMemory;
+        }
+        if (faulted_in_huge_page.value())
+            return PageFaultResponse::Continue;
+    }
+
     RefPtr<PhysicalPage> new_physical_page;
 
     if (page_in_slot_at_time_of_fault.is_lazy_committed_page()) {
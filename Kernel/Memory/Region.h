@@ -10,6 +10,7 @@
 #include <AK/EnumBits.h>
 #include <AK/IntrusiveList.h>
 #include <AK/IntrusiveRedBlackTree.h>
+#include <AK/Optional.h>
 #include <Kernel/Forward.h>
 #include <Kernel/KString.h>
 #include <Kernel/Library/LockWeakable.h>
@@ -191,7 +192,7 @@ public:
     void unmap(ShouldFlushTLB = ShouldFlushTLB::Yes);
     void unmap_with_locks_held(ShouldFlushTLB, SpinlockLocker<RecursiveSpinlock>& pd_locker);
 
-    void remap();
+    void remap(ShouldFlushTLB = ShouldFlushTLB::Yes);
 
     [[nodiscard]] bool is_mapped() const { return m_page_directory != nullptr; }
 
@@ -225,6 +226,12 @@ private:
     [[nodiscard]] bool map_individual_page_impl(size_t page_index);
     [[nodiscard]] bool map_individual_page_impl(size_t page_index, RefPtr<PhysicalPage>);
 
+    [[nodiscard]] Optional<size_t> huge_page_chunk_containing(size_t page_index) const;
+    [[nodiscard]] bool can_map_huge_page(size_t page_index) const;
+    [[nodiscard]] bool map_huge_page_impl(size_t page_index);
+    // Returns false if the chunk containing the page can't be backed by a huge page, and leaves it untouched then.
+    ErrorOr<bool> try_fault_in_huge_page(size_t page_index);
+
     LockRefPtr<PageDirectory> m_page_directory;
     VirtualRange m_range;
     size_t m_offset_in_vmobject { 0 };
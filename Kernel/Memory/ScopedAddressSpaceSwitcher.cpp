@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/InterruptDisabler.h>
 #include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Memory/ScopedAddressSpaceSwitcher.h>
@@ -26,7 +27,7 @@ ScopedAddressSpaceSwitcher::~ScopedAddressSpaceSwitcher()
     InterruptDisabler disabler;
 #if ARCH(I386) || ARCH(X86_64)
     Thread::current()->regs().cr3 = m_previous_cr3;
-    write_cr3(m_previous_cr3);
+    Processor::current().activate_cr3(m_previous_cr3);
 #elif ARCH(AARC64)
     TODO_AARCH64();
 #endif
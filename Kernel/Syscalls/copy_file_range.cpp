@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Checked.h>
+#include <Kernel/FileSystem/Inode.h>
+#include <Kernel/FileSystem/InodeFile.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+// Like on Linux, a single call copies at most this much, and callers loop until they're done.
+static constexpr size_t max_copy_file_range_length = 0x7ffff000;
+
+ErrorOr<FlatPtr> Process::sys$copy_file_range(Userspace<Syscall::SC_copy_file_range_params const*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.flags != 0)
+        return EINVAL;
+    auto length = min(params.length, max_copy_file_range_length);
+
+    auto source_description = TRY(open_file_description(params.fd_in));
+    auto destination_description = TRY(open_file_description(params.fd_out));
+    if (!source_description->is_readable() || !destination_description->is_writable())
+        return EBADF;
+    if (destination_description->should_append())
+        return EBADF;
+
+    if (!source_description->file().is_inode() || !destination_description->file().is_inode())
+        return EINVAL;
+    auto& source_file = static_cast<InodeFile&>(source_description->file());
+    auto& destination_file = static_cast<InodeFile&>(destination_description->file());
+    if (source_file.inode().is_directory() || destination_file.inode().is_directory())
+        return EISDIR;
+    if (!source_file.inode().metadata().is_regular_file() || !destination_file.inode().metadata().is_regular_file())
+        return EINVAL;
+
+    off_t source_offset = source_description->offset();
+    if (params.offset_in)
+        TRY(copy_from_user(&source_offset, params.offset_in));
+    off_t destination_offset = destination_description->offset();
+    if (params.offset_out)
+        TRY(copy_from_user(&destination_offset, params.offset_out));
+    if (source_offset < 0 || destination_offset < 0)
+        return EINVAL;
+    if (Checked<off_t>::addition_would_overflow(source_offset, length) || Checked<off_t>::addition_would_overflow(destination_offset, length))
+        return EOVERFLOW;
+
+    // Copying within a file is fine, as long as the ranges don't overlap.
+    if (&source_file.inode() == &destination_file.inode()
+        && source_offset < static_cast<off_t>(destination_offset + length)
+        && destination_offset < static_cast<off_t>(source_offset + length))
+        return EINVAL;
+
+    if (length == 0)
+        return 0;
+
+    auto ncopied = TRY(destination_file.copy_from(source_file, source_offset, destination_offset, length));
+    if (ncopied == 0)
+        return 0;
+
+    source_offset += ncopied;
+    if (params.offset_in)
+        TRY(copy_to_user(params.offset_in, &source_offset));
+    else
+        TRY(source_description->seek(source_offset, SEEK_SET));
+    destination_offset += ncopied;
+    if (params.offset_out)
+        TRY(copy_to_user(params.offset_out, &destination_offset));
+    else
+        TRY(destination_description->seek(destination_offset, SEEK_SET));
+    return ncopied;
+}
+
+}
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <Kernel/Arch/SafeMem.h>
 #include <Kernel/Arch/SmapDisabler.h>
 #include <Kernel/Arch/x86/MSR.h>
@@ -322,10 +323,11 @@ ErrorOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int p
             new_region->set_executable(prot & PROT_EXEC);
 
             // Map the new regions using our page directory (they were just allocated and don't have one).
+            // The old region has already been invalidated as a whole, so there's no need to flush the TLB again.
             for (auto* adjacent_region : adjacent_regions) {
-                TRY(adjacent_region->map(space->page_directory()));
+                TRY(adjacent_region->map(space->page_directory(), Memory::ShouldFlushTLB::No));
             }
-            TRY(new_region->map(space->page_directory()));
+            TRY(new_region->map(space->page_directory(), Memory::ShouldFlushTLB::No));
             return 0;
         }
 
@@ -345,6 +347,14 @@ ErrorOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int p
             if (full_size_found != range_to_mprotect.size())
                 return ENOMEM;
 
+            // Regions that are remapped in place get their TLB entries invalidated all at once at the end.
+            FlatPtr flush_start = NumericLimits<FlatPtr>::max();
+            FlatPtr flush_end = 0;
+            ScopeGuard flush_remapped_regions = [&] {
+                if (flush_start < flush_end)
+                    Memory::MemoryManager::flush_tlb(&space->page_directory(), VirtualAddress { flush_start }, (flush_end - flush_start) / PAGE_SIZE);
+            };
+
             // Finally, iterate over each region, either updating its access flags if the range covers it wholly,
             // or carving out a new subregion with the appropriate access flags set.
             for (auto* old_region : regions) {
@@ -358,7 +368,9 @@ ErrorOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int p
                     old_region->set_writable(prot & PROT_WRITE);
                     old_region->set_executable(prot & PROT_EXEC);
 
-                    old_region->remap();
+                    old_region->remap(Memory::ShouldFlushTLB::No);
+                    flush_start = min(flush_start, old_region->range().base().get());
+                    flush_end = max(flush_end, old_region->range().end().get());
                     continue;
                 }
                 // Remove the old region from our regions tree, since were going to add another region
@@ -383,9 +395,9 @@ ErrorOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int p
 
                 // Map the new region using our page directory (they were just allocated and don't have one) if any.
                 if (adjacent_regions.size())
-                    TRY(adjacent_regions[0]->map(space->page_directory()));
+                    TRY(adjacent_regions[0]->map(space->page_directory(), Memory::ShouldFlushTLB::No));
 
-                TRY(new_region->map(space->page_directory()));
+                TRY(new_region->map(space->page_directory(), Memory::ShouldFlushTLB::No));
             }
 
             return 0;
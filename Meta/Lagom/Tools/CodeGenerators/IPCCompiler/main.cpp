@@ -66,6 +66,19 @@ static bool is_primitive_type(String const& type)
     return type.is_one_of("u8", "i8", "u16", "i16", "u32", "i32", "u64", "i64", "bool", "double", "float", "int", "unsigned", "unsigned int");
 }
 
+// Arguments of view types point into the received message, and are only valid while it's being handled.
+static bool is_view_type(String const& type)
+{
+    return type.is_one_of("ReadonlyBytes", "StringView");
+}
+
+static String storage_type_for(String const& type)
+{
+    if (is_view_type(type))
+        return String::formatted("IPC::ViewArgument<{}>", type);
+    return type;
+}
+
 static String message_name(String const& endpoint, String const& message, bool is_response)
 {
     StringBuilder builder;
@@ -173,6 +186,13 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
             assert_specific('(');
             parse_parameters(message.outputs);
             assert_specific(')');
+
+            for (auto const& output : message.outputs) {
+                if (is_view_type(output.type)) {
+                    warnln("Response parameter '{}' of '{}' can't be a view, as responses don't outlive the call", output.name, message.name);
+                    VERIFY_NOT_REACHED();
+                }
+            }
         }
 
         consume_whitespace();
@@ -267,7 +287,7 @@ String constructor_for_message(String const& name, Vector<Parameter> const& para
     builder.append('(');
     for (size_t i = 0; i < parameters.size(); ++i) {
         auto const& parameter = parameters[i];
-        builder.appendff("{} {}", parameter.type, parameter.name);
+        builder.appendff("{} {}", storage_type_for(parameter.type), parameter.name);
         if (i != parameters.size() - 1)
             builder.append(", "sv);
     }
@@ -318,7 +338,7 @@ public:)~~~");
     for (auto const& parameter : parameters) {
         auto parameter_generator = message_generator.fork();
 
-        parameter_generator.set("parameter.type", parameter.type);
+        parameter_generator.set("parameter.type", storage_type_for(parameter.type));
         parameter_generator.set("parameter.name", parameter.name);
 
         if (parameter.type == "bool")
@@ -332,8 +352,9 @@ public:)~~~");
             return {};)~~~");
 
         if (parameter.attributes.contains_slow("UTF8")) {
+            parameter_generator.set("parameter.utf8_view", is_view_type(parameter.type) ? String::formatted("{}.view()", parameter.name) : parameter.name);
             parameter_generator.appendln(R"~~~(
-        if (!Utf8View(@parameter.name@).validate())
+        if (!Utf8View(@parameter.utf8_view@).validate())
             return {};)~~~");
         }
     }
@@ -380,6 +401,11 @@ public:)~~~");
         auto parameter_generator = message_generator.fork();
         parameter_generator.set("parameter.type", parameter.type);
         parameter_generator.set("parameter.name", parameter.name);
+        if (is_view_type(parameter.type)) {
+            parameter_generator.appendln(R"~~~(
+    @parameter.type@ @parameter.name@() const { return m_@parameter.name@.view(); })~~~");
+            continue;
+        }
         parameter_generator.appendln(R"~~~(
     const @parameter.type@& @parameter.name@() const { return m_@parameter.name@; }
     @parameter.type@ take_@parameter.name@() { return move(m_@parameter.name@); })~~~");
@@ -391,7 +417,7 @@ private:
 
     for (auto const& parameter : parameters) {
         auto parameter_generator = message_generator.fork();
-        parameter_generator.set("parameter.type", parameter.type);
+        parameter_generator.set("parameter.type", storage_type_for(parameter.type));
         parameter_generator.set("parameter.name", parameter.name);
         parameter_generator.appendln(R"~~~(
     @parameter.type@ m_@parameter.name@ {};)~~~");
@@ -461,7 +487,7 @@ void do_message_for_proxy(SourceGenerator message_generator, Endpoint const& end
             auto const& parameter = parameters[i];
             auto argument_generator = message_generator.fork();
             argument_generator.set("argument.name", parameter.name);
-            if (is_primitive_type(parameters[i].type))
+            if (is_primitive_type(parameters[i].type) || is_view_type(parameters[i].type))
                 argument_generator.append("@argument.name@");
             else
                 argument_generator.append("move(@argument.name@)");
@@ -718,7 +744,7 @@ public:
             auto make_argument_type = [](String const& type) {
                 StringBuilder builder;
 
-                bool const_ref = !is_primitive_type(type);
+                bool const_ref = !is_primitive_type(type) && !is_view_type(type);
 
                 builder.append(type);
                 if (const_ref)
@@ -8,6 +8,8 @@
 
 #include <AK/HashMap.h>
 #include <AK/JsonObject.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/JsonPullParser.h>
 #include <AK/JsonValue.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
@@ -129,6 +131,13 @@ TEST_CASE(json_parse_empty_string)
     EXPECT_EQ(value.is_error(), true);
 }
 
+TEST_CASE(json_parse_large_negative_number)
+{
+    auto value = JsonValue::from_string("-3000000000"sv);
+    EXPECT(value.value().is_i64());
+    EXPECT_EQ(value.value().as_i64(), -3000000000ll);
+}
+
 TEST_CASE(json_parse_long_decimals)
 {
     auto value = JsonValue::from_string("1644452550.6489999294281"sv);
@@ -267,3 +276,199 @@ TEST_CASE(json_parse_fails_on_invalid_number)
 
 #undef EXPECT_JSON_PARSE_TO_FAIL
 }
+
+TEST_CASE(json_pull_parser_tokens)
+{
+    JsonPullParser parser(R"({ "a": [1, -2.5, "x\ny"], "b\u0041": {}, "c": [] , "d": true, "e": null })"sv);
+    using Type = JsonPullParser::TokenType;
+    Vector<Type> expected_types {
+        Type::ObjectStart,
+        Type::Key, Type::ArrayStart, Type::Number, Type::Number, Type::String, Type::ArrayEnd,
+        Type::Key, Type::ObjectStart, Type::ObjectEnd,
+        Type::Key, Type::ArrayStart, Type::ArrayEnd,
+        Type::Key, Type::True,
+        Type::Key, Type::Null,
+        Type::ObjectEnd,
+        Type::EndOfInput
+    };
+    Vector<JsonPullParser::Token> tokens;
+    for (auto expected_type : expected_types) {
+        auto token = MUST(parser.next_token());
+        EXPECT_EQ(token.type, expected_type);
+        tokens.append(token);
+    }
+
+    EXPECT_EQ(tokens[1].text, "a"sv);
+    EXPECT_EQ(tokens[3].text, "1"sv);
+    EXPECT_EQ(tokens[4].text, "-2.5"sv);
+    EXPECT_EQ(tokens[5].text, "x\\ny"sv);
+    EXPECT(tokens[5].has_escapes);
+    EXPECT_EQ(tokens[5].to_string(), "x\ny");
+    EXPECT_EQ(tokens[7].to_string(), "bA");
+}
+
+TEST_CASE(json_pull_parser_errors)
+{
+#define EXPECT_PULL_PARSE_TO_FAIL(value)                      \
+    do {                                                      \
+        JsonPullParser parser(value##sv);                     \
+        EXPECT(parser.skip_value().is_error()                 \
+            || parser.next_token().is_error());               \
+    } while (false)
+
+    EXPECT_PULL_PARSE_TO_FAIL("");
+    EXPECT_PULL_PARSE_TO_FAIL("[1,]");
+    EXPECT_PULL_PARSE_TO_FAIL("[1 2]");
+    EXPECT_PULL_PARSE_TO_FAIL("{\"a\":1,}");
+    EXPECT_PULL_PARSE_TO_FAIL("{\"a\" 1}");
+    EXPECT_PULL_PARSE_TO_FAIL("{1:1}");
+    EXPECT_PULL_PARSE_TO_FAIL("[\"\\x\"]");
+    EXPECT_PULL_PARSE_TO_FAIL("[\"\\u12\"]");
+    EXPECT_PULL_PARSE_TO_FAIL("[\"abc]");
+    EXPECT_PULL_PARSE_TO_FAIL("[[]");
+    EXPECT_PULL_PARSE_TO_FAIL("[]]");
+
+#undef EXPECT_PULL_PARSE_TO_FAIL
+}
+
+TEST_CASE(json_pull_parser_read_into_struct)
+{
+    struct Thread {
+        u32 tid { 0 };
+        String name;
+    };
+    struct Process {
+        u32 pid { 0 };
+        bool kernel { false };
+        Vector<Thread> threads;
+    };
+
+    JsonPullParser parser(R"({"processes":[{"pid":1,"ignored":{"x":[1,{}]},"kernel":true,"threads":[{"tid":2,"name":"a\"b"}]},{"pid":3,"threads":[]}],"total":4})"sv);
+    Vector<Process> processes;
+    u64 total = 0;
+    auto result = parser.read_object([&](StringView key) -> ErrorOr<void> {
+        if (key == "total"sv) {
+            total = TRY(parser.read_number<u64>());
+            return {};
+        }
+        EXPECT_EQ(key, "processes"sv);
+        return parser.read_array([&]() -> ErrorOr<void> {
+            Process process;
+            TRY(parser.read_object([&](StringView key) -> ErrorOr<void> {
+                if (key == "pid"sv)
+                    process.pid = TRY(parser.read_number<u32>());
+                else if (key == "kernel"sv)
+                    process.kernel = TRY(parser.read_bool());
+                else if (key == "threads"sv)
+                    TRY(parser.read_array([&]() -> ErrorOr<void> {
+                        Thread thread;
+                        TRY(parser.read_object([&](StringView key) -> ErrorOr<void> {
+                            if (key == "tid"sv)
+                                thread.tid = TRY(parser.read_number<u32>());
+                            else
+                                thread.name = TRY(parser.read_string());
+                            return {};
+                        }));
+                        process.threads.append(move(thread));
+                        return {};
+                    }));
+                else
+                    TRY(parser.skip_value());
+                return {};
+            }));
+            processes.append(move(process));
+            return {};
+        });
+    });
+    EXPECT(!result.is_error());
+    EXPECT_EQ(total, 4u);
+    EXPECT_EQ(processes.size(), 2u);
+    EXPECT_EQ(processes[0].pid, 1u);
+    EXPECT(processes[0].kernel);
+    EXPECT_EQ(processes[0].threads.size(), 1u);
+    EXPECT_EQ(processes[0].threads[0].tid, 2u);
+    EXPECT_EQ(processes[0].threads[0].name, "a\"b");
+    EXPECT_EQ(processes[1].pid, 3u);
+    EXPECT(!processes[1].kernel);
+    EXPECT(processes[1].threads.is_empty());
+}
+
+// A document shaped like /sys/kernel/processes on a busy system.
+static String make_process_list_json(size_t process_count, size_t threads_per_process)
+{
+    StringBuilder builder;
+    auto json = MUST(JsonObjectSerializer<>::try_create(builder));
+    auto processes = MUST(json.add_array("processes"sv));
+    for (size_t pid = 0; pid < process_count; ++pid) {
+        auto process = MUST(processes.add_object());
+        MUST(process.add("pid"sv, pid));
+        MUST(process.add("uid"sv, 100));
+        MUST(process.add("name"sv, String::formatted("Process{}", pid)));
+        MUST(process.add("executable"sv, String::formatted("/bin/Process{}", pid)));
+        MUST(process.add("pledge"sv, "stdio recvfd sendfd rpath unix"sv));
+        MUST(process.add("amount_virtual"sv, pid * 4096));
+        MUST(process.add("amount_resident"sv, pid * 1024));
+        MUST(process.add("kernel"sv, false));
+        auto threads = MUST(process.add_array("threads"sv));
+        for (size_t tid = 0; tid < threads_per_process; ++tid) {
+            auto thread = MUST(threads.add_object());
+            MUST(thread.add("tid"sv, pid * 100 + tid));
+            MUST(thread.add("name"sv, String::formatted("Thread {}", tid)));
+            MUST(thread.add("state"sv, "Blocked"sv));
+            MUST(thread.add("times_scheduled"sv, 12345));
+            MUST(thread.add("time_user"sv, 1234567890ull));
+            MUST(thread.add("time_kernel"sv, 987654321ull));
+            MUST(thread.add("syscall_count"sv, 4321));
+            MUST(thread.finish());
+        }
+        MUST(threads.finish());
+        MUST(process.finish());
+    }
+    MUST(processes.finish());
+    MUST(json.add("total_time"sv, 1234567890123ull));
+    MUST(json.finish());
+    return builder.to_string();
+}
+
+BENCHMARK_CASE(json_parse_process_list)
+{
+    auto input = make_process_list_json(500, 8);
+    u64 total_time_user = 0;
+    for (int i = 0; i < 50; ++i) {
+        auto json = MUST(JsonValue::from_string(input));
+        json.as_object().get("processes"sv).as_array().for_each([&](auto& process) {
+            process.as_object().get("threads"sv).as_array().for_each([&](auto& thread) {
+                total_time_user += thread.as_object().get("time_user"sv).to_u64();
+            });
+        });
+    }
+    EXPECT_EQ(total_time_user, 50 * 500 * 8 * 1234567890ull);
+}
+
+BENCHMARK_CASE(json_pull_parse_process_list)
+{
+    auto input = make_process_list_json(500, 8);
+    u64 total_time_user = 0;
+    for (int i = 0; i < 50; ++i) {
+        JsonPullParser parser(input);
+        MUST(parser.read_object([&](StringView key) -> ErrorOr<void> {
+            if (key != "processes"sv)
+                return parser.skip_value();
+            return parser.read_array([&] {
+                return parser.read_object([&](StringView key) -> ErrorOr<void> {
+                    if (key != "threads"sv)
+                        return parser.skip_value();
+                    return parser.read_array([&] {
+                        return parser.read_object([&](StringView key) -> ErrorOr<void> {
+                            if (key != "time_user"sv)
+                                return parser.skip_value();
+                            total_time_user += TRY(parser.read_number<u64>());
+                            return {};
+                        });
+                    });
+                });
+            });
+        }));
+    }
+    EXPECT_EQ(total_time_user, 50 * 500 * 8 * 1234567890ull);
+}
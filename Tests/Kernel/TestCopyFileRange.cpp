@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// /tmp is a TmpFS, which shares whole blocks of this size between the files instead of copying them.
+static constexpr size_t tmpfs_block_size = 128 * KiB;
+
+static int create_temporary_file(Vector<u8> const& contents)
+{
+    char path[] = "/tmp/copy_file_range.XXXXXX";
+    auto fd = mkstemp(path);
+    VERIFY(fd >= 0);
+    unlink(path);
+    VERIFY(write(fd, contents.data(), contents.size()) == static_cast<ssize_t>(contents.size()));
+    return fd;
+}
+
+static Vector<u8> make_pattern(size_t size, u8 seed)
+{
+    Vector<u8> pattern;
+    for (size_t i = 0; i < size; ++i)
+        pattern.append(static_cast<u8>(i * 7 + i / 4093 + seed));
+    return pattern;
+}
+
+static Vector<u8> read_file(int fd)
+{
+    struct stat st;
+    VERIFY(fstat(fd, &st) == 0);
+    Vector<u8> contents;
+    contents.resize(st.st_size);
+    VERIFY(pread(fd, contents.data(), contents.size(), 0) == st.st_size);
+    return contents;
+}
+
+TEST_CASE(block_aligned_copy)
+{
+    auto source_contents = make_pattern(2 * tmpfs_block_size, 1);
+    auto source_fd = create_temporary_file(source_contents);
+    auto destination_fd = create_temporary_file({});
+
+    off_t source_offset = 0;
+    off_t destination_offset = 0;
+    EXPECT_EQ(copy_file_range(source_fd, &source_offset, destination_fd, &destination_offset, source_contents.size(), 0), static_cast<ssize_t>(source_contents.size()));
+    EXPECT_EQ(source_offset, static_cast<off_t>(source_contents.size()));
+    EXPECT_EQ(destination_offset, static_cast<off_t>(source_contents.size()));
+    EXPECT(read_file(destination_fd) == source_contents);
+
+    // The blocks are shared copy-on-write, so writing to either file must not change the other.
+    u8 byte = 0xaa;
+    EXPECT_EQ(pwrite(source_fd, &byte, 1, 10), 1);
+    EXPECT(read_file(destination_fd) == source_contents);
+    byte = 0x55;
+    EXPECT_EQ(pwrite(destination_fd, &byte, 1, tmpfs_block_size + 10), 1);
+    source_contents[10] = 0xaa;
+    EXPECT(read_file(source_fd) == source_contents);
+
+    close(source_fd);
+    close(destination_fd);
+}
+
+TEST_CASE(unaligned_tail_and_offsets)
+{
+    auto source_contents = make_pattern(2 * tmpfs_block_size + 1000, 2);
+    auto source_fd = create_temporary_file(source_contents);
+    auto destination_fd = create_temporary_file({});
+
+    // Without offset pointers, the file offsets are used and advanced.
+    EXPECT_EQ(lseek(source_fd, 0, SEEK_SET), 0);
+    EXPECT_EQ(copy_file_range(source_fd, nullptr, destination_fd, nullptr, source_contents.size(), 0), static_cast<ssize_t>(source_contents.size()));
+    EXPECT_EQ(lseek(source_fd, 0, SEEK_CUR), static_cast<off_t>(source_contents.size()));
+    EXPECT_EQ(lseek(destination_fd, 0, SEEK_CUR), static_cast<off_t>(source_contents.size()));
+    EXPECT(read_file(destination_fd) == source_contents);
+
+    // Offsets that aren't on a block boundary, and copying past the end of the source.
+    off_t source_offset = 100;
+    off_t destination_offset = 7;
+    auto expected_length = source_contents.size() - source_offset;
+    EXPECT_EQ(copy_file_range(source_fd, &source_offset, destination_fd, &destination_offset, source_contents.size(), 0), static_cast<ssize_t>(expected_length));
+    auto expected_contents = source_contents;
+    for (size_t i = 0; i < expected_length; ++i)
+        expected_contents[7 + i] = source_contents[100 + i];
+    EXPECT(read_file(destination_fd) == expected_contents);
+
+    close(source_fd);
+    close(destination_fd);
+}
+
+TEST_CASE(overlapping_ranges_in_the_same_file)
+{
+    auto contents = make_pattern(2 * tmpfs_block_size, 3);
+    auto fd = create_temporary_file(contents);
+
+    off_t source_offset = 0;
+    off_t destination_offset = 100;
+    errno = 0;
+    EXPECT_EQ(copy_file_range(fd, &source_offset, fd, &destination_offset, 1000, 0), -1);
+    EXPECT_EQ(errno, EINVAL);
+    EXPECT(read_file(fd) == contents);
+
+    // Ranges that don't overlap can be copied within the same file.
+    destination_offset = tmpfs_block_size;
+    EXPECT_EQ(copy_file_range(fd, &source_offset, fd, &destination_offset, tmpfs_block_size, 0), static_cast<ssize_t>(tmpfs_block_size));
+    for (size_t i = 0; i < tmpfs_block_size; ++i)
+        contents[tmpfs_block_size + i] = contents[i];
+    EXPECT(read_file(fd) == contents);
+
+    close(fd);
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Random.h>
+#include <LibAudio/Resampler.h>
+#include <LibCore/ElapsedTimer.h>
+
+// Resamples ten seconds of noise in buffers of the size that aplay uses.
+static void benchmark_resample_rate(StringView name, u32 source, u32 target, Audio::PolyphaseResampler::Quality quality)
+{
+    Vector<Audio::Sample> input;
+    for (size_t i = 0; i < source * 10; ++i)
+        input.append({ static_cast<float>(get_random_uniform(2000)) / 1000 - 1, static_cast<float>(get_random_uniform(2000)) / 1000 - 1 });
+
+    auto resampler = MUST(Audio::PolyphaseResampler::try_create(source, target, quality));
+    size_t output_count = 0;
+    auto timer = Core::ElapsedTimer::start_new();
+    for (size_t offset = 0; offset < input.size(); offset += 4096)
+        output_count += MUST(resampler.resample(input.span().slice(offset, min<size_t>(4096, input.size() - offset)))).size();
+    auto elapsed_ms = max(timer.elapsed(), 1);
+    outln("{}: {:.1}x realtime", name, static_cast<double>(output_count) / target * 1000 / elapsed_ms);
+}
+
+BENCHMARK_CASE(resample_low_quality)
+{
+    benchmark_resample_rate("resample_low_quality"sv, 44100, 48000, Audio::PolyphaseResampler::Quality::Low);
+}
+
+BENCHMARK_CASE(resample_medium_quality)
+{
+    benchmark_resample_rate("resample_medium_quality"sv, 44100, 48000, Audio::PolyphaseResampler::Quality::Medium);
+}
+
+BENCHMARK_CASE(resample_high_quality)
+{
+    benchmark_resample_rate("resample_high_quality"sv, 44100, 48000, Audio::PolyphaseResampler::Quality::High);
+}
+
+BENCHMARK_CASE(resample_downsampling)
+{
+    benchmark_resample_rate("resample_downsampling"sv, 96000, 44100, Audio::PolyphaseResampler::Quality::Medium);
+}
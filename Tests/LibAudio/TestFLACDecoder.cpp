@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/Vector.h>
+#include <LibAudio/FlacLoader.h>
+#include <LibTest/TestCase.h>
+
+static constexpr u32 test_sample_rate = 44100;
+static constexpr u8 test_bits_per_sample = 16;
+static constexpr u8 mono = 0b0000;
+static constexpr u8 mid_side_stereo = 0b1010;
+
+// Writes small FLAC streams bit by bit, so that every test controls exactly which coding features its frames use.
+// Checksums are left zero, as the loader doesn't check them.
+class FlacStreamBuilder {
+public:
+    FlacStreamBuilder(u64 total_samples, u8 channel_count)
+    {
+        write_bits(0x664C6143, 32);
+
+        // Last metadata block flag, STREAMINFO and its size.
+        write_bits(1, 1);
+        write_bits(0, 7);
+        write_bits(34, 24);
+        write_bits(16, 16);
+        write_bits(4096, 16);
+        write_bits(0, 24);
+        write_bits(0, 24);
+        write_bits(test_sample_rate, 20);
+        write_bits(channel_count - 1, 3);
+        write_bits(test_bits_per_sample - 1, 5);
+        write_bits(total_samples, 36);
+        for (size_t i = 0; i < 4; ++i)
+            write_bits(0, 32);
+    }
+
+    void write_bits(u64 value, u8 bit_count)
+    {
+        for (u8 i = bit_count; i > 0; --i) {
+            if (m_bit_offset == 0)
+                m_bytes.append(0);
+            if ((value >> (i - 1)) & 1)
+                m_bytes.last() |= 0x80 >> m_bit_offset;
+            m_bit_offset = (m_bit_offset + 1) % 8;
+        }
+    }
+
+    void write_signed_bits(i64 value, u8 bit_count)
+    {
+        write_bits(static_cast<u64>(value) & ((1ull << bit_count) - 1), bit_count);
+    }
+
+    void begin_frame(u8 frame_number, u8 channel_assignment, size_t sample_count)
+    {
+        VERIFY(frame_number < 0x80 && sample_count <= 256);
+        write_bits(0b11111111111110, 14);
+        write_bits(0, 1);
+        write_bits(0, 1);
+        // The block size follows the header, the sample rate and bit depth are the ones from STREAMINFO.
+        write_bits(6, 4);
+        write_bits(0, 4);
+        write_bits(channel_assignment, 4);
+        write_bits(0, 3);
+        write_bits(0, 1);
+        write_bits(frame_number, 8);
+        write_bits(sample_count - 1, 8);
+        write_bits(0, 8);
+    }
+
+    void write_subframe_header(u8 type)
+    {
+        write_bits(0, 1);
+        write_bits(type, 6);
+        write_bits(0, 1);
+    }
+
+    void write_verbatim_subframe(Span<i32 const> samples, u8 bits_per_sample = test_bits_per_sample)
+    {
+        write_subframe_header(0b000001);
+        for (auto sample : samples)
+            write_signed_bits(sample, bits_per_sample);
+    }
+
+    void end_frame()
+    {
+        m_bit_offset = 0;
+        write_bits(0, 16);
+    }
+
+    Bytes bytes() { return m_bytes.span(); }
+
+private:
+    Vector<u8> m_bytes;
+    u8 m_bit_offset { 0 };
+};
+
+static Vector<i32> to_pcm(Span<Audio::Sample const> samples, bool right_channel = false)
+{
+    Vector<i32> pcm;
+    for (auto& sample : samples)
+        pcm.append(round_to<i32>((right_channel ? sample.right : sample.left) * (1 << (test_bits_per_sample - 1))));
+    return pcm;
+}
+
+static Vector<i32> load_all_samples(Audio::FlacLoaderPlugin& loader, size_t chunk_size)
+{
+    Vector<i32> pcm;
+    while (true) {
+        auto samples = MUST(loader.get_more_samples(chunk_size));
+        if (samples.is_empty())
+            return pcm;
+        pcm.extend(to_pcm(samples.span()));
+    }
+}
+
+// Two frames of verbatim mono samples, with a distinct value for every sample.
+static FlacStreamBuilder build_two_frame_stream(Vector<i32>& reference)
+{
+    static constexpr size_t frame_size = 16;
+    for (size_t i = 0; i < 2 * frame_size; ++i)
+        reference.append(static_cast<i32>(i * 1000) - 16000);
+
+    FlacStreamBuilder builder { reference.size(), 1 };
+    for (u8 frame = 0; frame < 2; ++frame) {
+        builder.begin_frame(frame, mono, frame_size);
+        builder.write_verbatim_subframe(reference.span().slice(frame * frame_size, frame_size));
+        builder.end_frame();
+    }
+    return builder;
+}
+
+TEST_CASE(mid_side_stereo_keeps_lowest_bit_of_mid_channel)
+{
+    // Left and right differ by odd amounts, so the mid channel is rounded down.
+    Array<i32, 16> left { 100, -7, 3, 32767, -32768, 0, 1, -1, 12345, -12345, 2, 5, -100, 31, 30000, -29999 };
+    Array<i32, 16> right { 99, -8, 0, -32768, 32767, 1, -2, 0, -12344, 12344, 3, -6, 101, -30, -30001, 30000 };
+    Array<i32, 16> mid;
+    Array<i32, 16> side;
+    for (size_t i = 0; i < left.size(); ++i) {
+        mid[i] = (left[i] + right[i]) >> 1;
+        side[i] = left[i] - right[i];
+    }
+
+    FlacStreamBuilder builder { left.size(), 2 };
+    builder.begin_frame(0, mid_side_stereo, left.size());
+    builder.write_verbatim_subframe(mid.span());
+    // The side channel has one more bit.
+    builder.write_verbatim_subframe(side.span(), test_bits_per_sample + 1);
+    builder.end_frame();
+
+    Audio::FlacLoaderPlugin loader { builder.bytes() };
+    MUST(loader.initialize());
+    auto samples = MUST(loader.get_more_samples(left.size()));
+    EXPECT_EQ(to_pcm(samples.span()), Vector<i32>(left.span()));
+    EXPECT_EQ(to_pcm(samples.span(), true), Vector<i32>(right.span()));
+}
+
+TEST_CASE(escaped_residual_partition_is_sign_extended)
+{
+    // These need more than 8 bits, and many of them are negative.
+    Array<i32, 16> reference { -4096, 4095, -3000, 2500, -1, 300, -129, 128, 0, -256, 255, 1000, -1000, 17, -2048, 2047 };
+    static constexpr u8 escaped_bits_per_residual = 13;
+
+    FlacStreamBuilder builder { reference.size(), 1 };
+    builder.begin_frame(0, mono, reference.size());
+    // A fixed predictor of order zero stores the samples as the residual.
+    builder.write_subframe_header(0b001000);
+    // Rice coding with four bit parameters, a single partition, and the escape code.
+    builder.write_bits(0b00, 2);
+    builder.write_bits(0, 4);
+    builder.write_bits(0b1111, 4);
+    builder.write_bits(escaped_bits_per_residual, 5);
+    for (auto sample : reference)
+        builder.write_signed_bits(sample, escaped_bits_per_residual);
+    builder.end_frame();
+
+    Audio::FlacLoaderPlugin loader { builder.bytes() };
+    MUST(loader.initialize());
+    auto samples = MUST(loader.get_more_samples(reference.size()));
+    EXPECT_EQ(to_pcm(samples.span()), Vector<i32>(reference.span()));
+}
+
+TEST_CASE(negative_lpc_shift_is_rejected)
+{
+    static constexpr size_t sample_count = 16;
+
+    FlacStreamBuilder builder { sample_count, 1 };
+    builder.begin_frame(0, mono, sample_count);
+    // LPC of order one, with a single warm-up sample.
+    builder.write_subframe_header(0b100000);
+    builder.write_signed_bits(1000, test_bits_per_sample);
+    // 15 bit coefficient precision, a shift of -2 and the coefficient.
+    builder.write_bits(14, 4);
+    builder.write_signed_bits(-2, 5);
+    builder.write_signed_bits(1 << 12, 15);
+    // A zero residual for all other samples.
+    builder.write_bits(0b00, 2);
+    builder.write_bits(0, 4);
+    builder.write_bits(0, 4);
+    for (size_t i = 1; i < sample_count; ++i)
+        builder.write_bits(1, 1);
+    builder.end_frame();
+
+    Audio::FlacLoaderPlugin loader { builder.bytes() };
+    MUST(loader.initialize());
+    auto samples = loader.get_more_samples(sample_count);
+    EXPECT(samples.is_error());
+    EXPECT_EQ(samples.error().category, Audio::LoaderError::Category::Format);
+}
+
+TEST_CASE(seeking_drops_already_decoded_samples)
+{
+    Vector<i32> reference;
+    auto builder = build_two_frame_stream(reference);
+
+    Audio::FlacLoaderPlugin loader { builder.bytes() };
+    MUST(loader.initialize());
+    // The rest of the first frame is kept around for the next call.
+    (void)MUST(loader.get_more_samples(5));
+
+    MUST(loader.seek(2));
+    auto samples = MUST(loader.get_more_samples(4));
+    EXPECT_EQ(to_pcm(samples.span()), Vector<i32>(reference.span().slice(2, 4)));
+
+    MUST(loader.seek(20));
+    auto samples_after_second_seek = MUST(loader.get_more_samples(4));
+    EXPECT_EQ(to_pcm(samples_after_second_seek.span()), Vector<i32>(reference.span().slice(20, 4)));
+}
+
+TEST_CASE(all_samples_are_returned)
+{
+    Vector<i32> reference;
+    auto builder = build_two_frame_stream(reference);
+
+    // Chunks that don't line up with the frames leave samples behind for the next call, which must not count as loaded yet.
+    for (size_t chunk_size : { 5, 10, 16, 100 }) {
+        Audio::FlacLoaderPlugin loader { builder.bytes() };
+        MUST(loader.initialize());
+        EXPECT_EQ(load_all_samples(loader, chunk_size), reference);
+        EXPECT_EQ(loader.loaded_samples(), static_cast<int>(reference.size()));
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <LibAudio/Resampler.h>
+#include <LibTest/TestCase.h>
+
+static constexpr double test_frequency = 1000;
+static constexpr float test_amplitude = 0.5f;
+
+static Vector<Audio::Sample> resample_in_chunks(Audio::PolyphaseResampler& resampler, Span<Audio::Sample const> input, size_t chunk_size)
+{
+    Vector<Audio::Sample> output;
+    for (size_t offset = 0; offset < input.size(); offset += chunk_size)
+        output.extend(MUST(resampler.resample(input.slice(offset, min(chunk_size, input.size() - offset)))));
+    output.extend(MUST(resampler.flush()));
+    return output;
+}
+
+// Fits a sine of the test frequency to the signal, and returns the power of what's left over relative to that sine, in dB.
+static double total_harmonic_distortion_plus_noise(Span<Audio::Sample const> signal, u32 sample_rate)
+{
+    // Solve the least squares problem for sine, cosine and DC, with Cramer's rule.
+    double matrix[3][3] {};
+    double right_hand_side[3] {};
+    auto basis_at = [&](size_t i, double basis[3]) {
+        auto angle = 2 * AK::Pi<double> * test_frequency * i / sample_rate;
+        basis[0] = AK::sin(angle);
+        basis[1] = AK::cos(angle);
+        basis[2] = 1;
+    };
+    for (size_t i = 0; i < signal.size(); ++i) {
+        double basis[3];
+        basis_at(i, basis);
+        for (size_t row = 0; row < 3; ++row) {
+            for (size_t column = 0; column < 3; ++column)
+                matrix[row][column] += basis[row] * basis[column];
+            right_hand_side[row] += basis[row] * signal[i].left;
+        }
+    }
+    auto determinant = [](double const m[3][3]) {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+            - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+            + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    };
+    double solution[3];
+    for (size_t column = 0; column < 3; ++column) {
+        double replaced[3][3];
+        for (size_t row = 0; row < 3; ++row) {
+            for (size_t i = 0; i < 3; ++i)
+                replaced[row][i] = i == column ? right_hand_side[row] : matrix[row][i];
+        }
+        solution[column] = determinant(replaced) / determinant(matrix);
+    }
+
+    double signal_power = 0;
+    double residual_power = 0;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        double basis[3];
+        basis_at(i, basis);
+        auto fitted = solution[0] * basis[0] + solution[1] * basis[1] + solution[2] * basis[2];
+        signal_power += fitted * fitted;
+        residual_power += (signal[i].left - fitted) * (signal[i].left - fitted);
+        // Both channels carry the same signal, so they have to come out the same.
+        EXPECT_EQ(signal[i].left, signal[i].right);
+    }
+    return 10 * AK::log10(residual_power / signal_power);
+}
+
+static double resampled_sine_distortion(u32 source, u32 target, Audio::PolyphaseResampler::Quality quality)
+{
+    Vector<Audio::Sample> input;
+    for (size_t i = 0; i < source; ++i)
+        input.append(Audio::Sample { test_amplitude * static_cast<float>(AK::sin(2 * AK::Pi<double> * test_frequency * i / source)) });
+
+    auto resampler = MUST(Audio::PolyphaseResampler::try_create(source, target, quality));
+    // An odd chunk size, so that the chunks don't line up with the filter phases.
+    auto output = resample_in_chunks(resampler, input, 1237);
+    EXPECT(AK::abs(static_cast<i64>(output.size()) - static_cast<i64>(target)) <= 1);
+
+    // The edges are distorted by the silence around the signal, so only look at the middle.
+    auto edge = target / 10;
+    return total_harmonic_distortion_plus_noise(output.span().slice(edge, output.size() - 2 * edge), target);
+}
+
+TEST_CASE(upsampling_distortion)
+{
+    EXPECT(resampled_sine_distortion(44100, 48000, Audio::PolyphaseResampler::Quality::Low) < -55);
+    EXPECT(resampled_sine_distortion(44100, 48000, Audio::PolyphaseResampler::Quality::Medium) < -90);
+    EXPECT(resampled_sine_distortion(44100, 48000, Audio::PolyphaseResampler::Quality::High) < -110);
+}
+
+TEST_CASE(downsampling_distortion)
+{
+    EXPECT(resampled_sine_distortion(48000, 44100, Audio::PolyphaseResampler::Quality::Medium) < -90);
+    EXPECT(resampled_sine_distortion(96000, 22050, Audio::PolyphaseResampler::Quality::Medium) < -90);
+}
+
+TEST_CASE(rounded_phase_distortion)
+{
+    // These rates have no common divisor, so the resampler can't have a phase for every output sample.
+    EXPECT(resampled_sine_distortion(44100, 47999, Audio::PolyphaseResampler::Quality::High) < -75);
+}
+
+TEST_CASE(constant_signal)
+{
+    Vector<Audio::Sample> input;
+    for (size_t i = 0; i < 10000; ++i)
+        input.append({ 0.25f, -0.5f });
+
+    auto resampler = MUST(Audio::PolyphaseResampler::try_create(22050, 48000));
+    auto output = resample_in_chunks(resampler, input, 512);
+    // Skip the edges, where the filter overlaps the silence around the signal.
+    for (size_t i = 100; i < output.size() - 100; ++i) {
+        EXPECT_APPROXIMATE(output[i].left, 0.25f);
+        EXPECT_APPROXIMATE(output[i].right, -0.5f);
+    }
+}
+
+TEST_CASE(same_rate)
+{
+    Vector<Audio::Sample> input;
+    for (size_t i = 0; i < 100; ++i)
+        input.append(Audio::Sample { static_cast<float>(i) / 100 });
+
+    auto resampler = MUST(Audio::PolyphaseResampler::try_create(48000, 48000));
+    auto output = resample_in_chunks(resampler, input, 30);
+    EXPECT_EQ(output.size(), input.size());
+    for (size_t i = 0; i < input.size(); ++i)
+        EXPECT_EQ(output[i].left, input[i].left);
+}
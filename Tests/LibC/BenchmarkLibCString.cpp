@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <string.h>
+
+// These benchmarks exercise the dispatched string routines across a range of
+// sizes and with both aligned and misaligned start addresses.
+
+static constexpr size_t sizes[] = { 7, 16, 63, 256, 4096, 65536 };
+static constexpr size_t alignments[] = { 0, 1, 7, 15, 31 };
+static constexpr size_t bytes_per_case = 64 * MiB;
+
+static Vector<char> make_buffer(size_t size)
+{
+    Vector<char> buffer;
+    buffer.resize(size + 64);
+    memset(buffer.data(), 'a', buffer.size());
+    return buffer;
+}
+
+template<typename Callback>
+static void run_for_all_sizes_and_alignments(Callback callback)
+{
+    for (auto size : sizes) {
+        auto buffer = make_buffer(size);
+        for (auto alignment : alignments) {
+            auto* start = buffer.data() + alignment;
+            size_t iterations = bytes_per_case / size / array_size(alignments);
+            for (size_t i = 0; i < iterations; ++i)
+                callback(start, size);
+        }
+    }
+}
+
+BENCHMARK_CASE(strlen)
+{
+    size_t volatile sink = 0;
+    run_for_all_sizes_and_alignments([&](char* str, size_t size) {
+        str[size] = '\0';
+        sink = sink + strlen(str);
+        str[size] = 'a';
+    });
+}
+
+BENCHMARK_CASE(strchr)
+{
+    char* volatile sink = nullptr;
+    run_for_all_sizes_and_alignments([&](char* str, size_t size) {
+        str[size] = '\0';
+        sink = strchr(str, '!');
+        str[size] = 'a';
+    });
+}
+
+BENCHMARK_CASE(memchr)
+{
+    void* volatile sink = nullptr;
+    run_for_all_sizes_and_alignments([&](char* str, size_t size) {
+        sink = memchr(str, '!', size);
+    });
+}
+
+// The buffers compare equal, so memcmp and strcmp always have to scan all of them.
+BENCHMARK_CASE(memcmp)
+{
+    auto other = make_buffer(65536);
+    int volatile sink = 0;
+    run_for_all_sizes_and_alignments([&](char* str, size_t size) {
+        sink = memcmp(str, other.data(), size);
+    });
+}
+
+BENCHMARK_CASE(strcmp)
+{
+    auto other = make_buffer(65536);
+    int volatile sink = 0;
+    run_for_all_sizes_and_alignments([&](char* str, size_t size) {
+        str[size] = '\0';
+        other[size] = '\0';
+        sink = strcmp(str, other.data());
+        str[size] = 'a';
+        other[size] = 'a';
+    });
+}
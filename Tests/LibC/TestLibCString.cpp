@@ -29,3 +29,80 @@ TEST_CASE(strtok_r_delimiters_only)
     // The string to which `saved_str` initially points to shouldn't be modified.
     EXPECT_EQ(strcmp(dummy, "a;"), 0);
 }
+
+// The x86-64 implementations work on whole vectors, so make sure they handle
+// every combination of start alignment, length and match position.
+static constexpr size_t max_tested_length = 130;
+static constexpr size_t max_tested_alignment = 64;
+
+TEST_CASE(strlen_all_alignments)
+{
+    char buffer[max_tested_alignment + max_tested_length + 1];
+    memset(buffer, 'a', sizeof(buffer));
+    for (size_t alignment = 0; alignment < max_tested_alignment; ++alignment) {
+        for (size_t length = 0; length < max_tested_length; ++length) {
+            buffer[alignment + length] = '\0';
+            EXPECT_EQ(strlen(buffer + alignment), length);
+            buffer[alignment + length] = 'a';
+        }
+    }
+}
+
+TEST_CASE(strchr_and_memchr_all_alignments)
+{
+    char buffer[max_tested_alignment + max_tested_length + 1];
+    memset(buffer, 'a', sizeof(buffer));
+    for (size_t alignment = 0; alignment < max_tested_alignment; ++alignment) {
+        auto* str = buffer + alignment;
+        for (size_t length = 1; length < max_tested_length; ++length) {
+            str[length] = '\0';
+            EXPECT_EQ(strchr(str, 'b'), nullptr);
+            EXPECT_EQ(strchr(str, '\0'), str + length);
+            EXPECT_EQ(memchr(str, 'b', length), nullptr);
+            EXPECT_EQ(memchr(str, '\0', length), nullptr);
+            EXPECT_EQ(memchr(str, '\0', length + 1), str + length);
+
+            str[length - 1] = 'b';
+            EXPECT_EQ(strchr(str, 'b'), str + length - 1);
+            EXPECT_EQ(memchr(str, 'b', length), str + length - 1);
+            EXPECT_EQ(memchr(str, 'b', length - 1), nullptr);
+
+            str[length - 1] = 'a';
+            str[length] = 'a';
+        }
+    }
+}
+
+TEST_CASE(memcmp_and_strcmp_all_alignments)
+{
+    char first[max_tested_alignment + max_tested_length + 1];
+    char second[max_tested_alignment + max_tested_length + 1];
+    memset(first, 'a', sizeof(first));
+    memset(second, 'a', sizeof(second));
+    for (size_t alignment = 0; alignment < max_tested_alignment; ++alignment) {
+        auto* s1 = first + alignment;
+        auto* s2 = second + (max_tested_alignment - alignment - 1);
+        for (size_t length = 1; length < max_tested_length; ++length) {
+            s1[length] = '\0';
+            s2[length] = '\0';
+            EXPECT_EQ(memcmp(s1, s2, length), 0);
+            EXPECT_EQ(strcmp(s1, s2), 0);
+
+            s2[length - 1] = 'b';
+            EXPECT(memcmp(s1, s2, length) < 0);
+            EXPECT(memcmp(s2, s1, length) > 0);
+            EXPECT_EQ(memcmp(s1, s2, length - 1), 0);
+            EXPECT(strcmp(s1, s2) < 0);
+            EXPECT(strcmp(s2, s1) > 0);
+
+            // Bytes are compared as unsigned chars.
+            s2[length - 1] = '\x80';
+            EXPECT(memcmp(s1, s2, length) < 0);
+            EXPECT(strcmp(s1, s2) < 0);
+
+            s2[length - 1] = 'a';
+            s1[length] = 'a';
+            s2[length] = 'a';
+        }
+    }
+}
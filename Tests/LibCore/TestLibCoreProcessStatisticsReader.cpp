@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteBuffer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/StringBuilder.h>
+#include <Kernel/API/ProcessStatistics.h>
+#include <LibCore/ProcessStatisticsReader.h>
+
+// These mirror what the kernel generates for /sys/kernel/processes and /sys/kernel/processes_binary.
+
+static String make_process_list_json(size_t process_count, size_t threads_per_process)
+{
+    StringBuilder builder;
+    auto json = MUST(JsonObjectSerializer<>::try_create(builder));
+    auto processes = MUST(json.add_array("processes"sv));
+    for (size_t pid = 0; pid < process_count; ++pid) {
+        auto process = MUST(processes.add_object());
+        MUST(process.add("pledge"sv, "stdio recvfd sendfd rpath unix "sv));
+        MUST(process.add("veil"sv, "Locked"sv));
+        MUST(process.add("pid"sv, pid));
+        MUST(process.add("pgid"sv, 0));
+        MUST(process.add("pgp"sv, pid));
+        MUST(process.add("sid"sv, pid));
+        MUST(process.add("uid"sv, 100));
+        MUST(process.add("gid"sv, 100));
+        MUST(process.add("ppid"sv, 1));
+        MUST(process.add("tty"sv, "/dev/pts/0"sv));
+        MUST(process.add("nfds"sv, 12));
+        MUST(process.add("name"sv, String::formatted("Process{}", pid)));
+        MUST(process.add("executable"sv, String::formatted("/bin/Process{}", pid)));
+        MUST(process.add("amount_virtual"sv, pid * 4096));
+        MUST(process.add("amount_resident"sv, pid * 1024));
+        MUST(process.add("amount_dirty_private"sv, pid * 512));
+        MUST(process.add("amount_clean_inode"sv, 0));
+        MUST(process.add("amount_shared"sv, 8192));
+        MUST(process.add("amount_purgeable_volatile"sv, 0));
+        MUST(process.add("amount_purgeable_nonvolatile"sv, 0));
+        MUST(process.add("dumpable"sv, true));
+        MUST(process.add("kernel"sv, false));
+        auto threads = MUST(process.add_array("threads"sv));
+        for (size_t tid = 0; tid < threads_per_process; ++tid) {
+            auto thread = MUST(threads.add_object());
+            MUST(thread.add("tid"sv, pid * 100 + tid));
+            MUST(thread.add("name"sv, String::formatted("Thread {}", tid)));
+            MUST(thread.add("times_scheduled"sv, 12345));
+            MUST(thread.add("time_user"sv, 1234567890ull));
+            MUST(thread.add("time_kernel"sv, 987654321ull));
+            MUST(thread.add("state"sv, "Blocked"sv));
+            MUST(thread.add("cpu"sv, tid % 4));
+            MUST(thread.add("priority"sv, 30));
+            MUST(thread.add("syscall_count"sv, 4321));
+            MUST(thread.add("inode_faults"sv, 10));
+            MUST(thread.add("zero_faults"sv, 20));
+            MUST(thread.add("cow_faults"sv, 30));
+            MUST(thread.add("file_read_bytes"sv, 40960));
+            MUST(thread.add("file_write_bytes"sv, 1024));
+            MUST(thread.add("unix_socket_read_bytes"sv, 2048));
+            MUST(thread.add("unix_socket_write_bytes"sv, 4096));
+            MUST(thread.add("ipv4_socket_read_bytes"sv, 0));
+            MUST(thread.add("ipv4_socket_write_bytes"sv, 0));
+            MUST(thread.finish());
+        }
+        MUST(threads.finish());
+        MUST(process.finish());
+    }
+    MUST(processes.finish());
+    MUST(json.add("total_time"sv, 1234567890123ull));
+    MUST(json.add("total_time_kernel"sv, 123456789012ull));
+    MUST(json.finish());
+    return builder.to_string();
+}
+
+template<typename Fields, size_t string_count>
+static void append_record(ByteBuffer& buffer, Kernel::ProcessStatisticsRecordHeader::Type type, Fields const& fields, Array<StringView, string_count> const& strings)
+{
+    constexpr size_t fixed_size = sizeof(Kernel::ProcessStatisticsRecordHeader) + sizeof(Fields);
+    size_t size = fixed_size;
+    for (auto string : strings)
+        size += string.length();
+    auto padded_size = align_up_to(size, Kernel::process_statistics_record_alignment);
+
+    Kernel::ProcessStatisticsRecordHeader header {};
+    header.type = type;
+    header.fixed_size = fixed_size;
+    header.size = padded_size;
+    buffer.append(&header, sizeof(header));
+    buffer.append(&fields, sizeof(fields));
+    for (auto string : strings)
+        buffer.append(string.bytes());
+    for (size_t i = size; i < padded_size; ++i)
+        buffer.append(0);
+}
+
+static ByteBuffer make_process_list_binary(size_t process_count, size_t threads_per_process)
+{
+    ByteBuffer buffer;
+    Kernel::ProcessStatisticsHeader header {};
+    header.magic = Kernel::process_statistics_magic;
+    header.version = Kernel::process_statistics_version;
+    header.size = sizeof(header);
+    header.total_time = 1234567890123ull;
+    header.total_time_kernel = 123456789012ull;
+    buffer.append(&header, sizeof(header));
+
+    for (size_t pid = 0; pid < process_count; ++pid) {
+        auto name = String::formatted("Process{}", pid);
+        auto executable = String::formatted("/bin/Process{}", pid);
+        Array strings { name.view(), executable.view(), "/dev/pts/0"sv, "stdio recvfd sendfd rpath unix "sv, "Locked"sv };
+        Kernel::ProcessStatisticsProcessRecord process {};
+        process.pid = pid;
+        process.pgid = 0;
+        process.pgp = pid;
+        process.sid = pid;
+        process.uid = 100;
+        process.gid = 100;
+        process.ppid = 1;
+        process.nfds = 12;
+        process.amount_virtual = pid * 4096;
+        process.amount_resident = pid * 1024;
+        process.amount_dirty_private = pid * 512;
+        process.amount_shared = 8192;
+        process.dumpable = true;
+        process.name_length = strings[0].length();
+        process.executable_length = strings[1].length();
+        process.tty_length = strings[2].length();
+        process.pledge_length = strings[3].length();
+        process.veil_length = strings[4].length();
+        append_record(buffer, Kernel::ProcessStatisticsRecordHeader::Type::Process, process, strings);
+
+        for (size_t tid = 0; tid < threads_per_process; ++tid) {
+            auto thread_name = String::formatted("Thread {}", tid);
+            Array thread_strings { thread_name.view(), "Blocked"sv };
+            Kernel::ProcessStatisticsThreadRecord thread {};
+            thread.tid = pid * 100 + tid;
+            thread.times_scheduled = 12345;
+            thread.time_user = 1234567890ull;
+            thread.time_kernel = 987654321ull;
+            thread.cpu = tid % 4;
+            thread.priority = 30;
+            thread.syscall_count = 4321;
+            thread.inode_faults = 10;
+            thread.zero_faults = 20;
+            thread.cow_faults = 30;
+            thread.file_read_bytes = 40960;
+            thread.file_write_bytes = 1024;
+            thread.unix_socket_read_bytes = 2048;
+            thread.unix_socket_write_bytes = 4096;
+            thread.name_length = thread_strings[0].length();
+            thread.state_length = thread_strings[1].length();
+            append_record(buffer, Kernel::ProcessStatisticsRecordHeader::Type::Thread, thread, thread_strings);
+        }
+    }
+    return buffer;
+}
+
+static void expect_same_statistics(Core::AllProcessesStatistics const& a, Core::AllProcessesStatistics const& b)
+{
+    EXPECT_EQ(a.total_time_scheduled, b.total_time_scheduled);
+    EXPECT_EQ(a.total_time_scheduled_kernel, b.total_time_scheduled_kernel);
+    EXPECT_EQ(a.processes.size(), b.processes.size());
+    for (size_t i = 0; i < min(a.processes.size(), b.processes.size()); ++i) {
+        auto& process_a = a.processes[i];
+        auto& process_b = b.processes[i];
+        EXPECT_EQ(process_a.pid, process_b.pid);
+        EXPECT_EQ(process_a.pgp, process_b.pgp);
+        EXPECT_EQ(process_a.sid, process_b.sid);
+        EXPECT_EQ(process_a.uid, process_b.uid);
+        EXPECT_EQ(process_a.ppid, process_b.ppid);
+        EXPECT_EQ(process_a.nfds, process_b.nfds);
+        EXPECT_EQ(process_a.kernel, process_b.kernel);
+        EXPECT_EQ(process_a.name, process_b.name);
+        EXPECT_EQ(process_a.executable, process_b.executable);
+        EXPECT_EQ(process_a.tty, process_b.tty);
+        EXPECT_EQ(process_a.pledge, process_b.pledge);
+        EXPECT_EQ(process_a.veil, process_b.veil);
+        EXPECT_EQ(process_a.amount_virtual, process_b.amount_virtual);
+        EXPECT_EQ(process_a.amount_resident, process_b.amount_resident);
+        EXPECT_EQ(process_a.amount_dirty_private, process_b.amount_dirty_private);
+        EXPECT_EQ(process_a.amount_shared, process_b.amount_shared);
+        EXPECT_EQ(process_a.threads.size(), process_b.threads.size());
+        for (size_t j = 0; j < min(process_a.threads.size(), process_b.threads.size()); ++j) {
+            auto& thread_a = process_a.threads[j];
+            auto& thread_b = process_b.threads[j];
+            EXPECT_EQ(thread_a.tid, thread_b.tid);
+            EXPECT_EQ(thread_a.name, thread_b.name);
+            EXPECT_EQ(thread_a.state, thread_b.state);
+            EXPECT_EQ(thread_a.times_scheduled, thread_b.times_scheduled);
+            EXPECT_EQ(thread_a.time_user, thread_b.time_user);
+            EXPECT_EQ(thread_a.time_kernel, thread_b.time_kernel);
+            EXPECT_EQ(thread_a.cpu, thread_b.cpu);
+            EXPECT_EQ(thread_a.priority, thread_b.priority);
+            EXPECT_EQ(thread_a.syscall_count, thread_b.syscall_count);
+            EXPECT_EQ(thread_a.cow_faults, thread_b.cow_faults);
+            EXPECT_EQ(thread_a.file_read_bytes, thread_b.file_read_bytes);
+            EXPECT_EQ(thread_a.unix_socket_write_bytes, thread_b.unix_socket_write_bytes);
+        }
+    }
+}
+
+TEST_CASE(binary_matches_json)
+{
+    auto from_json = Core::ProcessStatisticsReader::from_json(make_process_list_json(20, 3), false);
+    auto from_binary = Core::ProcessStatisticsReader::from_binary(make_process_list_binary(20, 3), false);
+    EXPECT(from_json.has_value());
+    EXPECT(from_binary.has_value());
+    expect_same_statistics(*from_json, *from_binary);
+    EXPECT_EQ(from_binary->processes[7].name, "Process7"sv);
+    EXPECT_EQ(from_binary->processes[7].threads[2].tid, 702);
+    EXPECT_EQ(from_binary->processes[7].threads[2].state, "Blocked"sv);
+}
+
+TEST_CASE(binary_skips_unknown_records)
+{
+    auto buffer = make_process_list_binary(2, 1);
+
+    // A record type from the future, which has to be skipped without losing the records after it.
+    Kernel::ProcessStatisticsRecordHeader header {};
+    header.type = static_cast<Kernel::ProcessStatisticsRecordHeader::Type>(1234);
+    header.fixed_size = sizeof(header) + 8;
+    header.size = sizeof(header) + 16;
+    buffer.append(&header, sizeof(header));
+    for (size_t i = 0; i < 16; ++i)
+        buffer.append(0xff);
+    buffer.append(make_process_list_binary(1, 1).bytes().slice(sizeof(Kernel::ProcessStatisticsHeader)));
+
+    auto statistics = Core::ProcessStatisticsReader::from_binary(buffer, false);
+    EXPECT(statistics.has_value());
+    EXPECT_EQ(statistics->processes.size(), 3u);
+    EXPECT_EQ(statistics->processes[2].threads.size(), 1u);
+}
+
+TEST_CASE(binary_rejects_truncated_input)
+{
+    auto buffer = make_process_list_binary(2, 2);
+    EXPECT(!Core::ProcessStatisticsReader::from_binary(buffer.bytes().trim(buffer.size() - 1), false).has_value());
+    EXPECT(!Core::ProcessStatisticsReader::from_binary(buffer.bytes().trim(4), false).has_value());
+
+    // A string that runs past the end of its record.
+    auto* process = reinterpret_cast<Kernel::ProcessStatisticsProcessRecord*>(buffer.offset_pointer(sizeof(Kernel::ProcessStatisticsHeader) + sizeof(Kernel::ProcessStatisticsRecordHeader)));
+    process->veil_length = 1000;
+    EXPECT(!Core::ProcessStatisticsReader::from_binary(buffer, false).has_value());
+}
+
+TEST_CASE(binary_rejects_unknown_version)
+{
+    auto buffer = make_process_list_binary(2, 2);
+    reinterpret_cast<Kernel::ProcessStatisticsHeader*>(buffer.data())->version = Kernel::process_statistics_version + 1;
+    EXPECT(!Core::ProcessStatisticsReader::from_binary(buffer, false).has_value());
+}
+
+BENCHMARK_CASE(read_process_list_json)
+{
+    auto input = make_process_list_json(500, 8);
+    for (int i = 0; i < 50; ++i) {
+        auto statistics = Core::ProcessStatisticsReader::from_json(input, false);
+        EXPECT_EQ(statistics->processes.size(), 500u);
+    }
+}
+
+BENCHMARK_CASE(read_process_list_binary)
+{
+    auto input = make_process_list_binary(500, 8);
+    for (int i = 0; i < 50; ++i) {
+        auto statistics = Core::ProcessStatisticsReader::from_binary(input, false);
+        EXPECT_EQ(statistics->processes.size(), 500u);
+    }
+}
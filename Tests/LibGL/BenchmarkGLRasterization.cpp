@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibCore/ElapsedTimer.h>
+#include <LibGL/GL/gl.h>
+#include <LibGL/GLContext.h>
+#include <LibGfx/Bitmap.h>
+
+static NonnullOwnPtr<GL::GLContext> create_benchmark_context(int width, int height)
+{
+    auto bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { width, height }));
+    auto context = MUST(GL::create_context(*bitmap));
+    GL::make_context_current(context);
+    return context;
+}
+
+BENCHMARK_CASE(triangle_rate)
+{
+    int const run_count = 20;
+    int const triangles_per_axis = 256;
+    auto context = create_benchmark_context(1024, 1024);
+
+    // A grid of small triangles that covers the whole color buffer, like a finely tessellated mesh
+    auto timer = Core::ElapsedTimer::start_new();
+    for (int run = 0; run < run_count; ++run) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        glBegin(GL_TRIANGLES);
+        for (int y = 0; y < triangles_per_axis; ++y) {
+            for (int x = 0; x < triangles_per_axis; ++x) {
+                auto left = -1.f + 2.f * x / triangles_per_axis;
+                auto top = -1.f + 2.f * y / triangles_per_axis;
+                auto size = 2.f / triangles_per_axis;
+                glColor3f(static_cast<float>(x) / triangles_per_axis, static_cast<float>(y) / triangles_per_axis, 1.f);
+                glVertex2f(left, top);
+                glVertex2f(left + size, top);
+                glVertex2f(left, top + size);
+            }
+        }
+        glEnd();
+    }
+    auto elapsed_ms = max(timer.elapsed(), 1);
+    outln("triangle_rate: {:.1} thousand triangles/s", static_cast<double>(run_count) * triangles_per_axis * triangles_per_axis / elapsed_ms);
+
+    EXPECT_EQ(glGetError(), 0u);
+}
+
+BENCHMARK_CASE(fill_rate)
+{
+    int const run_count = 5;
+    int const layer_count = 16;
+    int const size = 1024;
+    auto context = create_benchmark_context(size, size);
+
+    // Layers of blended, screen-filling quads
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    auto timer = Core::ElapsedTimer::start_new();
+    for (int run = 0; run < run_count; ++run) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        glBegin(GL_QUADS);
+        for (int layer = 0; layer < layer_count; ++layer) {
+            glColor4f(static_cast<float>(layer) / layer_count, 0.5f, 1.f, 0.25f);
+            glVertex2f(-1.f, -1.f);
+            glVertex2f(1.f, -1.f);
+            glVertex2f(1.f, 1.f);
+            glVertex2f(-1.f, 1.f);
+        }
+        glEnd();
+    }
+    auto elapsed_ms = max(timer.elapsed(), 1);
+    outln("fill_rate: {:.1} megapixels/s", static_cast<double>(run_count) * layer_count * size * size / 1000.0 / elapsed_ms);
+
+    EXPECT_EQ(glGetError(), 0u);
+}
@@ -269,3 +269,29 @@ TEST_CASE(0009_test_draw_elements_in_display_list)
     context->present();
     expect_bitmap_equals_reference(context->frontbuffer(), "0009_test_draw_elements_in_display_list"sv);
 }
+
+TEST_CASE(0010_test_overlapping_quads_across_tiles)
+{
+    auto context = create_testing_context(200, 200);
+
+    // Blended quads that overlap each other and span several rasterization tiles,
+    // so the result depends on them being drawn in the order they were submitted
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBegin(GL_QUADS);
+    for (int i = 0; i < 16; ++i) {
+        auto offset = -.9f + i * .08f;
+        glColor4f((i % 3) / 2.f, (i % 5) / 4.f, (i % 7) / 6.f, .5f);
+        glVertex2f(offset, offset);
+        glVertex2f(offset + .6f, offset + .1f);
+        glVertex2f(offset + .5f, offset + .7f);
+        glVertex2f(offset - .1f, offset + .5f);
+    }
+    glEnd();
+
+    EXPECT_EQ(glGetError(), 0u);
+
+    context->present();
+    expect_bitmap_equals_reference(context->frontbuffer(), "0010_test_overlapping_quads_across_tiles"sv);
+}
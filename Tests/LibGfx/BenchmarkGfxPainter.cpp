@@ -6,9 +6,15 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/Math.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/Font/ScaledFont.h>
+#include <LibGfx/Font/TrueType/Font.h>
 #include <LibGfx/Painter.h>
+#include <LibGfx/Path.h>
 #include <stdio.h>
 
 // Make sure that no matter what order tests are run in, we've got some
@@ -61,3 +67,124 @@ BENCHMARK_CASE(fill_with_gradient)
         painter.fill_rect_with_gradient(bitmap->rect(), Color::Blue, Color::Red);
     }
 }
+
+BENCHMARK_CASE(draw_text_run_with_vector_font)
+{
+    int const run_count = 100;
+    int const bitmap_size = 1000;
+
+    auto vector_font = MUST(TTF::Font::try_load_from_file("/res/fonts/LiberationSerif-Regular.ttf"));
+    auto font = adopt_ref(*new Gfx::ScaledFont(vector_font, 12, 12));
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    Gfx::Painter painter(bitmap);
+    auto text = "The quick brown fox jumps over the lazy dog, 0123456789 times."sv;
+
+    for (int run = 0; run < run_count; run++) {
+        for (int line = 0; line < bitmap_size / 16; line++)
+            painter.draw_text_run({ 0.5f, 12.0f + line * 16 }, Utf8View { text }, *font, Color::Black);
+    }
+}
+
+static void report_throughput(StringView operation, u64 pixel_count, Core::ElapsedTimer const& timer)
+{
+    auto elapsed_ms = max(timer.elapsed(), 1);
+    outln("{}: {:.1} megapixels/s", operation, static_cast<double>(pixel_count) / 1000.0 / elapsed_ms);
+}
+
+static NonnullRefPtr<Gfx::Bitmap> make_translucent_bitmap(int size)
+{
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, { size, size }).release_value_but_fixme_should_propagate_errors();
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x)
+            bitmap->set_pixel(x, y, Color(x % 256, y % 256, (x + y) % 256, (x * y) % 256));
+    }
+    return bitmap;
+}
+
+BENCHMARK_CASE(blit_with_alpha)
+{
+    int const run_count = 100;
+    int const bitmap_size = 1000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    auto source = make_translucent_bitmap(bitmap_size);
+    Gfx::Painter painter(bitmap);
+
+    auto timer = Core::ElapsedTimer::start_new();
+    for (int run = 0; run < run_count; run++)
+        painter.blit({}, *source, source->rect());
+    report_throughput("blit_with_alpha"sv, static_cast<u64>(run_count) * bitmap_size * bitmap_size, timer);
+}
+
+BENCHMARK_CASE(blit_with_opacity)
+{
+    int const run_count = 100;
+    int const bitmap_size = 1000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    auto source = make_translucent_bitmap(bitmap_size);
+    Gfx::Painter painter(bitmap);
+
+    auto timer = Core::ElapsedTimer::start_new();
+    for (int run = 0; run < run_count; run++)
+        painter.blit({}, *source, source->rect(), 0.5f);
+    report_throughput("blit_with_opacity"sv, static_cast<u64>(run_count) * bitmap_size * bitmap_size, timer);
+}
+
+BENCHMARK_CASE(fill_with_alpha)
+{
+    int const run_count = 100;
+    int const bitmap_size = 1000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    Gfx::Painter painter(bitmap);
+
+    auto timer = Core::ElapsedTimer::start_new();
+    for (int run = 0; run < run_count; run++)
+        painter.fill_rect(bitmap->rect(), Color(0, 0, 255, 100));
+    report_throughput("fill_with_alpha"sv, static_cast<u64>(run_count) * bitmap_size * bitmap_size, timer);
+}
+
+BENCHMARK_CASE(draw_scaled_bitmap_with_bilinear_blend)
+{
+    int const run_count = 20;
+    int const bitmap_size = 1000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    auto source = make_translucent_bitmap(bitmap_size * 2 / 3);
+    Gfx::Painter painter(bitmap);
+
+    auto timer = Core::ElapsedTimer::start_new();
+    for (int run = 0; run < run_count; run++)
+        painter.draw_scaled_bitmap(bitmap->rect(), *source, source->rect(), 1.0f, Gfx::Painter::ScalingMode::BilinearBlend);
+    report_throughput("draw_scaled_bitmap_with_bilinear_blend"sv, static_cast<u64>(run_count) * bitmap_size * bitmap_size, timer);
+}
+
+BENCHMARK_CASE(fill_path_anti_aliased)
+{
+    int const run_count = 200;
+    int const bitmap_size = 1000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+
+    // A star with many points, which has lots of edges active on every scanline.
+    Gfx::Path path;
+    int const point_count = 64;
+    float const center = bitmap_size / 2.0f;
+    for (int i = 0; i < point_count * 2; ++i) {
+        float radius = i % 2 ? center * 0.6f : center * 0.95f;
+        float angle = i * AK::Pi<float> / point_count;
+        Gfx::FloatPoint point { center + radius * AK::cos(angle), center + radius * AK::sin(angle) };
+        if (i == 0)
+            path.move_to(point);
+        else
+            path.line_to(point);
+    }
+    path.close();
+
+    for (int run = 0; run < run_count; run++)
+        aa_painter.fill_path(path, Color(0, 0, 255, 200), Gfx::Painter::WindingRule::Nonzero);
+}
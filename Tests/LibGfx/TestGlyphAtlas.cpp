@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/GlyphAtlas.h>
+#include <LibTest/TestCase.h>
+
+static NonnullRefPtr<Gfx::Bitmap> make_glyph_bitmap(Gfx::IntSize const& size, u8 alpha)
+{
+    auto bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, size));
+    bitmap->fill(Color(0xff, 0xff, 0xff, alpha));
+    return bitmap;
+}
+
+TEST_CASE(subpixel_variants)
+{
+    EXPECT_EQ(Gfx::GlyphAtlas::subpixel_variant_for(10.0f), 0);
+    EXPECT_EQ(Gfx::GlyphAtlas::subpixel_variant_for(10.3f), 1);
+    EXPECT_EQ(Gfx::GlyphAtlas::subpixel_variant_for(10.5f), 2);
+    EXPECT_EQ(Gfx::GlyphAtlas::subpixel_variant_for(10.99f), 3);
+    EXPECT_EQ(Gfx::GlyphAtlas::subpixel_variant_for(-0.25f), 3);
+}
+
+TEST_CASE(insert_and_find)
+{
+    Gfx::GlyphAtlas atlas;
+    EXPECT(!atlas.find(42, 0).has_value());
+
+    auto inserted = atlas.insert(42, 0, make_glyph_bitmap({ 7, 12 }, 0x80), 3);
+    EXPECT(inserted.has_value());
+    EXPECT_EQ(inserted->size, Gfx::IntSize(7, 12));
+    EXPECT_EQ(inserted->left_bearing, 3);
+
+    auto found = atlas.find(42, 0);
+    EXPECT(found.has_value());
+    EXPECT_EQ(found->coverage, inserted->coverage);
+    for (int y = 0; y < 12; ++y) {
+        for (int x = 0; x < 7; ++x)
+            EXPECT_EQ(found->coverage[y * found->pitch + x], 0x80);
+    }
+
+    // Each subpixel variant is a separate entry.
+    EXPECT(!atlas.find(42, 1).has_value());
+    EXPECT(atlas.insert(42, 1, make_glyph_bitmap({ 8, 12 }, 0xff), 3).has_value());
+    EXPECT_EQ(atlas.find(42, 1)->coverage[0], 0xff);
+    EXPECT_EQ(atlas.find(42, 0)->coverage[0], 0x80);
+    EXPECT_EQ(atlas.page_count(), 1u);
+}
+
+TEST_CASE(glyphs_that_dont_fit_a_page)
+{
+    Gfx::GlyphAtlas atlas;
+    EXPECT(!atlas.insert(1, 0, make_glyph_bitmap({ Gfx::GlyphAtlas::page_size + 1, 10 }, 0xff), 0).has_value());
+    EXPECT_EQ(atlas.page_count(), 0u);
+}
+
+TEST_CASE(evict_least_recently_used_page)
+{
+    Gfx::GlyphAtlas atlas;
+    auto page_sized_glyph = make_glyph_bitmap({ Gfx::GlyphAtlas::page_size, Gfx::GlyphAtlas::page_size }, 0xff);
+
+    for (u32 glyph_id = 0; glyph_id < Gfx::GlyphAtlas::max_page_count; ++glyph_id)
+        EXPECT(atlas.insert(glyph_id, 0, page_sized_glyph, 0).has_value());
+    EXPECT_EQ(atlas.page_count(), Gfx::GlyphAtlas::max_page_count);
+
+    // Touch everything but glyph 1, which makes its page the least recently used one.
+    for (u32 glyph_id = 0; glyph_id < Gfx::GlyphAtlas::max_page_count; ++glyph_id) {
+        if (glyph_id != 1)
+            EXPECT(atlas.find(glyph_id, 0).has_value());
+    }
+
+    EXPECT(atlas.insert(1000, 0, page_sized_glyph, 0).has_value());
+    EXPECT_EQ(atlas.page_count(), Gfx::GlyphAtlas::max_page_count);
+    EXPECT(!atlas.find(1, 0).has_value());
+    EXPECT(atlas.find(0, 0).has_value());
+    EXPECT(atlas.find(1000, 0).has_value());
+}
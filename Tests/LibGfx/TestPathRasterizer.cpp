@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Path.h>
+#include <LibTest/TestCase.h>
+
+static NonnullRefPtr<Gfx::Bitmap> make_black_bitmap()
+{
+    auto bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { 20, 20 }));
+    bitmap->fill(Color::Black);
+    return bitmap;
+}
+
+static Gfx::Path make_rect_path(float left, float top, float right, float bottom)
+{
+    Gfx::Path path;
+    path.move_to({ left, top });
+    path.line_to({ right, top });
+    path.line_to({ right, bottom });
+    path.line_to({ left, bottom });
+    path.close();
+    return path;
+}
+
+static u8 coverage_at(Gfx::Bitmap const& bitmap, int x, int y)
+{
+    return bitmap.get_pixel(x, y).red();
+}
+
+TEST_CASE(fill_rect_with_fractional_edges)
+{
+    auto bitmap = make_black_bitmap();
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+
+    auto path = make_rect_path(2.5f, 3, 8.5f, 7);
+    aa_painter.fill_path(path, Color::White);
+
+    EXPECT_EQ(coverage_at(bitmap, 1, 4), 0);
+    EXPECT_EQ(coverage_at(bitmap, 2, 4), 128);
+    EXPECT_EQ(coverage_at(bitmap, 3, 4), 255);
+    EXPECT_EQ(coverage_at(bitmap, 7, 4), 255);
+    EXPECT_EQ(coverage_at(bitmap, 8, 4), 128);
+    EXPECT_EQ(coverage_at(bitmap, 9, 4), 0);
+    EXPECT_EQ(coverage_at(bitmap, 4, 2), 0);
+    EXPECT_EQ(coverage_at(bitmap, 4, 3), 255);
+}
+
+TEST_CASE(winding_rules)
+{
+    Gfx::Path path = make_rect_path(2, 2, 16, 16);
+    // The inner rect winds the same way as the outer one.
+    path.move_to({ 6, 6 });
+    path.line_to({ 12, 6 });
+    path.line_to({ 12, 12 });
+    path.line_to({ 6, 12 });
+    path.close();
+
+    auto nonzero = make_black_bitmap();
+    Gfx::Painter nonzero_painter(nonzero);
+    Gfx::AntiAliasingPainter(nonzero_painter).fill_path(path, Color::White, Gfx::Painter::WindingRule::Nonzero);
+    EXPECT_EQ(coverage_at(nonzero, 3, 3), 255);
+    EXPECT_EQ(coverage_at(nonzero, 8, 8), 255);
+
+    auto even_odd = make_black_bitmap();
+    Gfx::Painter even_odd_painter(even_odd);
+    Gfx::AntiAliasingPainter(even_odd_painter).fill_path(path, Color::White, Gfx::Painter::WindingRule::EvenOdd);
+    EXPECT_EQ(coverage_at(even_odd, 3, 3), 255);
+    EXPECT_EQ(coverage_at(even_odd, 8, 8), 0);
+}
+
+TEST_CASE(aliased_fill_is_clipped_and_translated)
+{
+    auto bitmap = make_black_bitmap();
+    Gfx::Painter painter(bitmap);
+    painter.translate(5, 5);
+    painter.add_clip_rect({ 0, 0, 5, 5 });
+
+    auto path = make_rect_path(-2, -2, 30, 30);
+    painter.fill_path(path, Color::White);
+
+    EXPECT_EQ(coverage_at(bitmap, 4, 5), 0);
+    EXPECT_EQ(coverage_at(bitmap, 5, 5), 255);
+    EXPECT_EQ(coverage_at(bitmap, 9, 9), 255);
+    EXPECT_EQ(coverage_at(bitmap, 10, 9), 0);
+    EXPECT_EQ(coverage_at(bitmap, 9, 10), 0);
+}
+
+TEST_CASE(stroke_with_bevelled_join)
+{
+    auto bitmap = make_black_bitmap();
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+
+    Gfx::Path path;
+    path.move_to({ 2, 5 });
+    path.line_to({ 15, 5 });
+    path.line_to({ 15, 18 });
+    aa_painter.stroke_path(path, Color::White, 2);
+
+    // A line of thickness 2 along y = 5 fully covers the rows above and below it.
+    EXPECT_EQ(coverage_at(bitmap, 8, 3), 0);
+    EXPECT_EQ(coverage_at(bitmap, 8, 4), 255);
+    EXPECT_EQ(coverage_at(bitmap, 8, 5), 255);
+    EXPECT_EQ(coverage_at(bitmap, 8, 6), 0);
+    EXPECT_EQ(coverage_at(bitmap, 14, 10), 255);
+    EXPECT_EQ(coverage_at(bitmap, 15, 10), 255);
+    // Overlapping pieces of the stroke don't cover more than fully.
+    EXPECT_EQ(coverage_at(bitmap, 14, 5), 255);
+}
+
+TEST_CASE(anti_aliased_fill_under_clip_matches_unclipped_fill)
+{
+    // The slanted edges cross both sides of the clip rect.
+    Gfx::Path path;
+    path.move_to({ -13.3f, 0 });
+    path.line_to({ 25.7f, 1 });
+    path.line_to({ 31, 19 });
+    path.line_to({ -9.5f, 16.25f });
+    path.close();
+
+    auto unclipped = make_black_bitmap();
+    Gfx::Painter unclipped_painter(unclipped);
+    Gfx::AntiAliasingPainter(unclipped_painter).fill_path(path, Color::White);
+
+    for (auto clip_rect : { Gfx::IntRect { 0, 0, 10, 20 }, Gfx::IntRect { 2, 0, 10, 20 }, Gfx::IntRect { 7, 3, 5, 11 } }) {
+        auto clipped = make_black_bitmap();
+        Gfx::Painter clipped_painter(clipped);
+        clipped_painter.add_clip_rect(clip_rect);
+        Gfx::AntiAliasingPainter(clipped_painter).fill_path(path, Color::White);
+
+        for (int y = 0; y < clipped->height(); ++y) {
+            for (int x = 0; x < clipped->width(); ++x) {
+                if (!clip_rect.contains(x, y)) {
+                    EXPECT_EQ(coverage_at(clipped, x, y), 0);
+                    continue;
+                }
+                auto difference = abs(coverage_at(clipped, x, y) - coverage_at(unclipped, x, y));
+                EXPECT(difference <= 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibGfx/PixelBlending.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(divide_by_255)
+{
+    for (u32 x = 0; x <= 255 * 255; ++x)
+        EXPECT_EQ(Gfx::Detail::divide_by_255(x), x / 255);
+}
+
+TEST_CASE(blend_onto_opaque_matches_color_blend)
+{
+    // The row is long enough to go through both the vectorized and the scalar code.
+    constexpr size_t pixel_count = 7;
+    for (u32 alpha = 0; alpha <= 255; ++alpha) {
+        for (u32 value = 0; value <= 255; value += 15) {
+            Array<Gfx::ARGB32, pixel_count> dst;
+            Array<Gfx::ARGB32, pixel_count> src;
+            for (size_t i = 0; i < pixel_count; ++i) {
+                dst[i] = Color(value, 255 - value, (value + i * 40) % 256).value();
+                src[i] = Color(255 - value, (value + i * 30) % 256, value, alpha).value();
+            }
+
+            auto blended = dst;
+            Gfx::blend_row_onto_opaque<true, false>(blended.data(), src.data(), pixel_count, 255);
+            for (size_t i = 0; i < pixel_count; ++i)
+                EXPECT_EQ(blended[i], Color::from_argb(dst[i]).blend(Color::from_argb(src[i])).value());
+        }
+    }
+}
+
+TEST_CASE(blend_with_opacity)
+{
+    Array<Gfx::ARGB32, 5> dst;
+    Array<Gfx::ARGB32, 5> src;
+    dst.fill(Color(Color::Black).value());
+    src.fill(Color(200, 100, 50).value());
+
+    Gfx::blend_row_onto_opaque<false, false>(dst.data(), src.data(), dst.size(), 128);
+    for (auto pixel : dst)
+        EXPECT_EQ(pixel, Color(100, 50, 25).value());
+
+    // A half transparent source at half opacity contributes a quarter of its color.
+    dst.fill(Color(Color::Black).value());
+    src.fill(Color(200, 100, 52, 128).value());
+    Gfx::blend_row_onto_opaque<true, false>(dst.data(), src.data(), dst.size(), 128);
+    for (auto pixel : dst)
+        EXPECT_EQ(pixel, Color(50, 25, 13).value());
+}
+
+TEST_CASE(blend_rgba_source)
+{
+    Array<Gfx::ARGB32, 6> dst;
+    Array<Gfx::ARGB32, 6> src;
+    dst.fill(Color(Color::Black).value());
+    // Red and blue are swapped in RGBA8888.
+    src.fill(Color(10, 20, 30, 255).value());
+
+    Gfx::blend_row_onto_opaque<true, true>(dst.data(), src.data(), dst.size(), 255);
+    for (auto pixel : dst)
+        EXPECT_EQ(pixel, Color(30, 20, 10).value());
+}
+
+TEST_CASE(fill_onto_opaque_matches_color_blend)
+{
+    Array<Gfx::ARGB32, 9> dst;
+    for (size_t i = 0; i < dst.size(); ++i)
+        dst[i] = Color(i * 20, 255 - i * 20, 128).value();
+
+    Color color(40, 80, 160, 77);
+    auto filled = dst;
+    Gfx::fill_row_onto_opaque(filled.data(), filled.size(), color);
+    for (size_t i = 0; i < dst.size(); ++i)
+        EXPECT_EQ(filled[i], Color::from_argb(dst[i]).blend(color).value());
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Vector.h>
+#include <LibIPC/MessageRing.h>
+#include <LibTest/TestCase.h>
+
+using RecordType = IPC::MessageRing::RecordType;
+
+static ReadonlyBytes bytes_of(u32 const& value)
+{
+    return { &value, sizeof(value) };
+}
+
+TEST_CASE(write_and_read)
+{
+    auto ring = MUST(IPC::MessageRing::try_create());
+    EXPECT(!MUST(ring.try_read()).has_value());
+
+    Array<u8, 5> payload { 1, 2, 3, 4, 5 };
+    EXPECT(ring.try_write(RecordType::Message, payload));
+    u32 size = 123456;
+    EXPECT(ring.try_write(RecordType::OutOfLineMessage, bytes_of(size)));
+
+    auto first = MUST(ring.try_read());
+    EXPECT(first.has_value());
+    EXPECT_EQ(first->type, RecordType::Message);
+    EXPECT_EQ(first->payload, payload.span());
+    ring.pop(*first);
+
+    auto second = MUST(ring.try_read());
+    EXPECT(second.has_value());
+    EXPECT_EQ(second->type, RecordType::OutOfLineMessage);
+    EXPECT_EQ(second->payload, bytes_of(size));
+    ring.pop(*second);
+
+    EXPECT(!MUST(ring.try_read()).has_value());
+}
+
+TEST_CASE(shared_through_fd)
+{
+    auto producer = MUST(IPC::MessageRing::try_create());
+    auto consumer = MUST(IPC::MessageRing::try_create_from_fd(dup(producer.fd())));
+
+    u32 value = 42;
+    EXPECT(producer.try_write(RecordType::Message, bytes_of(value)));
+    auto record = MUST(consumer.try_read());
+    EXPECT(record.has_value());
+    EXPECT_EQ(record->payload, bytes_of(value));
+    consumer.pop(*record);
+    EXPECT(!MUST(consumer.try_read()).has_value());
+}
+
+TEST_CASE(full_ring_and_wraparound)
+{
+    auto ring = MUST(IPC::MessageRing::try_create());
+    Vector<u8> payload;
+    payload.resize(1000);
+
+    // Go around the ring a few times, with records that don't line up with its end.
+    size_t written = 0;
+    size_t read = 0;
+    for (size_t round = 0; round < 10; ++round) {
+        for (;; ++written) {
+            payload[0] = static_cast<u8>(written);
+            if (!ring.try_write(RecordType::Message, payload))
+                break;
+        }
+        EXPECT(written - read > 0);
+        EXPECT((written - read) * payload.size() <= IPC::MessageRing::capacity);
+
+        // Only drain half, so the next round starts somewhere in the middle.
+        size_t to_read = (written - read + 1) / 2;
+        for (size_t i = 0; i < to_read; ++i, ++read) {
+            auto record = MUST(ring.try_read());
+            EXPECT(record.has_value());
+            EXPECT_EQ(record->payload.size(), payload.size());
+            EXPECT_EQ(record->payload[0], static_cast<u8>(read));
+            ring.pop(*record);
+        }
+    }
+
+    for (; read < written; ++read) {
+        auto record = MUST(ring.try_read());
+        EXPECT(record.has_value());
+        EXPECT_EQ(record->payload[0], static_cast<u8>(read));
+        ring.pop(*record);
+    }
+    EXPECT(!MUST(ring.try_read()).has_value());
+}
+
+TEST_CASE(wakeup_requests)
+{
+    auto ring = MUST(IPC::MessageRing::try_create());
+
+    // A new ring starts out with a request, as nobody has read from it yet.
+    EXPECT(ring.take_wakeup_request());
+    EXPECT(!ring.take_wakeup_request());
+
+    u32 value = 1;
+    EXPECT(ring.try_write(RecordType::Message, bytes_of(value)));
+    EXPECT(!ring.take_wakeup_request());
+
+    // Requesting a wakeup while there is something left to read tells us to read that first.
+    EXPECT(!ring.request_wakeup());
+    ring.pop(*MUST(ring.try_read()));
+    EXPECT(ring.request_wakeup());
+
+    // Any number of records only need a single wakeup.
+    EXPECT(ring.try_write(RecordType::Message, bytes_of(value)));
+    EXPECT(ring.take_wakeup_request());
+    EXPECT(ring.try_write(RecordType::Message, bytes_of(value)));
+    EXPECT(!ring.take_wakeup_request());
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Stream.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibTest/TestCase.h>
+#include <sys/socket.h>
+
+struct SocketPair {
+    NonnullOwnPtr<Core::Stream::LocalSocket> sender;
+    NonnullOwnPtr<Core::Stream::LocalSocket> receiver;
+};
+
+static SocketPair make_socket_pair()
+{
+    int fds[2];
+    VERIFY(socketpair(AF_LOCAL, SOCK_STREAM, 0, fds) == 0);
+    return { MUST(Core::Stream::LocalSocket::adopt_fd(fds[0])), MUST(Core::Stream::LocalSocket::adopt_fd(fds[1])) };
+}
+
+template<typename View>
+static IPC::ViewArgument<View> round_trip(View view, size_t& encoded_size)
+{
+    Core::EventLoop event_loop;
+    auto sockets = make_socket_pair();
+
+    IPC::MessageBuffer buffer;
+    IPC::Encoder encoder(buffer);
+    encoder << IPC::ViewArgument<View> { view };
+    encoded_size = buffer.data.size();
+    for (auto& fd : buffer.fds)
+        MUST(sockets.sender->send_fd(fd.value()));
+
+    InputMemoryStream stream { buffer.data.span() };
+    IPC::Decoder decoder { stream, *sockets.receiver };
+    IPC::ViewArgument<View> argument;
+    MUST(decoder.decode(argument));
+    return argument;
+}
+
+TEST_CASE(small_views_are_sent_inline)
+{
+    size_t encoded_size = 0;
+    auto text = "Well hello friends!"sv;
+    auto argument = round_trip(text, encoded_size);
+    EXPECT_EQ(argument.view(), text);
+    EXPECT_NE(argument.view().characters_without_null_termination(), text.characters_without_null_termination());
+    EXPECT(encoded_size > text.length());
+
+    // Copies point to the same received data, which stays valid after the original is gone.
+    auto copy = argument;
+    argument = {};
+    EXPECT_EQ(copy.view(), text);
+}
+
+TEST_CASE(large_views_are_spilled)
+{
+    auto data = MUST(ByteBuffer::create_uninitialized(IPC::ViewArgument<ReadonlyBytes>::spill_threshold));
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<u8>(i * 13);
+
+    size_t encoded_size = 0;
+    auto argument = round_trip(ReadonlyBytes { data }, encoded_size);
+    EXPECT_EQ(argument.view(), data.bytes());
+    EXPECT(encoded_size < 64);
+}
+
+TEST_CASE(empty_view)
+{
+    size_t encoded_size = 0;
+    auto argument = round_trip(ReadonlyBytes {}, encoded_size);
+    EXPECT(argument.view().is_empty());
+}
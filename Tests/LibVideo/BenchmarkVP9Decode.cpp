@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibCore/ElapsedTimer.h>
+#include <LibVideo/MatroskaDemuxer.h>
+#include <LibVideo/VP9/Decoder.h>
+
+// Decodes every frame of the file, including getting the decoded frames out of the decoder, like playback does.
+static void benchmark_decode_rate(StringView name, StringView path, int run_count)
+{
+    size_t frame_count = 0;
+    auto timer = Core::ElapsedTimer::start_new();
+    for (int run = 0; run < run_count; ++run) {
+        auto demuxer = MUST(Video::MatroskaDemuxer::from_file(path));
+        auto track = demuxer->get_tracks_for_type(Video::TrackType::Video)[0];
+        Video::VP9::Decoder vp9_decoder;
+
+        while (true) {
+            auto sample_result = demuxer->get_next_video_sample_for_track(track);
+            if (sample_result.is_error()) {
+                VERIFY(sample_result.error().category() == Video::DecoderErrorCategory::EndOfStream);
+                break;
+            }
+            MUST(vp9_decoder.receive_sample(sample_result.value()->data()));
+            (void)MUST(vp9_decoder.get_decoded_frame());
+            frame_count++;
+        }
+    }
+    auto elapsed_ms = max(timer.elapsed(), 1);
+    outln("{}: {:.1} frames/s", name, static_cast<double>(frame_count) * 1000 / elapsed_ms);
+}
+
+BENCHMARK_CASE(vp9_decode_rate)
+{
+    benchmark_decode_rate("vp9_decode_rate"sv, "./vp9_in_webm.webm"sv, 4);
+}
+
+BENCHMARK_CASE(vp9_4k_decode_rate)
+{
+    benchmark_decode_rate("vp9_4k_decode_rate"sv, "./vp9_4k.webm"sv, 1);
+}
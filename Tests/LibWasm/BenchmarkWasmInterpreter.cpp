@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/MemoryStream.h>
+#include <AK/NumericLimits.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/Types.h>
+#include <math.h>
+
+// (module
+//   (memory 1)
+//   (func $hash (export "hash") (param $length i32) (param $rounds i32) (result i32)
+//     (local $i i32) (local $x i32) (local $h i32) (local $acc i32) (local $r i32)
+//     ;; Fill memory[0..length) with xorshift32 output, then fold it $rounds times with FNV-1a.
+//     (local.set $x (i32.const 0x12345678))
+//     (block (loop
+//       (br_if 1 (i32.ge_u (local.get $i) (local.get $length)))
+//       (local.set $x (i32.xor (local.get $x) (i32.shl (local.get $x) (i32.const 13))))
+//       (local.set $x (i32.xor (local.get $x) (i32.shr_u (local.get $x) (i32.const 17))))
+//       (local.set $x (i32.xor (local.get $x) (i32.shl (local.get $x) (i32.const 5))))
+//       (i32.store8 (local.get $i) (local.get $x))
+//       (local.set $i (i32.add (local.get $i) (i32.const 1)))
+//       (br 0)))
+//     (block (loop
+//       (br_if 1 (i32.ge_u (local.get $r) (local.get $rounds)))
+//       (local.set $h (i32.const 2166136261))
+//       (local.set $i (i32.const 0))
+//       (block (loop
+//         (br_if 1 (i32.ge_u (local.get $i) (local.get $length)))
+//         (local.set $h (i32.mul (i32.xor (local.get $h) (i32.load8_u (local.get $i))) (i32.const 16777619)))
+//         (local.set $i (i32.add (local.get $i) (i32.const 1)))
+//         (br 0)))
+//       (local.set $acc (i32.add (i32.xor (local.get $acc) (local.get $h)) (local.get $r)))
+//       (local.set $r (i32.add (local.get $r) (i32.const 1)))
+//       (br 0)))
+//     (local.get $acc))
+//   (func $fib (export "fib") (param $n i32) (result i32)
+//     (if (result i32) (i32.lt_u (local.get $n) (i32.const 2))
+//       (then (local.get $n))
+//       (else (i32.add (call $fib (i32.sub (local.get $n) (i32.const 1)))
+//                      (call $fib (i32.sub (local.get $n) (i32.const 2))))))))
+static constexpr u8 test_module_bytes[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x02, 0x60,
+    0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x01, 0x7f, 0x01, 0x7f, 0x03, 0x03,
+    0x02, 0x00, 0x01, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x0e, 0x02, 0x04,
+    0x68, 0x61, 0x73, 0x68, 0x00, 0x00, 0x03, 0x66, 0x69, 0x62, 0x00, 0x01,
+    0x0a, 0xbb, 0x01, 0x02, 0x9b, 0x01, 0x01, 0x05, 0x7f, 0x41, 0xf8, 0xac,
+    0xd1, 0x91, 0x01, 0x21, 0x03, 0x02, 0x40, 0x03, 0x40, 0x20, 0x02, 0x20,
+    0x00, 0x4f, 0x0d, 0x01, 0x20, 0x03, 0x20, 0x03, 0x41, 0x0d, 0x74, 0x73,
+    0x21, 0x03, 0x20, 0x03, 0x20, 0x03, 0x41, 0x11, 0x76, 0x73, 0x21, 0x03,
+    0x20, 0x03, 0x20, 0x03, 0x41, 0x05, 0x74, 0x73, 0x21, 0x03, 0x20, 0x02,
+    0x20, 0x03, 0x3a, 0x00, 0x00, 0x20, 0x02, 0x41, 0x01, 0x6a, 0x21, 0x02,
+    0x0c, 0x00, 0x0b, 0x0b, 0x02, 0x40, 0x03, 0x40, 0x20, 0x06, 0x20, 0x01,
+    0x4f, 0x0d, 0x01, 0x41, 0xc5, 0xbb, 0xf2, 0x88, 0x78, 0x21, 0x04, 0x41,
+    0x00, 0x21, 0x02, 0x02, 0x40, 0x03, 0x40, 0x20, 0x02, 0x20, 0x00, 0x4f,
+    0x0d, 0x01, 0x20, 0x04, 0x20, 0x02, 0x2d, 0x00, 0x00, 0x73, 0x41, 0x93,
+    0x83, 0x80, 0x08, 0x6c, 0x21, 0x04, 0x20, 0x02, 0x41, 0x01, 0x6a, 0x21,
+    0x02, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x05, 0x20, 0x04, 0x73, 0x20, 0x06,
+    0x6a, 0x21, 0x05, 0x20, 0x06, 0x41, 0x01, 0x6a, 0x21, 0x06, 0x0c, 0x00,
+    0x0b, 0x0b, 0x20, 0x05, 0x0b, 0x1c, 0x00, 0x20, 0x00, 0x41, 0x02, 0x49,
+    0x04, 0x7f, 0x20, 0x00, 0x05, 0x20, 0x00, 0x41, 0x01, 0x6b, 0x10, 0x01,
+    0x20, 0x00, 0x41, 0x02, 0x6b, 0x10, 0x01, 0x6a, 0x0b, 0x0b,
+};
+
+// (module
+//   (type $binary (func (param i32 i32) (result i32)))
+//   (type $pair (func (param i32 i32) (result i32 i32)))
+//   (type $unary (func (param i32) (result i32)))
+//   (memory 1)
+//   (table 4 funcref)
+//   (elem (i32.const 0) $add $sub $negate)
+//   (func $add (type $binary) (i32.add (local.get 0) (local.get 1)))
+//   (func $sub (type $binary) (i32.sub (local.get 0) (local.get 1)))
+//   (func $negate (type $unary) (i32.sub (i32.const 0) (local.get 0)))
+//   (func (export "divide") (type $binary) (i32.div_s (local.get 0) (local.get 1)))
+//   (func (export "load") (type $unary) (i32.load offset=2 (local.get 0)))
+//   (func (export "unreachable_unless") (type $unary)
+//     (if (i32.eqz (local.get 0)) (then (unreachable)))
+//     (local.get 0))
+//   (func (export "br_table") (type $unary)
+//     (block (block (block (block (br_table 0 1 2 3 (local.get 0)))
+//       (return (i32.const 10)))
+//       (return (i32.const 11)))
+//       (return (i32.const 12)))
+//     (i32.const 13))
+//   (func (export "br_table_with_value") (type $unary)
+//     (block (result i32)
+//       (block (result i32) (br_table 0 1 (i32.const 7) (local.get 0)))
+//       (i32.add (i32.const 100))))
+//   (func $swap (export "swap") (type $pair) (local.get 1) (local.get 0))
+//   (func (export "multi_value_block") (type $binary)
+//     (call $swap (local.get 0) (local.get 1))
+//     (block (type $pair) (br_if 0 (local.get 0)) (i32.add (i32.const 1)))
+//     (i32.sub))
+//   (func (export "multi_value_loop") (type $unary) (local $acc i32) (local $n i32)
+//     ;; Sums up 1 to n, passing the sum and the counter as loop parameters.
+//     (i32.const 0) (local.get 0)
+//     (loop (type $pair)
+//       (local.set $n) (local.set $acc)
+//       (i32.add (local.get $acc) (local.get $n))
+//       (i32.sub (local.get $n) (i32.const 1))
+//       (br_if 0 (i32.gt_s (local.get $n) (i32.const 1))))
+//     (drop))
+//   (func (export "call_indirect") (param i32 i32 i32) (result i32)
+//     (call_indirect (type $binary) (local.get 1) (local.get 2) (local.get 0))))
+static constexpr u8 control_flow_module_bytes[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x1a, 0x04, 0x60,
+    0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x02, 0x7f, 0x7f, 0x02, 0x7f, 0x7f,
+    0x60, 0x01, 0x7f, 0x01, 0x7f, 0x60, 0x03, 0x7f, 0x7f, 0x7f, 0x01, 0x7f,
+    0x03, 0x0d, 0x0c, 0x00, 0x00, 0x02, 0x00, 0x02, 0x02, 0x02, 0x02, 0x01,
+    0x00, 0x02, 0x03, 0x04, 0x04, 0x01, 0x70, 0x00, 0x04, 0x05, 0x03, 0x01,
+    0x00, 0x01, 0x07, 0x85, 0x01, 0x09, 0x06, 0x64, 0x69, 0x76, 0x69, 0x64,
+    0x65, 0x00, 0x03, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x04, 0x12, 0x75,
+    0x6e, 0x72, 0x65, 0x61, 0x63, 0x68, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x75,
+    0x6e, 0x6c, 0x65, 0x73, 0x73, 0x00, 0x05, 0x08, 0x62, 0x72, 0x5f, 0x74,
+    0x61, 0x62, 0x6c, 0x65, 0x00, 0x06, 0x13, 0x62, 0x72, 0x5f, 0x74, 0x61,
+    0x62, 0x6c, 0x65, 0x5f, 0x77, 0x69, 0x74, 0x68, 0x5f, 0x76, 0x61, 0x6c,
+    0x75, 0x65, 0x00, 0x07, 0x04, 0x73, 0x77, 0x61, 0x70, 0x00, 0x08, 0x11,
+    0x6d, 0x75, 0x6c, 0x74, 0x69, 0x5f, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x5f,
+    0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x00, 0x09, 0x10, 0x6d, 0x75, 0x6c, 0x74,
+    0x69, 0x5f, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x5f, 0x6c, 0x6f, 0x6f, 0x70,
+    0x00, 0x0a, 0x0d, 0x63, 0x61, 0x6c, 0x6c, 0x5f, 0x69, 0x6e, 0x64, 0x69,
+    0x72, 0x65, 0x63, 0x74, 0x00, 0x0b, 0x09, 0x09, 0x01, 0x00, 0x41, 0x00,
+    0x0b, 0x03, 0x00, 0x01, 0x02, 0x0a, 0xb5, 0x01, 0x0c, 0x07, 0x00, 0x20,
+    0x00, 0x20, 0x01, 0x6a, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x6b,
+    0x0b, 0x07, 0x00, 0x41, 0x00, 0x20, 0x00, 0x6b, 0x0b, 0x07, 0x00, 0x20,
+    0x00, 0x20, 0x01, 0x6d, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x02,
+    0x0b, 0x0b, 0x00, 0x20, 0x00, 0x45, 0x04, 0x40, 0x00, 0x0b, 0x20, 0x00,
+    0x0b, 0x21, 0x00, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20,
+    0x00, 0x0e, 0x03, 0x00, 0x01, 0x02, 0x03, 0x0b, 0x41, 0x0a, 0x0f, 0x0b,
+    0x41, 0x0b, 0x0f, 0x0b, 0x41, 0x0c, 0x0f, 0x0b, 0x41, 0x0d, 0x0b, 0x14,
+    0x00, 0x02, 0x7f, 0x02, 0x7f, 0x41, 0x07, 0x20, 0x00, 0x0e, 0x01, 0x00,
+    0x01, 0x0b, 0x41, 0xe4, 0x00, 0x6a, 0x0b, 0x0b, 0x06, 0x00, 0x20, 0x01,
+    0x20, 0x00, 0x0b, 0x13, 0x00, 0x20, 0x00, 0x20, 0x01, 0x10, 0x08, 0x02,
+    0x01, 0x20, 0x00, 0x0d, 0x00, 0x41, 0x01, 0x6a, 0x0b, 0x6b, 0x0b, 0x21,
+    0x01, 0x02, 0x7f, 0x41, 0x00, 0x20, 0x00, 0x03, 0x01, 0x21, 0x02, 0x21,
+    0x01, 0x20, 0x01, 0x20, 0x02, 0x6a, 0x20, 0x02, 0x41, 0x01, 0x6b, 0x20,
+    0x02, 0x41, 0x01, 0x4a, 0x0d, 0x00, 0x0b, 0x1a, 0x0b, 0x0b, 0x00, 0x20,
+    0x01, 0x20, 0x02, 0x20, 0x00, 0x11, 0x00, 0x00, 0x0b,
+};
+
+// A module with an exported function for each of these instructions, named after it, that applies it to its parameters.
+static constexpr u8 float_module_bytes[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x2b, 0x08, 0x60,
+    0x02, 0x7c, 0x7c, 0x01, 0x7c, 0x60, 0x01, 0x7c, 0x01, 0x7c, 0x60, 0x02,
+    0x7d, 0x7d, 0x01, 0x7d, 0x60, 0x01, 0x7d, 0x01, 0x7d, 0x60, 0x01, 0x7c,
+    0x01, 0x7f, 0x60, 0x01, 0x7c, 0x01, 0x7d, 0x60, 0x01, 0x7e, 0x01, 0x7d,
+    0x60, 0x01, 0x7d, 0x01, 0x7e, 0x03, 0x1d, 0x1c, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02,
+    0x02, 0x02, 0x03, 0x03, 0x04, 0x04, 0x04, 0x04, 0x05, 0x06, 0x06, 0x07,
+    0x07, 0xfc, 0x02, 0x1c, 0x07, 0x66, 0x36, 0x34, 0x2e, 0x61, 0x64, 0x64,
+    0x00, 0x00, 0x07, 0x66, 0x36, 0x34, 0x2e, 0x73, 0x75, 0x62, 0x00, 0x01,
+    0x07, 0x66, 0x36, 0x34, 0x2e, 0x6d, 0x75, 0x6c, 0x00, 0x02, 0x07, 0x66,
+    0x36, 0x34, 0x2e, 0x64, 0x69, 0x76, 0x00, 0x03, 0x07, 0x66, 0x36, 0x34,
+    0x2e, 0x6d, 0x69, 0x6e, 0x00, 0x04, 0x07, 0x66, 0x36, 0x34, 0x2e, 0x6d,
+    0x61, 0x78, 0x00, 0x05, 0x0c, 0x66, 0x36, 0x34, 0x2e, 0x63, 0x6f, 0x70,
+    0x79, 0x73, 0x69, 0x67, 0x6e, 0x00, 0x06, 0x07, 0x66, 0x36, 0x34, 0x2e,
+    0x61, 0x62, 0x73, 0x00, 0x07, 0x07, 0x66, 0x36, 0x34, 0x2e, 0x6e, 0x65,
+    0x67, 0x00, 0x08, 0x08, 0x66, 0x36, 0x34, 0x2e, 0x63, 0x65, 0x69, 0x6c,
+    0x00, 0x09, 0x09, 0x66, 0x36, 0x34, 0x2e, 0x66, 0x6c, 0x6f, 0x6f, 0x72,
+    0x00, 0x0a, 0x09, 0x66, 0x36, 0x34, 0x2e, 0x74, 0x72, 0x75, 0x6e, 0x63,
+    0x00, 0x0b, 0x0b, 0x66, 0x36, 0x34, 0x2e, 0x6e, 0x65, 0x61, 0x72, 0x65,
+    0x73, 0x74, 0x00, 0x0c, 0x08, 0x66, 0x36, 0x34, 0x2e, 0x73, 0x71, 0x72,
+    0x74, 0x00, 0x0d, 0x07, 0x66, 0x33, 0x32, 0x2e, 0x61, 0x64, 0x64, 0x00,
+    0x0e, 0x07, 0x66, 0x33, 0x32, 0x2e, 0x64, 0x69, 0x76, 0x00, 0x0f, 0x07,
+    0x66, 0x33, 0x32, 0x2e, 0x6d, 0x69, 0x6e, 0x00, 0x10, 0x07, 0x66, 0x33,
+    0x32, 0x2e, 0x6d, 0x61, 0x78, 0x00, 0x11, 0x0b, 0x66, 0x33, 0x32, 0x2e,
+    0x6e, 0x65, 0x61, 0x72, 0x65, 0x73, 0x74, 0x00, 0x12, 0x08, 0x66, 0x33,
+    0x32, 0x2e, 0x73, 0x71, 0x72, 0x74, 0x00, 0x13, 0x0f, 0x69, 0x33, 0x32,
+    0x2e, 0x74, 0x72, 0x75, 0x6e, 0x63, 0x5f, 0x66, 0x36, 0x34, 0x5f, 0x73,
+    0x00, 0x14, 0x0f, 0x69, 0x33, 0x32, 0x2e, 0x74, 0x72, 0x75, 0x6e, 0x63,
+    0x5f, 0x66, 0x36, 0x34, 0x5f, 0x75, 0x00, 0x15, 0x13, 0x69, 0x33, 0x32,
+    0x2e, 0x74, 0x72, 0x75, 0x6e, 0x63, 0x5f, 0x73, 0x61, 0x74, 0x5f, 0x66,
+    0x36, 0x34, 0x5f, 0x73, 0x00, 0x16, 0x13, 0x69, 0x33, 0x32, 0x2e, 0x74,
+    0x72, 0x75, 0x6e, 0x63, 0x5f, 0x73, 0x61, 0x74, 0x5f, 0x66, 0x36, 0x34,
+    0x5f, 0x75, 0x00, 0x17, 0x0e, 0x66, 0x33, 0x32, 0x2e, 0x64, 0x65, 0x6d,
+    0x6f, 0x74, 0x65, 0x5f, 0x66, 0x36, 0x34, 0x00, 0x18, 0x11, 0x66, 0x33,
+    0x32, 0x2e, 0x63, 0x6f, 0x6e, 0x76, 0x65, 0x72, 0x74, 0x5f, 0x69, 0x36,
+    0x34, 0x5f, 0x73, 0x00, 0x19, 0x11, 0x66, 0x33, 0x32, 0x2e, 0x63, 0x6f,
+    0x6e, 0x76, 0x65, 0x72, 0x74, 0x5f, 0x69, 0x36, 0x34, 0x5f, 0x75, 0x00,
+    0x1a, 0x13, 0x69, 0x36, 0x34, 0x2e, 0x74, 0x72, 0x75, 0x6e, 0x63, 0x5f,
+    0x73, 0x61, 0x74, 0x5f, 0x66, 0x33, 0x32, 0x5f, 0x73, 0x00, 0x1b, 0x0a,
+    0xc2, 0x01, 0x1c, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0xa0, 0x0b, 0x07,
+    0x00, 0x20, 0x00, 0x20, 0x01, 0xa1, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20,
+    0x01, 0xa2, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0xa3, 0x0b, 0x07,
+    0x00, 0x20, 0x00, 0x20, 0x01, 0xa4, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20,
+    0x01, 0xa5, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0xa6, 0x0b, 0x05,
+    0x00, 0x20, 0x00, 0x99, 0x0b, 0x05, 0x00, 0x20, 0x00, 0x9a, 0x0b, 0x05,
+    0x00, 0x20, 0x00, 0x9b, 0x0b, 0x05, 0x00, 0x20, 0x00, 0x9c, 0x0b, 0x05,
+    0x00, 0x20, 0x00, 0x9d, 0x0b, 0x05, 0x00, 0x20, 0x00, 0x9e, 0x0b, 0x05,
+    0x00, 0x20, 0x00, 0x9f, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x92,
+    0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x95, 0x0b, 0x07, 0x00, 0x20,
+    0x00, 0x20, 0x01, 0x96, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x97,
+    0x0b, 0x05, 0x00, 0x20, 0x00, 0x90, 0x0b, 0x05, 0x00, 0x20, 0x00, 0x91,
+    0x0b, 0x05, 0x00, 0x20, 0x00, 0xaa, 0x0b, 0x05, 0x00, 0x20, 0x00, 0xab,
+    0x0b, 0x06, 0x00, 0x20, 0x00, 0xfc, 0x02, 0x0b, 0x06, 0x00, 0x20, 0x00,
+    0xfc, 0x03, 0x0b, 0x05, 0x00, 0x20, 0x00, 0xb6, 0x0b, 0x05, 0x00, 0x20,
+    0x00, 0xb4, 0x0b, 0x05, 0x00, 0x20, 0x00, 0xb5, 0x0b, 0x06, 0x00, 0x20,
+    0x00, 0xfc, 0x04, 0x0b,
+};
+
+class TestModule {
+public:
+    explicit TestModule(ReadonlyBytes bytes = { test_module_bytes, sizeof(test_module_bytes) })
+    {
+        InputMemoryStream stream { bytes };
+        auto module = Wasm::Module::parse(stream);
+        VERIFY(!module.is_error());
+        m_module = make<Wasm::Module>(module.release_value());
+
+        auto instance = m_machine.instantiate(*m_module, {});
+        VERIFY(!instance.is_error());
+        m_instance = instance.release_value();
+    }
+
+    Wasm::FunctionAddress function(StringView name) const
+    {
+        for (auto& entry : m_instance->exports()) {
+            if (entry.name() == name)
+                return entry.value().get<Wasm::FunctionAddress>();
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+    Wasm::Result invoke(StringView name, Vector<Wasm::Value> arguments)
+    {
+        return m_machine.invoke(function(name), move(arguments));
+    }
+
+    Wasm::Result invoke_without_lowering(StringView name, Vector<Wasm::Value> arguments)
+    {
+        Wasm::DebuggerBytecodeInterpreter interpreter;
+        return m_machine.invoke(interpreter, function(name), move(arguments));
+    }
+
+private:
+    OwnPtr<Wasm::Module> m_module;
+    Wasm::AbstractMachine m_machine;
+    OwnPtr<Wasm::ModuleInstance> m_instance;
+};
+
+static i32 result_as_i32(Wasm::Result const& result)
+{
+    VERIFY(!result.is_trap());
+    VERIFY(result.values().size() == 1);
+    auto value = result.values().first();
+    return value.to<i32>().value();
+}
+
+static bool is_nan(Wasm::Value const& value)
+{
+    return value.value().visit(
+        [](float value) { return isnan(value); },
+        [](double value) { return isnan(value); },
+        [](auto const&) { return false; });
+}
+
+static u64 bits_of(Wasm::Value const& value)
+{
+    return value.value().visit(
+        [](i32 value) -> u64 { return static_cast<u32>(value); },
+        [](i64 value) -> u64 { return value; },
+        [](float value) -> u64 { return bit_cast<u32>(value); },
+        [](double value) -> u64 { return bit_cast<u64>(value); },
+        [](Wasm::Reference const&) -> u64 { VERIFY_NOT_REACHED(); });
+}
+
+// Returns the result of the lowered code, after checking that the stack interpreter agrees with it bit for bit.
+// The only exception are NaNs, as their sign and payload are nondeterministic.
+static Wasm::Result invoke_and_compare(TestModule& module, StringView name, Vector<Wasm::Value> const& arguments)
+{
+    auto result = module.invoke(name, arguments);
+    auto expected = module.invoke_without_lowering(name, arguments);
+    EXPECT_EQ(result.is_trap(), expected.is_trap());
+    if (result.is_trap() || expected.is_trap())
+        return result;
+
+    EXPECT_EQ(result.values().size(), expected.values().size());
+    for (size_t i = 0; i < min(result.values().size(), expected.values().size()); ++i) {
+        EXPECT_EQ(result.values()[i].type().kind(), expected.values()[i].type().kind());
+        if (is_nan(result.values()[i]) && is_nan(expected.values()[i]))
+            continue;
+        EXPECT_EQ(bits_of(result.values()[i]), bits_of(expected.values()[i]));
+    }
+    return result;
+}
+
+TEST_CASE(lowered_code_matches_stack_interpreter)
+{
+    TestModule module;
+    for (i32 n = 0; n < 16; ++n) {
+        Vector<Wasm::Value> arguments { Wasm::Value(n) };
+        EXPECT_EQ(result_as_i32(module.invoke("fib"sv, arguments)), result_as_i32(module.invoke_without_lowering("fib"sv, arguments)));
+    }
+
+    Vector<Wasm::Value> arguments { Wasm::Value(1000), Wasm::Value(3) };
+    EXPECT_EQ(result_as_i32(module.invoke("hash"sv, arguments)), result_as_i32(module.invoke_without_lowering("hash"sv, arguments)));
+}
+
+TEST_CASE(lowered_code_traps_like_stack_interpreter)
+{
+    TestModule module { { control_flow_module_bytes, sizeof(control_flow_module_bytes) } };
+
+    EXPECT_EQ(result_as_i32(invoke_and_compare(module, "divide"sv, { Wasm::Value(-7), Wasm::Value(2) })), -3);
+    EXPECT(invoke_and_compare(module, "divide"sv, { Wasm::Value(1), Wasm::Value(0) }).is_trap());
+    EXPECT(invoke_and_compare(module, "divide"sv, { Wasm::Value(NumericLimits<i32>::min()), Wasm::Value(-1) }).is_trap());
+
+    EXPECT_EQ(result_as_i32(invoke_and_compare(module, "load"sv, { Wasm::Value(65530) })), 0);
+    EXPECT(invoke_and_compare(module, "load"sv, { Wasm::Value(65531) }).is_trap());
+    EXPECT(invoke_and_compare(module, "load"sv, { Wasm::Value(-1) }).is_trap());
+
+    EXPECT_EQ(result_as_i32(invoke_and_compare(module, "unreachable_unless"sv, { Wasm::Value(5) })), 5);
+    EXPECT(invoke_and_compare(module, "unreachable_unless"sv, { Wasm::Value(0) }).is_trap());
+}
+
+TEST_CASE(lowered_br_table_matches_stack_interpreter)
+{
+    TestModule module { { control_flow_module_bytes, sizeof(control_flow_module_bytes) } };
+
+    for (i32 index : { 0, 1, 2, 3, 4, 1000, -1 }) {
+        EXPECT_EQ(result_as_i32(invoke_and_compare(module, "br_table"sv, { Wasm::Value(index) })), static_cast<i32>(10 + min(static_cast<u32>(index), 3u)));
+        EXPECT_EQ(result_as_i32(invoke_and_compare(module, "br_table_with_value"sv, { Wasm::Value(index) })), index == 0 ? 107 : 7);
+    }
+}
+
+TEST_CASE(lowered_multi_value_code_matches_stack_interpreter)
+{
+    TestModule module { { control_flow_module_bytes, sizeof(control_flow_module_bytes) } };
+
+    // Results come back with the last one first.
+    auto result = invoke_and_compare(module, "swap"sv, { Wasm::Value(1), Wasm::Value(2) });
+    EXPECT_EQ(result.values().size(), 2u);
+    EXPECT_EQ(bits_of(result.values()[0]), 1u);
+    EXPECT_EQ(bits_of(result.values()[1]), 2u);
+
+    EXPECT_EQ(result_as_i32(invoke_and_compare(module, "multi_value_block"sv, { Wasm::Value(3), Wasm::Value(10) })), 7);
+    EXPECT_EQ(result_as_i32(invoke_and_compare(module, "multi_value_block"sv, { Wasm::Value(0), Wasm::Value(10) })), 9);
+    for (i32 n : { 1, 2, 5, 100 })
+        EXPECT_EQ(result_as_i32(invoke_and_compare(module, "multi_value_loop"sv, { Wasm::Value(n) })), n * (n + 1) / 2);
+}
+
+TEST_CASE(lowered_call_indirect_matches_stack_interpreter)
+{
+    TestModule module { { control_flow_module_bytes, sizeof(control_flow_module_bytes) } };
+
+    EXPECT_EQ(result_as_i32(invoke_and_compare(module, "call_indirect"sv, { Wasm::Value(0), Wasm::Value(7), Wasm::Value(3) })), 10);
+    EXPECT_EQ(result_as_i32(invoke_and_compare(module, "call_indirect"sv, { Wasm::Value(1), Wasm::Value(7), Wasm::Value(3) })), 4);
+    // A callee of the wrong type, a null entry, and indices past the end of the table.
+    for (i32 index : { 2, 3, 4, -1 })
+        EXPECT(invoke_and_compare(module, "call_indirect"sv, { Wasm::Value(index), Wasm::Value(7), Wasm::Value(3) }).is_trap());
+}
+
+TEST_CASE(lowered_float_code_matches_stack_interpreter)
+{
+    TestModule module { { float_module_bytes, sizeof(float_module_bytes) } };
+
+    double nan = NAN;
+    double infinity = INFINITY;
+    // Ties, negative zero, NaNs, infinities, and values that don't fit into the narrower types.
+    Array<double, 17> values { 0.0, -0.0, 0.5, -0.5, 1.5, 2.5, -2.5, 0.1, 3e9, -3e9, 1e300, infinity, -infinity, nan, -nan, 16777217.0, 4294967295.5 };
+
+    for (auto name : { "f64.add"sv, "f64.sub"sv, "f64.mul"sv, "f64.div"sv, "f64.min"sv, "f64.max"sv, "f64.copysign"sv }) {
+        for (auto lhs : values) {
+            for (auto rhs : values)
+                (void)invoke_and_compare(module, name, { Wasm::Value(lhs), Wasm::Value(rhs) });
+        }
+    }
+    for (auto name : { "f32.add"sv, "f32.div"sv, "f32.min"sv, "f32.max"sv }) {
+        for (auto lhs : values) {
+            for (auto rhs : values)
+                (void)invoke_and_compare(module, name, { Wasm::Value(static_cast<float>(lhs)), Wasm::Value(static_cast<float>(rhs)) });
+        }
+    }
+    for (auto value : values) {
+        for (auto name : { "f64.abs"sv, "f64.neg"sv, "f64.ceil"sv, "f64.floor"sv, "f64.trunc"sv, "f64.nearest"sv, "f64.sqrt"sv, "i32.trunc_f64_s"sv, "i32.trunc_f64_u"sv, "i32.trunc_sat_f64_s"sv, "i32.trunc_sat_f64_u"sv, "f32.demote_f64"sv })
+            (void)invoke_and_compare(module, name, { Wasm::Value(value) });
+        for (auto name : { "f32.nearest"sv, "f32.sqrt"sv, "i64.trunc_sat_f32_s"sv })
+            (void)invoke_and_compare(module, name, { Wasm::Value(static_cast<float>(value)) });
+    }
+    Array<i64, 7> integers { 0, 1, -1, 16777217, (1ll << 53) + 1, NumericLimits<i64>::max(), NumericLimits<i64>::min() };
+    for (auto value : integers) {
+        for (auto name : { "f32.convert_i64_s"sv, "f32.convert_i64_u"sv })
+            (void)invoke_and_compare(module, name, { Wasm::Value(value) });
+    }
+
+    EXPECT_EQ(bits_of(invoke_and_compare(module, "f64.nearest"sv, { Wasm::Value(2.5) }).values().first()), bit_cast<u64>(2.0));
+    EXPECT_EQ(bits_of(invoke_and_compare(module, "f64.nearest"sv, { Wasm::Value(-0.5) }).values().first()), bit_cast<u64>(-0.0));
+    auto maximum_with_nan = invoke_and_compare(module, "f64.max"sv, { Wasm::Value(nan), Wasm::Value(1.0) });
+    EXPECT(isnan(maximum_with_nan.values().first().to<double>().value()));
+    EXPECT(invoke_and_compare(module, "i32.trunc_f64_s"sv, { Wasm::Value(nan) }).is_trap());
+    EXPECT_EQ(result_as_i32(invoke_and_compare(module, "i32.trunc_sat_f64_s"sv, { Wasm::Value(3e9) })), NumericLimits<i32>::max());
+}
+
+BENCHMARK_CASE(hash_kernel)
+{
+    TestModule module;
+    auto result = module.invoke("hash"sv, { Wasm::Value(65536), Wasm::Value(64) });
+    EXPECT_EQ(result_as_i32(result), 2720);
+}
+
+BENCHMARK_CASE(recursive_fib)
+{
+    TestModule module;
+    auto result = module.invoke("fib"sv, { Wasm::Value(27) });
+    EXPECT_EQ(result_as_i32(result), 196418);
+}
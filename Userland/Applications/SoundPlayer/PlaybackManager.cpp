@@ -28,7 +28,8 @@ void PlaybackManager::set_loader(NonnullRefPtr<Audio::Loader>&& loader)
         m_total_length = m_loader->total_samples() / static_cast<float>(m_loader->sample_rate());
         m_device_samples_per_buffer = PlaybackManager::buffer_size_ms / 1000.0f * m_device_sample_rate;
         m_samples_to_load_per_buffer = PlaybackManager::buffer_size_ms / 1000.0f * m_loader->sample_rate();
-        m_resampler = Audio::ResampleHelper<Audio::Sample>(m_loader->sample_rate(), m_device_sample_rate);
+        // FIXME: Handle OOM better.
+        m_resampler = MUST(Audio::PolyphaseResampler::try_create(m_loader->sample_rate(), m_device_sample_rate));
         m_timer->start();
     } else {
         m_timer->stop();
@@ -43,6 +44,8 @@ void PlaybackManager::stop()
 
     if (m_loader)
         (void)m_loader->reset();
+    if (m_resampler.has_value())
+        m_resampler->reset();
 }
 
 void PlaybackManager::play()
@@ -65,6 +68,7 @@ void PlaybackManager::seek(int const position)
     set_paused(true);
 
     [[maybe_unused]] auto result = m_loader->seek(position);
+    m_resampler->reset();
 
     m_connection->clear_client_buffer();
     m_connection->async_clear_buffer();
@@ -119,9 +123,10 @@ void PlaybackManager::next_buffer()
         if (!maybe_buffer.is_error()) {
             m_current_buffer.swap(maybe_buffer.value());
             VERIFY(m_resampler.has_value());
-            m_resampler->reset();
+            // Once the loader is out of samples, get the ones still held back by the resampler.
             // FIXME: Handle OOM better.
-            auto resampled = MUST(FixedArray<Audio::Sample>::try_create(m_resampler->resample(move(m_current_buffer)).span()));
+            auto resampled_samples = m_current_buffer.is_empty() ? MUST(m_resampler->flush()) : MUST(m_resampler->resample(m_current_buffer.span()));
+            auto resampled = MUST(FixedArray<Audio::Sample>::try_create(resampled_samples.span()));
             m_current_buffer.swap(resampled);
             MUST(m_connection->async_enqueue(m_current_buffer));
         }
@@ -14,7 +14,7 @@
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio recvfd sendfd rpath unix prot_exec"));
+    TRY(Core::System::pledge("stdio thread recvfd sendfd rpath unix prot_exec"));
 
     unsigned refresh_rate = 12;
 
@@ -25,7 +25,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     auto app = TRY(GUI::Application::try_create(arguments));
 
-    TRY(Core::System::pledge("stdio recvfd sendfd rpath prot_exec"));
+    TRY(Core::System::pledge("stdio thread recvfd sendfd rpath prot_exec"));
 
     auto app_icon = GUI::Icon::default_icon("app-tubes"sv);
     auto window = TRY(GUI::Window::try_create());
@@ -37,6 +37,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     auto widget = TRY(window->try_set_main_widget<ChessWidget>());
 
     TRY(Core::System::unveil("/sys/kernel/processes", "r"));
+    TRY(Core::System::unveil("/sys/kernel/processes_binary", "r"));
     TRY(Core::System::unveil("/res", "r"));
     TRY(Core::System::unveil("/bin/ChessEngine", "x"));
     TRY(Core::System::unveil("/tmp/session/%sid/portal/launch", "rw"));
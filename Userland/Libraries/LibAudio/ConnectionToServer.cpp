@@ -32,6 +32,8 @@ ConnectionToServer::ConnectionToServer(NonnullOwnPtr<Core::Stream::LocalSocket>
         return (intptr_t) nullptr;
     }))
 {
+    if (auto result = enable_shared_memory_transport(); result.is_error())
+        dbgln("Audio::ConnectionToServer: Couldn't enable shared memory transport: {}", result.error());
     async_pause_playback();
     set_buffer(*m_buffer);
 }
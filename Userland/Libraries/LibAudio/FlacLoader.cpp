@@ -19,7 +19,6 @@
 #include <LibAudio/FlacLoader.h>
 #include <LibAudio/FlacTypes.h>
 #include <LibAudio/LoaderError.h>
-#include <LibAudio/Resampler.h>
 #include <LibCore/MemoryStream.h>
 #include <LibCore/Stream.h>
 
@@ -202,6 +201,7 @@ MaybeLoaderError FlacLoaderPlugin::seek(int int_sample_index)
     if (!maybe_target_seekpoint.has_value()) {
         if (sample_index < m_loaded_samples) {
             LOADER_TRY(m_stream->seek(m_data_start_location, Core::Stream::SeekMode::SetPosition));
+            discard_buffered_data();
             m_loaded_samples = 0;
         }
         auto to_read = sample_index - m_loaded_samples;
@@ -223,6 +223,7 @@ MaybeLoaderError FlacLoaderPlugin::seek(int int_sample_index)
         auto position = target_seekpoint.byte_offset + m_data_start_location;
         if (m_stream->seek(static_cast<i64>(position), Core::Stream::SeekMode::SetPosition).is_error())
             return LoaderError { LoaderError::Category::IO, m_loaded_samples, String::formatted("Invalid seek position {}", position) };
+        discard_buffered_data();
 
         auto remaining_samples_after_seekpoint = sample_index - m_data_start_location;
         if (remaining_samples_after_seekpoint > 0)
@@ -260,13 +261,126 @@ LoaderSamples FlacLoaderPlugin::get_more_samples(size_t max_bytes_to_read_from_i
         sample_index += m_current_frame->sample_count;
     }
 
-    m_loaded_samples += sample_index;
+    // The last frame may have gone past the requested samples, but its remaining samples are still unread.
+    m_loaded_samples += samples_to_read;
 
     return samples;
 }
 
+void FlacLoaderPlugin::discard_buffered_data()
+{
+    m_input_buffer.clear();
+    m_input_buffer_offset = 0;
+    m_unread_data.clear_with_capacity();
+}
+
+MaybeLoaderError FlacLoaderPlugin::refill_input_buffer()
+{
+    // Move the unread data to the front, and make room for at least as much again if no frame fit into the buffer.
+    auto unread_size = m_input_buffer.size() - m_input_buffer_offset;
+    if (m_input_buffer_offset > 0) {
+        __builtin_memmove(m_input_buffer.data(), m_input_buffer.data() + m_input_buffer_offset, unread_size);
+        m_input_buffer_offset = 0;
+    }
+    auto buffer_size = max(FLAC_INPUT_BUFFER_SIZE, max<size_t>(unread_size, m_max_frame_size) * 2);
+    LOADER_TRY(m_input_buffer.try_resize(buffer_size));
+
+    auto free_space = m_input_buffer.bytes().slice(unread_size);
+    while (!free_space.is_empty() && !m_stream->is_eof()) {
+        auto read_bytes = LOADER_TRY(m_stream->read(free_space));
+        if (read_bytes.is_empty())
+            break;
+        free_space = free_space.slice(read_bytes.size());
+    }
+    LOADER_TRY(m_input_buffer.try_resize(buffer_size - free_space.size()));
+    return {};
+}
+
 // 11.21. FRAME
 MaybeLoaderError FlacLoaderPlugin::next_frame(Span<Sample> target_vector)
+{
+    // If the stream info knows how large frames get, read ahead far enough that the frame can't be cut off.
+    if (m_input_buffer.size() - m_input_buffer_offset < m_max_frame_size && !m_stream->is_eof())
+        TRY(refill_input_buffer());
+
+    // Frames don't store their size, so just try to decode the frame, and read more of the stream if it was cut off.
+    for (;;) {
+        FlacBitReader bit_input { m_input_buffer.bytes().slice(m_input_buffer_offset) };
+        auto result = decode_frame(bit_input);
+        if (!result.is_error()) {
+            m_input_buffer_offset += bit_input.consumed_bytes();
+            break;
+        }
+        if (!bit_input.ran_out_of_data() || m_stream->is_eof())
+            return result.release_error();
+        TRY(refill_input_buffer());
+    }
+
+    auto& left = m_subframe_samples[0];
+    auto& right = m_subframe_samples[frame_channel_type_to_channel_count(m_current_frame->channels) == 1 ? 0 : 1];
+
+    switch (m_current_frame->channels) {
+    case FlacFrameChannelType::Mono:
+    case FlacFrameChannelType::Stereo:
+    // TODO mix together surround channels on each side?
+    case FlacFrameChannelType::StereoCenter:
+    case FlacFrameChannelType::Surround4p0:
+    case FlacFrameChannelType::Surround5p0:
+    case FlacFrameChannelType::Surround5p1:
+    case FlacFrameChannelType::Surround6p1:
+    case FlacFrameChannelType::Surround7p1:
+        break;
+    case FlacFrameChannelType::LeftSideStereo:
+        // channels are left (0) and side (1)
+        for (size_t i = 0; i < left.size(); ++i) {
+            // right = left - side
+            right[i] = left[i] - right[i];
+        }
+        break;
+    case FlacFrameChannelType::RightSideStereo:
+        // channels are side (0) and right (1)
+        for (size_t i = 0; i < right.size(); ++i) {
+            // left = right + side
+            left[i] = right[i] + left[i];
+        }
+        break;
+    case FlacFrameChannelType::MidSideStereo:
+        // channels are mid (0) and side (1)
+        for (size_t i = 0; i < left.size(); ++i) {
+            // The mid channel was rounded down, but the lost bit is the same as the lowest bit of the side channel.
+            i64 mid = (static_cast<i64>(left[i]) * 2) | (right[i] & 1);
+            i64 side = right[i];
+            left[i] = static_cast<i32>((mid + side) >> 1);
+            right[i] = static_cast<i32>((mid - side) >> 1);
+        }
+        break;
+    }
+
+    VERIFY(left.size() == right.size() && left.size() == m_current_frame->sample_count);
+
+    float sample_rescale = 1.0f / static_cast<float>(1 << (pcm_bits_per_sample(m_current_frame->bit_depth) - 1));
+    dbgln_if(AFLACLOADER_DEBUG, "Sample rescaled from {} bits: factor {:.1f}", pcm_bits_per_sample(m_current_frame->bit_depth), 1.0f / sample_rescale);
+
+    // zip together channels
+    auto samples_to_directly_copy = min(target_vector.size(), m_current_frame->sample_count);
+    for (size_t i = 0; i < samples_to_directly_copy; ++i) {
+        Sample frame = { left[i] * sample_rescale, right[i] * sample_rescale };
+        target_vector[i] = frame;
+    }
+    // move superfluous data into the class buffer instead
+    auto result = m_unread_data.try_grow_capacity(m_current_frame->sample_count - samples_to_directly_copy);
+    if (result.is_error())
+        return LoaderError { LoaderError::Category::Internal, static_cast<size_t>(samples_to_directly_copy + m_current_sample_or_frame), "Couldn't allocate sample buffer for superfluous data" };
+
+    for (size_t i = samples_to_directly_copy; i < m_current_frame->sample_count; ++i) {
+        Sample frame = { left[i] * sample_rescale, right[i] * sample_rescale };
+        m_unread_data.unchecked_append(frame);
+    }
+
+    return {};
+}
+
+MaybeLoaderError FlacLoaderPlugin::decode_frame(FlacBitReader& bit_stream)
 {
 #define FLAC_VERIFY(check, category, msg)                                                                                               \
     do {                                                                                                                                \
@@ -275,55 +389,54 @@ MaybeLoaderError FlacLoaderPlugin::next_frame(Span<Sample> target_vector)
         }                                                                                                                               \
     } while (0)
 
-    auto bit_stream = LOADER_TRY(BigEndianInputBitStream::construct(*m_stream));
-
     // TODO: Check the CRC-16 checksum (and others) by keeping track of read data
 
     // 11.22. FRAME_HEADER
-    u16 sync_code = LOADER_TRY(bit_stream->read_bits<u16>(14));
+    u16 sync_code = LOADER_TRY(bit_stream.read_bits(14));
     FLAC_VERIFY(sync_code == 0b11111111111110, LoaderError::Category::Format, "Sync code");
-    bool reserved_bit = LOADER_TRY(bit_stream->read_bit());
+    bool reserved_bit = LOADER_TRY(bit_stream.read_bit());
     FLAC_VERIFY(reserved_bit == 0, LoaderError::Category::Format, "Reserved frame header bit");
     // 11.22.2. BLOCKING STRATEGY
-    [[maybe_unused]] bool blocking_strategy = LOADER_TRY(bit_stream->read_bit());
+    [[maybe_unused]] bool blocking_strategy = LOADER_TRY(bit_stream.read_bit());
 
-    u32 sample_count = TRY(convert_sample_count_code(LOADER_TRY(bit_stream->read_bits<u8>(4))));
+    u32 sample_count = TRY(convert_sample_count_code(LOADER_TRY(bit_stream.read_bits(4))));
 
-    u32 frame_sample_rate = TRY(convert_sample_rate_code(LOADER_TRY(bit_stream->read_bits<u8>(4))));
+    u32 frame_sample_rate = TRY(convert_sample_rate_code(LOADER_TRY(bit_stream.read_bits(4))));
 
-    u8 channel_type_num = LOADER_TRY(bit_stream->read_bits<u8>(4));
+    u8 channel_type_num = LOADER_TRY(bit_stream.read_bits(4));
     FLAC_VERIFY(channel_type_num < 0b1011, LoaderError::Category::Format, "Channel assignment");
     FlacFrameChannelType channel_type = (FlacFrameChannelType)channel_type_num;
 
-    PcmSampleFormat bit_depth = TRY(convert_bit_depth_code(LOADER_TRY(bit_stream->read_bits<u8>(3))));
+    PcmSampleFormat bit_depth = TRY(convert_bit_depth_code(LOADER_TRY(bit_stream.read_bits(3))));
 
-    reserved_bit = LOADER_TRY(bit_stream->read_bit());
+    reserved_bit = LOADER_TRY(bit_stream.read_bit());
     FLAC_VERIFY(reserved_bit == 0, LoaderError::Category::Format, "Reserved frame header end bit");
 
     // 11.22.8. CODED NUMBER
     // FIXME: sample number can be 8-56 bits, frame number can be 8-48 bits
-    m_current_sample_or_frame = LOADER_TRY(read_utf8_char(*bit_stream));
+    m_current_sample_or_frame = LOADER_TRY(read_utf8_char(bit_stream));
 
     // Conditional header variables
     // 11.22.9. BLOCK SIZE INT
     if (sample_count == FLAC_BLOCKSIZE_AT_END_OF_HEADER_8) {
-        sample_count = LOADER_TRY(bit_stream->read_bits<u32>(8)) + 1;
+        sample_count = LOADER_TRY(bit_stream.read_bits(8)) + 1;
     } else if (sample_count == FLAC_BLOCKSIZE_AT_END_OF_HEADER_16) {
-        sample_count = LOADER_TRY(bit_stream->read_bits<u32>(16)) + 1;
+        sample_count = LOADER_TRY(bit_stream.read_bits(16)) + 1;
     }
 
     // 11.22.10. SAMPLE RATE INT
     if (frame_sample_rate == FLAC_SAMPLERATE_AT_END_OF_HEADER_8) {
-        frame_sample_rate = LOADER_TRY(bit_stream->read_bits<u32>(8)) * 1000;
+        frame_sample_rate = LOADER_TRY(bit_stream.read_bits(8)) * 1000;
     } else if (frame_sample_rate == FLAC_SAMPLERATE_AT_END_OF_HEADER_16) {
-        frame_sample_rate = LOADER_TRY(bit_stream->read_bits<u32>(16));
+        frame_sample_rate = LOADER_TRY(bit_stream.read_bits(16));
     } else if (frame_sample_rate == FLAC_SAMPLERATE_AT_END_OF_HEADER_16X10) {
-        frame_sample_rate = LOADER_TRY(bit_stream->read_bits<u32>(16)) * 10;
+        frame_sample_rate = LOADER_TRY(bit_stream.read_bits(16)) * 10;
     }
+    FLAC_VERIFY(frame_sample_rate == m_sample_rate, LoaderError::Category::Unimplemented, "Sample rate changes within the stream");
 
     // 11.22.11. FRAME CRC
     // TODO: check header checksum, see above
-    [[maybe_unused]] u8 checksum = LOADER_TRY(bit_stream->read_bits<u8>(8));
+    [[maybe_unused]] u8 checksum = LOADER_TRY(bit_stream.read_bits(8));
 
     dbgln_if(AFLACLOADER_DEBUG, "Frame: {} samples, {}bit {}Hz, channeltype {:x}, {} number {}, header checksum {}", sample_count, pcm_bits_per_sample(bit_depth), frame_sample_rate, channel_type_num, blocking_strategy ? "sample" : "frame", m_current_sample_or_frame, checksum);
 
@@ -335,95 +448,21 @@ MaybeLoaderError FlacLoaderPlugin::next_frame(Span<Sample> target_vector)
     };
 
     u8 subframe_count = frame_channel_type_to_channel_count(channel_type);
-    Vector<Vector<i32>> current_subframes;
-    current_subframes.ensure_capacity(subframe_count);
-
     for (u8 i = 0; i < subframe_count; ++i) {
-        FlacSubframeHeader new_subframe = TRY(next_subframe_header(*bit_stream, i));
-        Vector<i32> subframe_samples = TRY(parse_subframe(new_subframe, *bit_stream));
-        current_subframes.unchecked_append(move(subframe_samples));
+        FlacSubframeHeader new_subframe = TRY(next_subframe_header(bit_stream, i));
+        auto& samples = m_subframe_samples[i];
+        LOADER_TRY(samples.try_resize(sample_count));
+        TRY(parse_subframe(new_subframe, bit_stream, samples));
     }
 
     // 11.2. Overview ("The audio data is composed of...")
-    bit_stream->align_to_byte_boundary();
+    bit_stream.align_to_byte_boundary();
 
     // 11.23. FRAME_FOOTER
     // TODO: check checksum, see above
-    [[maybe_unused]] u16 footer_checksum = LOADER_TRY(bit_stream->read_bits<u16>(16));
+    [[maybe_unused]] u16 footer_checksum = LOADER_TRY(bit_stream.read_bits(16));
     dbgln_if(AFLACLOADER_DEBUG, "Subframe footer checksum: {}", footer_checksum);
 
-    Vector<i32> left;
-    Vector<i32> right;
-
-    switch (channel_type) {
-    case FlacFrameChannelType::Mono:
-        left = right = current_subframes[0];
-        break;
-    case FlacFrameChannelType::Stereo:
-    // TODO mix together surround channels on each side?
-    case FlacFrameChannelType::StereoCenter:
-    case FlacFrameChannelType::Surround4p0:
-    case FlacFrameChannelType::Surround5p0:
-    case FlacFrameChannelType::Surround5p1:
-    case FlacFrameChannelType::Surround6p1:
-    case FlacFrameChannelType::Surround7p1:
-        left = current_subframes[0];
-        right = current_subframes[1];
-        break;
-    case FlacFrameChannelType::LeftSideStereo:
-        // channels are left (0) and side (1)
-        left = current_subframes[0];
-        right.ensure_capacity(left.size());
-        for (size_t i = 0; i < left.size(); ++i) {
-            // right = left - side
-            right.unchecked_append(left[i] - current_subframes[1][i]);
-        }
-        break;
-    case FlacFrameChannelType::RightSideStereo:
-        // channels are side (0) and right (1)
-        right = current_subframes[1];
-        left.ensure_capacity(right.size());
-        for (size_t i = 0; i < right.size(); ++i) {
-            // left = right + side
-            left.unchecked_append(right[i] + current_subframes[0][i]);
-        }
-        break;
-    case FlacFrameChannelType::MidSideStereo:
-        // channels are mid (0) and side (1)
-        left.ensure_capacity(current_subframes[0].size());
-        right.ensure_capacity(current_subframes[0].size());
-        for (size_t i = 0; i < current_subframes[0].size(); ++i) {
-            i64 mid = current_subframes[0][i];
-            i64 side = current_subframes[1][i];
-            mid *= 2;
-            // prevent integer division errors
-            left.unchecked_append(static_cast<i32>((mid + side) / 2));
-            right.unchecked_append(static_cast<i32>((mid - side) / 2));
-        }
-        break;
-    }
-
-    VERIFY(left.size() == right.size() && left.size() == m_current_frame->sample_count);
-
-    float sample_rescale = static_cast<float>(1 << (pcm_bits_per_sample(m_current_frame->bit_depth) - 1));
-    dbgln_if(AFLACLOADER_DEBUG, "Sample rescaled from {} bits: factor {:.1f}", pcm_bits_per_sample(m_current_frame->bit_depth), sample_rescale);
-
-    // zip together channels
-    auto samples_to_directly_copy = min(target_vector.size(), m_current_frame->sample_count);
-    for (size_t i = 0; i < samples_to_directly_copy; ++i) {
-        Sample frame = { left[i] / sample_rescale, right[i] / sample_rescale };
-        target_vector[i] = frame;
-    }
-    // move superfluous data into the class buffer instead
-    auto result = m_unread_data.try_grow_capacity(m_current_frame->sample_count - samples_to_directly_copy);
-    if (result.is_error())
-        return LoaderError { LoaderError::Category::Internal, static_cast<size_t>(samples_to_directly_copy + m_current_sample_or_frame), "Couldn't allocate sample buffer for superfluous data" };
-
-    for (size_t i = samples_to_directly_copy; i < m_current_frame->sample_count; ++i) {
-        Sample frame = { left[i] / sample_rescale, right[i] / sample_rescale };
-        m_unread_data.unchecked_append(frame);
-    }
-
     return {};
 #undef FLAC_VERIFY
 }
@@ -516,7 +555,7 @@ u8 frame_channel_type_to_channel_count(FlacFrameChannelType channel_type)
 }
 
 // 11.25. SUBFRAME_HEADER
-ErrorOr<FlacSubframeHeader, LoaderError> FlacLoaderPlugin::next_subframe_header(BigEndianInputBitStream& bit_stream, u8 channel_index)
+ErrorOr<FlacSubframeHeader, LoaderError> FlacLoaderPlugin::next_subframe_header(FlacBitReader& bit_stream, u8 channel_index)
 {
     u8 bits_per_sample = static_cast<u16>(pcm_bits_per_sample(m_current_frame->bit_depth));
 
@@ -543,7 +582,7 @@ ErrorOr<FlacSubframeHeader, LoaderError> FlacLoaderPlugin::next_subframe_header(
         return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), "Zero bit padding" };
 
     // 11.25.1. SUBFRAME TYPE
-    u8 subframe_code = LOADER_TRY(bit_stream.read_bits<u8>(6));
+    u8 subframe_code = LOADER_TRY(bit_stream.read_bits(6));
     if ((subframe_code >= 0b000010 && subframe_code <= 0b000111) || (subframe_code > 0b001100 && subframe_code < 0b100000))
         return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), "Subframe type" };
 
@@ -580,137 +619,182 @@ ErrorOr<FlacSubframeHeader, LoaderError> FlacLoaderPlugin::next_subframe_header(
     };
 }
 
-ErrorOr<Vector<i32>, LoaderError> FlacLoaderPlugin::parse_subframe(FlacSubframeHeader& subframe_header, BigEndianInputBitStream& bit_input)
+MaybeLoaderError FlacLoaderPlugin::parse_subframe(FlacSubframeHeader& subframe_header, FlacBitReader& bit_input, Span<i32> samples)
 {
-    Vector<i32> samples;
+    if (subframe_header.wasted_bits_per_sample >= subframe_header.bits_per_sample)
+        return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), "Too many wasted bits per sample" };
 
     switch (subframe_header.type) {
     case FlacSubframeType::Constant: {
         // 11.26. SUBFRAME_CONSTANT
-        u64 constant_value = LOADER_TRY(bit_input.read_bits<u64>(subframe_header.bits_per_sample - subframe_header.wasted_bits_per_sample));
-        dbgln_if(AFLACLOADER_DEBUG, "Constant subframe: {}", constant_value);
-
-        samples.ensure_capacity(m_current_frame->sample_count);
-        VERIFY(subframe_header.bits_per_sample - subframe_header.wasted_bits_per_sample != 0);
-        i32 constant = sign_extend(static_cast<u32>(constant_value), subframe_header.bits_per_sample - subframe_header.wasted_bits_per_sample);
-        for (u32 i = 0; i < m_current_frame->sample_count; ++i) {
-            samples.unchecked_append(constant);
-        }
+        i32 constant = LOADER_TRY(bit_input.read_signed_bits(subframe_header.bits_per_sample - subframe_header.wasted_bits_per_sample));
+        dbgln_if(AFLACLOADER_DEBUG, "Constant subframe: {}", constant);
+
+        samples.fill(constant);
         break;
     }
     case FlacSubframeType::Fixed: {
         dbgln_if(AFLACLOADER_DEBUG, "Fixed LPC subframe order {}", subframe_header.order);
-        samples = TRY(decode_fixed_lpc(subframe_header, bit_input));
+        TRY(decode_fixed_lpc(subframe_header, bit_input, samples));
         break;
     }
     case FlacSubframeType::Verbatim: {
         dbgln_if(AFLACLOADER_DEBUG, "Verbatim subframe");
-        samples = TRY(decode_verbatim(subframe_header, bit_input));
+        TRY(decode_verbatim(subframe_header, bit_input, samples));
         break;
     }
     case FlacSubframeType::LPC: {
         dbgln_if(AFLACLOADER_DEBUG, "Custom LPC subframe order {}", subframe_header.order);
-        samples = TRY(decode_custom_lpc(subframe_header, bit_input));
+        TRY(decode_custom_lpc(subframe_header, bit_input, samples));
         break;
     }
     default:
         return LoaderError { LoaderError::Category::Unimplemented, static_cast<size_t>(m_current_sample_or_frame), "Unhandled FLAC subframe type" };
     }
 
-    for (size_t i = 0; i < samples.size(); ++i) {
-        samples[i] <<= subframe_header.wasted_bits_per_sample;
+    if (subframe_header.wasted_bits_per_sample != 0) {
+        for (auto& sample : samples)
+            sample <<= subframe_header.wasted_bits_per_sample;
     }
 
-    ResampleHelper<i32> resampler(m_current_frame->sample_rate, m_sample_rate);
-    return resampler.resample(samples);
+    return {};
 }
 
 // 11.29. SUBFRAME_VERBATIM
 // Decode a subframe that isn't actually encoded, usually seen in random data
-ErrorOr<Vector<i32>, LoaderError> FlacLoaderPlugin::decode_verbatim(FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input)
+MaybeLoaderError FlacLoaderPlugin::decode_verbatim(FlacSubframeHeader& subframe, FlacBitReader& bit_input, Span<i32> decoded)
 {
-    Vector<i32> decoded;
-    decoded.ensure_capacity(m_current_frame->sample_count);
+    for (auto& sample : decoded)
+        sample = LOADER_TRY(bit_input.read_signed_bits(subframe.bits_per_sample - subframe.wasted_bits_per_sample));
 
-    VERIFY(subframe.bits_per_sample - subframe.wasted_bits_per_sample != 0);
-    for (size_t i = 0; i < m_current_frame->sample_count; ++i) {
-        decoded.unchecked_append(sign_extend(
-            LOADER_TRY(bit_input.read_bits<u32>(subframe.bits_per_sample - subframe.wasted_bits_per_sample)),
-            subframe.bits_per_sample - subframe.wasted_bits_per_sample));
+    return {};
+}
+
+// Restores the samples from the residual with a predictor of a fixed order.
+// Knowing the order at compile time lets the compiler unroll the inner loop and keep the coefficients in registers.
+// The sums must be known to fit into 32 bits, see decode_custom_lpc().
+template<size_t order>
+static void restore_lpc_with_order(Span<i32> decoded, Array<i32, 32> const& coefficients, u8 shift)
+{
+    for (size_t i = order; i < decoded.size(); ++i) {
+        i32 sample = 0;
+        for (size_t t = 0; t < order; ++t)
+            sample += coefficients[t] * decoded[i - t - 1];
+        decoded[i] += sample >> shift;
     }
+}
 
-    return decoded;
+static void restore_lpc(Span<i32> decoded, Array<i32, 32> const& coefficients, u8 order, u8 shift)
+{
+    for (size_t i = order; i < decoded.size(); ++i) {
+        i64 sample = 0;
+        for (size_t t = 0; t < order; ++t) {
+            // It's really important that we compute in 64-bit land here.
+            // Even though FLAC operates at a maximum bit depth of 32 bits, modern encoders use super-large coefficients for maximum compression.
+            // These will easily overflow 32 bits and cause strange white noise that abruptly stops intermittently (at the end of a frame).
+            // The simple fix of course is to do intermediate computations in 64 bits.
+            // These considerations are not in the original FLAC spec, but have been added to the IETF standard: https://datatracker.ietf.org/doc/html/draft-ietf-cellar-flac-03#appendix-A.3
+            sample += static_cast<i64>(coefficients[t]) * static_cast<i64>(decoded[i - t - 1]);
+        }
+        decoded[i] += static_cast<i32>(sample >> shift);
+    }
 }
 
 // 11.28. SUBFRAME_LPC
 // Decode a subframe encoded with a custom linear predictor coding, i.e. the subframe provides the polynomial order and coefficients
-ErrorOr<Vector<i32>, LoaderError> FlacLoaderPlugin::decode_custom_lpc(FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input)
+MaybeLoaderError FlacLoaderPlugin::decode_custom_lpc(FlacSubframeHeader& subframe, FlacBitReader& bit_input, Span<i32> decoded)
 {
-    Vector<i32> decoded;
-    decoded.ensure_capacity(m_current_frame->sample_count);
+    u8 sample_bits = subframe.bits_per_sample - subframe.wasted_bits_per_sample;
+    if (subframe.order > decoded.size())
+        return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), "Predictor order larger than the frame" };
 
-    VERIFY(subframe.bits_per_sample - subframe.wasted_bits_per_sample != 0);
     // warm-up samples
-    for (auto i = 0; i < subframe.order; ++i) {
-        decoded.unchecked_append(sign_extend(
-            LOADER_TRY(bit_input.read_bits<u32>(subframe.bits_per_sample - subframe.wasted_bits_per_sample)),
-            subframe.bits_per_sample - subframe.wasted_bits_per_sample));
-    }
+    for (auto i = 0; i < subframe.order; ++i)
+        decoded[i] = LOADER_TRY(bit_input.read_signed_bits(sample_bits));
 
     // precision of the coefficients
-    u8 lpc_precision = LOADER_TRY(bit_input.read_bits<u8>(4));
+    u8 lpc_precision = LOADER_TRY(bit_input.read_bits(4));
     if (lpc_precision == 0b1111)
         return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), "Invalid linear predictor coefficient precision" };
     lpc_precision += 1;
 
     // shift needed on the data (signed!)
-    i8 lpc_shift = sign_extend(LOADER_TRY(bit_input.read_bits<u8>(5)), 5);
+    i8 lpc_shift = LOADER_TRY(bit_input.read_signed_bits(5));
+    // The IETF draft forbids negative shifts, and shifting by them would be undefined.
+    if (lpc_shift < 0)
+        return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), "Negative linear predictor coefficient shift" };
 
-    Vector<i32> coefficients;
-    coefficients.ensure_capacity(subframe.order);
+    Array<i32, 32> coefficients {};
     // read coefficients
-    for (auto i = 0; i < subframe.order; ++i) {
-        u32 raw_coefficient = LOADER_TRY(bit_input.read_bits<u32>(lpc_precision));
-        i32 coefficient = static_cast<i32>(sign_extend(raw_coefficient, lpc_precision));
-        coefficients.unchecked_append(coefficient);
-    }
+    for (auto i = 0; i < subframe.order; ++i)
+        coefficients[i] = LOADER_TRY(bit_input.read_signed_bits(lpc_precision));
 
-    dbgln_if(AFLACLOADER_DEBUG, "{}-bit {} shift coefficients: {}", lpc_precision, lpc_shift, coefficients);
+    dbgln_if(AFLACLOADER_DEBUG, "{}-bit {} shift coefficients: {}", lpc_precision, lpc_shift, coefficients.span().trim(subframe.order));
 
     TRY(decode_residual(decoded, subframe, bit_input));
 
     // approximate the waveform with the predictor
-    for (size_t i = subframe.order; i < m_current_frame->sample_count; ++i) {
-        // (see below)
-        i64 sample = 0;
-        for (size_t t = 0; t < subframe.order; ++t) {
-            // It's really important that we compute in 64-bit land here.
-            // Even though FLAC operates at a maximum bit depth of 32 bits, modern encoders use super-large coefficients for maximum compression.
-            // These will easily overflow 32 bits and cause strange white noise that abruptly stops intermittently (at the end of a frame).
-            // The simple fix of course is to do intermediate computations in 64 bits.
-            // These considerations are not in the original FLAC spec, but have been added to the IETF standard: https://datatracker.ietf.org/doc/html/draft-ietf-cellar-flac-03#appendix-A.3
-            sample += static_cast<i64>(coefficients[t]) * static_cast<i64>(decoded[i - t - 1]);
-        }
-        decoded[i] += sample >> lpc_shift;
+    // Every product has at most sample_bits + lpc_precision - 1 bits, so for the common low orders and bit depths, the sum fits into 32 bits.
+    if (sample_bits + lpc_precision + AK::ceil_log2(subframe.order) > 32) {
+        restore_lpc(decoded, coefficients, subframe.order, lpc_shift);
+        return {};
+    }
+
+    switch (subframe.order) {
+    case 1:
+        restore_lpc_with_order<1>(decoded, coefficients, lpc_shift);
+        break;
+    case 2:
+        restore_lpc_with_order<2>(decoded, coefficients, lpc_shift);
+        break;
+    case 3:
+        restore_lpc_with_order<3>(decoded, coefficients, lpc_shift);
+        break;
+    case 4:
+        restore_lpc_with_order<4>(decoded, coefficients, lpc_shift);
+        break;
+    case 5:
+        restore_lpc_with_order<5>(decoded, coefficients, lpc_shift);
+        break;
+    case 6:
+        restore_lpc_with_order<6>(decoded, coefficients, lpc_shift);
+        break;
+    case 7:
+        restore_lpc_with_order<7>(decoded, coefficients, lpc_shift);
+        break;
+    case 8:
+        restore_lpc_with_order<8>(decoded, coefficients, lpc_shift);
+        break;
+    case 9:
+        restore_lpc_with_order<9>(decoded, coefficients, lpc_shift);
+        break;
+    case 10:
+        restore_lpc_with_order<10>(decoded, coefficients, lpc_shift);
+        break;
+    case 11:
+        restore_lpc_with_order<11>(decoded, coefficients, lpc_shift);
+        break;
+    case 12:
+        restore_lpc_with_order<12>(decoded, coefficients, lpc_shift);
+        break;
+    default:
+        restore_lpc(decoded, coefficients, subframe.order, lpc_shift);
+        break;
     }
 
-    return decoded;
+    return {};
 }
 
 // 11.27. SUBFRAME_FIXED
 // Decode a subframe encoded with one of the fixed linear predictor codings
-ErrorOr<Vector<i32>, LoaderError> FlacLoaderPlugin::decode_fixed_lpc(FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input)
+MaybeLoaderError FlacLoaderPlugin::decode_fixed_lpc(FlacSubframeHeader& subframe, FlacBitReader& bit_input, Span<i32> decoded)
 {
-    Vector<i32> decoded;
-    decoded.ensure_capacity(m_current_frame->sample_count);
+    if (subframe.order > decoded.size())
+        return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), "Predictor order larger than the frame" };
 
-    VERIFY(subframe.bits_per_sample - subframe.wasted_bits_per_sample != 0);
     // warm-up samples
-    for (auto i = 0; i < subframe.order; ++i) {
-        decoded.unchecked_append(sign_extend(
-            LOADER_TRY(bit_input.read_bits<u32>(subframe.bits_per_sample - subframe.wasted_bits_per_sample)),
-            subframe.bits_per_sample - subframe.wasted_bits_per_sample));
-    }
+    for (auto i = 0; i < subframe.order; ++i)
+        decoded[i] = LOADER_TRY(bit_input.read_signed_bits(subframe.bits_per_sample - subframe.wasted_bits_per_sample));
 
     TRY(decode_residual(decoded, subframe, bit_input));
 
@@ -736,118 +820,109 @@ ErrorOr<Vector<i32>, LoaderError> FlacLoaderPlugin::decode_fixed_lpc(FlacSubfram
     switch (subframe.order) {
     case 0:
         // s_0(t) = 0
-        for (u32 i = subframe.order; i < m_current_frame->sample_count; ++i)
+        for (size_t i = subframe.order; i < decoded.size(); ++i)
             decoded[i] += 0;
         break;
     case 1:
         // s_1(t) = s(t-1)
-        for (u32 i = subframe.order; i < m_current_frame->sample_count; ++i)
+        for (size_t i = subframe.order; i < decoded.size(); ++i)
             decoded[i] += decoded[i - 1];
         break;
     case 2:
         // s_2(t) = 2s(t-1) - s(t-2)
-        for (u32 i = subframe.order; i < m_current_frame->sample_count; ++i)
+        for (size_t i = subframe.order; i < decoded.size(); ++i)
             decoded[i] += 2 * decoded[i - 1] - decoded[i - 2];
         break;
     case 3:
         // s_3(t) = 3s(t-1) - 3s(t-2) + s(t-3)
-        for (u32 i = subframe.order; i < m_current_frame->sample_count; ++i)
+        for (size_t i = subframe.order; i < decoded.size(); ++i)
             decoded[i] += 3 * decoded[i - 1] - 3 * decoded[i - 2] + decoded[i - 3];
         break;
     case 4:
         // s_4(t) = 4s(t-1) - 6s(t-2) + 4s(t-3) - s(t-4)
-        for (u32 i = subframe.order; i < m_current_frame->sample_count; ++i)
+        for (size_t i = subframe.order; i < decoded.size(); ++i)
             decoded[i] += 4 * decoded[i - 1] - 6 * decoded[i - 2] + 4 * decoded[i - 3] - decoded[i - 4];
         break;
     default:
         return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), String::formatted("Unrecognized predictor order {}", subframe.order) };
     }
-    return decoded;
+    return {};
 }
 
 // 11.30. RESIDUAL
 // Decode the residual, the "error" between the function approximation and the actual audio data
-MaybeLoaderError FlacLoaderPlugin::decode_residual(Vector<i32>& decoded, FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input)
+// The residuals are stored in place of the samples following the warm-up samples.
+MaybeLoaderError FlacLoaderPlugin::decode_residual(Span<i32> decoded, FlacSubframeHeader& subframe, FlacBitReader& bit_input)
 {
     // 11.30.1. RESIDUAL_CODING_METHOD
-    auto residual_mode = static_cast<FlacResidualMode>(LOADER_TRY(bit_input.read_bits<u8>(2)));
-    u8 partition_order = LOADER_TRY(bit_input.read_bits<u8>(4));
+    auto residual_mode = static_cast<FlacResidualMode>(LOADER_TRY(bit_input.read_bits(2)));
+    u8 partition_order = LOADER_TRY(bit_input.read_bits(4));
     size_t partitions = 1 << partition_order;
 
+    u8 partition_type;
     if (residual_mode == FlacResidualMode::Rice4Bit) {
         // 11.30.2. RESIDUAL_CODING_METHOD_PARTITIONED_EXP_GOLOMB
         // decode a single Rice partition with four bits for the order k
-        for (size_t i = 0; i < partitions; ++i) {
-            auto rice_partition = TRY(decode_rice_partition(4, partitions, i, subframe, bit_input));
-            decoded.extend(move(rice_partition));
-        }
+        partition_type = 4;
     } else if (residual_mode == FlacResidualMode::Rice5Bit) {
         // 11.30.3. RESIDUAL_CODING_METHOD_PARTITIONED_EXP_GOLOMB2
         // five bits equivalent
-        for (size_t i = 0; i < partitions; ++i) {
-            auto rice_partition = TRY(decode_rice_partition(5, partitions, i, subframe, bit_input));
-            decoded.extend(move(rice_partition));
-        }
-    } else
+        partition_type = 5;
+    } else {
         return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), "Reserved residual coding method" };
+    }
+
+    // The first partition doesn't contain residuals for the warm-up samples.
+    size_t partition_sample_count = decoded.size() >> partition_order;
+    if (decoded.size() % partitions != 0 || partition_sample_count < subframe.order)
+        return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), "Invalid residual partition order" };
+
+    auto residuals = decoded.slice(subframe.order);
+    for (size_t i = 0; i < partitions; ++i) {
+        auto residual_sample_count = i == 0 ? partition_sample_count - subframe.order : partition_sample_count;
+        TRY(decode_rice_partition(partition_type, residuals.trim(residual_sample_count), bit_input));
+        residuals = residuals.slice(residual_sample_count);
+    }
 
     return {};
 }
 
 // 11.30.2.1. EXP_GOLOMB_PARTITION and 11.30.3.1. EXP_GOLOMB2_PARTITION
 // Decode a single Rice partition as part of the residual, every partition can have its own Rice parameter k
-ALWAYS_INLINE ErrorOr<Vector<i32>, LoaderError> FlacLoaderPlugin::decode_rice_partition(u8 partition_type, u32 partitions, u32 partition_index, FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input)
+ALWAYS_INLINE MaybeLoaderError FlacLoaderPlugin::decode_rice_partition(u8 partition_type, Span<i32> residuals, FlacBitReader& bit_input)
 {
     // 11.30.2.2. EXP GOLOMB PARTITION ENCODING PARAMETER and 11.30.3.2. EXP-GOLOMB2 PARTITION ENCODING PARAMETER
-    u8 k = LOADER_TRY(bit_input.read_bits<u8>(partition_type));
-
-    u32 residual_sample_count;
-    if (partitions == 0)
-        residual_sample_count = m_current_frame->sample_count - subframe.order;
-    else
-        residual_sample_count = m_current_frame->sample_count / partitions;
-    if (partition_index == 0)
-        residual_sample_count -= subframe.order;
-
-    Vector<i32> rice_partition;
-    rice_partition.resize(residual_sample_count);
+    u8 k = LOADER_TRY(bit_input.read_bits(partition_type));
 
     // escape code for unencoded binary partition
     if (k == (1 << partition_type) - 1) {
-        u8 unencoded_bps = LOADER_TRY(bit_input.read_bits<u8>(5));
-        for (size_t r = 0; r < residual_sample_count; ++r) {
-            rice_partition[r] = LOADER_TRY(bit_input.read_bits<u8>(unencoded_bps));
-        }
+        u8 unencoded_bps = LOADER_TRY(bit_input.read_bits(5));
+        for (auto& residual : residuals)
+            residual = LOADER_TRY(bit_input.read_signed_bits(unencoded_bps));
     } else {
-        for (size_t r = 0; r < residual_sample_count; ++r) {
-            rice_partition[r] = LOADER_TRY(decode_unsigned_exp_golomb(k, bit_input));
-        }
+        for (auto& residual : residuals)
+            residual = LOADER_TRY(decode_unsigned_exp_golomb(k, bit_input));
     }
 
-    return rice_partition;
+    return {};
 }
 
 // Decode a single number encoded with Rice/Exponential-Golomb encoding (the unsigned variant)
-ALWAYS_INLINE ErrorOr<i32> decode_unsigned_exp_golomb(u8 k, BigEndianInputBitStream& bit_input)
+ALWAYS_INLINE ErrorOr<i32> decode_unsigned_exp_golomb(u8 k, FlacBitReader& bit_input)
 {
-    u8 q = 0;
-    while (TRY(bit_input.read_bit()) == 0)
-        ++q;
+    u32 q = TRY(bit_input.read_unary());
 
     // least significant bits (remainder)
-    u32 rem = TRY(bit_input.read_bits<u32>(k));
+    u32 rem = TRY(bit_input.read_bits(k));
     u32 value = q << k | rem;
 
     return rice_to_signed(value);
 }
 
-ErrorOr<u64> read_utf8_char(BigEndianInputBitStream& input)
+ErrorOr<u64> read_utf8_char(FlacBitReader& input)
 {
     u64 character;
-    u8 buffer = 0;
-    Bytes buffer_bytes { &buffer, 1 };
-    TRY(input.read(buffer_bytes));
-    u8 start_byte = buffer_bytes[0];
+    u8 start_byte = TRY(input.read_bits(8));
     // Signal byte is zero: ASCII character
     if ((start_byte & 0b10000000) == 0) {
         return start_byte;
@@ -862,8 +937,7 @@ ErrorOr<u64> read_utf8_char(BigEndianInputBitStream& input)
     u8 start_byte_bitmask = AK::exp2(bits_from_start_byte) - 1;
     character = start_byte_bitmask & start_byte;
     for (u8 i = length - 1; i > 0; --i) {
-        TRY(input.read(buffer_bytes));
-        u8 current_byte = buffer_bytes[0];
+        u8 current_byte = TRY(input.read_bits(8));
         character = (character << 6) | (current_byte & 0b00111111);
     }
     return character;
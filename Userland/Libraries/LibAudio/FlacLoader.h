@@ -8,6 +8,8 @@
 
 #include "FlacTypes.h"
 #include "Loader.h"
+#include <AK/Array.h>
+#include <AK/ByteBuffer.h>
 #include <AK/Error.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
@@ -25,6 +27,109 @@ using Core::Stream::BigEndianInputBitStream;
 // There was no intensive fine-tuning done to determine this value, so improvements may definitely be possible.
 constexpr size_t FLAC_BUFFER_SIZE = 8 * KiB;
 
+// The encoded stream is read in chunks of at least this size. A frame that was cut off by the end of the buffer
+// has to be decoded again after refilling, so this should hold many frames.
+constexpr size_t FLAC_INPUT_BUFFER_SIZE = 256 * KiB;
+
+// Reads bits in big-endian order from a frame in memory, keeping up to 64 of them in a reservoir.
+// Running out of data is not necessarily an error, as the frame may just not have been read completely yet.
+class FlacBitReader {
+public:
+    explicit FlacBitReader(ReadonlyBytes data)
+        : m_data(data)
+    {
+    }
+
+    ALWAYS_INLINE ErrorOr<u32> read_bits(u8 count)
+    {
+        VERIFY(count <= 32);
+        if (count == 0)
+            return 0;
+        TRY(ensure_bits(count));
+        u32 value = m_reservoir >> (64 - count);
+        consume_bits(count);
+        return value;
+    }
+
+    ALWAYS_INLINE ErrorOr<bool> read_bit() { return TRY(read_bits(1)) != 0; }
+
+    ALWAYS_INLINE ErrorOr<i32> read_signed_bits(u8 count)
+    {
+        VERIFY(count <= 32);
+        if (count == 0)
+            return 0;
+        TRY(ensure_bits(count));
+        // Arithmetic shift sign-extends the value.
+        i32 value = static_cast<i32>(static_cast<i64>(m_reservoir) >> (64 - count));
+        consume_bits(count);
+        return value;
+    }
+
+    // Counts the zero bits up to the next one bit, and skips them along with the one bit.
+    ALWAYS_INLINE ErrorOr<u32> read_unary()
+    {
+        u32 zero_count = 0;
+        while (true) {
+            if (m_reservoir != 0) {
+                auto leading_zeros = static_cast<u8>(__builtin_clzll(m_reservoir));
+                // The bits below the reservoir's fill level are always zero, so a one bit is always valid.
+                consume_bits(leading_zeros + 1);
+                return zero_count + leading_zeros;
+            }
+            zero_count += m_reservoir_bits;
+            m_reservoir_bits = 0;
+            refill();
+            if (m_reservoir_bits == 0)
+                return out_of_data();
+        }
+    }
+
+    void align_to_byte_boundary() { consume_bits(m_reservoir_bits % 8); }
+
+    // The number of whole bytes that have been read.
+    size_t consumed_bytes() const { return m_data_offset - m_reservoir_bits / 8; }
+    bool ran_out_of_data() const { return m_ran_out_of_data; }
+
+private:
+    ALWAYS_INLINE ErrorOr<void> ensure_bits(u8 count)
+    {
+        if (m_reservoir_bits < count) {
+            refill();
+            if (m_reservoir_bits < count)
+                return out_of_data();
+        }
+        return {};
+    }
+
+    ALWAYS_INLINE void refill()
+    {
+        while (m_reservoir_bits <= 56 && m_data_offset < m_data.size()) {
+            m_reservoir |= static_cast<u64>(m_data[m_data_offset++]) << (56 - m_reservoir_bits);
+            m_reservoir_bits += 8;
+        }
+    }
+
+    ALWAYS_INLINE void consume_bits(u8 count)
+    {
+        // Shifting a 64-bit value by 64 is undefined.
+        m_reservoir = count == 64 ? 0 : m_reservoir << count;
+        m_reservoir_bits -= count;
+    }
+
+    Error out_of_data()
+    {
+        m_ran_out_of_data = true;
+        return Error::from_string_literal("Unexpected end of frame");
+    }
+
+    ReadonlyBytes m_data;
+    size_t m_data_offset { 0 };
+    // The next bits to read start at the most significant bit.
+    u64 m_reservoir { 0 };
+    u8 m_reservoir_bits { 0 };
+    bool m_ran_out_of_data { false };
+};
+
 ALWAYS_INLINE u8 frame_channel_type_to_channel_count(FlacFrameChannelType channel_type);
 // Sign-extend an arbitrary-size signed number to 64 bit signed
 ALWAYS_INLINE i64 sign_extend(u32 n, u8 size);
@@ -34,9 +139,9 @@ ALWAYS_INLINE i32 rice_to_signed(u32 x);
 
 // decoders
 // read a UTF-8 encoded number, even if it is not a valid codepoint
-ALWAYS_INLINE ErrorOr<u64> read_utf8_char(BigEndianInputBitStream& input);
+ALWAYS_INLINE ErrorOr<u64> read_utf8_char(FlacBitReader& input);
 // decode a single number encoded with exponential golomb encoding of the specified order
-ALWAYS_INLINE ErrorOr<i32> decode_unsigned_exp_golomb(u8 order, BigEndianInputBitStream& bit_input);
+ALWAYS_INLINE ErrorOr<i32> decode_unsigned_exp_golomb(u8 order, FlacBitReader& bit_input);
 
 // Loader for the Free Lossless Audio Codec (FLAC)
 // This loader supports all audio features of FLAC, although audio from more than two channels is discarded.
@@ -77,17 +182,23 @@ private:
     ErrorOr<FlacRawMetadataBlock, LoaderError> next_meta_block(BigEndianInputBitStream& bit_input);
     // Fetches and writes the next FLAC frame
     MaybeLoaderError next_frame(Span<Sample>);
+    // Helper of next_frame that decodes a frame from the input buffer
+    MaybeLoaderError decode_frame(FlacBitReader& bit_input);
+    // Reads more of the stream into the input buffer, growing it if a frame doesn't fit
+    MaybeLoaderError refill_input_buffer();
+    // Drops everything read ahead of the stream position, which is needed after seeking
+    void discard_buffered_data();
     // Helper of next_frame that fetches a sub frame's header
-    ErrorOr<FlacSubframeHeader, LoaderError> next_subframe_header(BigEndianInputBitStream& bit_input, u8 channel_index);
+    ErrorOr<FlacSubframeHeader, LoaderError> next_subframe_header(FlacBitReader& bit_input, u8 channel_index);
     // Helper of next_frame that decompresses a subframe
-    ErrorOr<Vector<i32>, LoaderError> parse_subframe(FlacSubframeHeader& subframe_header, BigEndianInputBitStream& bit_input);
+    MaybeLoaderError parse_subframe(FlacSubframeHeader& subframe_header, FlacBitReader& bit_input, Span<i32> samples);
     // Subframe-internal data decoders (heavy lifting)
-    ErrorOr<Vector<i32>, LoaderError> decode_fixed_lpc(FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input);
-    ErrorOr<Vector<i32>, LoaderError> decode_verbatim(FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input);
-    ErrorOr<Vector<i32>, LoaderError> decode_custom_lpc(FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input);
-    MaybeLoaderError decode_residual(Vector<i32>& decoded, FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input);
+    MaybeLoaderError decode_fixed_lpc(FlacSubframeHeader& subframe, FlacBitReader& bit_input, Span<i32> decoded);
+    MaybeLoaderError decode_verbatim(FlacSubframeHeader& subframe, FlacBitReader& bit_input, Span<i32> decoded);
+    MaybeLoaderError decode_custom_lpc(FlacSubframeHeader& subframe, FlacBitReader& bit_input, Span<i32> decoded);
+    MaybeLoaderError decode_residual(Span<i32> decoded, FlacSubframeHeader& subframe, FlacBitReader& bit_input);
     // decode a single rice partition that has its own rice parameter
-    ALWAYS_INLINE ErrorOr<Vector<i32>, LoaderError> decode_rice_partition(u8 partition_type, u32 partitions, u32 partition_index, FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input);
+    ALWAYS_INLINE MaybeLoaderError decode_rice_partition(u8 partition_type, Span<i32> residuals, FlacBitReader& bit_input);
     MaybeLoaderError load_seektable(FlacRawMetadataBlock&);
 
     // Converters for special coding used in frame headers
@@ -112,6 +223,11 @@ private:
     // keep track of the start of the data in the FLAC stream to seek back more easily
     u64 m_data_start_location { 0 };
     Optional<FlacFrameHeader> m_current_frame;
+    // Frames are decoded from this buffer, which always starts at a frame boundary.
+    ByteBuffer m_input_buffer;
+    size_t m_input_buffer_offset { 0 };
+    // The decoded samples of each channel in the current frame, kept around to reuse their memory.
+    Array<Vector<i32>, 8> m_subframe_samples;
     // Whatever the last get_more_samples() call couldn't return gets stored here.
     Vector<Sample, FLAC_BUFFER_SIZE> m_unread_data;
     u64 m_current_sample_or_frame { 0 };
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/SIMD.h>
+#include <LibAudio/Resampler.h>
+
+namespace Audio {
+
+// With more phases than this, the tables would get too large, so the phase gets rounded instead.
+// The resulting timing error is at most 1/1024 of a sample.
+static constexpr u32 max_phase_count = 512;
+
+struct FilterParameters {
+    u32 tap_count;
+    double attenuation_db;
+};
+
+static FilterParameters filter_parameters_for(PolyphaseResampler::Quality quality)
+{
+    switch (quality) {
+    case PolyphaseResampler::Quality::Low:
+        return { 16, 55 };
+    case PolyphaseResampler::Quality::Medium:
+        return { 48, 80 };
+    case PolyphaseResampler::Quality::High:
+        return { 128, 100 };
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static u32 greatest_common_divisor(u32 a, u32 b)
+{
+    while (b != 0)
+        a = exchange(b, a % b);
+    return a;
+}
+
+// Zeroth order modified Bessel function of the first kind, which the Kaiser window is built from.
+static double bessel_i0(double x)
+{
+    double sum = 1;
+    double term = 1;
+    for (int k = 1; k < 50; ++k) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+        if (term < sum * 1e-12)
+            break;
+    }
+    return sum;
+}
+
+ErrorOr<PolyphaseResampler> PolyphaseResampler::try_create(u32 source, u32 target, Quality quality)
+{
+    VERIFY(source > 0);
+    VERIFY(target > 0);
+
+    auto divisor = greatest_common_divisor(source, target);
+    auto phase_count = min(target / divisor, max_phase_count);
+
+    auto parameters = filter_parameters_for(quality);
+    // Kaiser's formulas for the window shape and transition width that reach the given attenuation.
+    auto attenuation = parameters.attenuation_db;
+    double beta = attenuation > 50 ? 0.1102 * (attenuation - 8.7) : 0.5842 * AK::pow(attenuation - 21, 0.4) + 0.07886 * (attenuation - 21);
+    double transition_width = (attenuation - 7.95) / (14.36 * parameters.tap_count);
+
+    // When downsampling, the filter has to cut off below the target's Nyquist frequency instead of the source's,
+    // which takes proportionally more taps. The stopband starts right at the lower Nyquist frequency.
+    double bandwidth_scale = min(1.0, static_cast<double>(target) / source);
+    auto tap_count = static_cast<u32>(AK::ceil(parameters.tap_count / bandwidth_scale));
+    tap_count += tap_count % 2;
+    double cutoff = bandwidth_scale * (0.5 - transition_width / 2);
+
+    Vector<float> filter;
+    TRY(filter.try_resize(phase_count * tap_count * 2));
+    auto const half_taps = static_cast<double>(tap_count / 2);
+    auto const window_normalization = bessel_i0(beta);
+    for (u32 phase = 0; phase < phase_count; ++phase) {
+        auto fraction = static_cast<double>(phase) / phase_count;
+        Vector<double> coefficients;
+        TRY(coefficients.try_resize(tap_count));
+        double sum = 0;
+        for (u32 tap = 0; tap < tap_count; ++tap) {
+            // The distance in input samples between this tap and the output sample.
+            auto distance = static_cast<double>(tap) - (half_taps - 1) - fraction;
+            auto argument = 2 * cutoff * distance;
+            auto sinc = argument == 0 ? 1.0 : AK::sin(AK::Pi<double> * argument) / (AK::Pi<double> * argument);
+            auto window_position = distance / half_taps;
+            auto window = bessel_i0(beta * AK::sqrt(max(0.0, 1 - window_position * window_position))) / window_normalization;
+            coefficients[tap] = sinc * window;
+            sum += coefficients[tap];
+        }
+        // Normalize every phase to unity gain, so that a constant signal stays constant.
+        for (u32 tap = 0; tap < tap_count; ++tap) {
+            auto coefficient = static_cast<float>(coefficients[tap] / sum);
+            filter[(phase * tap_count + tap) * 2] = coefficient;
+            filter[(phase * tap_count + tap) * 2 + 1] = coefficient;
+        }
+    }
+
+    PolyphaseResampler resampler { source, target, phase_count, tap_count, move(filter) };
+    resampler.reset();
+    return resampler;
+}
+
+PolyphaseResampler::PolyphaseResampler(u32 source, u32 target, u32 phase_count, u32 tap_count, Vector<float> filter)
+    : m_source(source)
+    , m_target(target)
+    , m_position_scale(target / greatest_common_divisor(source, target))
+    , m_position_step(source / greatest_common_divisor(source, target))
+    , m_phase_count(phase_count)
+    , m_tap_count(tap_count)
+    , m_filter(move(filter))
+{
+}
+
+void PolyphaseResampler::reset()
+{
+    // Start with silence before the stream, so that the first output sample lines up with the first input sample.
+    m_input.clear_with_capacity();
+    m_input.resize(m_tap_count / 2 - 1);
+    m_position = m_input.size() * m_position_scale;
+}
+
+ErrorOr<Vector<Sample>> PolyphaseResampler::resample(Span<Sample const> samples)
+{
+    Vector<Sample> output;
+    if (m_source == m_target) {
+        TRY(output.try_append(samples.data(), samples.size()));
+        return output;
+    }
+
+    TRY(m_input.try_append(samples.data(), samples.size()));
+    TRY(resample_into(output));
+    return output;
+}
+
+ErrorOr<Vector<Sample>> PolyphaseResampler::flush()
+{
+    Vector<Sample> output;
+    if (m_source == m_target)
+        return output;
+
+    // Pad with silence until the filter has passed the last input sample.
+    TRY(m_input.try_resize(m_input.size() + m_tap_count / 2));
+    TRY(resample_into(output));
+    reset();
+    return output;
+}
+
+static_assert(sizeof(Sample) == 2 * sizeof(float));
+
+ErrorOr<void> PolyphaseResampler::resample_into(Vector<Sample>& output)
+{
+    using AK::SIMD::f32x4;
+
+    auto const half_taps = m_tap_count / 2;
+    // The output sample at input position i needs the input samples i - half_taps + 1 up to i + half_taps.
+    if (m_input.size() <= half_taps)
+        return {};
+    auto const available = m_input.size() - half_taps;
+    auto const end_position = available * m_position_scale;
+    if (m_position >= end_position)
+        return {};
+    TRY(output.try_ensure_capacity(output.size() + (end_position - m_position) / m_position_step + 1));
+
+    auto const* input = reinterpret_cast<u8 const*>(m_input.data());
+    auto const* filter = reinterpret_cast<u8 const*>(m_filter.data());
+    auto const row_size = m_tap_count * sizeof(Sample);
+
+    while (m_position < end_position) {
+        // Round to the nearest phase, which may be the first phase of the next input sample.
+        auto index = m_position / m_position_scale;
+        auto phase = (2 * (m_position % m_position_scale) * m_phase_count + m_position_scale) / (2 * m_position_scale);
+        index += phase / m_phase_count;
+        phase %= m_phase_count;
+        if (index >= available)
+            break;
+
+        // Each vector holds two consecutive stereo samples, and their coefficients duplicated for both channels.
+        auto const* samples = input + (index - half_taps + 1) * sizeof(Sample);
+        auto const* coefficients = filter + phase * row_size;
+        f32x4 sum {};
+        for (size_t offset = 0; offset < row_size; offset += sizeof(f32x4)) {
+            f32x4 sample_vector;
+            f32x4 coefficient_vector;
+            __builtin_memcpy(&sample_vector, samples + offset, sizeof(f32x4));
+            __builtin_memcpy(&coefficient_vector, coefficients + offset, sizeof(f32x4));
+            sum += sample_vector * coefficient_vector;
+        }
+        output.unchecked_append({ sum[0] + sum[2], sum[1] + sum[3] });
+
+        m_position += m_position_step;
+    }
+
+    // Drop the input samples that no future output sample needs anymore.
+    auto first_needed = min<size_t>(m_position / m_position_scale - (half_taps - 1), m_input.size());
+    m_input.remove(0, first_needed);
+    m_position -= first_needed * m_position_scale;
+    return {};
+}
+
+}
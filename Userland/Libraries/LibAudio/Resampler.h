@@ -7,14 +7,17 @@
 #pragma once
 
 #include <AK/Concepts.h>
+#include <AK/Error.h>
+#include <AK/Span.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
+#include <LibAudio/Sample.h>
 
 namespace Audio {
 
 // Small helper to resample from one playback rate to another
 // This isn't really "smart", in that we just insert (or drop) samples.
-// Should do better...
+// Use PolyphaseResampler for playback, this is only good enough for signals that get filtered afterwards anyways.
 template<typename SampleType>
 class ResampleHelper {
 public:
@@ -84,4 +87,52 @@ private:
     SampleType m_last_sample_r {};
 };
 
+// Band-limited resampler, which interpolates with a windowed sinc filter.
+//
+// The filter is precomputed for every phase that an output sample can have between two input samples,
+// so each output sample is a single dot product over the input. If the rates don't share a large enough
+// common divisor, the phase is rounded to the nearest of a fixed number of phases instead.
+// The resampler keeps the last few input samples around, so consecutive buffers of a stream join up seamlessly.
+class PolyphaseResampler {
+public:
+    enum class Quality {
+        // 16 taps and 55 dB of stopband attenuation, passes up to about 30% of the sample rate.
+        Low,
+        // 48 taps and 80 dB of stopband attenuation, passes up to about 40% of the sample rate.
+        Medium,
+        // 128 taps and 100 dB of stopband attenuation, passes up to about 45% of the sample rate.
+        High,
+    };
+
+    static ErrorOr<PolyphaseResampler> try_create(u32 source, u32 target, Quality = Quality::Medium);
+
+    // Resamples the next buffer of the stream. Output lags the input by half the filter length;
+    // call flush() at the end of the stream to get the remaining samples.
+    ErrorOr<Vector<Sample>> resample(Span<Sample const>);
+    ErrorOr<Vector<Sample>> flush();
+    // Starts a new stream, for example after seeking.
+    void reset();
+
+    u32 source() const { return m_source; }
+    u32 target() const { return m_target; }
+
+private:
+    PolyphaseResampler(u32 source, u32 target, u32 phase_count, u32 tap_count, Vector<float> filter);
+
+    ErrorOr<void> resample_into(Vector<Sample>& output);
+
+    u32 m_source;
+    u32 m_target;
+    // The position of the next output sample relative to the start of m_input, in steps of 1/m_position_scale
+    // input samples. Each output sample advances it by m_position_step, so it is exact for any pair of rates.
+    u64 m_position { 0 };
+    u64 m_position_scale;
+    u64 m_position_step;
+    u32 m_phase_count;
+    u32 m_tap_count;
+    // m_tap_count coefficients per phase, each stored twice in a row so they line up with the channels of a Sample.
+    Vector<float> m_filter;
+    Vector<Sample> m_input;
+};
+
 }
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/SIMD.h>
+#include <AK/Types.h>
+#include <limits.h>
+
+// Vectorized string and memory routines shared by the SSE2 and AVX2 variants.
+//
+// The kernels are templated on the vector type and get instantiated once per
+// translation unit: string.cpp builds the SSE2 variants, while string_avx2.cpp
+// is compiled with -mavx2. Everything in here has to stay static so that the
+// AVX-encoded copies never get merged with the baseline ones by the linker.
+//
+// Functions that scan for a terminator only ever perform aligned loads, which
+// can never cross into an unmapped page, even if they read past the end of
+// the string.
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace LibC::SIMDString {
+
+using AK::SIMD::c8x16;
+using AK::SIMD::c8x32;
+
+ALWAYS_INLINE static u32 movemask(c8x16 v)
+{
+    return static_cast<u32>(__builtin_ia32_pmovmskb128(v));
+}
+
+#ifdef __AVX2__
+ALWAYS_INLINE static u32 movemask(c8x32 v)
+{
+    return static_cast<u32>(__builtin_ia32_pmovmskb256(v));
+}
+#endif
+
+template<typename VectorType>
+ALWAYS_INLINE static VectorType splat(char c)
+{
+    VectorType v;
+    for (size_t i = 0; i < sizeof(VectorType); ++i)
+        v[i] = c;
+    return v;
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static VectorType load_aligned(char const* ptr)
+{
+    return *static_cast<VectorType const*>(__builtin_assume_aligned(ptr, sizeof(VectorType)));
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static VectorType load_unaligned(void const* ptr)
+{
+    VectorType v;
+    __builtin_memcpy(&v, ptr, sizeof(VectorType));
+    return v;
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static char const* align_down(char const* ptr)
+{
+    return reinterpret_cast<char const*>(reinterpret_cast<FlatPtr>(ptr) & ~(sizeof(VectorType) - 1));
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static bool may_cross_page(void const* ptr)
+{
+    return (reinterpret_cast<FlatPtr>(ptr) & (PAGE_SIZE - 1)) > PAGE_SIZE - sizeof(VectorType);
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static size_t strlen(char const* str)
+{
+    auto const zero = VectorType {};
+    auto const* block = align_down<VectorType>(str);
+
+    // Discard matches that lie before the start of the string.
+    u32 mask = movemask(load_aligned<VectorType>(block) == zero) >> (str - block);
+    if (mask != 0)
+        return count_trailing_zeroes(mask);
+
+    for (;;) {
+        block += sizeof(VectorType);
+        mask = movemask(load_aligned<VectorType>(block) == zero);
+        if (mask != 0)
+            return block - str + count_trailing_zeroes(mask);
+    }
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static char* strchr(char const* str, int c)
+{
+    auto const zero = VectorType {};
+    auto const needle = splat<VectorType>(static_cast<char>(c));
+    auto const* block = align_down<VectorType>(str);
+
+    auto matches = [&](VectorType v) {
+        return movemask((v == needle) | (v == zero));
+    };
+
+    auto found = [&](char const* ptr) -> char* {
+        if (*ptr == static_cast<char>(c))
+            return const_cast<char*>(ptr);
+        return nullptr;
+    };
+
+    u32 mask = matches(load_aligned<VectorType>(block)) >> (str - block);
+    if (mask != 0)
+        return found(str + count_trailing_zeroes(mask));
+
+    for (;;) {
+        block += sizeof(VectorType);
+        mask = matches(load_aligned<VectorType>(block));
+        if (mask != 0)
+            return found(block + count_trailing_zeroes(mask));
+    }
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static void* memchr(void const* ptr, int c, size_t size)
+{
+    if (size == 0)
+        return nullptr;
+
+    auto const needle = splat<VectorType>(static_cast<char>(c));
+    auto const* str = static_cast<char const*>(ptr);
+    auto const* end = str + size;
+    auto const* block = align_down<VectorType>(str);
+
+    u32 mask = movemask(load_aligned<VectorType>(block) == needle) >> (str - block);
+    for (auto const* base = str;;) {
+        if (mask != 0) {
+            auto const* match = base + count_trailing_zeroes(mask);
+            return match < end ? const_cast<char*>(match) : nullptr;
+        }
+        block += sizeof(VectorType);
+        if (block >= end)
+            return nullptr;
+        base = block;
+        mask = movemask(load_aligned<VectorType>(block) == needle);
+    }
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static int memcmp(void const* v1, void const* v2, size_t n)
+{
+    auto const* s1 = static_cast<u8 const*>(v1);
+    auto const* s2 = static_cast<u8 const*>(v2);
+
+    auto compare_block = [](u8 const* a, u8 const* b, int& result) {
+        u32 mask = movemask(load_unaligned<VectorType>(a) != load_unaligned<VectorType>(b));
+        if (mask == 0)
+            return false;
+        auto index = count_trailing_zeroes(mask);
+        result = a[index] < b[index] ? -1 : 1;
+        return true;
+    };
+
+    if (n < sizeof(VectorType)) {
+        for (size_t i = 0; i < n; ++i) {
+            if (s1[i] != s2[i])
+                return s1[i] < s2[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    int result = 0;
+    size_t offset = 0;
+    for (; offset + sizeof(VectorType) <= n; offset += sizeof(VectorType)) {
+        if (compare_block(s1 + offset, s2 + offset, result))
+            return result;
+    }
+
+    // Compare the tail with an overlapping block that ends exactly at n.
+    if (offset != n && compare_block(s1 + n - sizeof(VectorType), s2 + n - sizeof(VectorType), result))
+        return result;
+    return 0;
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static int strcmp(char const* s1, char const* s2)
+{
+    auto const zero = VectorType {};
+
+    for (;;) {
+        // Unaligned loads are only safe if neither string could run into the next page.
+        if (may_cross_page<VectorType>(s1) || may_cross_page<VectorType>(s2)) {
+            auto c1 = *reinterpret_cast<u8 const*>(s1);
+            auto c2 = *reinterpret_cast<u8 const*>(s2);
+            if (c1 != c2 || c1 == 0)
+                return c1 - c2;
+            ++s1;
+            ++s2;
+            continue;
+        }
+
+        auto a = load_unaligned<VectorType>(s1);
+        auto b = load_unaligned<VectorType>(s2);
+        u32 mask = movemask((a != b) | (a == zero));
+        if (mask != 0) {
+            auto index = count_trailing_zeroes(mask);
+            return *reinterpret_cast<u8 const*>(s1 + index) - *reinterpret_cast<u8 const*>(s2 + index);
+        }
+        s1 += sizeof(VectorType);
+        s2 += sizeof(VectorType);
+    }
+}
+
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "simd_string.h"
+#include <AK/Types.h>
+#include <cpuid.h>
+#include <string.h>
+
+using namespace LibC;
+using AK::SIMD::c8x16;
+
+extern "C" {
+
+// SSE2 is part of the x86-64 baseline, so these variants are always available.
+size_t strlen_sse2(char const* str)
+{
+    return SIMDString::strlen<c8x16>(str);
+}
+
+char* strchr_sse2(char const* str, int c)
+{
+    return SIMDString::strchr<c8x16>(str, c);
+}
+
+void* memchr_sse2(void const* ptr, int c, size_t size)
+{
+    return SIMDString::memchr<c8x16>(ptr, c, size);
+}
+
+int memcmp_sse2(void const* v1, void const* v2, size_t n)
+{
+    return SIMDString::memcmp<c8x16>(v1, v2, n);
+}
+
+int strcmp_sse2(char const* s1, char const* s2)
+{
+    return SIMDString::strcmp<c8x16>(s1, s2);
+}
+
+extern size_t strlen_avx2(char const*);
+extern char* strchr_avx2(char const*, int);
+extern void* memchr_avx2(void const*, int, size_t);
+extern int memcmp_avx2(void const*, void const*, size_t);
+extern int strcmp_avx2(char const*, char const*);
+
+// Bits 27 and 28 of ecx in cpuid[eax = 1] indicate support for "OSXSAVE" and "AVX"
+constexpr u32 cpuid_1_ecx_bit_osxsave = 1 << 27;
+constexpr u32 cpuid_1_ecx_bit_avx = 1 << 28;
+
+// Bit 5 of ebx in cpuid[eax = 7] indicates support for "AVX2"
+constexpr u32 cpuid_7_ebx_bit_avx2 = 1 << 5;
+
+// Bits 1 and 2 of XCR0 indicate that the OS saves the SSE and AVX register state
+constexpr u64 xcr0_sse_and_avx_state = 0b110;
+
+namespace {
+bool cpu_supports_avx2()
+{
+    u32 eax, ebx, ecx, edx;
+
+    __cpuid(0, eax, ebx, ecx, edx);
+    if (eax < 7)
+        return false;
+
+    __cpuid(1, eax, ebx, ecx, edx);
+    if (!(ecx & cpuid_1_ecx_bit_osxsave) || !(ecx & cpuid_1_ecx_bit_avx))
+        return false;
+
+    // The kernel only enables the YMM state in XCR0 if it is prepared to save it across context switches.
+    u32 xcr0_low, xcr0_high;
+    asm volatile("xgetbv"
+                 : "=a"(xcr0_low), "=d"(xcr0_high)
+                 : "c"(0));
+    if ((xcr0_low & xcr0_sse_and_avx_state) != xcr0_sse_and_avx_state)
+        return false;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return ebx & cpuid_7_ebx_bit_avx2;
+}
+
+[[gnu::used]] decltype(&strlen) resolve_strlen()
+{
+    return cpu_supports_avx2() ? strlen_avx2 : strlen_sse2;
+}
+
+[[gnu::used]] decltype(&strchr) resolve_strchr()
+{
+    return cpu_supports_avx2() ? strchr_avx2 : strchr_sse2;
+}
+
+[[gnu::used]] decltype(&memchr) resolve_memchr()
+{
+    return cpu_supports_avx2() ? memchr_avx2 : memchr_sse2;
+}
+
+[[gnu::used]] decltype(&memcmp) resolve_memcmp()
+{
+    return cpu_supports_avx2() ? memcmp_avx2 : memcmp_sse2;
+}
+
+[[gnu::used]] decltype(&strcmp) resolve_strcmp()
+{
+    return cpu_supports_avx2() ? strcmp_avx2 : strcmp_sse2;
+}
+}
+
+#if !defined(AK_COMPILER_CLANG) && !defined(_DYNAMIC_LOADER)
+[[gnu::ifunc("resolve_strlen")]] size_t strlen(char const*);
+[[gnu::ifunc("resolve_strchr")]] char* strchr(char const*, int);
+[[gnu::ifunc("resolve_memchr")]] void* memchr(void const*, int, size_t);
+[[gnu::ifunc("resolve_memcmp")]] int memcmp(void const*, void const*, size_t);
+[[gnu::ifunc("resolve_strcmp")]] int strcmp(char const*, char const*);
+#else
+// DynamicLoader can't self-relocate IFUNCs, and Clang builds can't rely on them either (see memset.cpp).
+size_t strlen(char const* str)
+{
+    static decltype(&strlen) s_impl = nullptr;
+    if (s_impl == nullptr)
+        s_impl = resolve_strlen();
+
+    return s_impl(str);
+}
+
+char* strchr(char const* str, int c)
+{
+    static decltype(&strchr) s_impl = nullptr;
+    if (s_impl == nullptr)
+        s_impl = resolve_strchr();
+
+    return s_impl(str, c);
+}
+
+void* memchr(void const* ptr, int c, size_t size)
+{
+    static decltype(&memchr) s_impl = nullptr;
+    if (s_impl == nullptr)
+        s_impl = resolve_memchr();
+
+    return s_impl(ptr, c, size);
+}
+
+int memcmp(void const* v1, void const* v2, size_t n)
+{
+    static decltype(&memcmp) s_impl = nullptr;
+    if (s_impl == nullptr)
+        s_impl = resolve_memcmp();
+
+    return s_impl(v1, v2, n);
+}
+
+int strcmp(char const* s1, char const* s2)
+{
+    static decltype(&strcmp) s_impl = nullptr;
+    if (s_impl == nullptr)
+        s_impl = resolve_strcmp();
+
+    return s_impl(s1, s2);
+}
+#endif
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+// This file is compiled with -mavx2 and must only be entered through the
+// resolvers in string.cpp, which verify that the CPU and OS support AVX2.
+
+#include "simd_string.h"
+
+#ifndef __AVX2__
+#    error "string_avx2.cpp must be compiled with -mavx2"
+#endif
+
+using namespace LibC;
+using AK::SIMD::c8x32;
+
+extern "C" {
+
+size_t strlen_avx2(char const* str)
+{
+    return SIMDString::strlen<c8x32>(str);
+}
+
+char* strchr_avx2(char const* str, int c)
+{
+    return SIMDString::strchr<c8x32>(str, c);
+}
+
+void* memchr_avx2(void const* ptr, int c, size_t size)
+{
+    return SIMDString::memchr<c8x32>(ptr, c, size);
+}
+
+int memcmp_avx2(void const* v1, void const* v2, size_t n)
+{
+    return SIMDString::memcmp<c8x32>(v1, v2, n);
+}
+
+int strcmp_avx2(char const* s1, char const* s2)
+{
+    return SIMDString::strcmp<c8x32>(s1, s2);
+}
+}
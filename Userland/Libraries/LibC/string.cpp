@@ -49,6 +49,8 @@ size_t strcspn(char const* s, char const* reject)
     }
 }
 
+// For x86-64, vectorized strlen, strcmp, memcmp, strchr and memchr are found in ./arch/x86_64/string.cpp
+#if !ARCH(X86_64)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strlen.html
 size_t strlen(char const* str)
 {
@@ -57,6 +59,7 @@ size_t strlen(char const* str)
         ++len;
     return len;
 }
+#endif
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strnlen.html
 size_t strnlen(char const* str, size_t maxlen)
@@ -87,6 +90,7 @@ char* strndup(char const* str, size_t maxlen)
     return new_str;
 }
 
+#if !ARCH(X86_64)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strcmp.html
 int strcmp(char const* s1, char const* s2)
 {
@@ -95,6 +99,7 @@ int strcmp(char const* s1, char const* s2)
             return 0;
     return *(unsigned char const*)s1 - *(unsigned char const*)--s2;
 }
+#endif
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strncmp.html
 int strncmp(char const* s1, char const* s2, size_t n)
@@ -110,6 +115,7 @@ int strncmp(char const* s1, char const* s2, size_t n)
     return 0;
 }
 
+#if !ARCH(X86_64)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/memcmp.html
 int memcmp(void const* v1, void const* v2, size_t n)
 {
@@ -121,6 +127,7 @@ int memcmp(void const* v1, void const* v2, size_t n)
     }
     return 0;
 }
+#endif
 
 int timingsafe_memcmp(void const* b1, void const* b2, size_t len)
 {
@@ -236,6 +243,7 @@ size_t strlcpy(char* dest, char const* src, size_t n)
     return i;
 }
 
+#if !ARCH(X86_64)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strchr.html
 char* strchr(char const* str, int c)
 {
@@ -247,6 +255,7 @@ char* strchr(char const* str, int c)
             return nullptr;
     }
 }
+#endif
 
 // https://pubs.opengroup.org/onlinepubs/9699959399/functions/index.html
 char* index(char const* str, int c)
@@ -263,6 +272,7 @@ char* strchrnul(char const* str, int c)
     }
 }
 
+#if !ARCH(X86_64)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/memchr.html
 void* memchr(void const* ptr, int c, size_t size)
 {
@@ -274,6 +284,7 @@ void* memchr(void const* ptr, int c, size_t size)
     }
     return nullptr;
 }
+#endif
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strrchr.html
 char* strrchr(char const* str, int ch)
@@ -416,6 +416,14 @@ ssize_t pwrite(int fd, void const* buf, size_t count, off_t offset)
     return nwritten;
 }
 
+// https://man7.org/linux/man-pages/man2/copy_file_range.2.html
+ssize_t copy_file_range(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t length, unsigned flags)
+{
+    Syscall::SC_copy_file_range_params params { fd_in, offset_in, fd_out, offset_out, length, flags };
+    int rc = syscall(SC_copy_file_range, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 // Note: Be sure to send to directory_name parameter a directory name ended with trailing slash.
 static int ttyname_r_for_directory(char const* directory_name, dev_t device_mode, ino_t inode_number, char* buffer, size_t size)
 {
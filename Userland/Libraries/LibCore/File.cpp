@@ -11,6 +11,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <libgen.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -417,7 +418,25 @@ ErrorOr<void, File::CopyError> File::copy_file(String const& dst_path, struct st
             return CopyError { errno, false };
     }
 
+    bool copied_in_kernel = false;
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+    // Let the kernel copy the data, so that it doesn't have to pass through userspace.
+    // Not every file supports that, and some (like /proc files on Linux) claim to be empty,
+    // so unless anything was copied we fall back to reading and writing it ourselves.
     for (;;) {
+        ssize_t ncopied = copy_file_range(source.fd(), nullptr, dst_fd, nullptr, SSIZE_MAX, 0);
+        if (ncopied < 0) {
+            if (copied_in_kernel)
+                return CopyError { errno, false };
+            break;
+        }
+        if (ncopied == 0)
+            break;
+        copied_in_kernel = true;
+    }
+#endif
+
+    while (!copied_in_kernel) {
         char buffer[32768];
         ssize_t nread = ::read(source.fd(), buffer, sizeof(buffer));
         if (nread < 0) {
@@ -5,10 +5,10 @@
  */
 
 #include <AK/ByteBuffer.h>
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
-#include <AK/JsonValue.h>
+#include <AK/ByteReader.h>
+#include <AK/JsonPullParser.h>
 #include <LibCore/File.h>
+#include <Kernel/API/ProcessStatistics.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <pwd.h>
 
@@ -20,87 +20,304 @@ Optional<AllProcessesStatistics> ProcessStatisticsReader::get_all(RefPtr<Core::F
 {
     if (proc_all_file) {
         if (!proc_all_file->seek(0, Core::SeekMode::SetPosition)) {
-            warnln("ProcessStatisticsReader: Failed to refresh /sys/kernel/processes: {}", proc_all_file->error_string());
+            warnln("ProcessStatisticsReader: Failed to refresh {}: {}", proc_all_file->filename(), proc_all_file->error_string());
             return {};
         }
     } else {
-        proc_all_file = Core::File::construct("/sys/kernel/processes");
+        // Prefer the binary format, which is much cheaper for both the kernel and us, but fall back to JSON for kernels without it.
+        proc_all_file = Core::File::construct("/sys/kernel/processes_binary");
         if (!proc_all_file->open(Core::OpenMode::ReadOnly)) {
-            warnln("ProcessStatisticsReader: Failed to open /sys/kernel/processes: {}", proc_all_file->error_string());
-            return {};
+            proc_all_file = Core::File::construct("/sys/kernel/processes");
+            if (!proc_all_file->open(Core::OpenMode::ReadOnly)) {
+                warnln("ProcessStatisticsReader: Failed to open /sys/kernel/processes: {}", proc_all_file->error_string());
+                return {};
+            }
         }
     }
 
-    AllProcessesStatistics all_processes_statistics;
-
     auto file_contents = proc_all_file->read_all();
-    auto json = JsonValue::from_string(file_contents);
-    if (json.is_error())
-        return {};
+    if (file_contents.size() >= sizeof(u32) && ByteReader::load32(file_contents.data()) == Kernel::process_statistics_magic)
+        return from_binary(file_contents, include_usernames);
+    return from_json(file_contents, include_usernames);
+}
+
+Optional<AllProcessesStatistics> ProcessStatisticsReader::from_json(StringView json, bool include_usernames)
+{
+    AllProcessesStatistics all_processes_statistics {};
+
+    // This is read every second by some programs, so avoid building a JsonValue tree and copying every string.
+    JsonPullParser parser { json };
+
+    auto read_thread = [&](Core::ThreadStatistics& thread) {
+        return parser.read_object([&](StringView key) -> ErrorOr<void> {
+            if (key == "tid"sv)
+                thread.tid = TRY(parser.read_number<u32>());
+            else if (key == "times_scheduled"sv)
+                thread.times_scheduled = TRY(parser.read_number<u32>());
+            else if (key == "name"sv)
+                thread.name = TRY(parser.read_string());
+            else if (key == "state"sv)
+                thread.state = TRY(parser.read_string());
+            else if (key == "time_user"sv)
+                thread.time_user = TRY(parser.read_number<u64>());
+            else if (key == "time_kernel"sv)
+                thread.time_kernel = TRY(parser.read_number<u64>());
+            else if (key == "cpu"sv)
+                thread.cpu = TRY(parser.read_number<u32>());
+            else if (key == "priority"sv)
+                thread.priority = TRY(parser.read_number<u32>());
+            else if (key == "syscall_count"sv)
+                thread.syscall_count = TRY(parser.read_number<u32>());
+            else if (key == "inode_faults"sv)
+                thread.inode_faults = TRY(parser.read_number<u32>());
+            else if (key == "zero_faults"sv)
+                thread.zero_faults = TRY(parser.read_number<u32>());
+            else if (key == "cow_faults"sv)
+                thread.cow_faults = TRY(parser.read_number<u32>());
+            else if (key == "unix_socket_read_bytes"sv)
+                thread.unix_socket_read_bytes = TRY(parser.read_number<u32>());
+            else if (key == "unix_socket_write_bytes"sv)
+                thread.unix_socket_write_bytes = TRY(parser.read_number<u32>());
+            else if (key == "ipv4_socket_read_bytes"sv)
+                thread.ipv4_socket_read_bytes = TRY(parser.read_number<u32>());
+            else if (key == "ipv4_socket_write_bytes"sv)
+                thread.ipv4_socket_write_bytes = TRY(parser.read_number<u32>());
+            else if (key == "file_read_bytes"sv)
+                thread.file_read_bytes = TRY(parser.read_number<u32>());
+            else if (key == "file_write_bytes"sv)
+                thread.file_write_bytes = TRY(parser.read_number<u32>());
+            else
+                TRY(parser.skip_value());
+            return {};
+        });
+    };
+
+    auto read_threads = [&](Core::ProcessStatistics& process) {
+        return parser.read_array([&]() -> ErrorOr<void> {
+            Core::ThreadStatistics thread {};
+            TRY(read_thread(thread));
+            TRY(process.threads.try_append(move(thread)));
+            return {};
+        });
+    };
+
+    auto read_process = [&](Core::ProcessStatistics& process) {
+        return parser.read_object([&](StringView key) -> ErrorOr<void> {
+            // kernel data first
+            if (key == "pid"sv)
+                process.pid = TRY(parser.read_number<u32>());
+            else if (key == "pgid"sv)
+                process.pgid = TRY(parser.read_number<u32>());
+            else if (key == "pgp"sv)
+                process.pgp = TRY(parser.read_number<u32>());
+            else if (key == "sid"sv)
+                process.sid = TRY(parser.read_number<u32>());
+            else if (key == "uid"sv)
+                process.uid = TRY(parser.read_number<u32>());
+            else if (key == "gid"sv)
+                process.gid = TRY(parser.read_number<u32>());
+            else if (key == "ppid"sv)
+                process.ppid = TRY(parser.read_number<u32>());
+            else if (key == "nfds"sv)
+                process.nfds = TRY(parser.read_number<u32>());
+            else if (key == "kernel"sv)
+                process.kernel = TRY(parser.read_bool());
+            else if (key == "name"sv)
+                process.name = TRY(parser.read_string());
+            else if (key == "executable"sv)
+                process.executable = TRY(parser.read_string());
+            else if (key == "tty"sv)
+                process.tty = TRY(parser.read_string());
+            else if (key == "pledge"sv)
+                process.pledge = TRY(parser.read_string());
+            else if (key == "veil"sv)
+                process.veil = TRY(parser.read_string());
+            else if (key == "amount_virtual"sv)
+                process.amount_virtual = TRY(parser.read_number<u32>());
+            else if (key == "amount_resident"sv)
+                process.amount_resident = TRY(parser.read_number<u32>());
+            else if (key == "amount_shared"sv)
+                process.amount_shared = TRY(parser.read_number<u32>());
+            else if (key == "amount_dirty_private"sv)
+                process.amount_dirty_private = TRY(parser.read_number<u32>());
+            else if (key == "amount_clean_inode"sv)
+                process.amount_clean_inode = TRY(parser.read_number<u32>());
+            else if (key == "amount_purgeable_volatile"sv)
+                process.amount_purgeable_volatile = TRY(parser.read_number<u32>());
+            else if (key == "amount_purgeable_nonvolatile"sv)
+                process.amount_purgeable_nonvolatile = TRY(parser.read_number<u32>());
+            else if (key == "threads"sv)
+                TRY(read_threads(process));
+            else
+                TRY(parser.skip_value());
+            return {};
+        });
+    };
 
-    auto& json_obj = json.value().as_object();
-    json_obj.get("processes"sv).as_array().for_each([&](auto& value) {
-        const JsonObject& process_object = value.as_object();
-        Core::ProcessStatistics process;
-
-        // kernel data first
-        process.pid = process_object.get("pid"sv).to_u32();
-        process.pgid = process_object.get("pgid"sv).to_u32();
-        process.pgp = process_object.get("pgp"sv).to_u32();
-        process.sid = process_object.get("sid"sv).to_u32();
-        process.uid = process_object.get("uid"sv).to_u32();
-        process.gid = process_object.get("gid"sv).to_u32();
-        process.ppid = process_object.get("ppid"sv).to_u32();
-        process.nfds = process_object.get("nfds"sv).to_u32();
-        process.kernel = process_object.get("kernel"sv).to_bool();
-        process.name = process_object.get("name"sv).to_string();
-        process.executable = process_object.get("executable"sv).to_string();
-        process.tty = process_object.get("tty"sv).to_string();
-        process.pledge = process_object.get("pledge"sv).to_string();
-        process.veil = process_object.get("veil"sv).to_string();
-        process.amount_virtual = process_object.get("amount_virtual"sv).to_u32();
-        process.amount_resident = process_object.get("amount_resident"sv).to_u32();
-        process.amount_shared = process_object.get("amount_shared"sv).to_u32();
-        process.amount_dirty_private = process_object.get("amount_dirty_private"sv).to_u32();
-        process.amount_clean_inode = process_object.get("amount_clean_inode"sv).to_u32();
-        process.amount_purgeable_volatile = process_object.get("amount_purgeable_volatile"sv).to_u32();
-        process.amount_purgeable_nonvolatile = process_object.get("amount_purgeable_nonvolatile"sv).to_u32();
-
-        auto& thread_array = process_object.get_ptr("threads"sv)->as_array();
-        process.threads.ensure_capacity(thread_array.size());
-        thread_array.for_each([&](auto& value) {
-            auto& thread_object = value.as_object();
-            Core::ThreadStatistics thread;
-            thread.tid = thread_object.get("tid"sv).to_u32();
-            thread.times_scheduled = thread_object.get("times_scheduled"sv).to_u32();
-            thread.name = thread_object.get("name"sv).to_string();
-            thread.state = thread_object.get("state"sv).to_string();
-            thread.time_user = thread_object.get("time_user"sv).to_u64();
-            thread.time_kernel = thread_object.get("time_kernel"sv).to_u64();
-            thread.cpu = thread_object.get("cpu"sv).to_u32();
-            thread.priority = thread_object.get("priority"sv).to_u32();
-            thread.syscall_count = thread_object.get("syscall_count"sv).to_u32();
-            thread.inode_faults = thread_object.get("inode_faults"sv).to_u32();
-            thread.zero_faults = thread_object.get("zero_faults"sv).to_u32();
-            thread.cow_faults = thread_object.get("cow_faults"sv).to_u32();
-            thread.unix_socket_read_bytes = thread_object.get("unix_socket_read_bytes"sv).to_u32();
-            thread.unix_socket_write_bytes = thread_object.get("unix_socket_write_bytes"sv).to_u32();
-            thread.ipv4_socket_read_bytes = thread_object.get("ipv4_socket_read_bytes"sv).to_u32();
-            thread.ipv4_socket_write_bytes = thread_object.get("ipv4_socket_write_bytes"sv).to_u32();
-            thread.file_read_bytes = thread_object.get("file_read_bytes"sv).to_u32();
-            thread.file_write_bytes = thread_object.get("file_write_bytes"sv).to_u32();
-            process.threads.append(move(thread));
+    auto read_processes = [&] {
+        return parser.read_array([&]() -> ErrorOr<void> {
+            Core::ProcessStatistics process {};
+            TRY(read_process(process));
+            // and synthetic data last
+            if (include_usernames)
+                process.username = username_from_uid(process.uid);
+            TRY(all_processes_statistics.processes.try_append(move(process)));
+            return {};
         });
+    };
+
+    auto result = parser.read_object([&](StringView key) -> ErrorOr<void> {
+        if (key == "processes"sv)
+            TRY(read_processes());
+        else if (key == "total_time"sv)
+            all_processes_statistics.total_time_scheduled = TRY(parser.read_number<u64>());
+        else if (key == "total_time_kernel"sv)
+            all_processes_statistics.total_time_scheduled_kernel = TRY(parser.read_number<u64>());
+        else
+            TRY(parser.skip_value());
+        return {};
+    });
+    if (result.is_error())
+        return {};
+
+    return all_processes_statistics;
+}
 
-        // and synthetic data last
-        if (include_usernames) {
+// Copies the fixed-size fields of a record into a zeroed struct, so that fields added by newer kernels are ignored,
+// and fields that an older kernel doesn't have are left as zero.
+template<typename Fields>
+static Optional<Fields> read_fixed_fields(ReadonlyBytes record, size_t fixed_size)
+{
+    Fields fields {};
+    auto offset = sizeof(Kernel::ProcessStatisticsRecordHeader);
+    if (fixed_size < offset || fixed_size > record.size())
+        return {};
+    memcpy(&fields, record.offset_pointer(offset), min(sizeof(Fields), fixed_size - offset));
+    return fields;
+}
+
+Optional<AllProcessesStatistics> ProcessStatisticsReader::from_binary(ReadonlyBytes bytes, bool include_usernames)
+{
+    Kernel::ProcessStatisticsHeader header {};
+    if (bytes.size() < sizeof(header))
+        return {};
+    memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != Kernel::process_statistics_magic || header.size < sizeof(header) || header.size > bytes.size())
+        return {};
+    if (header.version != Kernel::process_statistics_version)
+        return {};
+
+    AllProcessesStatistics all_processes_statistics {};
+    all_processes_statistics.total_time_scheduled = header.total_time;
+    all_processes_statistics.total_time_scheduled_kernel = header.total_time_kernel;
+
+    auto finish_process = [&](Core::ProcessStatistics& process) {
+        if (include_usernames)
             process.username = username_from_uid(process.uid);
-        }
         all_processes_statistics.processes.append(move(process));
-    });
+    };
+
+    Optional<Core::ProcessStatistics> current_process;
+    for (auto remaining = bytes.slice(header.size); !remaining.is_empty();) {
+        Kernel::ProcessStatisticsRecordHeader record_header {};
+        if (remaining.size() < sizeof(record_header))
+            return {};
+        memcpy(&record_header, remaining.data(), sizeof(record_header));
+        if (record_header.size < sizeof(record_header) || record_header.size > remaining.size())
+            return {};
+        auto record = remaining.trim(record_header.size);
+        remaining = remaining.slice(record_header.size);
+
+        // The strings follow the fixed-size fields, in the order of their lengths.
+        auto strings = record.slice(min<size_t>(record_header.fixed_size, record.size()));
+        auto take_string = [&](size_t length) -> Optional<String> {
+            if (length > strings.size())
+                return {};
+            auto string = String { StringView { strings.trim(length) } };
+            strings = strings.slice(length);
+            return string;
+        };
+
+        switch (record_header.type) {
+        case Kernel::ProcessStatisticsRecordHeader::Type::Process: {
+            auto fields = read_fixed_fields<Kernel::ProcessStatisticsProcessRecord>(record, record_header.fixed_size);
+            if (!fields.has_value())
+                return {};
+            if (current_process.has_value())
+                finish_process(*current_process);
+
+            // kernel data first
+            Core::ProcessStatistics process {};
+            process.pid = fields->pid;
+            process.pgid = fields->pgid;
+            process.pgp = fields->pgp;
+            process.sid = fields->sid;
+            process.uid = fields->uid;
+            process.gid = fields->gid;
+            process.ppid = fields->ppid;
+            process.nfds = fields->nfds;
+            process.kernel = fields->kernel;
+            process.amount_virtual = fields->amount_virtual;
+            process.amount_resident = fields->amount_resident;
+            process.amount_shared = fields->amount_shared;
+            process.amount_dirty_private = fields->amount_dirty_private;
+            process.amount_clean_inode = fields->amount_clean_inode;
+            process.amount_purgeable_volatile = fields->amount_purgeable_volatile;
+            process.amount_purgeable_nonvolatile = fields->amount_purgeable_nonvolatile;
+            auto name = take_string(fields->name_length);
+            auto executable = take_string(fields->executable_length);
+            auto tty = take_string(fields->tty_length);
+            auto pledge = take_string(fields->pledge_length);
+            auto veil = take_string(fields->veil_length);
+            if (!name.has_value() || !executable.has_value() || !tty.has_value() || !pledge.has_value() || !veil.has_value())
+                return {};
+            process.name = name.release_value();
+            process.executable = executable.release_value();
+            process.tty = tty.release_value();
+            process.pledge = pledge.release_value();
+            process.veil = veil.release_value();
+            current_process = move(process);
+            break;
+        }
+        case Kernel::ProcessStatisticsRecordHeader::Type::Thread: {
+            auto fields = read_fixed_fields<Kernel::ProcessStatisticsThreadRecord>(record, record_header.fixed_size);
+            if (!fields.has_value() || !current_process.has_value())
+                return {};
+
+            Core::ThreadStatistics thread {};
+            thread.tid = fields->tid;
+            thread.times_scheduled = fields->times_scheduled;
+            thread.time_user = fields->time_user;
+            thread.time_kernel = fields->time_kernel;
+            thread.cpu = fields->cpu;
+            thread.priority = fields->priority;
+            thread.syscall_count = fields->syscall_count;
+            thread.inode_faults = fields->inode_faults;
+            thread.zero_faults = fields->zero_faults;
+            thread.cow_faults = fields->cow_faults;
+            thread.unix_socket_read_bytes = fields->unix_socket_read_bytes;
+            thread.unix_socket_write_bytes = fields->unix_socket_write_bytes;
+            thread.ipv4_socket_read_bytes = fields->ipv4_socket_read_bytes;
+            thread.ipv4_socket_write_bytes = fields->ipv4_socket_write_bytes;
+            thread.file_read_bytes = fields->file_read_bytes;
+            thread.file_write_bytes = fields->file_write_bytes;
+            auto name = take_string(fields->name_length);
+            auto state = take_string(fields->state_length);
+            if (!name.has_value() || !state.has_value())
+                return {};
+            thread.name = name.release_value();
+            thread.state = state.release_value();
+            current_process->threads.append(move(thread));
+            break;
+        }
+        default:
+            // Records from newer kernels that we don't know about.
+            break;
+        }
+    }
+    if (current_process.has_value())
+        finish_process(*current_process);
 
-    all_processes_statistics.total_time_scheduled = json_obj.get("total_time"sv).to_u64();
-    all_processes_statistics.total_time_scheduled_kernel = json_obj.get("total_time_kernel"sv).to_u64();
     return all_processes_statistics;
 }
 
@@ -34,7 +34,7 @@ struct ThreadStatistics {
 };
 
 struct ProcessStatistics {
-    // Keep this in sync with /sys/kernel/processes.
+    // Keep this in sync with /sys/kernel/processes and Kernel/API/ProcessStatistics.h.
     // From the kernel side:
     pid_t pid;
     pid_t pgid;
@@ -75,6 +75,10 @@ public:
     static Optional<AllProcessesStatistics> get_all(RefPtr<Core::File>&, bool include_usernames = true);
     static Optional<AllProcessesStatistics> get_all(bool include_usernames = true);
 
+    // Parse the contents of /sys/kernel/processes and /sys/kernel/processes_binary respectively.
+    static Optional<AllProcessesStatistics> from_json(StringView, bool include_usernames = true);
+    static Optional<AllProcessesStatistics> from_binary(ReadonlyBytes, bool include_usernames = true);
+
 private:
     static String username_from_uid(uid_t);
     static HashMap<uid_t, String> s_usernames;
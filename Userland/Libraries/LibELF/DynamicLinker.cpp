@@ -83,6 +83,18 @@ Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(
     return weak_result;
 }
 
+// Most symbols are looked up over and over again while linking, once for every object that refers to them.
+// With the cache, each symbol name is only looked up in all the global objects once.
+Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(StringView name, GlobalSymbolCache& cache)
+{
+    if (auto cached_result = cache.get(name); cached_result.has_value())
+        return cached_result.release_value();
+
+    auto result = lookup_global_symbol(name);
+    cache.set(name, result);
+    return result;
+}
+
 static Result<NonnullRefPtr<DynamicLoader>, DlErrorMessage> map_library(String const& filepath, int fd)
 {
     VERIFY(filepath.starts_with('/'));
@@ -373,12 +385,16 @@ static Result<void, DlErrorMessage> link_main_library(String const& path, int fl
             s_global_objects.set(dynamic_object->filepath(), *dynamic_object);
     }
 
+    // No objects are added to the global objects while linking, so lookup results can't change.
+    // Only the relocations done by link() use the cache, lazy PLT fixups may happen on other threads at any time.
+    GlobalSymbolCache global_symbol_cache;
     for (auto& loader : loaders) {
-        bool success = loader.link(flags);
+        bool success = loader.link(flags, global_symbol_cache);
         if (!success) {
             return DlErrorMessage { String::formatted("Failed to link library {}", loader.filepath()) };
         }
     }
+    dbgln_if(DYNAMIC_LOAD_DEBUG, "Cached {} global symbol lookups", global_symbol_cache.size());
 
     for (auto& loader : loaders) {
         auto result = loader.load_stage_3(flags);
@@ -6,15 +6,20 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/Result.h>
 #include <AK/Vector.h>
 #include <LibELF/DynamicObject.h>
 
 namespace ELF {
 
+// Remembers global symbol lookups while a set of libraries is linked, keyed by names that point into the string tables of the mapped objects.
+using GlobalSymbolCache = HashMap<StringView, Optional<DynamicObject::SymbolLookupResult>>;
+
 class DynamicLinker {
 public:
     static Optional<DynamicObject::SymbolLookupResult> lookup_global_symbol(StringView symbol);
+    static Optional<DynamicObject::SymbolLookupResult> lookup_global_symbol(StringView symbol, GlobalSymbolCache&);
     [[noreturn]] static void linker_main(String&& main_program_path, int fd, bool is_secure, int argc, char** argv, char** envp);
 
 private:
@@ -11,6 +11,7 @@
 #include <AK/Optional.h>
 #include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
+#include <AK/TemporaryChange.h>
 #include <LibELF/DynamicLinker.h>
 #include <LibELF/DynamicLoader.h>
 #include <LibELF/Hashes.h>
@@ -157,8 +158,9 @@ RefPtr<DynamicObject> DynamicLoader::map()
     return m_dynamic_object;
 }
 
-bool DynamicLoader::link(unsigned flags)
+bool DynamicLoader::link(unsigned flags, GlobalSymbolCache& global_symbol_cache)
 {
+    TemporaryChange global_symbol_cache_change { m_global_symbol_cache, &global_symbol_cache };
     return load_stage_2(flags);
 }
 
@@ -492,7 +494,7 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
     case R_X86_64_64: {
 #endif
         auto symbol = relocation.symbol();
-        auto res = lookup_symbol(symbol);
+        auto res = lookup_symbol_for_relocation(symbol);
         if (!res.has_value()) {
             if (symbol.bind() == STB_WEAK)
                 return RelocationResult::ResolveLater;
@@ -511,7 +513,7 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
 #if ARCH(I386)
     case R_386_PC32: {
         auto symbol = relocation.symbol();
-        auto result = lookup_symbol(symbol);
+        auto result = lookup_symbol_for_relocation(symbol);
         if (!result.has_value())
             return RelocationResult::Failed;
         auto relative_offset = result.value().address - m_dynamic_object->base_address().offset(relocation.offset());
@@ -523,7 +525,7 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
     case R_X86_64_GLOB_DAT: {
 #endif
         auto symbol = relocation.symbol();
-        auto res = lookup_symbol(symbol);
+        auto res = lookup_symbol_for_relocation(symbol);
         VirtualAddress symbol_location;
         if (!res.has_value()) {
             if (symbol.bind() == STB_WEAK) {
@@ -575,7 +577,7 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
         FlatPtr symbol_value;
         DynamicObject const* dynamic_object_of_symbol;
         if (relocation.symbol_index() != 0) {
-            auto res = lookup_symbol(symbol);
+            auto res = lookup_symbol_for_relocation(symbol);
             if (!res.has_value())
                 break;
             VERIFY(symbol.type() != STT_GNU_IFUNC);
@@ -726,4 +728,12 @@ Optional<DynamicObject::SymbolLookupResult> DynamicLoader::lookup_symbol(const E
     return DynamicObject::SymbolLookupResult { symbol.value(), symbol.size(), symbol.address(), symbol.bind(), symbol.type(), &symbol.object() };
 }
 
+Optional<DynamicObject::SymbolLookupResult> DynamicLoader::lookup_symbol_for_relocation(const ELF::DynamicObject::Symbol& symbol)
+{
+    if (!m_global_symbol_cache || !(symbol.is_undefined() || symbol.bind() == STB_WEAK))
+        return lookup_symbol(symbol);
+
+    return DynamicLinker::lookup_global_symbol(symbol.name(), *m_global_symbol_cache);
+}
+
 } // end namespace ELF
@@ -12,6 +12,7 @@
 #include <AK/RefCounted.h>
 #include <AK/String.h>
 #include <LibC/elf.h>
+#include <LibELF/DynamicLinker.h>
 #include <LibELF/DynamicObject.h>
 #include <LibELF/Image.h>
 #include <bits/dlfcn_integration.h>
@@ -54,7 +55,8 @@ public:
     // Note that the DynamicObject will not be linked yet. Callers are responsible for calling link() to finish it.
     RefPtr<DynamicObject> map();
 
-    bool link(unsigned flags);
+    // Global symbol lookups done by the relocations are remembered in the given cache.
+    bool link(unsigned flags, GlobalSymbolCache&);
 
     // Stage 2 of loading: dynamic object loading and primary relocations
     bool load_stage_2(unsigned flags);
@@ -134,6 +136,7 @@ private:
         ResolveLater = 2,
     };
     RelocationResult do_relocation(DynamicObject::Relocation const&, ShouldInitializeWeak should_initialize_weak);
+    Optional<DynamicObject::SymbolLookupResult> lookup_symbol_for_relocation(const ELF::DynamicObject::Symbol&);
     void do_relr_relocations();
     void find_tls_size_and_alignment();
 
@@ -160,6 +163,9 @@ private:
 
     Vector<DynamicObject::Relocation> m_unresolved_relocations;
 
+    // Only set while link() does the main relocations.
+    GlobalSymbolCache* m_global_symbol_cache { nullptr };
+
     mutable RefPtr<DynamicObject> m_cached_dynamic_object;
 
     bool m_fully_relocated { false };
@@ -9,11 +9,11 @@
 #    pragma GCC optimize("O3")
 #endif
 
-#include "FillPathImplementation.h"
 #include <AK/Function.h>
 #include <AK/NumericLimits.h>
 #include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Path.h>
+#include <LibGfx/PathRasterizer.h>
 
 namespace Gfx {
 
@@ -174,47 +174,24 @@ void AntiAliasingPainter::draw_line(FloatPoint const& actual_from, FloatPoint co
     draw_anti_aliased_line<AntiAliasPolicy::Full>(actual_from, actual_to, color, thickness, style, alternate_color);
 }
 
+AffineTransform AntiAliasingPainter::transform_to_physical() const
+{
+    auto scale = m_underlying_painter.scale();
+    return AffineTransform().scale(scale, scale).translate(m_underlying_painter.translation().to_type<float>()).multiply(m_transform);
+}
+
 void AntiAliasingPainter::fill_path(Path& path, Color color, Painter::WindingRule rule)
 {
-    Detail::fill_path<Detail::FillPathMode::AllowFloatingPoints>(*this, path, color, rule);
+    PathRasterizer rasterizer(m_underlying_painter.clip_rect() * m_underlying_painter.scale());
+    rasterizer.add_path(path, transform_to_physical());
+    rasterizer.fill(*m_underlying_painter.target(), color, rule);
 }
 
 void AntiAliasingPainter::stroke_path(Path const& path, Color color, float thickness)
 {
-    FloatPoint cursor;
-
-    for (auto& segment : path.segments()) {
-        switch (segment.type()) {
-        case Segment::Type::Invalid:
-            VERIFY_NOT_REACHED();
-        case Segment::Type::MoveTo:
-            cursor = segment.point();
-            break;
-        case Segment::Type::LineTo:
-            draw_line(cursor, segment.point(), color, thickness);
-            cursor = segment.point();
-            break;
-        case Segment::Type::QuadraticBezierCurveTo: {
-            auto& through = static_cast<QuadraticBezierCurveSegment const&>(segment).through();
-            draw_quadratic_bezier_curve(through, cursor, segment.point(), color, thickness);
-            cursor = segment.point();
-            break;
-        }
-        case Segment::Type::CubicBezierCurveTo: {
-            auto& curve = static_cast<CubicBezierCurveSegment const&>(segment);
-            auto& through_0 = curve.through_0();
-            auto& through_1 = curve.through_1();
-            draw_cubic_bezier_curve(through_0, through_1, cursor, segment.point(), color, thickness);
-            cursor = segment.point();
-            break;
-        }
-        case Segment::Type::EllipticalArcTo:
-            auto& arc = static_cast<EllipticalArcSegment const&>(segment);
-            draw_elliptical_arc(cursor, segment.point(), arc.center(), arc.radii(), arc.x_axis_rotation(), arc.theta_1(), arc.theta_delta(), color, thickness);
-            cursor = segment.point();
-            break;
-        }
-    }
+    PathRasterizer rasterizer(m_underlying_painter.clip_rect() * m_underlying_painter.scale());
+    rasterizer.add_stroke(path, thickness * m_underlying_painter.scale(), transform_to_physical());
+    rasterizer.fill(*m_underlying_painter.target(), color, Painter::WindingRule::Nonzero);
 }
 
 void AntiAliasingPainter::draw_elliptical_arc(FloatPoint const& p1, FloatPoint const& p2, FloatPoint const& center, FloatPoint const& radii, float x_axis_rotation, float theta_1, float theta_delta, Color color, float thickness, Painter::LineStyle style)
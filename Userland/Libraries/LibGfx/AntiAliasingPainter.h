@@ -75,6 +75,8 @@ private:
 
     void draw_dotted_line(IntPoint, IntPoint, Gfx::Color, int thickness);
 
+    AffineTransform transform_to_physical() const;
+
     enum class AntiAliasPolicy {
         OnlyEnds,
         Full,
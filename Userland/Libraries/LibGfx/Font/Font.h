@@ -14,6 +14,7 @@
 #include <AK/Types.h>
 #include <LibCore/MappedFile.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/GlyphAtlas.h>
 #include <LibGfx/Size.h>
 
 namespace Gfx {
@@ -125,6 +126,10 @@ public:
     virtual Glyph glyph(u32 code_point) const = 0;
     virtual bool contains_glyph(u32 code_point) const = 0;
 
+    // Fonts that rasterize their glyphs on demand keep them in a glyph atlas. This returns the glyph for code_point,
+    // rasterized for the fractional part of x, or nothing if the glyph can't be drawn from an atlas.
+    virtual Optional<GlyphAtlas::Glyph> atlas_glyph(u32, float) const { return {}; }
+
     virtual u8 glyph_width(u32 code_point) const = 0;
     virtual int glyph_or_emoji_width(u32 code_point) const = 0;
     virtual float glyphs_horizontal_kerning(u32 left_code_point, u32 right_code_point) const = 0;
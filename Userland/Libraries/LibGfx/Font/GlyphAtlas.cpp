@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/OwnPtr.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/GlyphAtlas.h>
+#include <math.h>
+
+namespace Gfx {
+
+u8 GlyphAtlas::subpixel_variant_for(float x)
+{
+    auto fraction = x - floorf(x);
+    return min(static_cast<u8>(fraction * subpixel_variant_count), static_cast<u8>(subpixel_variant_count - 1));
+}
+
+GlyphAtlas::Glyph GlyphAtlas::glyph_for_entry(Entry const& entry)
+{
+    auto& page = m_pages[entry.page_index];
+    page.last_used = ++m_clock;
+    return Glyph {
+        .coverage = &page.coverage[entry.y * page_size + entry.x],
+        .pitch = page_size,
+        .size = { entry.width, entry.height },
+        .left_bearing = entry.left_bearing,
+    };
+}
+
+Optional<GlyphAtlas::Glyph> GlyphAtlas::find(u32 glyph_id, u8 subpixel_variant)
+{
+    auto it = m_entries.find(key_for(glyph_id, subpixel_variant));
+    if (it == m_entries.end())
+        return {};
+    return glyph_for_entry(it->value);
+}
+
+bool GlyphAtlas::allocate_in_page(Page& page, IntSize const& size, int& x, int& y)
+{
+    // Glyphs are packed left to right into shelves, which are as tall as the tallest glyph on them.
+    int shelf_x = page.shelf_x;
+    int shelf_y = page.shelf_y;
+    int shelf_height = page.shelf_height;
+    if (shelf_x + size.width() > page_size) {
+        shelf_y += shelf_height;
+        shelf_x = 0;
+        shelf_height = 0;
+    }
+    if (shelf_y + size.height() > page_size)
+        return false;
+
+    x = shelf_x;
+    y = shelf_y;
+    page.shelf_x = shelf_x + size.width();
+    page.shelf_y = shelf_y;
+    page.shelf_height = max(shelf_height, size.height());
+    return true;
+}
+
+Optional<size_t> GlyphAtlas::page_with_room_for(IntSize const& size, int& x, int& y)
+{
+    for (size_t i = m_pages.size(); i > 0; --i) {
+        if (allocate_in_page(m_pages[i - 1], size, x, y))
+            return i - 1;
+    }
+
+    if (m_pages.size() < max_page_count) {
+        auto page = try_make<Page>();
+        if (page.is_error())
+            return {};
+        m_pages.append(page.release_value());
+        if (allocate_in_page(m_pages.last(), size, x, y))
+            return m_pages.size() - 1;
+        return {};
+    }
+
+    // All pages are full, so throw away everything on the page that was used least recently.
+    size_t least_recently_used_index = 0;
+    for (size_t i = 1; i < m_pages.size(); ++i) {
+        if (m_pages[i].last_used < m_pages[least_recently_used_index].last_used)
+            least_recently_used_index = i;
+    }
+
+    auto& page = m_pages[least_recently_used_index];
+    for (auto key : page.keys)
+        m_entries.remove(key);
+    page.keys.clear_with_capacity();
+    page.shelf_x = 0;
+    page.shelf_y = 0;
+    page.shelf_height = 0;
+
+    if (allocate_in_page(page, size, x, y))
+        return least_recently_used_index;
+    return {};
+}
+
+Optional<GlyphAtlas::Glyph> GlyphAtlas::insert(u32 glyph_id, u8 subpixel_variant, Bitmap const& glyph_bitmap, int left_bearing)
+{
+    auto size = glyph_bitmap.size();
+    if (size.is_empty() || size.width() > page_size || size.height() > page_size)
+        return {};
+
+    int x = 0;
+    int y = 0;
+    auto page_index = page_with_room_for(size, x, y);
+    if (!page_index.has_value())
+        return {};
+
+    auto& page = m_pages[*page_index];
+    for (int row = 0; row < size.height(); ++row) {
+        auto const* source = glyph_bitmap.scanline(row);
+        auto* destination = &page.coverage[(y + row) * page_size + x];
+        for (int column = 0; column < size.width(); ++column)
+            destination[column] = Color::from_argb(source[column]).alpha();
+    }
+
+    auto key = key_for(glyph_id, subpixel_variant);
+    page.keys.append(key);
+
+    Entry entry {
+        .page_index = static_cast<u16>(*page_index),
+        .x = static_cast<u16>(x),
+        .y = static_cast<u16>(y),
+        .width = static_cast<u16>(size.width()),
+        .height = static_cast<u16>(size.height()),
+        .left_bearing = left_bearing,
+    };
+    m_entries.set(key, entry);
+    return glyph_for_entry(entry);
+}
+
+}
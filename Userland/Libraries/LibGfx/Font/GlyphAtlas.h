@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/Optional.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Size.h>
+
+namespace Gfx {
+
+// Stores the rasterized glyphs of a font as 8-bit coverage masks, packed into a handful of fixed-size pages.
+// Compared to keeping a separate bitmap per glyph, this keeps the glyphs of a run close together in memory,
+// and bounds how much memory a font can use for its glyphs. When all pages are full, the page that was
+// used least recently is cleared to make room.
+//
+// Every glyph can be stored in several variants, one per horizontal subpixel offset it was rasterized at.
+class GlyphAtlas {
+    AK_MAKE_NONCOPYABLE(GlyphAtlas);
+    AK_MAKE_NONMOVABLE(GlyphAtlas);
+
+public:
+    static constexpr int page_size = 256;
+    static constexpr size_t max_page_count = 16;
+    static constexpr u8 subpixel_variant_count = 4;
+
+    struct Glyph {
+        // The coverage of the top left pixel. Rows are pitch bytes apart.
+        u8 const* coverage { nullptr };
+        size_t pitch { 0 };
+        IntSize size;
+        int left_bearing { 0 };
+    };
+
+    GlyphAtlas() = default;
+
+    static u8 subpixel_variant_for(float x);
+    static float subpixel_offset_for(u8 subpixel_variant) { return static_cast<float>(subpixel_variant) / subpixel_variant_count; }
+
+    // NOTE: The returned coverage is only valid until the next call to insert().
+    Optional<Glyph> find(u32 glyph_id, u8 subpixel_variant);
+    Optional<Glyph> insert(u32 glyph_id, u8 subpixel_variant, Bitmap const& glyph_bitmap, int left_bearing);
+
+    size_t page_count() const { return m_pages.size(); }
+
+private:
+    struct Page {
+        u8 coverage[page_size * page_size] {};
+        int shelf_x { 0 };
+        int shelf_y { 0 };
+        int shelf_height { 0 };
+        u64 last_used { 0 };
+        Vector<u64> keys;
+    };
+
+    struct Entry {
+        u16 page_index { 0 };
+        u16 x { 0 };
+        u16 y { 0 };
+        u16 width { 0 };
+        u16 height { 0 };
+        int left_bearing { 0 };
+    };
+
+    static u64 key_for(u32 glyph_id, u8 subpixel_variant) { return (static_cast<u64>(glyph_id) << 8) | subpixel_variant; }
+    static bool allocate_in_page(Page&, IntSize const&, int& x, int& y);
+
+    Glyph glyph_for_entry(Entry const&);
+    Optional<size_t> page_with_room_for(IntSize const&, int& x, int& y);
+
+    HashMap<u64, Entry> m_entries;
+    NonnullOwnPtrVector<Page> m_pages;
+    u64 m_clock { 0 };
+};
+
+}
@@ -44,11 +44,35 @@ RefPtr<Gfx::Bitmap> ScaledFont::rasterize_glyph(u32 glyph_id) const
     if (glyph_iterator != m_cached_glyph_bitmaps.end())
         return glyph_iterator->value;
 
-    auto glyph_bitmap = m_font->rasterize_glyph(glyph_id, m_x_scale, m_y_scale);
+    auto glyph_bitmap = m_font->rasterize_glyph(glyph_id, m_x_scale, m_y_scale, 0);
     m_cached_glyph_bitmaps.set(glyph_id, glyph_bitmap);
     return glyph_bitmap;
 }
 
+Optional<GlyphAtlas::Glyph> ScaledFont::atlas_glyph(u32 code_point, float x) const
+{
+    auto glyph_id = glyph_id_for_code_point(code_point);
+    auto subpixel_variant = GlyphAtlas::subpixel_variant_for(x);
+    if (auto glyph = m_glyph_atlas.find(glyph_id, subpixel_variant); glyph.has_value())
+        return glyph;
+
+    // Glyphs that didn't fit into the atlas before are drawn from their cached bitmap instead.
+    if (m_cached_glyph_bitmaps.contains(glyph_id))
+        return {};
+
+    auto glyph_bitmap = m_font->rasterize_glyph(glyph_id, m_x_scale, m_y_scale, GlyphAtlas::subpixel_offset_for(subpixel_variant));
+    if (!glyph_bitmap)
+        return {};
+    auto glyph = m_glyph_atlas.insert(glyph_id, subpixel_variant, *glyph_bitmap, glyph_metrics(glyph_id).left_side_bearing);
+    if (!glyph.has_value()) {
+        if (subpixel_variant == 0)
+            m_cached_glyph_bitmaps.set(glyph_id, move(glyph_bitmap));
+        else
+            (void)rasterize_glyph(glyph_id);
+    }
+    return glyph;
+}
+
 Gfx::Glyph ScaledFont::glyph(u32 code_point) const
 {
     auto id = glyph_id_for_code_point(code_point);
@@ -9,6 +9,7 @@
 #include <AK/HashMap.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/Font.h>
+#include <LibGfx/Font/GlyphAtlas.h>
 #include <LibGfx/Font/VectorFont.h>
 
 #define POINTS_PER_INCH 72.0f
@@ -31,6 +32,7 @@ public:
     ScaledFontMetrics metrics() const { return m_font->metrics(m_x_scale, m_y_scale); }
     ScaledGlyphMetrics glyph_metrics(u32 glyph_id) const { return m_font->glyph_metrics(glyph_id, m_x_scale, m_y_scale); }
     RefPtr<Gfx::Bitmap> rasterize_glyph(u32 glyph_id) const;
+    GlyphAtlas const& glyph_atlas() const { return m_glyph_atlas; }
 
     // ^Gfx::Font
     virtual NonnullRefPtr<Font> clone() const override { return *this; } // FIXME: clone() should not need to be implemented
@@ -42,6 +44,7 @@ public:
     virtual u16 weight() const override { return m_font->weight(); }
     virtual Gfx::Glyph glyph(u32 code_point) const override;
     virtual bool contains_glyph(u32 code_point) const override { return m_font->glyph_id_for_code_point(code_point) > 0; }
+    virtual Optional<GlyphAtlas::Glyph> atlas_glyph(u32 code_point, float x) const override;
     virtual u8 glyph_width(u32 code_point) const override;
     virtual int glyph_or_emoji_width(u32 code_point) const override;
     virtual float glyphs_horizontal_kerning(u32 left_code_point, u32 right_code_point) const override;
@@ -71,6 +74,8 @@ private:
     float m_y_scale { 0.0f };
     float m_point_width { 0.0f };
     float m_point_height { 0.0f };
+    mutable GlyphAtlas m_glyph_atlas;
+    // Glyphs that don't fit into the atlas, rasterized without a subpixel offset.
     mutable HashMap<u32, RefPtr<Gfx::Bitmap>> m_cached_glyph_bitmaps;
 
     template<typename T>
@@ -47,14 +47,32 @@ void Typeface::add_bitmap_font(RefPtr<BitmapFont> font)
 void Typeface::set_vector_font(RefPtr<VectorFont> font)
 {
     m_vector_font = move(font);
+    m_scaled_fonts.clear();
 }
 
 RefPtr<Font> Typeface::get_font(float point_size, Font::AllowInexactSizeMatch allow_inexact_size_match) const
 {
     VERIFY(point_size > 0);
 
-    if (m_vector_font)
-        return adopt_ref(*new Gfx::ScaledFont(*m_vector_font, point_size, point_size));
+    if (m_vector_font) {
+        if (auto it = m_scaled_fonts.find(point_size); it != m_scaled_fonts.end()) {
+            it->value.last_use = ++m_scaled_font_use_counter;
+            return it->value.font;
+        }
+
+        if (m_scaled_fonts.size() >= max_cached_scaled_fonts) {
+            auto least_recently_used = m_scaled_fonts.begin();
+            for (auto it = m_scaled_fonts.begin(); it != m_scaled_fonts.end(); ++it) {
+                if (it->value.last_use < least_recently_used->value.last_use)
+                    least_recently_used = it;
+            }
+            m_scaled_fonts.remove(least_recently_used);
+        }
+
+        auto font = adopt_ref(*new Gfx::ScaledFont(*m_vector_font, point_size, point_size));
+        m_scaled_fonts.set(point_size, { font, ++m_scaled_font_use_counter });
+        return font;
+    }
 
     RefPtr<BitmapFont> best_match;
     int size = roundf(point_size);
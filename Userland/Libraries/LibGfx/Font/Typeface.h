@@ -8,6 +8,7 @@
 
 #include <AK/FlyString.h>
 #include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <AK/RefCounted.h>
 #include <AK/Vector.h>
 #include <LibGfx/Font/BitmapFont.h>
@@ -44,6 +45,16 @@ private:
 
     Vector<RefPtr<BitmapFont>> m_bitmap_fonts;
     RefPtr<VectorFont> m_vector_font;
+
+    // Every size of the vector font is only instantiated once, so that everyone using it shares its glyph atlas.
+    // Since each of them can hold on to a sizeable atlas, only the most recently used sizes are kept around.
+    static constexpr size_t max_cached_scaled_fonts = 16;
+    struct CachedScaledFont {
+        NonnullRefPtr<Font> font;
+        u64 last_use { 0 };
+    };
+    mutable HashMap<float, CachedScaledFont> m_scaled_fonts;
+    mutable u64 m_scaled_font_use_counter { 0 };
 };
 
 }
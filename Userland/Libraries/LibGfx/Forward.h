@@ -17,6 +17,7 @@ class DisjointRectSet;
 
 class Emoji;
 class Font;
+class GlyphAtlas;
 class GlyphBitmap;
 class ImageDecoder;
 struct FontPixelMetrics;
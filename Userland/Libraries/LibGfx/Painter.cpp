@@ -16,7 +16,9 @@
 #include "Font/Font.h"
 #include "Font/FontDatabase.h"
 #include "Gamma.h"
+#include "PixelBlending.h"
 #include <AK/Assertions.h>
+#include <AK/BitCast.h>
 #include <AK/Debug.h>
 #include <AK/Function.h>
 #include <AK/Math.h>
@@ -28,9 +30,9 @@
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
 #include <LibGfx/CharacterBitmap.h>
-#include <LibGfx/FillPathImplementation.h>
 #include <LibGfx/Palette.h>
 #include <LibGfx/Path.h>
+#include <LibGfx/PathRasterizer.h>
 #include <LibGfx/Quad.h>
 #include <LibGfx/TextDirection.h>
 #include <LibGfx/TextLayout.h>
@@ -121,6 +123,14 @@ void Painter::fill_physical_rect(IntRect const& physical_rect, Color color)
     ARGB32* dst = m_target->scanline(physical_rect.top()) + physical_rect.left();
     size_t const dst_skip = m_target->pitch() / sizeof(ARGB32);
 
+    if (!m_target->has_alpha_channel()) {
+        for (int i = physical_rect.height() - 1; i >= 0; --i) {
+            fill_row_onto_opaque(dst, physical_rect.width(), color);
+            dst += dst_skip;
+        }
+        return;
+    }
+
     for (int i = physical_rect.height() - 1; i >= 0; --i) {
         for (int j = 0; j < physical_rect.width(); ++j)
             dst[j] = Color::from_argb(dst[j]).blend(color).value();
@@ -816,10 +826,28 @@ static void swap_red_and_blue_channels(Color& color)
     color = Color::from_argb(bgra);
 }
 
-// FIXME: This function is very unoptimized.
+template<bool source_has_alpha, bool source_is_rgba>
+static void do_blit_with_opacity_onto_opaque(BlitState& state)
+{
+    u8 opacity = static_cast<u8>(clamp(state.opacity, 0.0f, 1.0f) * 255);
+    for (int row = 0; row < state.row_count; ++row) {
+        blend_row_onto_opaque<source_has_alpha, source_is_rgba>(state.dst, state.src, state.column_count, opacity);
+        state.dst += state.dst_pitch;
+        state.src += state.src_pitch;
+    }
+}
+
 template<BlitState::AlphaState has_alpha>
 static void do_blit_with_opacity(BlitState& state)
 {
+    if constexpr (!(has_alpha & BlitState::DstAlpha)) {
+        constexpr bool source_has_alpha = has_alpha & BlitState::SrcAlpha;
+        if (state.src_format == BitmapFormat::RGBA8888)
+            return do_blit_with_opacity_onto_opaque<source_has_alpha, true>(state);
+        return do_blit_with_opacity_onto_opaque<source_has_alpha, false>(state);
+    }
+
+    // FIXME: Blending onto a destination with an alpha channel is still done one Color at a time.
     for (int row = 0; row < state.row_count; ++row) {
         for (int x = 0; x < state.column_count; ++x) {
             Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_argb(state.dst[x]) : Color::from_rgb(state.dst[x]);
@@ -1130,6 +1158,24 @@ ALWAYS_INLINE static void do_draw_integer_scaled_bitmap(Gfx::Bitmap& target, Int
     }
 }
 
+ALWAYS_INLINE static Color bilinear_interpolate(Color top_left, Color top_right, Color bottom_left, Color bottom_right, float x_ratio, float y_ratio)
+{
+#ifdef __SSE__
+    // Interpolate all four channels at once.
+    using AK::SIMD::f32x4;
+    using AK::SIMD::u8x4;
+    auto to_f32x4 = [](Color color) { return __builtin_convertvector(bit_cast<u8x4>(color.value()), f32x4); };
+    auto top = to_f32x4(top_left) + (to_f32x4(top_right) - to_f32x4(top_left)) * x_ratio;
+    auto bottom = to_f32x4(bottom_left) + (to_f32x4(bottom_right) - to_f32x4(bottom_left)) * x_ratio;
+    auto result = top + (bottom - top) * y_ratio + 0.5f;
+    return Color::from_argb(bit_cast<u32>(__builtin_convertvector(result, u8x4)));
+#else
+    auto top = top_left.interpolate(top_right, x_ratio);
+    auto bottom = bottom_left.interpolate(bottom_right, x_ratio);
+    return top.interpolate(bottom, y_ratio);
+#endif
+}
+
 template<bool has_alpha_channel, Painter::ScalingMode scaling_mode, typename GetPixel>
 ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect const& dst_rect, IntRect const& clipped_rect, Gfx::Bitmap const& source, FloatRect const& src_rect, GetPixel get_pixel, float opacity)
 {
@@ -1164,6 +1210,12 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
     i64 clipped_src_bottom_shifted = (clipped_src_rect.y() + clipped_src_rect.height()) * shift;
     i64 clipped_src_right_shifted = (clipped_src_rect.x() + clipped_src_rect.width()) * shift;
 
+    // When blending onto an opaque target, we sample a whole row first and then blend it in one go.
+    bool const blend_rows_onto_opaque_target = has_alpha_channel && !target.has_alpha_channel();
+    Vector<ARGB32> row;
+    if (blend_rows_onto_opaque_target)
+        row.resize(clipped_rect.width());
+
     for (int y = clipped_rect.top(); y <= clipped_rect.bottom(); ++y) {
         auto* scanline = (Color*)target.scanline(y);
         auto desired_y = ((y - dst_rect.y()) * vscale + src_top);
@@ -1172,8 +1224,11 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
 
         for (int x = clipped_rect.left(); x <= clipped_rect.right(); ++x) {
             auto desired_x = ((x - dst_rect.x()) * hscale + src_left);
-            if (desired_x < clipped_src_rect.left() || desired_x > clipped_src_right_shifted)
+            if (desired_x < clipped_src_rect.left() || desired_x > clipped_src_right_shifted) {
+                if (blend_rows_onto_opaque_target)
+                    row[x - clipped_rect.left()] = Color(Color::Transparent).value();
                 continue;
+            }
 
             Color src_pixel;
             if constexpr (scaling_mode == Painter::ScalingMode::BilinearBlend) {
@@ -1193,10 +1248,7 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
                 auto bottom_left = get_pixel(source, scaled_x0, scaled_y1);
                 auto bottom_right = get_pixel(source, scaled_x1, scaled_y1);
 
-                auto top = top_left.interpolate(top_right, x_ratio);
-                auto bottom = bottom_left.interpolate(bottom_right, x_ratio);
-
-                src_pixel = top.interpolate(bottom, y_ratio);
+                src_pixel = bilinear_interpolate(top_left, top_right, bottom_left, bottom_right, x_ratio, y_ratio);
             } else if constexpr (scaling_mode == Painter::ScalingMode::SmoothPixels) {
                 auto scaled_x1 = clamp(desired_x >> 32, clipped_src_rect.left(), clipped_src_rect.right());
                 auto scaled_x0 = clamp(scaled_x1 - 1, clipped_src_rect.left(), clipped_src_rect.right());
@@ -1224,6 +1276,11 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
                 src_pixel = get_pixel(source, scaled_x, scaled_y);
             }
 
+            if (blend_rows_onto_opaque_target) {
+                row[x - clipped_rect.left()] = src_pixel.value();
+                continue;
+            }
+
             if (has_opacity)
                 src_pixel.set_alpha(src_pixel.alpha() * opacity);
             if constexpr (has_alpha_channel) {
@@ -1232,6 +1289,9 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
                 scanline[x] = src_pixel;
             }
         }
+
+        if (blend_rows_onto_opaque_target)
+            blend_row_onto_opaque<true, false>(target.scanline(y) + clipped_rect.left(), row.data(), row.size(), static_cast<u8>(clamp(opacity, 0.0f, 1.0f) * 255));
     }
 }
 
@@ -1322,8 +1382,19 @@ FLATTEN void Painter::draw_glyph(IntPoint const& point, u32 code_point, Color co
 
 FLATTEN void Painter::draw_glyph(IntPoint const& point, u32 code_point, Font const& font, Color color)
 {
+    draw_glyph(point.to_type<float>(), code_point, font, color);
+}
+
+void Painter::draw_glyph(FloatPoint const& point, u32 code_point, Font const& font, Color color)
+{
+    // Glyphs from an atlas are rasterized for the fractional part of the position, everything else is snapped to whole pixels.
+    if (auto atlas_glyph = font.atlas_glyph(code_point, point.x()); atlas_glyph.has_value()) {
+        draw_atlas_glyph({ static_cast<int>(floorf(point.x())) + atlas_glyph->left_bearing, static_cast<int>(point.y()) }, *atlas_glyph, color);
+        return;
+    }
+
     auto glyph = font.glyph(code_point);
-    auto top_left = point + IntPoint(glyph.left_bearing(), 0);
+    auto top_left = point.to_type<int>() + IntPoint(glyph.left_bearing(), 0);
 
     if (glyph.is_glyph_bitmap()) {
         draw_bitmap(top_left, glyph.glyph_bitmap(), color);
@@ -1334,6 +1405,52 @@ FLATTEN void Painter::draw_glyph(IntPoint const& point, u32 code_point, Font con
     }
 }
 
+void Painter::draw_atlas_glyph(IntPoint const& top_left, GlyphAtlas::Glyph const& glyph, Color color)
+{
+    auto dst_rect = IntRect(top_left, glyph.size).translated(translation());
+    auto clipped_rect = dst_rect.intersected(clip_rect());
+    if (clipped_rect.is_empty())
+        return;
+
+    int scale = this->scale();
+    clipped_rect *= scale;
+    dst_rect *= scale;
+
+    int const first_row = clipped_rect.top() - dst_rect.top();
+    int const first_column = clipped_rect.left() - dst_rect.left();
+    ARGB32* dst = m_target->scanline(clipped_rect.y()) + clipped_rect.x();
+    size_t const dst_skip = m_target->pitch() / sizeof(ARGB32);
+
+    auto blend_pixel = [&](ARGB32& pixel, u8 coverage) {
+        if (coverage == 0)
+            return;
+        if (coverage == 0xff && color.alpha() == 0xff) {
+            pixel = color.value();
+            return;
+        }
+        pixel = Color::from_argb(pixel).blend(color.with_alpha(coverage * color.alpha() / 0xff)).value();
+    };
+
+    if (scale == 1) {
+        u8 const* coverage = glyph.coverage + first_row * glyph.pitch + first_column;
+        for (int row = 0; row < clipped_rect.height(); ++row) {
+            for (int x = 0; x < clipped_rect.width(); ++x)
+                blend_pixel(dst[x], coverage[x]);
+            dst += dst_skip;
+            coverage += glyph.pitch;
+        }
+        return;
+    }
+
+    // NOTE: The atlas only holds glyphs at 1x, so we upsample them like blit_filtered() does for glyph bitmaps.
+    for (int row = 0; row < clipped_rect.height(); ++row) {
+        u8 const* coverage = glyph.coverage + ((first_row + row) / scale) * glyph.pitch;
+        for (int x = 0; x < clipped_rect.width(); ++x)
+            blend_pixel(dst[x], coverage[(first_column + x) / scale]);
+        dst += dst_skip;
+    }
+}
+
 void Painter::draw_emoji(IntPoint const& point, Gfx::Bitmap const& emoji, Font const& font)
 {
     IntRect dst_rect {
@@ -1354,6 +1471,11 @@ void Painter::draw_glyph_or_emoji(IntPoint const& point, u32 code_point, Font co
 }
 
 void Painter::draw_glyph_or_emoji(IntPoint const& point, Utf8CodePointIterator& it, Font const& font, Color color)
+{
+    draw_glyph_or_emoji(point.to_type<float>(), it, font, color);
+}
+
+void Painter::draw_glyph_or_emoji(FloatPoint const& point, Utf8CodePointIterator& it, Font const& font, Color color)
 {
     // FIXME: These should live somewhere else.
     constexpr u32 text_variation_selector = 0xFE0E;
@@ -1394,7 +1516,7 @@ void Painter::draw_glyph_or_emoji(IntPoint const& point, Utf8CodePointIterator&
 
     // If we didn't find a text glyph, or have an emoji variation selector or regional indicator, try to draw an emoji glyph.
     if (auto const* emoji = Emoji::emoji_for_code_point_iterator(it)) {
-        draw_emoji(point, *emoji, font);
+        draw_emoji(point.to_type<int>(), *emoji, font);
         return;
     }
 
@@ -2318,8 +2440,10 @@ void Painter::stroke_path(Path const& path, Color color, int thickness)
 
 void Painter::fill_path(Path const& path, Color color, WindingRule winding_rule)
 {
-    VERIFY(scale() == 1); // FIXME: Add scaling support.
-    Detail::fill_path<Detail::FillPathMode::PlaceOnIntGrid>(*this, path, color, winding_rule);
+    auto transform = AffineTransform().scale(scale(), scale()).translate(translation().to_type<float>());
+    PathRasterizer rasterizer(clip_rect() * scale());
+    rasterizer.add_path(path, transform);
+    rasterizer.fill(*m_target, color, winding_rule, PathRasterizer::Antialiasing::No);
 }
 
 void Painter::blit_disabled(IntPoint const& location, Gfx::Bitmap const& bitmap, IntRect const& rect, Palette const& palette)
@@ -2426,7 +2550,7 @@ void Painter::draw_text_run(FloatPoint const& baseline_start, Utf8View const& st
 
         // FIXME: this is probably not the real space taken for complex emojis
         x += font.glyphs_horizontal_kerning(last_code_point, code_point);
-        draw_glyph_or_emoji({ static_cast<int>(x), y }, code_point_iterator, font, color);
+        draw_glyph_or_emoji(FloatPoint { x, static_cast<float>(y) }, code_point_iterator, font, color);
         x += font.glyph_or_emoji_width(code_point) + font.glyph_spacing();
         last_code_point = code_point;
     }
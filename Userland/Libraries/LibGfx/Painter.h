@@ -12,6 +12,7 @@
 #include <AK/Vector.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/Font/GlyphAtlas.h>
 #include <LibGfx/Forward.h>
 #include <LibGfx/Point.h>
 #include <LibGfx/Rect.h>
@@ -91,6 +92,7 @@ public:
     void draw_emoji(IntPoint const&, Gfx::Bitmap const&, Font const&);
     void draw_glyph_or_emoji(IntPoint const&, u32, Font const&, Color);
     void draw_glyph_or_emoji(IntPoint const&, Utf8CodePointIterator&, Font const&, Color);
+    void draw_glyph_or_emoji(FloatPoint const&, Utf8CodePointIterator&, Font const&, Color);
     void draw_circle_arc_intersecting(IntRect const&, IntPoint const&, int radius, Color, int thickness);
 
     // Streamlined text drawing routine that does no wrapping/elision/alignment.
@@ -185,6 +187,9 @@ protected:
     Vector<State, 4> m_state_stack;
 
 private:
+    void draw_glyph(FloatPoint const&, u32, Font const&, Color);
+    void draw_atlas_glyph(IntPoint const&, GlyphAtlas::Glyph const&, Color);
+
     Vector<DirectionalRun> split_text_into_directional_runs(Utf8View const&, TextDirection initial_direction);
     bool text_contains_bidirectional_text(Utf8View const&, TextDirection);
     template<typename DrawGlyphFunction>
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Debug.h>
+#include <AK/Math.h>
+#include <AK/QuickSort.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Path.h>
+#include <LibGfx/PathRasterizer.h>
+#include <LibGfx/PixelBlending.h>
+
+namespace Gfx {
+
+PathRasterizer::PathRasterizer(IntRect const& clip_rect)
+    : m_clip_rect(clip_rect)
+{
+}
+
+void PathRasterizer::add_line(FloatPoint const& from, FloatPoint const& to)
+{
+    if (from.y() == to.y())
+        return;
+
+    auto const& top = from.y() < to.y() ? from : to;
+    auto const& bottom = from.y() < to.y() ? to : from;
+    m_edges.append(Edge {
+        .top = top.y(),
+        .bottom = bottom.y(),
+        .x_at_top = top.x(),
+        .dxdy = (bottom.x() - top.x()) / (bottom.y() - top.y()),
+        .direction = from.y() < to.y() ? 1.0f : -1.0f,
+    });
+}
+
+void PathRasterizer::add_polygon(Vector<FloatPoint> const& points)
+{
+    if (points.size() < 2)
+        return;
+    for (size_t i = 1; i < points.size(); ++i)
+        add_line(points[i - 1], points[i]);
+    add_line(points.last(), points.first());
+}
+
+template<typename Callback>
+static void for_each_polyline(Path const& path, AffineTransform const& transform, Callback callback)
+{
+    Vector<FloatPoint> polyline;
+    auto flush = [&] {
+        if (polyline.size() >= 2)
+            callback(polyline);
+        polyline.clear_with_capacity();
+    };
+    auto add_point = [&](FloatPoint const& point) {
+        polyline.append(transform.map(point));
+    };
+
+    FloatPoint cursor;
+    for (auto& segment : path.segments()) {
+        switch (segment.type()) {
+        case Segment::Type::Invalid:
+            VERIFY_NOT_REACHED();
+        case Segment::Type::MoveTo:
+            flush();
+            add_point(segment.point());
+            break;
+        case Segment::Type::LineTo:
+            if (polyline.is_empty())
+                add_point(cursor);
+            add_point(segment.point());
+            break;
+        case Segment::Type::QuadraticBezierCurveTo: {
+            if (polyline.is_empty())
+                add_point(cursor);
+            auto& through = static_cast<QuadraticBezierCurveSegment const&>(segment).through();
+            Painter::for_each_line_segment_on_bezier_curve(through, cursor, segment.point(), [&](FloatPoint const&, FloatPoint const& to) {
+                add_point(to);
+            });
+            break;
+        }
+        case Segment::Type::CubicBezierCurveTo: {
+            if (polyline.is_empty())
+                add_point(cursor);
+            auto& curve = static_cast<CubicBezierCurveSegment const&>(segment);
+            Painter::for_each_line_segment_on_cubic_bezier_curve(curve.through_0(), curve.through_1(), cursor, segment.point(), [&](FloatPoint const&, FloatPoint const& to) {
+                add_point(to);
+            });
+            break;
+        }
+        case Segment::Type::EllipticalArcTo: {
+            if (polyline.is_empty())
+                add_point(cursor);
+            auto& arc = static_cast<EllipticalArcSegment const&>(segment);
+            Painter::for_each_line_segment_on_elliptical_arc(cursor, segment.point(), arc.center(), arc.radii(), arc.x_axis_rotation(), arc.theta_1(), arc.theta_delta(), [&](FloatPoint const&, FloatPoint const& to) {
+                add_point(to);
+            });
+            break;
+        }
+        }
+        cursor = segment.point();
+    }
+    flush();
+}
+
+void PathRasterizer::add_path(Path const& path, AffineTransform const& transform)
+{
+    for_each_polyline(path, transform, [&](Vector<FloatPoint> const& polyline) {
+        add_polygon(polyline);
+    });
+}
+
+void PathRasterizer::add_stroke(Path const& path, float thickness, AffineTransform const& transform)
+{
+    if (thickness <= 0)
+        return;
+
+    // Overlapping pieces only add up to full coverage if they all wind the same way.
+    Vector<FloatPoint> polygon;
+    auto add_piece = [&](auto... points) {
+        polygon.clear_with_capacity();
+        (polygon.append(points), ...);
+        float twice_the_area = 0;
+        for (size_t i = 0; i < polygon.size(); ++i) {
+            auto const& a = polygon[i];
+            auto const& b = polygon[(i + 1) % polygon.size()];
+            twice_the_area += a.x() * b.y() - b.x() * a.y();
+        }
+        if (twice_the_area < 0)
+            polygon.reverse();
+        add_polygon(polygon);
+    };
+
+    auto half_thickness = thickness / 2;
+    for_each_polyline(path, transform, [&](Vector<FloatPoint> const& polyline) {
+        Optional<FloatPoint> previous_offset;
+        for (size_t i = 1; i < polyline.size(); ++i) {
+            auto const& from = polyline[i - 1];
+            auto const& to = polyline[i];
+            auto delta = to - from;
+            auto length = AK::hypot(delta.x(), delta.y());
+            if (length == 0)
+                continue;
+
+            FloatPoint offset { -delta.y() * half_thickness / length, delta.x() * half_thickness / length };
+            add_piece(from + offset, to + offset, to - offset, from - offset);
+            if (previous_offset.has_value()) {
+                add_piece(from, from + *previous_offset, from + offset);
+                add_piece(from, from - *previous_offset, from - offset);
+            }
+            previous_offset = offset;
+        }
+    });
+}
+
+void PathRasterizer::accumulate_edge_in_row(Edge const& edge, int row)
+{
+    float top = max(static_cast<float>(row), edge.top);
+    float bottom = min(static_cast<float>(row + 1), edge.bottom);
+    if (bottom <= top)
+        return;
+
+    float const width = m_clip_rect.width();
+    auto x_at = [&](float y) {
+        return edge.x_at_top + (y - edge.top) * edge.dxdy - m_clip_rect.left();
+    };
+    float x_top = x_at(top);
+    float x_bottom = x_at(bottom);
+    float area = (bottom - top) * edge.direction;
+
+    // The parts of the edge outside of the clip rect still change the coverage inside of it: Everything left of it
+    // covers the row from its left side onwards, like a vertical edge at x = 0 would. Nothing right of it can reach back in.
+    Array<float, 4> splits { 0.0f };
+    size_t split_count = 1;
+    if (x_top != x_bottom) {
+        for (float boundary : { 0.0f, width }) {
+            float t = (boundary - x_top) / (x_bottom - x_top);
+            if (t > 0.0f && t < 1.0f)
+                splits[split_count++] = t;
+        }
+        if (split_count == 3 && splits[2] < splits[1])
+            swap(splits[1], splits[2]);
+    }
+    splits[split_count++] = 1.0f;
+
+    for (size_t i = 1; i < split_count; ++i) {
+        float x0 = x_top + (x_bottom - x_top) * splits[i - 1];
+        float x1 = x_top + (x_bottom - x_top) * splits[i];
+        float piece_area = area * (splits[i] - splits[i - 1]);
+        float midpoint = 0.5f * (x0 + x1);
+        if (midpoint >= width)
+            continue;
+        if (midpoint <= 0.0f)
+            accumulate_edge_piece(0.0f, 0.0f, piece_area);
+        else
+            accumulate_edge_piece(clamp(x0, 0.0f, width), clamp(x1, 0.0f, width), piece_area);
+    }
+}
+
+void PathRasterizer::accumulate_edge_piece(float x0, float x1, float area)
+{
+    // Cell x holds the change in coverage from pixel x - 1 to pixel x.
+    if (x1 < x0)
+        swap(x0, x1);
+
+    float x0_floor = floorf(x0);
+    int x0_cell = static_cast<int>(x0_floor);
+    float x1_ceil = ceilf(x1);
+    int x1_cell = static_cast<int>(x1_ceil);
+    m_first_touched_cell = min(m_first_touched_cell, x0_cell);
+
+    if (x1_cell <= x0_cell + 1) {
+        // The edge stays within one pixel, which is covered up to the midpoint of the edge.
+        float midpoint = 0.5f * (x0 + x1) - x0_floor;
+        m_accumulation[x0_cell] += area - area * midpoint;
+        m_accumulation[x0_cell + 1] += area * midpoint;
+        m_last_touched_cell = max(m_last_touched_cell, x0_cell + 1);
+        return;
+    }
+
+    // The edge crosses several pixels, spread its area over them.
+    float inverse_width = 1.0f / (x1 - x0);
+    float x0_fraction = x0 - x0_floor;
+    float first_area = 0.5f * inverse_width * (1.0f - x0_fraction) * (1.0f - x0_fraction);
+    float x1_fraction = x1 - x1_ceil + 1.0f;
+    float last_area = 0.5f * inverse_width * x1_fraction * x1_fraction;
+
+    m_accumulation[x0_cell] += area * first_area;
+    if (x1_cell == x0_cell + 2) {
+        m_accumulation[x0_cell + 1] += area * (1.0f - first_area - last_area);
+    } else {
+        float second_area = inverse_width * (1.5f - x0_fraction);
+        m_accumulation[x0_cell + 1] += area * (second_area - first_area);
+        for (int cell = x0_cell + 2; cell < x1_cell - 1; ++cell)
+            m_accumulation[cell] += area * inverse_width;
+        float area_before_last = second_area + (x1_cell - x0_cell - 3) * inverse_width;
+        m_accumulation[x1_cell - 1] += area * (1.0f - area_before_last - last_area);
+    }
+    m_accumulation[x1_cell] += area * last_area;
+    m_last_touched_cell = max(m_last_touched_cell, x1_cell);
+}
+
+void PathRasterizer::fill(Bitmap& target, Color color, Painter::WindingRule winding_rule, Antialiasing antialiasing)
+{
+    auto clip_rect = m_clip_rect.intersected(target.rect());
+    if (m_edges.is_empty() || clip_rect.is_empty() || color.alpha() == 0)
+        return;
+    m_clip_rect = clip_rect;
+
+    quick_sort(m_edges, [](auto const& a, auto const& b) { return a.top < b.top; });
+
+    float bottom = m_edges.first().bottom;
+    for (auto& edge : m_edges)
+        bottom = max(bottom, edge.bottom);
+    int first_row = max(m_clip_rect.top(), static_cast<int>(floorf(m_edges.first().top)));
+    int last_row = min(m_clip_rect.bottom(), static_cast<int>(ceilf(bottom)) - 1);
+    dbgln_if(FILL_PATH_DEBUG, "PathRasterizer: Filling {} edges in rows {} to {} of {}", m_edges.size(), first_row, last_row, m_clip_rect);
+
+    int const width = m_clip_rect.width();
+    // Two extra cells for edges that touch the right side of the clip rect.
+    m_accumulation.clear_with_capacity();
+    m_accumulation.resize(width + 2);
+
+    auto coverage_for = [&](float accumulated) {
+        auto coverage = fabsf(accumulated);
+        if (winding_rule == Painter::WindingRule::EvenOdd) {
+            coverage = fmodf(coverage, 2.0f);
+            if (coverage > 1.0f)
+                coverage = 2.0f - coverage;
+        } else {
+            coverage = min(coverage, 1.0f);
+        }
+        if (antialiasing == Antialiasing::No)
+            return coverage >= 0.5f ? 1.0f : 0.0f;
+        return coverage;
+    };
+
+    bool const target_is_opaque = !target.has_alpha_channel();
+    Vector<Edge const*> active_edges;
+    size_t next_edge = 0;
+
+    for (int row = first_row; row <= last_row; ++row) {
+        active_edges.remove_all_matching([&](auto* edge) { return edge->bottom <= row; });
+        for (; next_edge < m_edges.size() && m_edges[next_edge].top < row + 1; ++next_edge) {
+            if (m_edges[next_edge].bottom > row)
+                active_edges.append(&m_edges[next_edge]);
+        }
+        if (active_edges.is_empty())
+            continue;
+
+        m_first_touched_cell = width + 1;
+        m_last_touched_cell = -1;
+        for (auto* edge : active_edges)
+            accumulate_edge_in_row(*edge, row);
+        if (m_last_touched_cell < 0)
+            continue;
+
+        auto* scanline = target.scanline(row) + m_clip_rect.left();
+        float accumulated = 0;
+        for (int x = m_first_touched_cell; x <= m_last_touched_cell;) {
+            accumulated += m_accumulation[x];
+            m_accumulation[x] = 0;
+            if (x >= width)
+                break;
+
+            // Coverage doesn't change until the next cell an edge touched, so blend that whole span at once.
+            int span_end = x + 1;
+            while (span_end < width && span_end <= m_last_touched_cell && m_accumulation[span_end] == 0)
+                ++span_end;
+            // Past the last touched cell, the coverage stays the same up to the right side of the clip rect.
+            if (span_end > m_last_touched_cell)
+                span_end = width;
+
+            auto alpha = static_cast<u8>(roundf(coverage_for(accumulated) * color.alpha()));
+            if (alpha != 0) {
+                if (target_is_opaque) {
+                    fill_row_onto_opaque(scanline + x, span_end - x, color.with_alpha(alpha));
+                } else {
+                    for (int i = x; i < span_end; ++i)
+                        scanline[i] = Color::from_argb(scanline[i]).blend(color.with_alpha(alpha)).value();
+                }
+            }
+            x = span_end;
+        }
+        for (int x = max(width, m_first_touched_cell); x <= m_last_touched_cell; ++x)
+            m_accumulation[x] = 0;
+    }
+
+    m_edges.clear();
+}
+
+}
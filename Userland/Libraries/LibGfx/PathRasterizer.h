@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Vector.h>
+#include <LibGfx/AffineTransform.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Rect.h>
+
+namespace Gfx {
+
+// Rasterizes paths by computing exactly how much of every pixel they cover.
+//
+// Each edge adds the signed area it covers to the cells of an accumulation buffer, and the running
+// sum of a row of cells is the coverage of the pixels in that row. As only the cells an edge crosses
+// are touched, edges never need to be sorted by x, and the spans between edges are resolved in a
+// single pass. Rows are rasterized one at a time, so the buffer is just one row wide.
+//
+// All coordinates are in the physical coordinates of the target bitmap.
+class PathRasterizer {
+public:
+    enum class Antialiasing {
+        Yes,
+        No,
+    };
+
+    explicit PathRasterizer(IntRect const& clip_rect);
+
+    void add_line(FloatPoint const& from, FloatPoint const& to);
+    void add_polygon(Vector<FloatPoint> const&);
+
+    // Adds the area enclosed by the path. Open subpaths are closed implicitly.
+    void add_path(Path const&, AffineTransform const& = {});
+    // Adds the area covered by a line of the given thickness along the path, with bevelled joins.
+    void add_stroke(Path const&, float thickness, AffineTransform const& = {});
+
+    void fill(Bitmap& target, Color, Painter::WindingRule, Antialiasing = Antialiasing::Yes);
+
+private:
+    struct Edge {
+        float top { 0 };
+        float bottom { 0 };
+        float x_at_top { 0 };
+        float dxdy { 0 };
+        float direction { 1 };
+    };
+
+    void accumulate_edge_in_row(Edge const&, int row);
+    // Adds a piece of an edge that lies within the clip rect and spans from x0 to x1, relative to its left side.
+    void accumulate_edge_piece(float x0, float x1, float area);
+
+    IntRect m_clip_rect;
+    Vector<Edge> m_edges;
+    Vector<float> m_accumulation;
+    int m_first_touched_cell { 0 };
+    int m_last_touched_cell { -1 };
+};
+
+}
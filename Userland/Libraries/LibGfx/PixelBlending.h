@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/SIMD.h>
+#include <AK/Types.h>
+#include <LibGfx/Color.h>
+
+// Row kernels for compositing 32-bit pixels onto targets without an alpha channel.
+//
+// Blending onto an opaque pixel simplifies Color::blend() to dst * (255 - alpha) / 255 + src * alpha / 255,
+// which only needs 16-bit multiplies and a division by 255 that can be done with shifts. That lets us
+// handle four pixels at a time, with each pixel's channels spread over the 16-bit lanes of a vector.
+// The scalar versions compute exactly the same results, and deal with whatever is left over.
+
+namespace Gfx {
+
+namespace Detail {
+
+// floor(x / 255), exact for all x <= 255 * 255.
+ALWAYS_INLINE static constexpr u32 divide_by_255(u32 x)
+{
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+ALWAYS_INLINE static constexpr ARGB32 swap_red_and_blue(ARGB32 pixel)
+{
+    return (pixel & 0xff00ff00) | ((pixel & 0x000000ff) << 16) | ((pixel & 0x00ff0000) >> 16);
+}
+
+ALWAYS_INLINE static constexpr ARGB32 blend_pixel_onto_opaque(ARGB32 dst, ARGB32 src, u32 alpha)
+{
+    u32 inverse_alpha = 255 - alpha;
+    // Red and blue are blended together, as neither half of the sum can exceed 255 * 255.
+    u32 red_and_blue = (src & 0x00ff00ff) * alpha + (dst & 0x00ff00ff) * inverse_alpha;
+    u32 green = ((src >> 8) & 0xff) * alpha + ((dst >> 8) & 0xff) * inverse_alpha;
+    red_and_blue = ((red_and_blue + 0x00010001 + ((red_and_blue >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    return 0xff000000 | red_and_blue | (divide_by_255(green) << 8);
+}
+
+#ifdef __SSE2__
+using AK::SIMD::u16x8;
+using AK::SIMD::u32x4;
+
+ALWAYS_INLINE static u16x8 divide_by_255(u16x8 x)
+{
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+ALWAYS_INLINE static u32x4 load_pixels(ARGB32 const* pixels)
+{
+    u32x4 result;
+    __builtin_memcpy(&result, pixels, sizeof(result));
+    return result;
+}
+
+ALWAYS_INLINE static void store_pixels(ARGB32* pixels, u32x4 value)
+{
+    __builtin_memcpy(pixels, &value, sizeof(value));
+}
+
+// Returns the alpha of each pixel in both 16-bit halves of its lane.
+ALWAYS_INLINE static u16x8 splat_alpha(u32x4 pixels)
+{
+    auto alpha = pixels >> 24;
+    return (u16x8)(alpha | (alpha << 16));
+}
+
+ALWAYS_INLINE static u32x4 blend_pixels_onto_opaque(u32x4 dst, u32x4 src, u16x8 alpha)
+{
+    u16x8 inverse_alpha = 255 - alpha;
+    // Within each pixel, the low 16-bit lane holds blue and red, the high lane green and alpha.
+    u16x8 blue_and_red = divide_by_255(((u16x8)src & 0xff) * alpha + ((u16x8)dst & 0xff) * inverse_alpha);
+    u16x8 green_and_alpha = divide_by_255(((u16x8)src >> 8) * alpha + ((u16x8)dst >> 8) * inverse_alpha);
+    return (u32x4)(blue_and_red | (green_and_alpha << 8)) | 0xff000000;
+}
+#endif
+
+}
+
+// Blends count pixels from src onto dst, which is treated as opaque.
+// The alpha of every source pixel is scaled by opacity first. Without a source alpha channel, opacity is used as-is.
+template<bool source_has_alpha, bool source_is_rgba>
+ALWAYS_INLINE static void blend_row_onto_opaque(ARGB32* dst, ARGB32 const* src, size_t count, u8 opacity)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    using namespace Detail;
+    for (; i + 4 <= count; i += 4) {
+        auto source = load_pixels(src + i);
+        if constexpr (source_is_rgba)
+            source = (source & 0xff00ff00) | ((source & 0x000000ff) << 16) | ((source >> 16) & 0x000000ff);
+        u16x8 alpha;
+        if constexpr (source_has_alpha)
+            alpha = divide_by_255(splat_alpha(source) * opacity);
+        else
+            alpha = u16x8 {} + opacity;
+        store_pixels(dst + i, blend_pixels_onto_opaque(load_pixels(dst + i), source, alpha));
+    }
+#endif
+    for (; i < count; ++i) {
+        auto source = src[i];
+        if constexpr (source_is_rgba)
+            source = Detail::swap_red_and_blue(source);
+        u32 alpha = opacity;
+        if constexpr (source_has_alpha)
+            alpha = Detail::divide_by_255((source >> 24) * opacity);
+        dst[i] = Detail::blend_pixel_onto_opaque(dst[i], source, alpha);
+    }
+}
+
+// Blends color onto count pixels of dst, which is treated as opaque.
+ALWAYS_INLINE static void fill_row_onto_opaque(ARGB32* dst, size_t count, Color color)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    using namespace Detail;
+    auto source = u32x4 {} + color.value();
+    auto alpha = u16x8 {} + color.alpha();
+    for (; i + 4 <= count; i += 4)
+        store_pixels(dst + i, blend_pixels_onto_opaque(load_pixels(dst + i), source, alpha));
+#endif
+    for (; i < count; ++i)
+        dst[i] = Detail::blend_pixel_onto_opaque(dst[i], color.value(), color.alpha());
+}
+
+}
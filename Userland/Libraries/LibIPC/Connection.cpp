@@ -12,6 +12,11 @@
 
 namespace IPC {
 
+// Messages on the socket are prefixed with their size. Sizes that can't belong to a message are used
+// to tell the peer that we set up a ring for it, or that there are new messages in that ring.
+static constexpr u32 ring_attached_frame = NumericLimits<u32>::max();
+static constexpr u32 ring_wakeup_frame = NumericLimits<u32>::max() - 1;
+
 struct CoreEventLoopDeferredInvoker final : public DeferredInvoker {
     virtual ~CoreEventLoopDeferredInvoker() = default;
 
@@ -52,6 +57,20 @@ ErrorOr<void> ConnectionBase::post_message(Message const& message)
     return post_message(message.encode());
 }
 
+ErrorOr<void> ConnectionBase::enable_shared_memory_transport()
+{
+    if (m_outgoing_ring.has_value())
+        return {};
+    if (!m_socket->is_open())
+        return Error::from_string_literal("Trying to enable shared memory transport during IPC shutdown");
+
+    auto ring = TRY(MessageRing::try_create());
+    TRY(fd_passing_socket().send_fd(ring.fd()));
+    TRY(write_to_socket({ &ring_attached_frame, sizeof(ring_attached_frame) }));
+    m_outgoing_ring = move(ring);
+    return {};
+}
+
 ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
 {
     // NOTE: If this connection is being shut down, but has not yet been destroyed,
@@ -59,6 +78,9 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
     if (!m_socket->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
+    if (m_outgoing_ring.has_value())
+        return post_message_through_ring(move(buffer));
+
     // Prepend the message size.
     uint32_t message_size = buffer.data.size();
     TRY(buffer.data.try_prepend(reinterpret_cast<u8 const*>(&message_size), sizeof(message_size)));
@@ -70,7 +92,58 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
         }
     }
 
-    ReadonlyBytes bytes_to_write { buffer.data.span() };
+    TRY(write_to_socket(buffer.data.span()));
+    m_responsiveness_timer->start();
+    return {};
+}
+
+ErrorOr<void> ConnectionBase::post_message_through_ring(MessageBuffer buffer)
+{
+    Threading::MutexLocker locker(m_outgoing_ring_mutex);
+    auto& ring = *m_outgoing_ring;
+
+    // Large messages would hog the ring, so they get an anonymous buffer of their own.
+    auto record_type = MessageRing::RecordType::Message;
+    ReadonlyBytes payload = buffer.data.span();
+    u32 out_of_line_size = buffer.data.size();
+    if (payload.size() > MessageRing::max_payload_size) {
+        auto out_of_line_buffer = TRY(Core::AnonymousBuffer::create_with_size(payload.size()));
+        memcpy(out_of_line_buffer.data<void>(), payload.data(), payload.size());
+        if (auto result = fd_passing_socket().send_fd(out_of_line_buffer.fd()); result.is_error()) {
+            shutdown_with_error(result.error());
+            return result;
+        }
+        record_type = MessageRing::RecordType::OutOfLineMessage;
+        payload = { &out_of_line_size, sizeof(out_of_line_size) };
+    }
+
+    for (auto& fd : buffer.fds) {
+        if (auto result = fd_passing_socket().send_fd(fd.value()); result.is_error()) {
+            shutdown_with_error(result.error());
+            return result;
+        }
+    }
+
+    // FIXME: Like with the socket, the limit of 100 attempts is arbitrary, and only there to prevent spinning forever.
+    int attempts = 0;
+    while (!ring.try_write(record_type, payload)) {
+        if (++attempts == 100) {
+            auto error = Error::from_string_literal("IPC::Connection::post_message: Peer ring overflowed");
+            shutdown_with_error(error);
+            return error;
+        }
+        sched_yield();
+    }
+
+    if (ring.take_wakeup_request())
+        TRY(write_to_socket({ &ring_wakeup_frame, sizeof(ring_wakeup_frame) }));
+
+    m_responsiveness_timer->start();
+    return {};
+}
+
+ErrorOr<void> ConnectionBase::write_to_socket(ReadonlyBytes bytes_to_write)
+{
     int writes_done = 0;
     size_t initial_size = bytes_to_write.size();
     while (!bytes_to_write.is_empty()) {
@@ -104,8 +177,6 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
     if (writes_done > 1) {
         dbgln("LibIPC::Connection FIXME Warning, needed {} writes needed to send message of size {}B, this is pretty bad, as it spins on the EventLoop", writes_done, initial_size);
     }
-
-    m_responsiveness_timer->start();
     return {};
 }
 
@@ -191,12 +262,88 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
     return bytes;
 }
 
+ErrorOr<void> ConnectionBase::try_parse_messages(Vector<u8> const& bytes, size_t& index)
+{
+    u32 message_size = 0;
+    while (index + sizeof(message_size) <= bytes.size()) {
+        memcpy(&message_size, bytes.data() + index, sizeof(message_size));
+        if (message_size == ring_wakeup_frame) {
+            // The ring is drained after every read from the socket anyway.
+            index += sizeof(message_size);
+            continue;
+        }
+        if (message_size == ring_attached_frame) {
+            index += sizeof(message_size);
+            auto fd = TRY(fd_passing_socket().receive_fd(O_CLOEXEC));
+            m_incoming_ring = TRY(MessageRing::try_create_from_fd(fd));
+            continue;
+        }
+        if (message_size == 0 || bytes.size() - index - sizeof(uint32_t) < message_size)
+            break;
+        index += sizeof(message_size);
+        auto message = try_parse_message({ bytes.data() + index, message_size });
+        if (!message) {
+            dbgln("Failed to parse a message");
+            break;
+        }
+        m_unprocessed_messages.append(message.release_nonnull());
+        index += message_size;
+    }
+    return {};
+}
+
+ErrorOr<void> ConnectionBase::drain_messages_from_incoming_ring()
+{
+    auto& ring = *m_incoming_ring;
+    bool received_messages = false;
+    for (;;) {
+        auto record = TRY(ring.try_read());
+        if (!record.has_value()) {
+            if (ring.request_wakeup())
+                break;
+            continue;
+        }
+
+        // The peer can still write to the ring and to out-of-line buffers while we're reading them. If we decoded
+        // messages in place, what the decoder checked could be changed before it's used, so they're copied out first.
+        if (record->type == MessageRing::RecordType::OutOfLineMessage) {
+            u32 size = 0;
+            if (record->payload.size() != sizeof(size))
+                return Error::from_string_literal("drain_messages_from_incoming_ring: Bad out-of-line message record");
+            memcpy(&size, record->payload.data(), sizeof(size));
+            auto fd = TRY(fd_passing_socket().receive_fd(O_CLOEXEC));
+            auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(fd, size));
+            TRY(m_incoming_message_buffer.try_resize(buffer.size()));
+            memcpy(m_incoming_message_buffer.data(), buffer.data<u8>(), buffer.size());
+        } else {
+            TRY(m_incoming_message_buffer.try_resize(record->payload.size()));
+            memcpy(m_incoming_message_buffer.data(), record->payload.data(), record->payload.size());
+        }
+        ring.pop(*record);
+
+        auto message = try_parse_message(m_incoming_message_buffer);
+        if (!message)
+            return Error::from_string_literal("drain_messages_from_incoming_ring: Failed to parse a message");
+        m_unprocessed_messages.append(message.release_nonnull());
+        received_messages = true;
+    }
+
+    if (received_messages) {
+        m_responsiveness_timer->stop();
+        did_become_responsive();
+    }
+    return {};
+}
+
 ErrorOr<void> ConnectionBase::drain_messages_from_peer()
 {
     auto bytes = TRY(read_as_much_as_possible_from_socket_without_blocking());
 
     size_t index = 0;
-    try_parse_messages(bytes, index);
+    if (auto result = try_parse_messages(bytes, index); result.is_error()) {
+        shutdown_with_error(result.error());
+        return result;
+    }
 
     if (index < bytes.size()) {
         // Sometimes we might receive a partial message. That's okay, just stash away
@@ -210,6 +357,13 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
         m_unprocessed_bytes = move(remaining_bytes);
     }
 
+    if (m_incoming_ring.has_value()) {
+        if (auto result = drain_messages_from_incoming_ring(); result.is_error()) {
+            shutdown_with_error(result.error());
+            return result;
+        }
+    }
+
     if (!m_unprocessed_messages.is_empty()) {
         m_deferred_invoker->schedule([strong_this = NonnullRefPtr(*this)]() mutable {
             strong_this->handle_messages();
@@ -17,6 +17,8 @@
 #include <LibCore/Timer.h>
 #include <LibIPC/Forward.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/MessageRing.h>
+#include <LibThreading/Mutex.h>
 #include <errno.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -46,6 +48,10 @@ public:
     bool is_open() const { return m_socket->is_open(); }
     ErrorOr<void> post_message(Message const&);
 
+    // Sends all further messages to the peer through a shared memory ring instead of the socket.
+    // This requires the "sendfd" pledge here and the "recvfd" pledge on the other side.
+    ErrorOr<void> enable_shared_memory_transport();
+
     void shutdown();
     virtual void die() { }
 
@@ -57,15 +63,19 @@ protected:
 
     virtual void may_have_become_unresponsive() { }
     virtual void did_become_responsive() { }
-    virtual void try_parse_messages(Vector<u8> const& bytes, size_t& index) = 0;
+    virtual OwnPtr<Message> try_parse_message(ReadonlyBytes) = 0;
     virtual void shutdown_with_error(Error const&);
 
     OwnPtr<IPC::Message> wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id);
     void wait_for_socket_to_become_readable();
     ErrorOr<Vector<u8>> read_as_much_as_possible_from_socket_without_blocking();
     ErrorOr<void> drain_messages_from_peer();
+    ErrorOr<void> try_parse_messages(Vector<u8> const& bytes, size_t& index);
+    ErrorOr<void> drain_messages_from_incoming_ring();
 
     ErrorOr<void> post_message(MessageBuffer);
+    ErrorOr<void> post_message_through_ring(MessageBuffer);
+    ErrorOr<void> write_to_socket(ReadonlyBytes);
     void handle_messages();
 
     IPC::Stub& m_local_stub;
@@ -78,6 +88,13 @@ protected:
     NonnullOwnPtrVector<Message> m_unprocessed_messages;
     ByteBuffer m_unprocessed_bytes;
 
+    Optional<MessageRing> m_outgoing_ring;
+    // The ring only supports a single producer, but messages may be posted from several threads.
+    Threading::Mutex m_outgoing_ring_mutex;
+    Optional<MessageRing> m_incoming_ring;
+    // Messages are copied out of shared memory into this before they're decoded.
+    ByteBuffer m_incoming_message_buffer;
+
     u32 m_local_endpoint_magic { 0 };
 
     NonnullOwnPtr<DeferredInvoker> m_deferred_invoker;
@@ -129,24 +146,11 @@ protected:
         return {};
     }
 
-    virtual void try_parse_messages(Vector<u8> const& bytes, size_t& index) override
+    virtual OwnPtr<Message> try_parse_message(ReadonlyBytes bytes) override
     {
-        u32 message_size = 0;
-        for (; index + sizeof(message_size) < bytes.size(); index += message_size) {
-            memcpy(&message_size, bytes.data() + index, sizeof(message_size));
-            if (message_size == 0 || bytes.size() - index - sizeof(uint32_t) < message_size)
-                break;
-            index += sizeof(message_size);
-            auto remaining_bytes = ReadonlyBytes { bytes.data() + index, message_size };
-            if (auto message = LocalEndpoint::decode_message(remaining_bytes, fd_passing_socket())) {
-                m_unprocessed_messages.append(message.release_nonnull());
-            } else if (auto message = PeerEndpoint::decode_message(remaining_bytes, fd_passing_socket())) {
-                m_unprocessed_messages.append(message.release_nonnull());
-            } else {
-                dbgln("Failed to parse a message");
-                break;
-            }
-        }
+        if (auto message = LocalEndpoint::decode_message(bytes, fd_passing_socket()))
+            return message;
+        return PeerEndpoint::decode_message(bytes, fd_passing_socket());
     }
 };
 
@@ -17,6 +17,7 @@
 #include <LibIPC/File.h>
 #include <LibIPC/Forward.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/ViewArgument.h>
 
 namespace IPC {
 
@@ -132,6 +133,23 @@ public:
         return {};
     }
 
+    template<typename View>
+    ErrorOr<void> decode(ViewArgument<View>& argument)
+    {
+        bool spilled;
+        TRY(decode(spilled));
+        if (spilled) {
+            Core::AnonymousBuffer buffer;
+            TRY(decode(buffer));
+            argument.set_storage(move(buffer));
+        } else {
+            ByteBuffer buffer;
+            TRY(decode(buffer));
+            argument.set_storage(move(buffer));
+        }
+        return {};
+    }
+
     template<typename T>
     ErrorOr<void> decode(Optional<T>& optional)
     {
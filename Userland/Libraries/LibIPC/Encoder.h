@@ -12,6 +12,7 @@
 #include <LibCore/SharedCircularQueue.h>
 #include <LibIPC/Forward.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/ViewArgument.h>
 
 namespace IPC {
 
@@ -86,6 +87,22 @@ public:
         return *this;
     }
 
+    template<typename View>
+    Encoder& operator<<(ViewArgument<View> const& argument)
+    {
+        auto bytes = argument.bytes();
+        if (bytes.size() >= ViewArgument<View>::spill_threshold) {
+            if (auto buffer = Core::AnonymousBuffer::create_with_size(bytes.size()); !buffer.is_error()) {
+                memcpy(buffer.value().template data<void>(), bytes.data(), bytes.size());
+                *this << true;
+                encode(buffer.value());
+                return *this;
+            }
+        }
+        *this << false << static_cast<i32>(bytes.size()) << StringView { bytes };
+        return *this;
+    }
+
     template<Enum T>
     Encoder& operator<<(T const& enum_value)
     {
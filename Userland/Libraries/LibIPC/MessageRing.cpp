@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibIPC/MessageRing.h>
+
+namespace IPC {
+
+static_assert(is_power_of_two(MessageRing::capacity));
+
+ErrorOr<MessageRing> MessageRing::try_create()
+{
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(data_offset + capacity));
+    new (buffer.data<void>()) SharedHeader();
+    return MessageRing(move(buffer));
+}
+
+ErrorOr<MessageRing> MessageRing::try_create_from_fd(int fd)
+{
+    auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(fd, data_offset + capacity));
+    return MessageRing(move(buffer));
+}
+
+MessageRing::MessageRing(Core::AnonymousBuffer buffer)
+    : m_buffer(move(buffer))
+{
+}
+
+bool MessageRing::try_write(RecordType type, ReadonlyBytes payload)
+{
+    VERIFY(payload.size() <= max_payload_size);
+
+    auto record_size = record_size_for(payload.size());
+    auto write_offset = header().write_offset.load(AK::MemoryOrder::memory_order_relaxed);
+    auto read_offset = header().read_offset.load(AK::MemoryOrder::memory_order_acquire);
+
+    // Records are kept contiguous, so that they can be copied out in one go.
+    auto space_until_end = capacity - write_offset % capacity;
+    auto padding_size = space_until_end < record_size ? space_until_end : 0;
+    if (capacity - (write_offset - read_offset) < padding_size + record_size)
+        return false;
+
+    if (padding_size != 0) {
+        RecordHeader padding { RecordType::Padding, static_cast<u32>(padding_size - sizeof(RecordHeader)) };
+        __builtin_memcpy(data() + write_offset % capacity, &padding, sizeof(padding));
+        write_offset += padding_size;
+    }
+
+    RecordHeader record { type, static_cast<u32>(payload.size()) };
+    auto* destination = data() + write_offset % capacity;
+    __builtin_memcpy(destination, &record, sizeof(record));
+    __builtin_memcpy(destination + sizeof(record), payload.data(), payload.size());
+    header().write_offset.store(write_offset + record_size);
+    return true;
+}
+
+bool MessageRing::take_wakeup_request()
+{
+    return header().wakeup_requested.exchange(0) != 0;
+}
+
+ErrorOr<Optional<MessageRing::Record>> MessageRing::try_read()
+{
+    for (;;) {
+        auto read_offset = header().read_offset.load(AK::MemoryOrder::memory_order_relaxed);
+        auto write_offset = header().write_offset.load();
+        if (read_offset == write_offset)
+            return Optional<Record> {};
+
+        auto available = write_offset - read_offset;
+        auto offset_in_ring = read_offset % capacity;
+        RecordHeader record;
+        if (available > capacity || available < sizeof(record))
+            return Error::from_string_literal("MessageRing: Bad write offset");
+        __builtin_memcpy(&record, data() + offset_in_ring, sizeof(record));
+
+        if (record.size > capacity)
+            return Error::from_string_literal("MessageRing: Bad record size");
+        auto record_size = record_size_for(record.size);
+        if (record_size > available || offset_in_ring + record_size > capacity)
+            return Error::from_string_literal("MessageRing: Bad record size");
+
+        if (record.type == RecordType::Padding) {
+            header().read_offset.store(read_offset + record_size, AK::MemoryOrder::memory_order_release);
+            continue;
+        }
+        if (record.type != RecordType::Message && record.type != RecordType::OutOfLineMessage)
+            return Error::from_string_literal("MessageRing: Bad record type");
+
+        return Record { record.type, { data() + offset_in_ring + sizeof(record), record.size } };
+    }
+}
+
+void MessageRing::pop(Record const& record)
+{
+    auto read_offset = header().read_offset.load(AK::MemoryOrder::memory_order_relaxed);
+    header().read_offset.store(read_offset + record_size_for(record.payload.size()), AK::MemoryOrder::memory_order_release);
+}
+
+bool MessageRing::request_wakeup()
+{
+    header().wakeup_requested.store(1);
+    return header().write_offset.load() == header().read_offset.load(AK::MemoryOrder::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Error.h>
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <LibCore/AnonymousBuffer.h>
+
+namespace IPC {
+
+// A single-producer, single-consumer ring of variable-sized records in shared memory.
+//
+// Each side of a connection can move its outgoing messages into one of these, which saves the
+// copies through the kernel and the system calls that the socket needs for every message.
+// The connection socket is then only needed to pass file descriptors and to wake up the receiver.
+// The receiver asks for a wakeup before it goes to sleep, and the sender only sends one when it
+// was asked to, so any number of messages sent in the meantime are handled in a single batch.
+//
+// The peer can write to the ring at any time, even while a record is being read. The record headers
+// are copied out and checked, but payloads are not: They have to be copied out before they're used.
+class MessageRing {
+public:
+    static constexpr size_t capacity = 64 * KiB;
+    // Larger records would have to wait until the ring is almost empty, so they shouldn't be sent through it.
+    static constexpr size_t max_payload_size = capacity / 4;
+
+    enum class RecordType : u32 {
+        // The payload is an encoded message.
+        Message,
+        // The payload is the u32 size of an encoded message in an anonymous buffer, which was sent along as a file descriptor.
+        OutOfLineMessage,
+        // Fills up the end of the ring when a record doesn't fit there.
+        Padding,
+    };
+
+    struct Record {
+        RecordType type;
+        // Points into the shared memory, so the peer can still change it.
+        ReadonlyBytes payload;
+    };
+
+    static ErrorOr<MessageRing> try_create();
+    static ErrorOr<MessageRing> try_create_from_fd(int fd);
+
+    int fd() const { return m_buffer.fd(); }
+
+    // Producer side. Returns false if there isn't enough room for the record right now.
+    bool try_write(RecordType, ReadonlyBytes payload);
+    // Returns whether the consumer asked to be woken up, and resets the request.
+    bool take_wakeup_request();
+
+    // Consumer side. Records have to be popped before the next one can be read.
+    ErrorOr<Optional<Record>> try_read();
+    void pop(Record const&);
+    // Asks the producer to wake us up when it writes the next record. Returns false if there is
+    // already something to read, in which case the caller should read that before it goes to sleep.
+    bool request_wakeup();
+
+private:
+    struct SharedHeader {
+        AK_CACHE_ALIGNED Atomic<size_t> write_offset { 0 };
+        AK_CACHE_ALIGNED Atomic<size_t> read_offset { 0 };
+        AK_CACHE_ALIGNED Atomic<u32> wakeup_requested { 1 };
+    };
+
+    struct RecordHeader {
+        RecordType type;
+        u32 size;
+    };
+
+    static constexpr size_t data_offset = round_up_to_power_of_two(sizeof(SharedHeader), 64);
+
+    static constexpr size_t record_size_for(size_t payload_size)
+    {
+        return sizeof(RecordHeader) + round_up_to_power_of_two(payload_size, sizeof(RecordHeader));
+    }
+
+    explicit MessageRing(Core::AnonymousBuffer);
+
+    SharedHeader& header() { return *reinterpret_cast<SharedHeader*>(m_buffer.data<void>()); }
+    u8* data() { return m_buffer.data<u8>() + data_offset; }
+
+    Core::AnonymousBuffer m_buffer;
+};
+
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Span.h>
+#include <AK/StringView.h>
+#include <AK/Variant.h>
+#include <LibCore/AnonymousBuffer.h>
+
+namespace IPC {
+
+// Holds a message argument of a view type, i.e. ReadonlyBytes or StringView.
+//
+// The sender only keeps the view, as messages are encoded before posting them returns. Large views are
+// spilled into an anonymous file, which the receiver maps and points the view into, so their data isn't
+// copied at all. Smaller ones are sent inline, and copied once into the received message.
+// Either way, the view stays valid for as long as the message, so at least until its handler returns.
+template<typename View>
+requires(IsOneOf<View, ReadonlyBytes, StringView>) class ViewArgument {
+public:
+    // Anything smaller is cheaper to copy than to pass through a file.
+    static constexpr size_t spill_threshold = 64 * KiB;
+
+    ViewArgument() = default;
+    ViewArgument(View view)
+    {
+        if constexpr (IsSame<View, StringView>)
+            m_bytes = view.bytes();
+        else
+            m_bytes = view;
+    }
+
+    View view() const { return View { bytes() }; }
+
+    ReadonlyBytes bytes() const
+    {
+        return m_storage.visit(
+            [&](Empty) { return m_bytes; },
+            [](ByteBuffer const& buffer) { return buffer.bytes(); },
+            [&](Core::AnonymousBuffer const& buffer) { return ReadonlyBytes { buffer.data<u8>(), buffer.size() }; });
+    }
+
+    void set_storage(ByteBuffer buffer) { m_storage = move(buffer); }
+    void set_storage(Core::AnonymousBuffer buffer) { m_storage = move(buffer); }
+
+private:
+    ReadonlyBytes m_bytes;
+    // The view is derived from the storage when there is one, so copies of received arguments stay valid.
+    Variant<Empty, ByteBuffer, Core::AnonymousBuffer> m_storage;
+};
+
+}
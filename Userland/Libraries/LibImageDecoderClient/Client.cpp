@@ -4,7 +4,6 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <LibCore/AnonymousBuffer.h>
 #include <LibImageDecoderClient/Client.h>
 
 namespace ImageDecoderClient {
@@ -25,15 +24,7 @@ Optional<DecodedImage> Client::decode_image(ReadonlyBytes encoded_data)
     if (encoded_data.is_empty())
         return {};
 
-    auto encoded_buffer_or_error = Core::AnonymousBuffer::create_with_size(encoded_data.size());
-    if (encoded_buffer_or_error.is_error()) {
-        dbgln("Could not allocate encoded buffer");
-        return {};
-    }
-    auto encoded_buffer = encoded_buffer_or_error.release_value();
-
-    memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
-    auto response_or_error = try_decode_image(move(encoded_buffer));
+    auto response_or_error = try_decode_image(encoded_data);
 
     if (response_or_error.is_error()) {
         dbgln("ImageDecoder died heroically");
@@ -27,11 +27,7 @@ RefPtr<Request> RequestClient::start_request(String const& method, URL const& ur
     for (auto& it : request_headers)
         header_dictionary.add(it.key, it.value);
 
-    auto body_result = ByteBuffer::copy(request_body);
-    if (body_result.is_error())
-        return nullptr;
-
-    auto response = IPCProxy::start_request(method, url, header_dictionary, body_result.release_value(), proxy_data);
+    auto response = IPCProxy::start_request(method, url, header_dictionary, request_body, proxy_data);
     auto request_id = response.request_id();
     if (request_id < 0 || !response.response_fd().has_value())
         return nullptr;
@@ -24,6 +24,12 @@ static constexpr int MAX_TEXTURE_SIZE = 2048;
 static constexpr float MAX_TEXTURE_LOD_BIAS = 2.f;
 static constexpr int SUBPIXEL_BITS = 4;
 
+// Triangles are binned into square tiles of this size, which are rasterized in parallel.
+// This must be even so that pixel quads never straddle two tiles.
+static constexpr int TILE_SIZE = 64;
+// Batches with fewer triangles than this are rasterized on the calling thread.
+static constexpr size_t MIN_TRIANGLES_FOR_PARALLEL_RASTERIZATION = 16;
+
 // See: https://www.khronos.org/opengl/wiki/Common_Mistakes#Texture_edge_color_problem
 // FIXME: make this dynamically configurable through ConfigServer
 static constexpr bool CLAMP_DEPRECATED_BEHAVIOR = false;
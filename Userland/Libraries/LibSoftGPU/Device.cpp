@@ -282,7 +282,6 @@ ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_covera
     auto const qy1 = render_bounds_bottom & ~1;
 
     // Rasterize all quads
-    // FIXME: this could be embarrassingly parallel
     for (int qy = qy0; qy <= qy1; qy += 2) {
         for (int qx = qx0; qx <= qx1; qx += 2) {
             PixelQuad quad;
@@ -674,7 +673,7 @@ void Device::rasterize_point(GPU::Vertex& point)
         rasterize_point_aliased(point);
 }
 
-void Device::rasterize_triangle(Triangle& triangle)
+void Device::rasterize_triangle(Triangle const& triangle, Gfx::IntRect const& tile_rect)
 {
     INCREASE_STATISTICS_COUNTER(g_num_rasterized_triangles, 1);
 
@@ -698,14 +697,16 @@ void Device::rasterize_triangle(Triangle& triangle)
     }
 
     // Force counter-clockwise ordering of vertices
+    auto const* first_vertex = &triangle.vertices[0];
+    auto const* second_vertex = &triangle.vertices[1];
     if (triangle_area < 0) {
-        swap(triangle.vertices[0], triangle.vertices[1]);
+        swap(first_vertex, second_vertex);
         swap(v0, v1);
         triangle_area *= -1;
     }
 
-    auto const& vertex0 = triangle.vertices[0];
-    auto const& vertex1 = triangle.vertices[1];
+    auto const& vertex0 = *first_vertex;
+    auto const& vertex1 = *second_vertex;
     auto const& vertex2 = triangle.vertices[2];
 
     auto const one_over_area = 1.0f / triangle_area;
@@ -784,6 +785,9 @@ void Device::rasterize_triangle(Triangle& triangle)
         expand4(vertex2.window_coordinates.z() + depth_offset),
     };
 
+    // Only touch the pixels of the tile we are rasterizing; the triangle's other tiles might be drawn concurrently
+    render_bounds.intersect(tile_rect);
+
     rasterize(
         render_bounds,
         [&](auto& quad) {
@@ -1199,8 +1203,81 @@ void Device::draw_primitives(GPU::PrimitiveType primitive_type, FloatMatrix4x4 c
         }
     }
 
-    for (auto& triangle : m_processed_triangles)
-        rasterize_triangle(triangle);
+    rasterize_processed_triangles();
+}
+
+void Device::rasterize_processed_triangles()
+{
+    auto const frame_buffer_rect = m_frame_buffer->rect();
+
+    // The statistics counters are not thread-safe, so we stay on this thread if they are enabled
+    if constexpr (!ENABLE_STATISTICS_OVERLAY) {
+        if (!m_tried_to_create_worker_pool && m_processed_triangles.size() >= MIN_TRIANGLES_FOR_PARALLEL_RASTERIZATION) {
+            m_worker_pool = WorkerPool::try_create_for_available_processors();
+            m_tried_to_create_worker_pool = true;
+        }
+    }
+
+    if (!m_worker_pool || m_processed_triangles.size() < MIN_TRIANGLES_FOR_PARALLEL_RASTERIZATION) {
+        for (auto const& triangle : m_processed_triangles)
+            rasterize_triangle(triangle, frame_buffer_rect);
+        return;
+    }
+
+    // Bin each triangle into every tile that its bounding box overlaps. A tile is rasterized by a single
+    // thread that draws its triangles in submission order, so the result is the same as drawing the
+    // triangles one by one, while tiles do not share any pixels and can be rasterized in parallel.
+    auto const horizontal_tile_count = ceil_div(frame_buffer_rect.width(), TILE_SIZE);
+    auto const vertical_tile_count = ceil_div(frame_buffer_rect.height(), TILE_SIZE);
+    m_tile_bins.resize(horizontal_tile_count * vertical_tile_count);
+    for (auto& bin : m_tile_bins)
+        bin.clear_with_capacity();
+
+    auto binning_rect = frame_buffer_rect;
+    if (m_options.scissor_enabled)
+        binning_rect.intersect(m_options.scissor_box);
+
+    for (size_t i = 0; i < m_processed_triangles.size(); ++i) {
+        auto const& vertices = m_processed_triangles[i].vertices;
+        auto const min_x = min(min(vertices[0].window_coordinates.x(), vertices[1].window_coordinates.x()), vertices[2].window_coordinates.x());
+        auto const max_x = max(max(vertices[0].window_coordinates.x(), vertices[1].window_coordinates.x()), vertices[2].window_coordinates.x());
+        auto const min_y = min(min(vertices[0].window_coordinates.y(), vertices[1].window_coordinates.y()), vertices[2].window_coordinates.y());
+        auto const max_y = max(max(vertices[0].window_coordinates.y(), vertices[1].window_coordinates.y()), vertices[2].window_coordinates.y());
+
+        // Rounding to subpixels can move the rasterized edges slightly, so we add a pixel on each side
+        Gfx::IntRect bounds {
+            static_cast<int>(floorf(min_x)) - 1,
+            static_cast<int>(floorf(min_y)) - 1,
+            static_cast<int>(ceilf(max_x) - floorf(min_x)) + 3,
+            static_cast<int>(ceilf(max_y) - floorf(min_y)) + 3,
+        };
+        bounds.intersect(binning_rect);
+        if (bounds.is_empty())
+            continue;
+
+        for (int tile_y = bounds.top() / TILE_SIZE; tile_y <= bounds.bottom() / TILE_SIZE; ++tile_y) {
+            for (int tile_x = bounds.left() / TILE_SIZE; tile_x <= bounds.right() / TILE_SIZE; ++tile_x)
+                m_tile_bins[tile_y * horizontal_tile_count + tile_x].append(i);
+        }
+    }
+
+    m_occupied_tiles.clear_with_capacity();
+    for (size_t tile_index = 0; tile_index < m_tile_bins.size(); ++tile_index) {
+        if (!m_tile_bins[tile_index].is_empty())
+            m_occupied_tiles.append(tile_index);
+    }
+
+    m_worker_pool->run(m_occupied_tiles.size(), [&](size_t job_index) {
+        auto const tile_index = m_occupied_tiles[job_index];
+        Gfx::IntRect const tile_rect {
+            static_cast<int>(tile_index % horizontal_tile_count) * TILE_SIZE,
+            static_cast<int>(tile_index / horizontal_tile_count) * TILE_SIZE,
+            TILE_SIZE,
+            TILE_SIZE,
+        };
+        for (auto triangle_index : m_tile_bins[tile_index])
+            rasterize_triangle(m_processed_triangles[triangle_index], tile_rect);
+    });
 }
 
 ALWAYS_INLINE void Device::shade_fragments(PixelQuad& quad)
@@ -9,6 +9,7 @@
 
 #include <AK/Array.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibGPU/Device.h>
@@ -36,6 +37,7 @@
 #include <LibSoftGPU/Config.h>
 #include <LibSoftGPU/Sampler.h>
 #include <LibSoftGPU/Triangle.h>
+#include <LibSoftGPU/WorkerPool.h>
 
 namespace SoftGPU {
 
@@ -96,7 +98,8 @@ private:
     void rasterize_point_antialiased(GPU::Vertex&);
     void rasterize_point(GPU::Vertex&);
 
-    void rasterize_triangle(Triangle&);
+    void rasterize_triangle(Triangle const&, Gfx::IntRect const& tile_rect);
+    void rasterize_processed_triangles();
     void setup_blend_factors();
     void shade_fragments(PixelQuad&);
 
@@ -107,6 +110,10 @@ private:
     Vector<Triangle> m_triangle_list;
     Vector<Triangle> m_processed_triangles;
     Vector<GPU::Vertex> m_clipped_vertices;
+    Vector<Vector<u32>> m_tile_bins;
+    Vector<size_t> m_occupied_tiles;
+    OwnPtr<WorkerPool> m_worker_pool;
+    bool m_tried_to_create_worker_pool { false };
     Array<Sampler, GPU::NUM_TEXTURE_UNITS> m_samplers;
     AlphaBlendFactors m_alpha_blend_factors;
     Array<GPU::Light, NUM_LIGHTS> m_lights;
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibSoftGPU/WorkerPool.h>
+
+#ifdef AK_OS_SERENITY
+#    include <AK/JsonArray.h>
+#    include <AK/JsonValue.h>
+#    include <LibCore/File.h>
+#else
+#    include <unistd.h>
+#endif
+
+namespace SoftGPU {
+
+static size_t available_processor_count()
+{
+#ifdef AK_OS_SERENITY
+    // If /sys/kernel/cpuinfo is not unveiled to us, we simply stay on the calling thread.
+    auto file = Core::File::open("/sys/kernel/cpuinfo", Core::OpenMode::ReadOnly);
+    if (file.is_error())
+        return 1;
+    auto json = JsonValue::from_string(file.value()->read_all());
+    if (json.is_error() || !json.value().is_array())
+        return 1;
+    return max<size_t>(json.value().as_array().size(), 1);
+#else
+    auto count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? static_cast<size_t>(count) : 1;
+#endif
+}
+
+OwnPtr<WorkerPool> WorkerPool::try_create_for_available_processors()
+{
+    auto processor_count = available_processor_count();
+    if (processor_count <= 1)
+        return {};
+    // The calling thread does its share of the work, too.
+    return make<WorkerPool>(processor_count - 1);
+}
+
+WorkerPool::WorkerPool(size_t thread_count)
+{
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto thread = Threading::Thread::construct([this] { return worker_main(); }, String::formatted("SoftGPU worker {}", i));
+        thread->start();
+        m_threads.append(move(thread));
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_should_exit = true;
+        m_batch_available.broadcast();
+    }
+    for (auto& thread : m_threads)
+        (void)thread.join();
+}
+
+void WorkerPool::Batch::run_jobs()
+{
+    for (;;) {
+        auto index = next_job.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        if (index >= job_count)
+            return;
+        job(index);
+    }
+}
+
+intptr_t WorkerPool::worker_main()
+{
+    Threading::MutexLocker locker(m_mutex);
+    u64 last_batch_generation = 0;
+    for (;;) {
+        while (!m_should_exit && (m_current_batch == nullptr || m_batch_generation == last_batch_generation))
+            m_batch_available.wait();
+        if (m_should_exit)
+            return 0;
+
+        last_batch_generation = m_batch_generation;
+        auto& batch = *m_current_batch;
+        ++batch.active_workers;
+        locker.unlock();
+
+        batch.run_jobs();
+
+        locker.lock();
+        if (--batch.active_workers == 0)
+            m_workers_finished.signal();
+    }
+}
+
+void WorkerPool::run(size_t job_count, Function<void(size_t)> const& job)
+{
+    if (job_count <= 1) {
+        if (job_count == 1)
+            job(0);
+        return;
+    }
+
+    Batch batch { .job = job, .job_count = job_count };
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_current_batch = &batch;
+        ++m_batch_generation;
+        m_batch_available.broadcast();
+    }
+
+    batch.run_jobs();
+
+    // Once the batch is withdrawn no more workers can pick it up, so waiting for the ones
+    // that did makes sure that every job has finished.
+    Threading::MutexLocker locker(m_mutex);
+    m_current_batch = nullptr;
+    while (batch.active_workers > 0)
+        m_workers_finished.wait();
+}
+
+}
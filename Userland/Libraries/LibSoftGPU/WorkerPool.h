@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/OwnPtr.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace SoftGPU {
+
+// A fixed set of threads that help the calling thread work through a batch of independent jobs.
+class WorkerPool {
+public:
+    // Returns a pool sized to the number of processors, or nothing if there is only one processor
+    // available to us. Processes that create worker threads need the "thread" pledge.
+    static OwnPtr<WorkerPool> try_create_for_available_processors();
+
+    explicit WorkerPool(size_t thread_count);
+    ~WorkerPool();
+
+    // Calls job(i) once for every i below job_count, on the worker threads and the calling thread,
+    // and returns once all of them have finished. Jobs are started in ascending order.
+    void run(size_t job_count, Function<void(size_t)> const& job);
+
+private:
+    struct Batch {
+        Function<void(size_t)> const& job;
+        size_t job_count { 0 };
+        Atomic<size_t> next_job { 0 };
+        size_t active_workers { 0 };
+
+        void run_jobs();
+    };
+
+    intptr_t worker_main();
+
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_batch_available { m_mutex };
+    Threading::ConditionVariable m_workers_finished { m_mutex };
+    Batch* m_current_batch { nullptr };
+    u64 m_batch_generation { 0 };
+    bool m_should_exit { false };
+    NonnullRefPtrVector<Threading::Thread> m_threads;
+};
+
+}
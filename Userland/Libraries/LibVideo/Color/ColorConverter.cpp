@@ -6,6 +6,7 @@
 
 #include <AK/Format.h>
 #include <AK/Math.h>
+#include <AK/SIMDExtras.h>
 #include <AK/StdLibExtras.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibVideo/Color/ColorPrimaries.h>
@@ -260,4 +261,42 @@ Gfx::Color ColorConverter::convert_yuv_to_full_range_rgb(u16 y, u16 u, u16 v)
     return Gfx::Color(r, g, b);
 }
 
+void ColorConverter::convert_yuv_to_full_range_rgb(Span<u16 const> y_row, Span<u16 const> u_row, Span<u16 const> v_row, Span<Gfx::ARGB32> output_row)
+{
+    auto count = output_row.size();
+    VERIFY(y_row.size() >= count && u_row.size() >= count && v_row.size() >= count);
+
+    size_t column = 0;
+    if (m_should_skip_color_remapping) {
+        // Without color remapping, the conversion is a single matrix multiplication, so convert four pixels at once.
+        // This does the same float operations in the same order as the matrix multiplication, so the results match.
+        using namespace AK::SIMD;
+        auto const& matrix = m_input_conversion_matrix.elements();
+        auto load_samples = [](u16 const* samples) {
+            u16x4 result;
+            __builtin_memcpy(&result, samples, sizeof(result));
+            return to_f32x4(result);
+        };
+        auto to_color_component = [](f32x4 value) {
+            value = value < 0.0f ? expand4(0.0f) : value;
+            value = value > 1.0f ? expand4(1.0f) : value;
+            return to_u32x4(value * 255.0f);
+        };
+
+        for (; column + 4 <= count; column += 4) {
+            auto y = load_samples(&y_row[column]);
+            auto u = load_samples(&u_row[column]);
+            auto v = load_samples(&v_row[column]);
+            auto r = to_color_component(y * matrix[0][0] + u * matrix[0][1] + v * matrix[0][2] + matrix[0][3]);
+            auto g = to_color_component(y * matrix[1][0] + u * matrix[1][1] + v * matrix[1][2] + matrix[1][3]);
+            auto b = to_color_component(y * matrix[2][0] + u * matrix[2][1] + v * matrix[2][2] + matrix[2][3]);
+            u32x4 colors = expand4(0xff000000u) | (r << 16) | (g << 8) | b;
+            __builtin_memcpy(&output_row[column], &colors, sizeof(colors));
+        }
+    }
+
+    for (; column < count; column++)
+        output_row[column] = convert_yuv_to_full_range_rgb(y_row[column], u_row[column], v_row[column]).value();
+}
+
 }
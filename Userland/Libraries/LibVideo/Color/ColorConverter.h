@@ -64,6 +64,8 @@ public:
     static DecoderErrorOr<ColorConverter> create(u8 bit_depth, CodingIndependentCodePoints cicp);
 
     Gfx::Color convert_yuv_to_full_range_rgb(u16 y, u16 u, u16 v);
+    // Converts a row of pixels, with one sample of each plane per pixel.
+    void convert_yuv_to_full_range_rgb(Span<u16 const> y_row, Span<u16 const> u_row, Span<u16 const> v_row, Span<Gfx::ARGB32> output_row);
 
 private:
     static constexpr size_t to_linear_size = 64;
@@ -5,6 +5,7 @@
  */
 
 #include <AK/Format.h>
+#include <LibCore/Event.h>
 #include <LibCore/Timer.h>
 #include <LibVideo/MatroskaReader.h>
 #include <LibVideo/VP9/Decoder.h>
@@ -14,20 +15,6 @@
 
 namespace Video {
 
-// We post DecoderErrors to the event queue to be handled, since some will occur off the main thread.
-#define TRY_OR_POST_ERROR_AND_RETURN(expression, return_value)                                         \
-    ({                                                                                                 \
-        auto _temporary_result = ((expression));                                                       \
-        if (_temporary_result.is_error()) {                                                            \
-            dbgln("Playback error encountered: {}", _temporary_result.error().string_literal());       \
-            m_main_loop.post_event(*this, make<DecoderErrorEvent>(_temporary_result.release_error())); \
-            return return_value;                                                                       \
-        }                                                                                              \
-        _temporary_result.release_value();                                                             \
-    })
-
-#define TRY_OR_POST_ERROR(expression) TRY_OR_POST_ERROR_AND_RETURN(expression, )
-
 DecoderErrorOr<NonnullRefPtr<PlaybackManager>> PlaybackManager::from_file(Object* event_handler, StringView filename)
 {
     NonnullOwnPtr<Demuxer> demuxer = TRY(MatroskaDemuxer::from_file(filename));
@@ -48,17 +35,25 @@ PlaybackManager::PlaybackManager(Object* event_handler, NonnullOwnPtr<Demuxer>&
     , m_demuxer(move(demuxer))
     , m_selected_video_track(video_track)
     , m_decoder(move(decoder))
+    , m_decode_thread(Threading::Thread::construct([this] { return decode_thread_loop(); }, "Video Decoder"sv))
     , m_frame_queue(make<VideoFrameQueue>())
     , m_present_timer(Core::Timer::construct())
-    , m_decode_timer(Core::Timer::construct())
 {
     m_present_timer->set_single_shot(true);
     m_present_timer->set_interval(0);
     m_present_timer->on_timeout = [&] { update_presented_frame(); };
 
-    m_decode_timer->set_single_shot(true);
-    m_decode_timer->set_interval(0);
-    m_decode_timer->on_timeout = [&] { on_decode_timer(); };
+    m_decode_thread->start();
+}
+
+PlaybackManager::~PlaybackManager()
+{
+    {
+        Threading::MutexLocker locker(m_decode_mutex);
+        m_stop_decoding = true;
+        m_decode_wait_condition.signal();
+    }
+    (void)m_decode_thread->join();
 }
 
 void PlaybackManager::set_playback_status(PlaybackStatus status)
@@ -71,7 +66,6 @@ void PlaybackManager::set_playback_status(PlaybackStatus status)
         if (status == PlaybackStatus::Playing) {
             if (old_status == PlaybackStatus::Stopped) {
                 restart_playback();
-                m_frame_queue->clear();
                 m_skipped_frames = 0;
             }
             m_last_present_in_real_time = Time::now_monotonic();
@@ -88,6 +82,11 @@ void PlaybackManager::set_playback_status(PlaybackStatus status)
 
 void PlaybackManager::event(Core::Event& event)
 {
+    if (event.type() == Core::Event::Custom && static_cast<Core::CustomEvent&>(event).custom_type() == VideoFrameQueued) {
+        on_frame_queued();
+        return;
+    }
+
     if (event.type() == DecoderErrorOccurred) {
         auto& error_event = static_cast<DecoderErrorEvent&>(event);
         VERIFY(error_event.error().category() != DecoderErrorCategory::EndOfStream);
@@ -111,11 +110,11 @@ bool PlaybackManager::prepare_next_frame()
 {
     if (m_next_frame.has_value())
         return true;
+    Threading::MutexLocker locker(m_decode_mutex);
     if (m_frame_queue->is_empty())
         return false;
-    auto frame_item = m_frame_queue->dequeue();
-    m_next_frame.emplace(frame_item);
-    m_decode_timer->start();
+    m_next_frame.emplace(m_frame_queue->dequeue());
+    m_decode_wait_condition.signal();
     return true;
 }
 
@@ -147,12 +146,18 @@ void PlaybackManager::update_presented_frame()
         if (frame_item_to_display.has_value()) {
             dbgln_if(PLAYBACK_MANAGER_DEBUG, "At {}ms: Dropped frame with timestamp {}ms for the next at {}ms", current_playback_time().to_milliseconds(), frame_item_to_display->timestamp.to_milliseconds(), m_next_frame->timestamp.to_milliseconds());
             m_skipped_frames++;
+            Threading::MutexLocker locker(m_decode_mutex);
+            return_bitmap_to_pool(move(frame_item_to_display->bitmap));
         }
         frame_item_to_display = m_next_frame.release_value();
     }
 
     if (!out_of_queued_frames && frame_item_to_display.has_value()) {
         m_main_loop.post_event(*this, make<VideoFramePresentEvent>(frame_item_to_display->bitmap));
+        {
+            Threading::MutexLocker locker(m_decode_mutex);
+            return_bitmap_to_pool(exchange(m_previously_presented_frame, exchange(m_presented_frame, frame_item_to_display->bitmap)));
+        }
         m_last_present_in_media_time = current_playback_time();
         m_last_present_in_real_time = Time::now_monotonic();
         frame_item_to_display.clear();
@@ -182,63 +187,144 @@ void PlaybackManager::update_presented_frame()
     }
 
     set_playback_status(PlaybackStatus::Buffering);
-    m_decode_timer->start();
 }
 
 void PlaybackManager::restart_playback()
 {
     m_last_present_in_media_time = Time::zero();
     m_last_present_in_real_time = Time::zero();
-    TRY_OR_POST_ERROR(m_demuxer->seek_to_most_recent_keyframe(m_selected_video_track, 0));
+
+    Threading::MutexLocker locker(m_decode_mutex);
+    while (!m_frame_queue->is_empty())
+        return_bitmap_to_pool(m_frame_queue->dequeue().bitmap);
+    m_reached_end_of_stream = false;
+    m_restart_requested = true;
+    m_decode_wait_condition.signal();
 }
 
-bool PlaybackManager::decode_and_queue_one_sample()
+void PlaybackManager::on_frame_queued()
 {
-    if (m_frame_queue->size() >= FRAME_BUFFER_COUNT)
-        return false;
-#if PLAYBACK_MANAGER_DEBUG
-    auto start_time = Time::now_monotonic();
-#endif
+    if (!is_buffering())
+        return;
 
-    auto frame_sample_result = m_demuxer->get_next_video_sample_for_track(m_selected_video_track);
-    if (frame_sample_result.is_error()) {
-        if (frame_sample_result.error().category() == DecoderErrorCategory::EndOfStream) {
-            m_frame_queue->enqueue(FrameQueueItem::eos_marker());
-            return false;
+    // Only start playing again once the queue is full, so that we don't immediately run out of frames again.
+    bool finished_buffering = false;
+    {
+        Threading::MutexLocker locker(m_decode_mutex);
+        finished_buffering = m_frame_queue->size() >= FRAME_BUFFER_COUNT || m_reached_end_of_stream;
+    }
+    if (finished_buffering)
+        set_playback_status(PlaybackStatus::Playing);
+}
+
+// Must be called with m_decode_mutex held.
+void PlaybackManager::return_bitmap_to_pool(RefPtr<Gfx::Bitmap> bitmap)
+{
+    if (!bitmap)
+        return;
+    // The frame handler may have kept a reference to a presented frame, which must not be drawn over.
+    // Note: Presented frames are only referenced on the main thread, which is where they are returned from,
+    //       so the reference count can't change under us here.
+    if (bitmap->ref_count() != 1)
+        return;
+    // The queued frames, the presented ones and the one being decoded shouldn't need more than this.
+    if (m_bitmap_pool.size() < FRAME_BUFFER_COUNT + 3)
+        m_bitmap_pool.append(bitmap.release_nonnull());
+}
+
+void PlaybackManager::post_decoder_error(DecoderError error)
+{
+    dbgln("Playback error encountered: {}", error.string_literal());
+    m_main_loop.post_event(*this, make<DecoderErrorEvent>(move(error)), Core::EventLoop::ShouldWake::Yes);
+}
+
+intptr_t PlaybackManager::decode_thread_loop()
+{
+    while (true) {
+        bool should_restart = false;
+        {
+            Threading::MutexLocker locker(m_decode_mutex);
+            while (!m_stop_decoding && !m_restart_requested && (m_reached_end_of_stream || m_frame_queue->size() >= FRAME_BUFFER_COUNT))
+                m_decode_wait_condition.wait();
+            if (m_stop_decoding)
+                return 0;
+            should_restart = exchange(m_restart_requested, false);
         }
-        m_main_loop.post_event(*this, make<DecoderErrorEvent>(frame_sample_result.release_error()));
-        return false;
+
+        if (should_restart) {
+            auto seek_result = m_demuxer->seek_to_most_recent_keyframe(m_selected_video_track, 0);
+            if (seek_result.is_error()) {
+                post_decoder_error(seek_result.release_error());
+                Threading::MutexLocker locker(m_decode_mutex);
+                m_reached_end_of_stream = true;
+                continue;
+            }
+        }
+
+        decode_and_queue_one_sample();
     }
-    auto frame_sample = frame_sample_result.release_value();
+}
 
-    TRY_OR_POST_ERROR_AND_RETURN(m_decoder->receive_sample(frame_sample->data()), false);
-    auto decoded_frame = TRY_OR_POST_ERROR_AND_RETURN(m_decoder->get_decoded_frame(), false);
+DecoderErrorOr<FrameQueueItem> PlaybackManager::decode_one_sample()
+{
+    auto frame_sample = TRY(m_demuxer->get_next_video_sample_for_track(m_selected_video_track));
+
+    TRY(m_decoder->receive_sample(frame_sample->data()));
+    auto decoded_frame = TRY(m_decoder->get_decoded_frame());
 
     auto& cicp = decoded_frame->cicp();
     cicp.adopt_specified_values(frame_sample->container_cicp());
     cicp.default_code_points_if_unspecified({ Video::ColorPrimaries::BT709, Video::TransferCharacteristics::BT709, Video::MatrixCoefficients::BT709, Video::ColorRange::Studio });
 
-    auto bitmap = TRY_OR_POST_ERROR_AND_RETURN(decoded_frame->to_bitmap(), false);
-    m_frame_queue->enqueue(FrameQueueItem { bitmap, frame_sample->timestamp() });
+    auto bitmap = TRY(get_bitmap_for_frame(decoded_frame->size()));
+    TRY(decoded_frame->output_to_bitmap(bitmap));
+    return FrameQueueItem { bitmap, frame_sample->timestamp() };
+}
+
+DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> PlaybackManager::get_bitmap_for_frame(Gfx::IntSize size)
+{
+    {
+        Threading::MutexLocker locker(m_decode_mutex);
+        // Bitmaps of a previous frame size won't be used again.
+        m_bitmap_pool.remove_all_matching([&](auto& bitmap) { return bitmap->size() != size; });
+        if (!m_bitmap_pool.is_empty())
+            return m_bitmap_pool.take_last();
+    }
+
+    return DECODER_TRY_ALLOC(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, size));
+}
+
+void PlaybackManager::decode_and_queue_one_sample()
+{
+#if PLAYBACK_MANAGER_DEBUG
+    auto start_time = Time::now_monotonic();
+#endif
+
+    auto frame_item_result = decode_one_sample();
 
 #if PLAYBACK_MANAGER_DEBUG
     auto end_time = Time::now_monotonic();
     dbgln("Decoding took {}ms", (end_time - start_time).to_milliseconds());
 #endif
 
-    return true;
-}
-
-void PlaybackManager::on_decode_timer()
-{
-    if (!decode_and_queue_one_sample() && is_buffering()) {
-        set_playback_status(PlaybackStatus::Playing);
+    Threading::MutexLocker locker(m_decode_mutex);
+    // Playback was restarted while we were decoding, so this frame is no longer wanted.
+    if (m_restart_requested) {
+        if (!frame_item_result.is_error())
+            return_bitmap_to_pool(frame_item_result.release_value().bitmap);
         return;
     }
 
-    // Continually decode until buffering is complete
-    if (is_buffering())
-        m_decode_timer->start();
+    if (frame_item_result.is_error()) {
+        m_reached_end_of_stream = true;
+        if (frame_item_result.error().category() == DecoderErrorCategory::EndOfStream)
+            m_frame_queue->enqueue(FrameQueueItem::eos_marker());
+        else
+            post_decoder_error(frame_item_result.release_error());
+    } else {
+        m_frame_queue->enqueue(frame_item_result.release_value());
+    }
+    m_main_loop.wake_once(*this, VideoFrameQueued);
 }
 
 }
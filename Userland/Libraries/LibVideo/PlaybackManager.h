@@ -55,7 +55,7 @@ public:
     static DecoderErrorOr<NonnullRefPtr<PlaybackManager>> from_data(Object* event_handler, Span<u8> data);
 
     PlaybackManager(Object* event_handler, NonnullOwnPtr<Demuxer>& demuxer, Track video_track, NonnullOwnPtr<VideoDecoder>& decoder);
-    ~PlaybackManager() override = default;
+    ~PlaybackManager() override;
 
     void resume_playback();
     void pause_playback();
@@ -71,6 +71,8 @@ public:
     Time current_playback_time();
     Time duration();
 
+    // The bitmap is reused for a later frame once two newer frames have been presented, unless the handler
+    // still holds a reference to it by then.
     Function<void(NonnullRefPtr<Gfx::Bitmap>, Time)> on_frame_present;
 
 private:
@@ -79,9 +81,15 @@ private:
     bool prepare_next_frame();
     void update_presented_frame();
 
+    void on_frame_queued();
+    void return_bitmap_to_pool(RefPtr<Gfx::Bitmap>);
+    void post_decoder_error(DecoderError);
+
     // Runs off the main thread
-    bool decode_and_queue_one_sample();
-    void on_decode_timer();
+    intptr_t decode_thread_loop();
+    DecoderErrorOr<FrameQueueItem> decode_one_sample();
+    DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> get_bitmap_for_frame(Gfx::IntSize);
+    void decode_and_queue_one_sample();
 
     Core::EventLoop& m_main_loop;
 
@@ -93,13 +101,28 @@ private:
     Track m_selected_video_track;
     NonnullOwnPtr<VideoDecoder> m_decoder;
 
+    // The decode thread keeps the frame queue filled ahead of presentation, so that a slow frame
+    // only eats into the time that the queued frames cover, instead of delaying the frame itself.
+    // The demuxer and the decoder are only used by the decode thread once it has been started.
+    Threading::Mutex m_decode_mutex;
+    Threading::ConditionVariable m_decode_wait_condition { m_decode_mutex };
+    NonnullRefPtr<Threading::Thread> m_decode_thread;
+    // These are guarded by m_decode_mutex.
     NonnullOwnPtr<VideoFrameQueue> m_frame_queue;
+    bool m_restart_requested { false };
+    bool m_reached_end_of_stream { false };
+    bool m_stop_decoding { false };
+    // Frames are converted into bitmaps from this pool, so that playback doesn't allocate and map a new bitmap
+    // for every frame. The main thread hands bitmaps back once they were dropped or replaced on screen.
+    Vector<NonnullRefPtr<Gfx::Bitmap>> m_bitmap_pool;
+
     Optional<FrameQueueItem> m_next_frame;
+    // The event handler may still be showing the previously presented frame until it has handled the newest one,
+    // so both of them are kept out of the pool.
+    RefPtr<Gfx::Bitmap> m_presented_frame;
+    RefPtr<Gfx::Bitmap> m_previously_presented_frame;
 
     NonnullRefPtr<Core::Timer> m_present_timer;
-    unsigned m_decoding_buffer_time_ms = 16;
-
-    NonnullRefPtr<Core::Timer> m_decode_timer;
 
     u64 m_skipped_frames;
 };
@@ -108,6 +131,7 @@ enum EventType : unsigned {
     DecoderErrorOccurred = (('v' << 2) | ('i' << 1) | 'd') << 4,
     VideoFramePresent,
     PlaybackStatusChange,
+    VideoFrameQueued,
 };
 
 class DecoderErrorEvent : public Core::Event {
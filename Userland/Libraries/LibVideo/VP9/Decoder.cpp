@@ -6,6 +6,7 @@
  */
 
 #include <AK/IntegralMath.h>
+#include <AK/SIMDExtras.h>
 #include <LibGfx/Size.h>
 #include <LibVideo/Color/CodingIndependentCodePoints.h>
 
@@ -397,8 +398,7 @@ DecoderErrorOr<void> Decoder::predict_intra(u8 plane, u32 x, u32 y, bool have_le
     //           - [1 .. block_size]
     //           - [block_size + 1 .. block_size * 2]
     //       The array indices must be offset by 1 to accomodate index -1.
-    Vector<Intermediate>& above_row = m_buffers.above_row;
-    DECODER_TRY_ALLOC(above_row.try_resize_and_keep_capacity(block_size * 2 + 1));
+    auto& above_row = m_buffers.above_row;
     auto above_row_at = [&](i32 index) -> Intermediate& {
         return above_row[index + 1];
     };
@@ -445,8 +445,7 @@ DecoderErrorOr<void> Decoder::predict_intra(u8 plane, u32 x, u32 y, bool have_le
     }
 
     // The array leftCol[ i ] for i = 0..size-1 is specified by:
-    Vector<Intermediate>& left_column = m_buffers.left_column;
-    DECODER_TRY_ALLOC(left_column.try_resize_and_keep_capacity(block_size));
+    auto& left_column = m_buffers.left_column;
     if (have_left) {
         // − If haveLeft is equal to 1, leftCol[ i ] is set equal to CurrFrame[ plane ][ Min(maxY, y+i) ][ x-1 ].
         for (auto i = 0u; i < block_size; i++)
@@ -458,8 +457,7 @@ DecoderErrorOr<void> Decoder::predict_intra(u8 plane, u32 x, u32 y, bool have_le
     }
 
     // A 2D array named pred containing the intra predicted samples is constructed as follows:
-    Vector<Intermediate>& predicted_samples = m_buffers.predicted_samples;
-    DECODER_TRY_ALLOC(predicted_samples.try_resize_and_keep_capacity(block_size * block_size));
+    auto& predicted_samples = m_buffers.predicted_samples;
     auto const predicted_sample_at = [&](u32 row, u32 column) -> Intermediate& {
         return predicted_samples[index_from_row_and_column(row, column, block_size)];
     };
@@ -770,7 +768,7 @@ MotionVector Decoder::clamp_motion_vector(u8 plane, MotionVector vector)
     };
 }
 
-DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, u8 ref_list, u32 x, u32 y, u32 width, u32 height, u32 block_index, Vector<u16>& block_buffer)
+DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, u8 ref_list, u32 x, u32 y, u32 width, u32 height, u32 block_index, Span<u16> block_buffer)
 {
     // 2. The motion vector selection process in section 8.5.2.1 is invoked with plane, refList, blockIdx as inputs
     // and the output being the motion vector mv.
@@ -873,24 +871,25 @@ DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, u8 ref_list, u32 x,
     // − variables w and h giving the width and height of the block in units of samples
     // The output from this process is the 2D array named pred containing inter predicted samples.
 
+    // The variable lastX is set equal to ( (RefFrameWidth[ refIdx ] + subX) >> subX) - 1.
+    // The variable lastY is set equal to ( (RefFrameHeight[ refIdx ] + subY) >> subY) - 1.
+    // (lastX and lastY specify the coordinates of the bottom right sample of the reference plane.)
+    i32 scaled_right = ((m_parser->m_ref_frame_width[reference_frame_index] + subsampling_x) >> subsampling_x) - 1;
+    i32 scaled_bottom = ((m_parser->m_ref_frame_height[reference_frame_index] + subsampling_y) >> subsampling_y) - 1;
+
     // A variable ref specifying the reference frame contents is set equal to FrameStore[ refIdx ].
+    // NOTE: The reference frame is stored with a stride of lastX + 1, see update_reference_frames().
     auto& reference_frame_buffer = m_parser->m_frame_store[reference_frame_index][plane];
-    auto reference_frame_width = m_parser->m_ref_frame_width[reference_frame_index] >> subsampling_x;
+    auto reference_frame_width = static_cast<u32>(scaled_right + 1);
     auto reference_frame_buffer_at = [&](u32 row, u32 column) -> u16& {
         return reference_frame_buffer[row * reference_frame_width + column];
     };
 
-    block_buffer.resize_and_keep_capacity(width * height);
+    VERIFY(width <= maximum_block_size && height <= maximum_block_size && width % 4 == 0);
     auto block_buffer_at = [&](u32 row, u32 column) -> u16& {
         return block_buffer[row * width + column];
     };
 
-    // The variable lastX is set equal to ( (RefFrameWidth[ refIdx ] + subX) >> subX) - 1.
-    // The variable lastY is set equal to ( (RefFrameHeight[ refIdx ] + subY) >> subY) - 1.
-    // (lastX and lastY specify the coordinates of the bottom right sample of the reference plane.)
-    i32 scaled_right = ((m_parser->m_ref_frame_width[reference_frame_index] + subsampling_x) >> subsampling_x) - 1;
-    i32 scaled_bottom = ((m_parser->m_ref_frame_height[reference_frame_index] + subsampling_y) >> subsampling_y) - 1;
-
     // The variable intermediateHeight specifying the height required for the intermediate array is set equal to (((h -
     // 1) * yStep + 15) >> 4) + 8.
     auto intermediate_height = (((height - 1) * scaled_step_y + 15) >> 4) + 8;
@@ -901,38 +900,87 @@ DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, u8 ref_list, u32 x,
     // The filtering is applied as follows:
     // The array intermediate is specified as follows:
     // Note: Height is specified by `intermediate_height`, width is specified by `width`
-    Vector<u16>& intermediate_buffer = m_buffers.inter_horizontal;
-    intermediate_buffer.clear_with_capacity();
-    intermediate_buffer.resize_and_keep_capacity(intermediate_height * width);
+    VERIFY(intermediate_height <= maximum_inter_intermediate_height);
+    auto intermediate_buffer = m_buffers.inter_horizontal.span().trim(intermediate_height * width);
     auto intermediate_buffer_at = [&](u32 row, u32 column) -> u16& {
         return intermediate_buffer[row * width + column];
     };
 
-    for (auto row = 0u; row < intermediate_height; row++) {
-        for (auto column = 0u; column < width; column++) {
-            auto samples_start = offset_scaled_block_x + static_cast<i32>(scaled_step_x * column);
+    // When the reference frame has the same size as the current frame, every sample in the block uses the same
+    // filter, so four samples at a time are filtered with vectors.
+    auto minimum_sample_value = AK::SIMD::expand4(0);
+    auto maximum_sample_value = AK::SIMD::expand4((1 << m_parser->m_bit_depth) - 1);
+    auto filter_4_samples = [&](i32 const* filter, auto get_4_samples) {
+        auto accumulated_samples = AK::SIMD::expand4(0);
+        for (auto t = 0u; t < 8u; t++)
+            accumulated_samples += filter[t] * get_4_samples(t);
+        accumulated_samples = (accumulated_samples + (1 << 6)) >> 7;
+        accumulated_samples = accumulated_samples < minimum_sample_value ? minimum_sample_value : accumulated_samples;
+        accumulated_samples = accumulated_samples > maximum_sample_value ? maximum_sample_value : accumulated_samples;
+        return AK::SIMD::to_u16x4(accumulated_samples);
+    };
+    auto load_4_samples = [](u16 const* samples) {
+        AK::SIMD::u16x4 result;
+        __builtin_memcpy(&result, samples, sizeof(result));
+        return AK::SIMD::to_i32x4(result);
+    };
+    auto store_4_samples = [](u16* destination, AK::SIMD::u16x4 samples) {
+        __builtin_memcpy(destination, &samples, sizeof(samples));
+    };
 
-            i32 accumulated_samples = 0;
-            for (auto t = 0u; t < 8u; t++) {
-                auto sample = reference_frame_buffer_at(
-                    clip_3(0, scaled_bottom, (offset_scaled_block_y >> 4) + static_cast<i32>(row) - 3),
-                    clip_3(0, scaled_right, (samples_start >> 4) + static_cast<i32>(t) - 3));
-                accumulated_samples += subpel_filters[m_parser->m_interp_filter][samples_start & 15][t] * sample;
+    if (scaled_step_x == 16) {
+        auto const* filter = subpel_filters[m_parser->m_interp_filter][offset_scaled_block_x & 15];
+        auto first_column = (offset_scaled_block_x >> 4) - 3;
+        // The row of reference samples that the filter reads from, with the reference frame edges extended.
+        Array<u16, maximum_block_size + 7> reference_row;
+        for (auto row = 0u; row < intermediate_height; row++) {
+            auto reference_row_index = clip_3(0, scaled_bottom, (offset_scaled_block_y >> 4) + static_cast<i32>(row) - 3);
+            for (auto column = 0u; column < width + 7; column++)
+                reference_row[column] = reference_frame_buffer_at(reference_row_index, clip_3(0, scaled_right, first_column + static_cast<i32>(column)));
+
+            for (auto column = 0u; column < width; column += 4) {
+                auto filtered = filter_4_samples(filter, [&](u32 t) { return load_4_samples(&reference_row[column + t]); });
+                store_4_samples(&intermediate_buffer_at(row, column), filtered);
+            }
+        }
+    } else {
+        for (auto row = 0u; row < intermediate_height; row++) {
+            for (auto column = 0u; column < width; column++) {
+                auto samples_start = offset_scaled_block_x + static_cast<i32>(scaled_step_x * column);
+
+                i32 accumulated_samples = 0;
+                for (auto t = 0u; t < 8u; t++) {
+                    auto sample = reference_frame_buffer_at(
+                        clip_3(0, scaled_bottom, (offset_scaled_block_y >> 4) + static_cast<i32>(row) - 3),
+                        clip_3(0, scaled_right, (samples_start >> 4) + static_cast<i32>(t) - 3));
+                    accumulated_samples += subpel_filters[m_parser->m_interp_filter][samples_start & 15][t] * sample;
+                }
+                intermediate_buffer_at(row, column) = clip_1(m_parser->m_bit_depth, round_2(accumulated_samples, 7));
             }
-            intermediate_buffer_at(row, column) = clip_1(m_parser->m_bit_depth, round_2(accumulated_samples, 7));
         }
     }
 
-    for (auto row = 0u; row < height; row++) {
-        for (auto column = 0u; column < width; column++) {
-            auto samples_start = (offset_scaled_block_y & 15) + static_cast<i32>(scaled_step_y * row);
-
-            i32 accumulated_samples = 0;
-            for (auto t = 0u; t < 8u; t++) {
-                auto sample = intermediate_buffer_at((samples_start >> 4) + t, column);
-                accumulated_samples += subpel_filters[m_parser->m_interp_filter][samples_start & 15][t] * sample;
+    if (scaled_step_y == 16) {
+        // Each row of the block starts at the same fraction of a sample, so it is filtered from the next 8 rows.
+        auto const* filter = subpel_filters[m_parser->m_interp_filter][offset_scaled_block_y & 15];
+        for (auto row = 0u; row < height; row++) {
+            for (auto column = 0u; column < width; column += 4) {
+                auto filtered = filter_4_samples(filter, [&](u32 t) { return load_4_samples(&intermediate_buffer_at(row + t, column)); });
+                store_4_samples(&block_buffer_at(row, column), filtered);
+            }
+        }
+    } else {
+        for (auto row = 0u; row < height; row++) {
+            for (auto column = 0u; column < width; column++) {
+                auto samples_start = (offset_scaled_block_y & 15) + static_cast<i32>(scaled_step_y * row);
+
+                i32 accumulated_samples = 0;
+                for (auto t = 0u; t < 8u; t++) {
+                    auto sample = intermediate_buffer_at((samples_start >> 4) + t, column);
+                    accumulated_samples += subpel_filters[m_parser->m_interp_filter][samples_start & 15][t] * sample;
+                }
+                block_buffer_at(row, column) = clip_1(m_parser->m_bit_depth, round_2(accumulated_samples, 7));
             }
-            block_buffer_at(row, column) = clip_1(m_parser->m_bit_depth, round_2(accumulated_samples, 7));
         }
     }
 
@@ -956,9 +1004,9 @@ DecoderErrorOr<void> Decoder::predict_inter(u8 plane, u32 x, u32 y, u32 width, u
     // The prediction arrays are formed by the following ordered steps:
     // 1. The variable refList is set equal to 0.
     // 2. through 5.
-    auto predicted_buffer = m_buffers.inter_predicted;
+    auto predicted_buffer = m_buffers.inter_predicted.span();
     TRY(predict_inter_block(plane, 0, x, y, width, height, block_index, predicted_buffer));
-    auto predicted_buffer_at = [&](Vector<u16>& buffer, u32 row, u32 column) -> u16& {
+    auto predicted_buffer_at = [&](Span<u16> buffer, u32 row, u32 column) -> u16& {
         return buffer[row * width + column];
     };
 
@@ -989,7 +1037,7 @@ DecoderErrorOr<void> Decoder::predict_inter(u8 plane, u32 x, u32 y, u32 width, u
 
     // − Otherwise, CurrFrame[ plane ][ y + i ][ x + j ] is set equal to Round2( preds[ 0 ][ i ][ j ] + preds[ 1 ][ i ][ j ], 1 )
     // for i = 0..h-1 and j = 0..w-1.
-    auto second_predicted_buffer = m_buffers.inter_predicted_compound;
+    auto second_predicted_buffer = m_buffers.inter_predicted_compound.span();
     TRY(predict_inter_block(plane, 1, x, y, width, height, block_index, second_predicted_buffer));
 
     for (auto i = 0u; i < height_in_frame_buffer; i++) {
@@ -1082,8 +1130,7 @@ DecoderErrorOr<void> Decoder::reconstruct(u8 plane, u32 transform_block_x, u32 t
 
     // 1. Dequant[ i ][ j ] is set equal to ( Tokens[ i * n0 + j ] * get_ac_quant( plane ) ) / dqDenom
     //    for i = 0..(n0-1), for j = 0..(n0-1)
-    Vector<Intermediate>& dequantized = m_buffers.dequantized;
-    DECODER_TRY_ALLOC(dequantized.try_resize_and_keep_capacity(buffer_size(block_size, block_size)));
+    auto dequantized = m_buffers.dequantized.span().trim(block_size * block_size);
     Intermediate ac_quant = get_ac_quant(plane);
     for (auto i = 0u; i < block_size; i++) {
         for (auto j = 0u; j < block_size; j++) {
@@ -1127,7 +1174,7 @@ DecoderErrorOr<void> Decoder::reconstruct(u8 plane, u32 transform_block_x, u32 t
     return {};
 }
 
-inline DecoderErrorOr<void> Decoder::inverse_walsh_hadamard_transform(Vector<Intermediate>& data, u8 log2_of_block_size, u8 shift)
+inline DecoderErrorOr<void> Decoder::inverse_walsh_hadamard_transform(Span<Intermediate> data, u8 log2_of_block_size, u8 shift)
 {
     (void)data;
     (void)shift;
@@ -1172,6 +1219,11 @@ inline i32 Decoder::round_2(T value, u8 bits)
     return static_cast<i32>(value);
 }
 
+inline Decoder::IntermediateX4 Decoder::round_2(IntermediateX4 value, u8 bits)
+{
+    return (value + (1 << (bits - 1))) >> bits;
+}
+
 inline bool check_bounds(i64 value, u8 bits)
 {
     i64 const maximum = (1ll << (bits - 1ll)) - 1ll;
@@ -1184,15 +1236,24 @@ inline bool Decoder::check_intermediate_bounds(Intermediate value)
     return value >= ~maximum && value <= maximum;
 }
 
+inline bool Decoder::check_intermediate_bounds(IntermediateX4 value)
+{
+    auto maximum = AK::SIMD::expand4((1 << (8 + m_parser->m_bit_depth - 1)) - 1);
+    return AK::SIMD::none((value < ~maximum) | (value > maximum));
+}
+
 // (8.7.1.1) The function B( a, b, angle, 0 ) performs a butterfly rotation.
-inline void Decoder::butterfly_rotation_in_place(Vector<Intermediate>& data, size_t index_a, size_t index_b, u8 angle, bool flip)
+template<typename T>
+inline void Decoder::butterfly_rotation_in_place(Span<T> data, size_t index_a, size_t index_b, u8 angle, bool flip)
 {
+    // Vectors are only used when these fit in 32 bits.
+    using Product = Conditional<IsSame<T, Intermediate>, i64, T>;
     auto cos = cos64(angle);
     auto sin = sin64(angle);
     // 1. The variable x is set equal to T[ a ] * cos64( angle ) - T[ b ] * sin64( angle ).
-    i64 rotated_a = data[index_a] * cos - data[index_b] * sin;
+    Product rotated_a = data[index_a] * cos - data[index_b] * sin;
     // 2. The variable y is set equal to T[ a ] * sin64( angle ) + T[ b ] * cos64( angle ).
-    i64 rotated_b = data[index_a] * sin + data[index_b] * cos;
+    Product rotated_b = data[index_a] * sin + data[index_b] * cos;
     // 3. T[ a ] is set equal to Round2( x, 14 ).
     data[index_a] = round_2(rotated_a, 14);
     // 4. T[ b ] is set equal to Round2( y, 14 ).
@@ -1211,7 +1272,8 @@ inline void Decoder::butterfly_rotation_in_place(Vector<Intermediate>& data, siz
 }
 
 // (8.7.1.1) The function H( a, b, 0 ) performs a Hadamard rotation.
-inline void Decoder::hadamard_rotation_in_place(Vector<Intermediate>& data, size_t index_a, size_t index_b, bool flip)
+template<typename T>
+inline void Decoder::hadamard_rotation_in_place(Span<T> data, size_t index_a, size_t index_b, bool flip)
 {
     // The function H( a, b, 1 ) performs a Hadamard rotation with flipped indices and is specified as follows:
     // 1. The function H( b, a, 0 ) is invoked.
@@ -1235,7 +1297,8 @@ inline void Decoder::hadamard_rotation_in_place(Vector<Intermediate>& data, size
     VERIFY(check_intermediate_bounds(data[index_b]));
 }
 
-inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_permutation(Vector<Intermediate>& data, u8 log2_of_block_size)
+template<typename T>
+inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_permutation(Span<T> data, u8 log2_of_block_size)
 {
     u8 block_size = 1 << log2_of_block_size;
 
@@ -1245,10 +1308,9 @@ inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_per
         return DecoderError::corrupted("Block size was out of range"sv);
 
     // 1.1. A temporary array named copyT is set equal to T.
-    Vector<Intermediate>& data_copy = m_buffers.transform_temp;
-    data_copy.clear_with_capacity();
-    DECODER_TRY_ALLOC(data_copy.try_resize_and_keep_capacity(buffer_size(block_size, block_size)));
-    data_copy = data;
+    Array<T, maximum_transform_size> data_copy;
+    for (auto i = 0u; i < block_size; i++)
+        data_copy[i] = data[i];
 
     // 1.2. T[ i ] is set equal to copyT[ brev( n, i ) ] for i = 0..((1<<n) - 1).
     for (auto i = 0u; i < block_size; i++)
@@ -1257,7 +1319,8 @@ inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_per
     return {};
 }
 
-inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform(Vector<Intermediate>& data, u8 log2_of_block_size)
+template<typename T>
+inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform(Span<T> data, u8 log2_of_block_size)
 {
     // 2.1. The variable n0 is set equal to 1<<n.
     u8 block_size = 1 << log2_of_block_size;
@@ -1355,7 +1418,7 @@ inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform(Vector<In
     return {};
 }
 
-inline void Decoder::inverse_asymmetric_discrete_sine_transform_input_array_permutation(Vector<Intermediate>& data, Vector<Intermediate>& temp, u8 log2_of_block_size)
+inline void Decoder::inverse_asymmetric_discrete_sine_transform_input_array_permutation(Span<Intermediate> data, u8 log2_of_block_size)
 {
     // The variable n0 is set equal to 1<<n.
     auto block_size = 1u << log2_of_block_size;
@@ -1363,7 +1426,9 @@ inline void Decoder::inverse_asymmetric_discrete_sine_transform_input_array_perm
     // We can iterate by 2 at a time instead of taking half block size.
 
     // A temporary array named copyT is set equal to T.
-    temp = data;
+    Array<Intermediate, 16> temp;
+    for (auto i = 0u; i < block_size; i++)
+        temp[i] = data[i];
 
     // The values at even locations T[ 2 * i ] are set equal to copyT[ n0 - 1 - 2 * i ] for i = 0..(n1-1).
     // The values at odd locations T[ 2 * i + 1 ] are set equal to copyT[ 2 * i ] for i = 0..(n1-1).
@@ -1373,10 +1438,12 @@ inline void Decoder::inverse_asymmetric_discrete_sine_transform_input_array_perm
     }
 }
 
-inline void Decoder::inverse_asymmetric_discrete_sine_transform_output_array_permutation(Vector<Intermediate>& data, Vector<Intermediate>& temp, u8 log2_of_block_size)
+inline void Decoder::inverse_asymmetric_discrete_sine_transform_output_array_permutation(Span<Intermediate> data, u8 log2_of_block_size)
 {
     // A temporary array named copyT is set equal to T.
-    temp = data;
+    Array<Intermediate, 16> temp;
+    for (auto i = 0u; i < data.size(); i++)
+        temp[i] = data[i];
 
     // The permutation depends on n as follows:
     if (log2_of_block_size == 4) {
@@ -1400,7 +1467,7 @@ inline void Decoder::inverse_asymmetric_discrete_sine_transform_output_array_per
     }
 }
 
-inline void Decoder::inverse_asymmetric_discrete_sine_transform_4(Vector<Intermediate>& data)
+inline void Decoder::inverse_asymmetric_discrete_sine_transform_4(Span<Intermediate> data)
 {
     VERIFY(data.size() == 4);
     const i64 sinpi_1_9 = 5283;
@@ -1467,7 +1534,7 @@ inline void Decoder::inverse_asymmetric_discrete_sine_transform_4(Vector<Interme
 // The function SB( a, b, angle, 0 ) performs a butterfly rotation.
 // Spec defines the source as array T, and the destination array as S.
 template<typename S, typename D>
-inline void Decoder::butterfly_rotation(Vector<S>& source, Vector<D>& destination, size_t index_a, size_t index_b, u8 angle, bool flip)
+inline void Decoder::butterfly_rotation(Span<S> source, Span<D> destination, size_t index_a, size_t index_b, u8 angle, bool flip)
 {
     // The function SB( a, b, angle, 0 ) performs a butterfly rotation according to the following ordered steps:
     auto cos = cos64(angle);
@@ -1490,7 +1557,7 @@ inline void Decoder::butterfly_rotation(Vector<S>& source, Vector<D>& destinatio
 // The function SH( a, b ) performs a Hadamard rotation and rounding.
 // Spec defines the source array as S, and the destination array as T.
 template<typename S, typename D>
-inline void Decoder::hadamard_rotation(Vector<S>& source, Vector<D>& destination, size_t index_a, size_t index_b)
+inline void Decoder::hadamard_rotation(Span<S> source, Span<D> destination, size_t index_a, size_t index_b)
 {
     // Keep the source buffer's precision until rounding.
     S a = source[index_a];
@@ -1501,22 +1568,21 @@ inline void Decoder::hadamard_rotation(Vector<S>& source, Vector<D>& destination
     destination[index_b] = round_2(a - b, 14);
 }
 
-inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_8(Vector<Intermediate>& data)
+inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_8(Span<Intermediate> data)
 {
     VERIFY(data.size() == 8);
 
     // This process does an in-place transform of the array T using:
 
     // A higher precision array S for intermediate results.
-    Vector<i64>& high_precision_temp = m_buffers.adst_temp;
-    high_precision_temp.clear_with_capacity();
-    DECODER_TRY_ALLOC(high_precision_temp.try_resize_and_keep_capacity(8));
+    Array<i64, 8> high_precision_temp_array {};
+    auto high_precision_temp = high_precision_temp_array.span();
 
     // The following ordered steps apply:
 
     // 1. Invoke the ADST input array permutation process specified in section 8.7.1.4 with the input variable n set
     //    equal to 3.
-    inverse_asymmetric_discrete_sine_transform_input_array_permutation(data, m_buffers.transform_temp, 3);
+    inverse_asymmetric_discrete_sine_transform_input_array_permutation(data, 3);
 
     // 2. Invoke SB( 2*i, 1+2*i, 30-8*i, 1 ) for i = 0..3.
     for (auto i = 0u; i < 4; i++)
@@ -1550,7 +1616,7 @@ inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_
 
     // 8. Invoke the ADST output array permutation process specified in section 8.7.1.5 with the input variable n
     //    set equal to 3.
-    inverse_asymmetric_discrete_sine_transform_output_array_permutation(data, m_buffers.transform_temp, 3);
+    inverse_asymmetric_discrete_sine_transform_output_array_permutation(data, 3);
 
     // 9. Set T[ 1+2*i ] equal to -T[ 1+2*i ] for i = 0..3.
     for (auto i = 0u; i < 4; i++) {
@@ -1560,21 +1626,20 @@ inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_
     return {};
 }
 
-inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_16(Vector<Intermediate>& data)
+inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_16(Span<Intermediate> data)
 {
     VERIFY(data.size() == 16);
     // This process does an in-place transform of the array T using:
 
     // A higher precision array S for intermediate results.
-    Vector<i64>& high_precision_temp = m_buffers.adst_temp;
-    high_precision_temp.clear_with_capacity();
-    DECODER_TRY_ALLOC(high_precision_temp.try_resize_and_keep_capacity(16));
+    Array<i64, 16> high_precision_temp_array {};
+    auto high_precision_temp = high_precision_temp_array.span();
 
     // The following ordered steps apply:
 
     // 1. Invoke the ADST input array permutation process specified in section 8.7.1.4 with the input variable n set
     // equal to 4.
-    inverse_asymmetric_discrete_sine_transform_input_array_permutation(data, m_buffers.transform_temp, 4);
+    inverse_asymmetric_discrete_sine_transform_input_array_permutation(data, 4);
 
     // 2. Invoke SB( 2*i, 1+2*i, 31-4*i, 1 ) for i = 0..7.
     for (auto i = 0u; i < 8; i++)
@@ -1626,7 +1691,7 @@ inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_
 
     // 11. Invoke the ADST output array permutation process specified in section 8.7.1.5 with the input variable n
     // set equal to 4.
-    inverse_asymmetric_discrete_sine_transform_output_array_permutation(data, m_buffers.transform_temp, 4);
+    inverse_asymmetric_discrete_sine_transform_output_array_permutation(data, 4);
 
     // 12. Set T[ 1+12*j+2*i ] equal to -T[ 1+12*j+2*i ] for i = 0..1, for j = 0..1.
     for (auto i = 0u; i < 2; i++) {
@@ -1638,7 +1703,7 @@ inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_
     return {};
 }
 
-inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform(Vector<Intermediate>& data, u8 log2_of_block_size)
+inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform(Span<Intermediate> data, u8 log2_of_block_size)
 {
     // 8.7.1.9 Inverse ADST Process
 
@@ -1659,7 +1724,7 @@ inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform(
     return inverse_asymmetric_discrete_sine_transform_16(data);
 }
 
-DecoderErrorOr<void> Decoder::inverse_transform_2d(Vector<Intermediate>& dequantized, u8 log2_of_block_size)
+DecoderErrorOr<void> Decoder::inverse_transform_2d(Span<Intermediate> dequantized, u8 log2_of_block_size)
 {
     // This process performs a 2D inverse transform for an array of size 2^n by 2^n stored in the 2D array Dequant.
     // The input to this process is a variable n (log2_of_block_size) that specifies the base 2 logarithm of the width of the transform.
@@ -1667,47 +1732,90 @@ DecoderErrorOr<void> Decoder::inverse_transform_2d(Vector<Intermediate>& dequant
     // 1. Set the variable n0 (block_size) equal to 1 << n.
     auto block_size = 1u << log2_of_block_size;
 
-    Vector<Intermediate>& row_or_column = m_buffers.row_or_column;
-    DECODER_TRY_ALLOC(row_or_column.try_resize_and_keep_capacity(block_size));
+    auto tx_type = m_parser->m_tx_type;
+    if (!m_parser->m_lossless && tx_type != DCT_DCT && tx_type != ADST_DCT && tx_type != DCT_ADST && tx_type != ADST_ADST)
+        return DecoderError::corrupted("Unknown tx_type"sv);
+    bool can_use_vectors = !m_parser->m_lossless && m_parser->m_bit_depth == 8;
+    auto column_rounding_bits = min(6, log2_of_block_size + 2);
 
-    // 2. The row transforms with i = 0..(n0-1) are applied as follows:
-    for (auto i = 0u; i < block_size; i++) {
-        // 1. Set T[ j ] equal to Dequant[ i ][ j ] for j = 0..(n0-1).
-        for (auto j = 0u; j < block_size; j++)
-            row_or_column[j] = dequantized[index_from_row_and_column(i, j, block_size)];
+    Array<Intermediate, maximum_transform_size> row_or_column_array;
+    auto row_or_column = row_or_column_array.span().trim(block_size);
+    Array<IntermediateX4, maximum_transform_size> rows_or_columns_array;
+    auto rows_or_columns = rows_or_columns_array.span().trim(block_size);
 
-        // 2. If Lossless is equal to 1, invoke the Inverse WHT process as specified in section 8.7.1.10 with shift equal
-        //    to 2.
-        if (m_parser->m_lossless) {
-            TRY(inverse_walsh_hadamard_transform(row_or_column, log2_of_block_size, 2));
-            continue;
-        }
-        switch (m_parser->m_tx_type) {
-        case DCT_DCT:
-        case ADST_DCT:
-            // Otherwise, if TxType is equal to DCT_DCT or TxType is equal to ADST_DCT, apply an inverse DCT as
-            // follows:
-            // 1. Invoke the inverse DCT permutation process as specified in section 8.7.1.2 with the input variable n.
-            TRY(inverse_discrete_cosine_transform_array_permutation(row_or_column, log2_of_block_size));
-            // 2. Invoke the inverse DCT process as specified in section 8.7.1.3 with the input variable n.
-            TRY(inverse_discrete_cosine_transform(row_or_column, log2_of_block_size));
-            break;
-        case DCT_ADST:
-        case ADST_ADST:
-            // 4. Otherwise (TxType is equal to DCT_ADST or TxType is equal to ADST_ADST), invoke the inverse ADST
-            //    process as specified in section 8.7.1.9 with input variable n.
-            TRY(inverse_asymmetric_discrete_sine_transform(row_or_column, log2_of_block_size));
-            break;
-        default:
-            return DecoderError::corrupted("Unknown tx_type"sv);
+    // 2. The row transforms with i = 0..(n0-1) are applied as follows:
+    if (can_use_vectors && (tx_type == DCT_DCT || tx_type == ADST_DCT)) {
+        // Transform four rows at a time, with each row in one lane of the vectors.
+        for (auto i = 0u; i < block_size; i += 4) {
+            for (auto j = 0u; j < block_size; j++) {
+                rows_or_columns[j] = IntermediateX4 {
+                    dequantized[index_from_row_and_column(i, j, block_size)],
+                    dequantized[index_from_row_and_column(i + 1, j, block_size)],
+                    dequantized[index_from_row_and_column(i + 2, j, block_size)],
+                    dequantized[index_from_row_and_column(i + 3, j, block_size)],
+                };
+            }
+            TRY(inverse_discrete_cosine_transform_array_permutation(rows_or_columns, log2_of_block_size));
+            TRY(inverse_discrete_cosine_transform(rows_or_columns, log2_of_block_size));
+            for (auto j = 0u; j < block_size; j++) {
+                for (auto lane = 0u; lane < 4; lane++)
+                    dequantized[index_from_row_and_column(i + lane, j, block_size)] = rows_or_columns[j][lane];
+            }
         }
+    } else {
+        for (auto i = 0u; i < block_size; i++) {
+            // 1. Set T[ j ] equal to Dequant[ i ][ j ] for j = 0..(n0-1).
+            for (auto j = 0u; j < block_size; j++)
+                row_or_column[j] = dequantized[index_from_row_and_column(i, j, block_size)];
 
-        // 5. Set Dequant[ i ][ j ] equal to T[ j ] for j = 0..(n0-1).
-        for (auto j = 0u; j < block_size; j++)
-            dequantized[index_from_row_and_column(i, j, block_size)] = row_or_column[j];
+            // 2. If Lossless is equal to 1, invoke the Inverse WHT process as specified in section 8.7.1.10 with shift equal
+            //    to 2.
+            if (m_parser->m_lossless) {
+                TRY(inverse_walsh_hadamard_transform(row_or_column, log2_of_block_size, 2));
+                continue;
+            }
+            switch (tx_type) {
+            case DCT_DCT:
+            case ADST_DCT:
+                // Otherwise, if TxType is equal to DCT_DCT or TxType is equal to ADST_DCT, apply an inverse DCT as
+                // follows:
+                // 1. Invoke the inverse DCT permutation process as specified in section 8.7.1.2 with the input variable n.
+                TRY(inverse_discrete_cosine_transform_array_permutation(row_or_column, log2_of_block_size));
+                // 2. Invoke the inverse DCT process as specified in section 8.7.1.3 with the input variable n.
+                TRY(inverse_discrete_cosine_transform(row_or_column, log2_of_block_size));
+                break;
+            case DCT_ADST:
+            case ADST_ADST:
+                // 4. Otherwise (TxType is equal to DCT_ADST or TxType is equal to ADST_ADST), invoke the inverse ADST
+                //    process as specified in section 8.7.1.9 with input variable n.
+                TRY(inverse_asymmetric_discrete_sine_transform(row_or_column, log2_of_block_size));
+                break;
+            default:
+                VERIFY_NOT_REACHED();
+            }
+
+            // 5. Set Dequant[ i ][ j ] equal to T[ j ] for j = 0..(n0-1).
+            for (auto j = 0u; j < block_size; j++)
+                dequantized[index_from_row_and_column(i, j, block_size)] = row_or_column[j];
+        }
     }
 
     // 3. The column transforms with j = 0..(n0-1) are applied as follows:
+    if (can_use_vectors && (tx_type == DCT_DCT || tx_type == DCT_ADST)) {
+        // Transform four columns at a time, which are next to each other in every row.
+        for (auto j = 0u; j < block_size; j += 4) {
+            for (auto i = 0u; i < block_size; i++)
+                __builtin_memcpy(&rows_or_columns[i], &dequantized[index_from_row_and_column(i, j, block_size)], sizeof(IntermediateX4));
+            TRY(inverse_discrete_cosine_transform_array_permutation(rows_or_columns, log2_of_block_size));
+            TRY(inverse_discrete_cosine_transform(rows_or_columns, log2_of_block_size));
+            for (auto i = 0u; i < block_size; i++) {
+                auto rounded = round_2(rows_or_columns[i], column_rounding_bits);
+                __builtin_memcpy(&dequantized[index_from_row_and_column(i, j, block_size)], &rounded, sizeof(IntermediateX4));
+            }
+        }
+        return {};
+    }
+
     for (auto j = 0u; j < block_size; j++) {
         // 1. Set T[ i ] equal to Dequant[ i ][ j ] for i = 0..(n0-1).
         for (auto i = 0u; i < block_size; i++)
@@ -1719,7 +1827,7 @@ DecoderErrorOr<void> Decoder::inverse_transform_2d(Vector<Intermediate>& dequant
             TRY(inverse_walsh_hadamard_transform(row_or_column, log2_of_block_size, 2));
             continue;
         }
-        switch (m_parser->m_tx_type) {
+        switch (tx_type) {
         case DCT_DCT:
         case DCT_ADST:
             // Otherwise, if TxType is equal to DCT_DCT or TxType is equal to DCT_ADST, apply an inverse DCT as
@@ -1748,7 +1856,7 @@ DecoderErrorOr<void> Decoder::inverse_transform_2d(Vector<Intermediate>& dequant
         if (!m_parser->m_lossless) {
             for (auto i = 0u; i < block_size; i++) {
                 auto index = index_from_row_and_column(i, j, block_size);
-                dequantized[index] = round_2(dequantized[index], min(6, log2_of_block_size + 2));
+                dequantized[index] = round_2(dequantized[index], column_rounding_bits);
             }
         }
     }
@@ -1798,15 +1906,15 @@ DecoderErrorOr<void> Decoder::update_reference_frames()
                     stride >>= m_parser->m_subsampling_x;
                 }
 
-                auto original_buffer = get_output_buffer(plane);
+                auto const& original_buffer = get_output_buffer(plane);
                 auto& frame_store_buffer = m_parser->m_frame_store[i][plane];
                 frame_store_buffer.resize_and_keep_capacity(width * height);
 
-                for (auto x = 0u; x < width; x++) {
-                    for (auto y = 0u; y < height; y++) {
-                        auto sample = original_buffer[index_from_row_and_column(y, x, stride)];
-                        frame_store_buffer[index_from_row_and_column(y, x, width)] = sample;
-                    }
+                for (auto y = 0u; y < height; y++) {
+                    memcpy(
+                        frame_store_buffer.data() + index_from_row_and_column(y, 0, width),
+                        original_buffer.data() + index_from_row_and_column(y, 0, stride),
+                        width * sizeof(*frame_store_buffer.data()));
                 }
             }
         }
@@ -8,6 +8,7 @@
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
+#include <LibWasm/AbstractMachine/Lowering.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Types.h>
 
@@ -135,6 +136,7 @@ ErrorOr<void, ValidationError> AbstractMachine::validate(Module& module)
         return result.release_error();
     }
 
+    lower_functions(module);
     return {};
 }
 
@@ -478,11 +478,12 @@ private:
 
 class Frame {
 public:
-    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity)
+    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity, LoweredFunction const* lowered = nullptr)
         : m_module(module)
         , m_locals(move(locals))
         , m_expression(expression)
         , m_arity(arity)
+        , m_lowered(lowered)
     {
     }
 
@@ -491,12 +492,14 @@ public:
     auto& locals() { return m_locals; }
     auto& expression() const { return m_expression; }
     auto arity() const { return m_arity; }
+    auto lowered() const { return m_lowered; }
 
 private:
     ModuleInstance const& m_module;
     Vector<Value> m_locals;
     Expression const& m_expression;
     size_t m_arity { 0 };
+    LoweredFunction const* m_lowered { nullptr };
 };
 
 class Stack {
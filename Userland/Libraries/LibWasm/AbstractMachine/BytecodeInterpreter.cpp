@@ -5,9 +5,12 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/Endian.h>
+#include <AK/ScopeGuard.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/AbstractMachine/Lowering.h>
 #include <LibWasm/AbstractMachine/Operators.h>
 #include <LibWasm/Opcode.h>
 #include <LibWasm/Printer/Printer.h>
@@ -32,6 +35,11 @@ namespace Wasm {
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap.clear();
+    if (auto* lowered = configuration.frame().lowered(); lowered && should_use_lowered_code() && configuration.ip() == 0) {
+        interpret_lowered(configuration, *lowered);
+        return;
+    }
+
     auto& instructions = configuration.frame().expression().instructions();
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
@@ -55,6 +63,391 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     }
 }
 
+template<typename T>
+ALWAYS_INLINE static T read_slot(u64 slot)
+{
+    if constexpr (IsSame<T, float>)
+        return bit_cast<float>(static_cast<u32>(slot));
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<double>(slot);
+    else
+        return static_cast<T>(slot);
+}
+
+template<typename T>
+ALWAYS_INLINE static u64 to_slot(T value)
+{
+    if constexpr (IsSame<T, float>)
+        return bit_cast<u32>(value);
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<u64>(value);
+    else if constexpr (sizeof(T) <= sizeof(u32))
+        return static_cast<u32>(value);
+    else
+        return static_cast<u64>(value);
+}
+
+// References are stored as their address plus one, which leaves zero for null references.
+static u64 value_to_slot(Value const& value)
+{
+    return value.value().visit(
+        [](Reference const& reference) {
+            return reference.ref().visit(
+                [](Reference::Null const&) -> u64 { return 0; },
+                [](Reference::Func const& function) -> u64 { return function.address.value() + 1; },
+                [](Reference::Extern const& extern_) -> u64 { return extern_.address.value() + 1; });
+        },
+        [](auto number) { return to_slot(number); });
+}
+
+static Value slot_to_value(u64 slot, ValueType type)
+{
+    switch (type.kind()) {
+    case ValueType::I32:
+        return Value(read_slot<i32>(slot));
+    case ValueType::I64:
+        return Value(read_slot<i64>(slot));
+    case ValueType::F32:
+        return Value(read_slot<float>(slot));
+    case ValueType::F64:
+        return Value(read_slot<double>(slot));
+    case ValueType::FunctionReference:
+    case ValueType::NullFunctionReference:
+        if (slot == 0)
+            return Value(Reference { Reference::Null { ValueType(ValueType::FunctionReference) } });
+        return Value(Reference { Reference::Func { FunctionAddress { slot - 1 } } });
+    case ValueType::ExternReference:
+    case ValueType::NullExternReference:
+        if (slot == 0)
+            return Value(Reference { Reference::Null { ValueType(ValueType::ExternReference) } });
+        return Value(Reference { Reference::Extern { ExternAddress { slot - 1 } } });
+    }
+    VERIFY_NOT_REACHED();
+}
+
+template<typename T>
+ALWAYS_INLINE static T read_from_memory(u8 const* data)
+{
+    if constexpr (IsSame<T, float>) {
+        return bit_cast<float>(read_from_memory<u32>(data));
+    } else if constexpr (IsSame<T, double>) {
+        return bit_cast<double>(read_from_memory<u64>(data));
+    } else {
+        T value;
+        __builtin_memcpy(&value, data, sizeof(T));
+        return AK::convert_between_host_and_little_endian(value);
+    }
+}
+
+template<typename T>
+ALWAYS_INLINE static void write_to_memory(u8* data, T value)
+{
+    if constexpr (IsSame<T, float>) {
+        write_to_memory(data, bit_cast<u32>(value));
+    } else if constexpr (IsSame<T, double>) {
+        write_to_memory(data, bit_cast<u64>(value));
+    } else {
+        value = AK::convert_between_host_and_little_endian(value);
+        __builtin_memcpy(data, &value, sizeof(T));
+    }
+}
+
+template<typename PushType, typename ResultType>
+ALWAYS_INLINE static bool store_result(u64& destination, ResultType call_result, Optional<Trap>& trap)
+{
+    PushType result;
+    if constexpr (IsSpecializationOf<ResultType, AK::Result>) {
+        if (call_result.is_error()) {
+            trap = Trap { call_result.error() };
+            return false;
+        }
+        result = call_result.release_value();
+    } else {
+        result = call_result;
+    }
+    destination = to_slot(result);
+    return true;
+}
+
+bool BytecodeInterpreter::ensure_lowered_slots(size_t count)
+{
+    if (count <= m_lowered_slots.size())
+        return true;
+    if (count > Constants::max_allowed_lowered_frame_slots) {
+        m_trap = Trap { "Call stack exhausted" };
+        return false;
+    }
+    m_lowered_slots.resize(max(count, min(m_lowered_slots.size() * 2, Constants::max_allowed_lowered_frame_slots)));
+    return true;
+}
+
+void BytecodeInterpreter::interpret_lowered(Configuration& configuration, LoweredFunction const& function)
+{
+    auto& module = configuration.frame().module();
+    auto frame_base = m_lowered_slots_in_use;
+    if (!ensure_lowered_slots(frame_base + function.frame_size()))
+        return;
+
+    auto& locals = configuration.frame().locals();
+    VERIFY(locals.size() == function.local_count());
+    for (size_t i = 0; i < locals.size(); ++i)
+        m_lowered_slots[frame_base + i] = value_to_slot(locals[i]);
+
+    if (!execute_lowered(configuration, function, module, frame_base))
+        return;
+
+    // Leave the results on the stack just like the stack-based interpreter does.
+    auto& result_types = function.result_types();
+    for (size_t i = 0; i < result_types.size(); ++i)
+        configuration.stack().push(slot_to_value(m_lowered_slots[frame_base + i], result_types[i]));
+}
+
+bool BytecodeInterpreter::call_from_lowered(Configuration& configuration, FunctionAddress address, size_t arguments_base)
+{
+    if (m_stack_info.size_free() < Constants::minimum_stack_space_to_keep_free) {
+        m_trap = Trap { "Call stack exhausted" };
+        return false;
+    }
+
+    auto* instance = configuration.store().get(address);
+    if (auto* wasm_function = instance->get_pointer<WasmFunction>(); wasm_function && wasm_function->code().lowered()) {
+        auto& function = *wasm_function->code().lowered();
+        if (!ensure_lowered_slots(arguments_base + function.frame_size()))
+            return false;
+        for (size_t i = function.parameter_count(); i < function.local_count(); ++i)
+            m_lowered_slots[arguments_base + i] = 0;
+        return execute_lowered(configuration, function, wasm_function->module(), arguments_base);
+    }
+
+    // Host functions and functions that could not be lowered go through the configuration.
+    FunctionType const* type { nullptr };
+    instance->visit([&](auto const& function) { type = &function.type(); });
+    Vector<Value> arguments;
+    arguments.ensure_capacity(type->parameters().size());
+    for (size_t i = 0; i < type->parameters().size(); ++i)
+        arguments.unchecked_append(slot_to_value(m_lowered_slots[arguments_base + i], type->parameters()[i]));
+
+    Result result { Trap { ""sv } };
+    {
+        CallFrameHandle handle { *this, configuration };
+        result = configuration.call(*this, address, move(arguments));
+    }
+
+    if (result.is_trap()) {
+        m_trap = move(result.trap());
+        return false;
+    }
+
+    // Like in call_address(), the results come back in reverse order.
+    auto& results = result.values();
+    for (size_t i = 0; i < results.size(); ++i)
+        m_lowered_slots[arguments_base + i] = value_to_slot(results[results.size() - i - 1]);
+    return true;
+}
+
+bool BytecodeInterpreter::execute_lowered(Configuration& configuration, LoweredFunction const& function, ModuleInstance const& module, size_t frame_base)
+{
+    static void* const dispatch_table[] = {
+#define __ENUMERATE_LOWERED_OPCODE(name, ...) &&handle_##name,
+        ENUMERATE_LOWERED_CONTROL_INSTRUCTIONS(__ENUMERATE_LOWERED_OPCODE)
+        ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_LOWERED_OPCODE)
+        ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_LOWERED_OPCODE)
+        ENUMERATE_LOWERED_LOADS(__ENUMERATE_LOWERED_OPCODE)
+        ENUMERATE_LOWERED_STORES(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+    };
+
+    auto previous_slots_in_use = m_lowered_slots_in_use;
+    m_lowered_slots_in_use = max(previous_slots_in_use, frame_base + function.frame_size());
+    ScopeGuard restore_slots_in_use = [&] { m_lowered_slots_in_use = previous_slots_in_use; };
+
+    auto const* code = function.instructions().data();
+    auto const* ip = code;
+    // The slot storage may be reallocated by calls, so the frame pointer has to be reloaded after each of them.
+    u64* fp = m_lowered_slots.data() + frame_base;
+
+    MemoryInstance* memory = nullptr;
+    u8* memory_data = nullptr;
+    u64 memory_size = 0;
+    auto reload_memory = [&] {
+        if (module.memories().is_empty())
+            return;
+        memory = configuration.store().get(module.memories().first());
+        memory_data = memory->data().data();
+        memory_size = memory->size();
+    };
+    reload_memory();
+
+    // Only backward jumps can make a function run for longer than its size, so when the instruction count
+    // is limited, they are charged for all instructions between the jump and its target.
+    auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
+    u64 executed_instructions = 0;
+    auto charge_backward_jump = [&](u64 target) {
+        auto current = static_cast<u64>(ip - code);
+        if (target > current)
+            return true;
+        executed_instructions += current - target + 1;
+        if (executed_instructions < Constants::max_allowed_executed_instructions_per_call)
+            return true;
+        m_trap = Trap { "Exceeded maximum allowed number of instructions" };
+        return false;
+    };
+
+#define DISPATCH() goto* dispatch_table[ip->opcode]
+#define NEXT()      \
+    do {            \
+        ++ip;       \
+        DISPATCH(); \
+    } while (false)
+#define JUMP(target)                                                                      \
+    do {                                                                                  \
+        if (should_limit_instruction_count && !charge_backward_jump(target)) [[unlikely]] \
+            return false;                                                                 \
+        ip = code + (target);                                                             \
+        DISPATCH();                                                                       \
+    } while (false)
+#define TRAP(reason)              \
+    do {                          \
+        m_trap = Trap { reason }; \
+        return false;             \
+    } while (false)
+
+    DISPATCH();
+
+handle_unreachable:
+    TRAP("Unreachable");
+handle_copy:
+    fp[ip->destination] = fp[ip->lhs];
+    NEXT();
+handle_constant:
+    fp[ip->destination] = ip->immediate;
+    NEXT();
+handle_jump:
+    JUMP(ip->immediate);
+handle_jump_if_zero:
+    if (static_cast<u32>(fp[ip->lhs]) == 0)
+        JUMP(ip->immediate);
+    NEXT();
+handle_jump_if_not_zero:
+    if (static_cast<u32>(fp[ip->lhs]) != 0)
+        JUMP(ip->immediate);
+    NEXT();
+handle_branch:
+    for (u32 i = 0; i < ip->rhs; ++i)
+        fp[ip->destination + i] = fp[ip->lhs + i];
+    JUMP(ip->immediate);
+handle_branch_table: {
+    // Out of range indices (including negative ones) select the default target, which comes last.
+    auto& target = function.branch_targets()[ip->immediate + min(static_cast<u32>(fp[ip->lhs]), ip->rhs)];
+    for (u32 i = 0; i < target.count; ++i)
+        fp[target.destination + i] = fp[target.source + i];
+    JUMP(target.target);
+}
+handle_return_:
+    for (u32 i = 0; i < ip->rhs; ++i)
+        fp[i] = fp[ip->lhs + i];
+    return true;
+handle_call:
+    if (!call_from_lowered(configuration, module.functions()[ip->immediate], frame_base + ip->lhs))
+        return false;
+    fp = m_lowered_slots.data() + frame_base;
+    reload_memory();
+    NEXT();
+handle_call_indirect: {
+    auto* table = configuration.store().get(module.tables()[ip->rhs]);
+    auto index = static_cast<u32>(fp[ip->lhs]);
+    if (index >= table->elements().size())
+        TRAP("Indirect call index out of bounds");
+    auto& element = table->elements()[index];
+    if (!element.has_value() || !element->ref().has<Reference::Func>())
+        TRAP("Indirect call to a null or non-function reference");
+    auto address = element->ref().get<Reference::Func>().address;
+
+    FunctionType const* callee_type { nullptr };
+    configuration.store().get(address)->visit([&](auto const& function) { callee_type = &function.type(); });
+    auto& expected_type = module.types()[ip->immediate];
+    if (callee_type->parameters() != expected_type.parameters() || callee_type->results() != expected_type.results())
+        TRAP("Indirect call type mismatch");
+
+    if (!call_from_lowered(configuration, address, frame_base + ip->destination))
+        return false;
+    fp = m_lowered_slots.data() + frame_base;
+    reload_memory();
+    NEXT();
+}
+handle_select:
+    fp[ip->destination] = static_cast<u32>(fp[ip->immediate]) != 0 ? fp[ip->lhs] : fp[ip->rhs];
+    NEXT();
+handle_global_get:
+    fp[ip->destination] = value_to_slot(configuration.store().get(module.globals()[ip->immediate])->value());
+    NEXT();
+handle_global_set: {
+    auto* global = configuration.store().get(module.globals()[ip->immediate]);
+    global->set_value(slot_to_value(fp[ip->lhs], global->value().type()));
+    NEXT();
+}
+handle_memory_size:
+    fp[ip->destination] = to_slot(static_cast<i32>(memory_size / Constants::page_size));
+    NEXT();
+handle_memory_grow: {
+    auto old_pages = static_cast<i32>(memory_size / Constants::page_size);
+    auto new_pages = static_cast<size_t>(read_slot<u32>(fp[ip->lhs]));
+    auto grown = memory->grow(new_pages * Constants::page_size);
+    fp[ip->destination] = to_slot(grown ? old_pages : -1);
+    reload_memory();
+    NEXT();
+}
+handle_ref_is_null:
+    fp[ip->destination] = fp[ip->lhs] == 0 ? 1 : 0;
+    NEXT();
+handle_ref_func:
+    fp[ip->destination] = module.functions()[ip->immediate].value() + 1;
+    NEXT();
+
+#define __ENUMERATE_LOWERED_OPCODE(name, PopType, PushType, Operator)                                                    \
+    handle_##name:                                                                                                       \
+    if (!store_result<PushType>(fp[ip->destination], Operator {}(read_slot<PopType>(fp[ip->lhs])), m_trap)) [[unlikely]] \
+        return false;                                                                                                    \
+    NEXT();
+    ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+
+#define __ENUMERATE_LOWERED_OPCODE(name, PopType, PushType, Operator)                                                                                     \
+    handle_##name:                                                                                                                                        \
+    if (!store_result<PushType>(fp[ip->destination], Operator {}(read_slot<PopType>(fp[ip->lhs]), read_slot<PopType>(fp[ip->rhs])), m_trap)) [[unlikely]] \
+        return false;                                                                                                                                     \
+    NEXT();
+    ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+
+#define __ENUMERATE_LOWERED_OPCODE(name, ReadType, PushType)                                                     \
+    handle_##name : {                                                                                            \
+        auto address = static_cast<u64>(static_cast<u32>(fp[ip->lhs])) + ip->immediate;                          \
+        if (address + sizeof(ReadType) > memory_size) [[unlikely]]                                               \
+            TRAP("Memory access out of bounds");                                                                 \
+        fp[ip->destination] = to_slot(static_cast<PushType>(read_from_memory<ReadType>(memory_data + address))); \
+        NEXT();                                                                                                  \
+    }
+    ENUMERATE_LOWERED_LOADS(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+
+#define __ENUMERATE_LOWERED_OPCODE(name, PopType, StoreType)                                             \
+    handle_##name : {                                                                                    \
+        auto address = static_cast<u64>(static_cast<u32>(fp[ip->lhs])) + ip->immediate;                  \
+        if (address + sizeof(StoreType) > memory_size) [[unlikely]]                                      \
+            TRAP("Memory access out of bounds");                                                         \
+        write_to_memory(memory_data + address, static_cast<StoreType>(read_slot<PopType>(fp[ip->rhs]))); \
+        NEXT();                                                                                          \
+    }
+    ENUMERATE_LOWERED_STORES(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+
+#undef DISPATCH
+#undef NEXT
+#undef JUMP
+#undef TRAP
+}
+
 void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
@@ -72,7 +465,8 @@ void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelInd
         configuration.stack().pop();
     }
 
-    for (auto& result : results)
+    // pop_values() returns the top of the stack first.
+    for (auto& result : results.in_reverse())
         configuration.stack().push(move(result));
 
     configuration.ip() = label->continuation();
@@ -395,23 +789,15 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return;
     }
     case Instructions::loop.value(): {
-        size_t arity = 0;
         size_t parameter_count = 0;
         auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
+        if (args.block_type.kind() == BlockType::Index) {
             auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
             parameter_count = type.parameters().size();
         }
-        }
 
-        configuration.stack().entries().insert(configuration.stack().size() - parameter_count, Label(arity, ip.value() + 1));
+        // Branching to a loop starts it over, so the branch carries the loop's parameters rather than its results.
+        configuration.stack().entries().insert(configuration.stack().size() - parameter_count, Label(parameter_count, ip.value() + 1));
         return;
     }
     case Instructions::if_.value(): {
@@ -33,6 +33,8 @@ struct BytecodeInterpreter : public Interpreter {
     };
 
 protected:
+    // Interpreters that need to observe every instruction of the original bytecode have to opt out of running lowered code.
+    virtual bool should_use_lowered_code() const { return true; }
     virtual void interpret(Configuration&, InstructionPointer&, Instruction const&);
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
@@ -65,8 +67,17 @@ protected:
         return m_trap.has_value();
     }
 
+    void interpret_lowered(Configuration&, LoweredFunction const&);
+    bool execute_lowered(Configuration&, LoweredFunction const&, ModuleInstance const&, size_t frame_base);
+    bool call_from_lowered(Configuration&, FunctionAddress, size_t arguments_base);
+    bool ensure_lowered_slots(size_t count);
+
     Optional<Trap> m_trap;
     StackInfo m_stack_info;
+
+    // Frames of lowered functions, the arguments of a call become the first locals of the callee's frame.
+    Vector<u64> m_lowered_slots;
+    size_t m_lowered_slots_in_use { 0 };
 };
 
 struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
@@ -76,6 +87,7 @@ struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
     Function<bool(Configuration&, InstructionPointer&, Instruction const&, Interpreter const&)> post_interpret_hook;
 
 private:
+    virtual bool should_use_lowered_code() const override { return false; }
     virtual void interpret(Configuration&, InstructionPointer&, Instruction const&) override;
 };
 
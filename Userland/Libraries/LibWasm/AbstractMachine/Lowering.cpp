@@ -0,0 +1,523 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/StdLibExtras.h>
+#include <LibWasm/AbstractMachine/Lowering.h>
+#include <LibWasm/Opcode.h>
+#include <LibWasm/Printer/Printer.h>
+
+namespace Wasm {
+
+namespace {
+
+class FunctionLowering {
+public:
+    FunctionLowering(Module const& module, Vector<FunctionType const*> const& function_types, Module::Function const& function)
+        : m_module(module)
+        , m_function_types(function_types)
+        , m_function(function)
+        , m_type(module.type(function.type()))
+        , m_local_count(m_type.parameters().size() + function.locals().size())
+    {
+    }
+
+    RefPtr<LoweredFunction> lower();
+
+private:
+    enum class ControlKind {
+        Block,
+        Loop,
+        If,
+    };
+
+    struct PendingJump {
+        size_t index { 0 };
+        bool is_branch_table_entry { false };
+    };
+
+    struct ControlFrame {
+        ControlKind kind { ControlKind::Block };
+        size_t base_height { 0 };
+        size_t parameter_count { 0 };
+        size_t result_count { 0 };
+        size_t start { 0 };
+        Optional<size_t> else_jump;
+        Vector<PendingJump> pending_jumps;
+
+        size_t branch_arity() const { return kind == ControlKind::Loop ? parameter_count : result_count; }
+    };
+
+    bool lower(Instruction const&);
+    void enter(ControlKind, BlockType const&);
+    void end(ControlFrame);
+
+    size_t emit(LoweredOpCode opcode, u32 destination = 0, u32 lhs = 0, u32 rhs = 0, u64 immediate = 0)
+    {
+        m_code.append(LoweredInstruction { to_underlying(opcode), destination, lhs, rhs, immediate });
+        return m_code.size() - 1;
+    }
+
+    u32 slot(size_t height) const { return static_cast<u32>(m_local_count + height); }
+
+    void push(size_t count = 1)
+    {
+        m_height += count;
+        m_max_height = max(m_max_height, m_height);
+    }
+
+    void pop(size_t count = 1)
+    {
+        VERIFY(m_height >= count);
+        m_height -= count;
+    }
+
+    // Jumps may land here, so instructions emitted before this point must not be folded into later ones.
+    void bind_label() { m_fusion_barrier = m_code.size(); }
+
+    void patch(PendingJump const& jump, size_t target)
+    {
+        if (jump.is_branch_table_entry)
+            m_branch_targets[jump.index].target = target;
+        else
+            m_code[jump.index].immediate = target;
+    }
+
+    LoweredBranchTarget branch_target(size_t label, size_t pending_index, bool is_branch_table_entry);
+    void emit_branch(size_t label);
+    void emit_unary(LoweredOpCode);
+    void emit_binary(LoweredOpCode);
+    void emit_memory_access(LoweredOpCode, Instruction::MemoryArgument const&, bool is_store);
+    u32 take_operand(u32 slot);
+    bool retarget_last_result(u32 slot, u32 local);
+
+    Module const& m_module;
+    Vector<FunctionType const*> const& m_function_types;
+    Module::Function const& m_function;
+    FunctionType const& m_type;
+    size_t m_local_count { 0 };
+
+    Vector<LoweredInstruction> m_code;
+    Vector<LoweredBranchTarget> m_branch_targets;
+    Vector<ControlFrame> m_control;
+    size_t m_height { 0 };
+    size_t m_max_height { 0 };
+    size_t m_fusion_barrier { 0 };
+
+    // Code following an unconditional control transfer is skipped until the end of the enclosing block.
+    bool m_unreachable { false };
+    size_t m_unreachable_depth { 0 };
+};
+
+static bool writes_only_destination(LoweredOpCode opcode)
+{
+    switch (opcode) {
+    case LoweredOpCode::copy:
+    case LoweredOpCode::constant:
+    case LoweredOpCode::select:
+    case LoweredOpCode::global_get:
+    case LoweredOpCode::memory_size:
+    case LoweredOpCode::ref_is_null:
+    case LoweredOpCode::ref_func:
+#define __ENUMERATE_LOWERED_OPCODE(name, ...) case LoweredOpCode::name:
+        ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_LOWERED_OPCODE)
+        ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_LOWERED_OPCODE)
+        ENUMERATE_LOWERED_LOADS(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+        return true;
+    default:
+        return false;
+    }
+}
+
+// A local.get emitted right before its only consumer is folded into that consumer's operand.
+u32 FunctionLowering::take_operand(u32 slot)
+{
+    if (m_code.size() <= m_fusion_barrier)
+        return slot;
+    auto& last = m_code.last();
+    if (last.opcode != to_underlying(LoweredOpCode::copy) || last.destination != slot || last.lhs >= m_local_count)
+        return slot;
+    auto local = last.lhs;
+    m_code.take_last();
+    return local;
+}
+
+// A value computed right before a local.set is written to the local directly.
+bool FunctionLowering::retarget_last_result(u32 slot, u32 local)
+{
+    if (m_code.size() <= m_fusion_barrier)
+        return false;
+    auto& last = m_code.last();
+    if (last.destination != slot || !writes_only_destination(static_cast<LoweredOpCode>(last.opcode)))
+        return false;
+    last.destination = local;
+    return true;
+}
+
+void FunctionLowering::emit_unary(LoweredOpCode opcode)
+{
+    auto operand = take_operand(slot(m_height - 1));
+    emit(opcode, slot(m_height - 1), operand);
+}
+
+void FunctionLowering::emit_binary(LoweredOpCode opcode)
+{
+    auto rhs = take_operand(slot(m_height - 1));
+    auto lhs = take_operand(slot(m_height - 2));
+    pop();
+    emit(opcode, slot(m_height - 1), lhs, rhs);
+}
+
+void FunctionLowering::emit_memory_access(LoweredOpCode opcode, Instruction::MemoryArgument const& argument, bool is_store)
+{
+    if (is_store) {
+        auto value = take_operand(slot(m_height - 1));
+        auto address = take_operand(slot(m_height - 2));
+        pop(2);
+        emit(opcode, 0, address, value, argument.offset);
+        return;
+    }
+    auto address = take_operand(slot(m_height - 1));
+    emit(opcode, slot(m_height - 1), address, 0, argument.offset);
+}
+
+LoweredBranchTarget FunctionLowering::branch_target(size_t label, size_t pending_index, bool is_branch_table_entry)
+{
+    auto& frame = m_control[m_control.size() - label - 1];
+    auto arity = frame.branch_arity();
+    LoweredBranchTarget target {
+        .target = 0,
+        .destination = slot(frame.base_height),
+        .source = slot(m_height - arity),
+        .count = static_cast<u32>(arity),
+    };
+    if (target.source == target.destination)
+        target.count = 0;
+
+    if (frame.kind == ControlKind::Loop)
+        target.target = frame.start;
+    else
+        frame.pending_jumps.append({ pending_index, is_branch_table_entry });
+    return target;
+}
+
+void FunctionLowering::emit_branch(size_t label)
+{
+    auto target = branch_target(label, m_code.size(), false);
+    if (target.count == 0)
+        emit(LoweredOpCode::jump, 0, 0, 0, target.target);
+    else
+        emit(LoweredOpCode::branch, target.destination, target.source, target.count, target.target);
+}
+
+void FunctionLowering::enter(ControlKind kind, BlockType const& block_type)
+{
+    size_t parameter_count = 0;
+    size_t result_count = 0;
+    switch (block_type.kind()) {
+    case BlockType::Empty:
+        break;
+    case BlockType::Type:
+        result_count = 1;
+        break;
+    case BlockType::Index: {
+        auto& type = m_module.type(block_type.type_index());
+        parameter_count = type.parameters().size();
+        result_count = type.results().size();
+        break;
+    }
+    }
+
+    VERIFY(m_height >= parameter_count);
+    m_control.append(ControlFrame {
+        .kind = kind,
+        .base_height = m_height - parameter_count,
+        .parameter_count = parameter_count,
+        .result_count = result_count,
+        .start = m_code.size(),
+        .else_jump = {},
+        .pending_jumps = {},
+    });
+}
+
+void FunctionLowering::end(ControlFrame frame)
+{
+    if (frame.else_jump.has_value())
+        m_code[*frame.else_jump].immediate = m_code.size();
+    for (auto& jump : frame.pending_jumps)
+        patch(jump, m_code.size());
+    bind_label();
+
+    m_height = frame.base_height;
+    push(frame.result_count);
+    m_unreachable = false;
+}
+
+RefPtr<LoweredFunction> FunctionLowering::lower()
+{
+    // The function body behaves like a block whose label is the function's return.
+    m_control.append(ControlFrame {
+        .kind = ControlKind::Block,
+        .base_height = 0,
+        .parameter_count = 0,
+        .result_count = m_type.results().size(),
+        .start = 0,
+        .else_jump = {},
+        .pending_jumps = {},
+    });
+
+    for (auto& instruction : m_function.body().instructions()) {
+        if (!lower(instruction)) {
+            dbgln_if(WASM_TRACE_DEBUG, "Not lowering function: Instruction '{}' is not supported", instruction_name(instruction.opcode()));
+            return nullptr;
+        }
+    }
+
+    VERIFY(m_control.size() == 1);
+    end(m_control.take_last());
+    emit(LoweredOpCode::return_, 0, slot(0), m_type.results().size());
+
+    return adopt_ref(*new LoweredFunction(
+        move(m_code),
+        move(m_branch_targets),
+        m_type.results(),
+        m_type.parameters().size(),
+        m_local_count,
+        m_local_count + m_max_height));
+}
+
+bool FunctionLowering::lower(Instruction const& instruction)
+{
+    auto opcode = instruction.opcode();
+
+    if (m_unreachable) {
+        if (opcode == Instructions::block || opcode == Instructions::loop || opcode == Instructions::if_) {
+            ++m_unreachable_depth;
+            return true;
+        }
+        if (opcode == Instructions::structured_end && m_unreachable_depth > 0) {
+            --m_unreachable_depth;
+            return true;
+        }
+        if (m_unreachable_depth > 0 || (opcode != Instructions::structured_end && opcode != Instructions::structured_else))
+            return true;
+    }
+
+    switch (opcode.value()) {
+    case Instructions::unreachable.value():
+        emit(LoweredOpCode::unreachable);
+        m_unreachable = true;
+        return true;
+    case Instructions::nop.value():
+        return true;
+    case Instructions::block.value():
+        enter(ControlKind::Block, instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type);
+        return true;
+    case Instructions::loop.value():
+        enter(ControlKind::Loop, instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type);
+        bind_label();
+        return true;
+    case Instructions::if_.value(): {
+        pop();
+        auto condition = take_operand(slot(m_height));
+        auto jump = emit(LoweredOpCode::jump_if_zero, 0, condition);
+        enter(ControlKind::If, instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type);
+        m_control.last().else_jump = jump;
+        return true;
+    }
+    case Instructions::structured_else.value(): {
+        auto& frame = m_control.last();
+        VERIFY(frame.kind == ControlKind::If && frame.else_jump.has_value());
+        if (!m_unreachable)
+            frame.pending_jumps.append({ emit(LoweredOpCode::jump), false });
+        m_code[*frame.else_jump].immediate = m_code.size();
+        frame.else_jump.clear();
+        bind_label();
+        m_height = frame.base_height + frame.parameter_count;
+        m_unreachable = false;
+        return true;
+    }
+    case Instructions::structured_end.value():
+        // The function's own frame is closed after the last instruction.
+        VERIFY(m_control.size() > 1);
+        end(m_control.take_last());
+        return true;
+    case Instructions::br.value():
+        emit_branch(instruction.arguments().get<LabelIndex>().value());
+        m_unreachable = true;
+        return true;
+    case Instructions::br_if.value(): {
+        pop();
+        auto condition = take_operand(slot(m_height));
+        auto label = instruction.arguments().get<LabelIndex>().value();
+        auto arity = m_control[m_control.size() - label - 1].branch_arity();
+        if (arity == 0 || slot(m_height - arity) == slot(m_control[m_control.size() - label - 1].base_height)) {
+            auto target = branch_target(label, m_code.size(), false);
+            emit(LoweredOpCode::jump_if_not_zero, 0, condition, 0, target.target);
+            return true;
+        }
+        // Values have to be moved along with the branch, so only take it when the condition holds.
+        auto skip = emit(LoweredOpCode::jump_if_zero, 0, condition);
+        emit_branch(label);
+        m_code[skip].immediate = m_code.size();
+        bind_label();
+        return true;
+    }
+    case Instructions::br_table.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
+        pop();
+        auto index = take_operand(slot(m_height));
+        auto first_target = m_branch_targets.size();
+        for (auto& label : arguments.labels)
+            m_branch_targets.append(branch_target(label.value(), m_branch_targets.size(), true));
+        m_branch_targets.append(branch_target(arguments.default_.value(), m_branch_targets.size(), true));
+        emit(LoweredOpCode::branch_table, 0, index, arguments.labels.size(), first_target);
+        m_unreachable = true;
+        return true;
+    }
+    case Instructions::return_.value(): {
+        auto result_count = m_type.results().size();
+        emit(LoweredOpCode::return_, 0, slot(m_height - result_count), result_count);
+        m_unreachable = true;
+        return true;
+    }
+    case Instructions::call.value(): {
+        auto index = instruction.arguments().get<FunctionIndex>().value();
+        auto& type = *m_function_types[index];
+        pop(type.parameters().size());
+        emit(LoweredOpCode::call, 0, slot(m_height), 0, index);
+        push(type.results().size());
+        return true;
+    }
+    case Instructions::call_indirect.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::IndirectCallArgs>();
+        auto& type = m_module.type(arguments.type);
+        pop();
+        auto index = take_operand(slot(m_height));
+        pop(type.parameters().size());
+        emit(LoweredOpCode::call_indirect, slot(m_height), index, arguments.table.value(), arguments.type.value());
+        push(type.results().size());
+        return true;
+    }
+    case Instructions::drop.value():
+        pop();
+        return true;
+    case Instructions::select.value():
+    case Instructions::select_typed.value():
+        pop(3);
+        emit(LoweredOpCode::select, slot(m_height), slot(m_height), slot(m_height + 1), slot(m_height + 2));
+        push();
+        return true;
+    case Instructions::local_get.value():
+        emit(LoweredOpCode::copy, slot(m_height), instruction.arguments().get<LocalIndex>().value());
+        push();
+        return true;
+    case Instructions::local_set.value(): {
+        auto local = static_cast<u32>(instruction.arguments().get<LocalIndex>().value());
+        pop();
+        if (!retarget_last_result(slot(m_height), local))
+            emit(LoweredOpCode::copy, local, slot(m_height));
+        return true;
+    }
+    case Instructions::local_tee.value():
+        emit(LoweredOpCode::copy, instruction.arguments().get<LocalIndex>().value(), slot(m_height - 1));
+        return true;
+    case Instructions::global_get.value():
+        emit(LoweredOpCode::global_get, slot(m_height), 0, 0, instruction.arguments().get<GlobalIndex>().value());
+        push();
+        return true;
+    case Instructions::global_set.value():
+        pop();
+        emit(LoweredOpCode::global_set, 0, slot(m_height), 0, instruction.arguments().get<GlobalIndex>().value());
+        return true;
+    case Instructions::memory_size.value():
+        emit(LoweredOpCode::memory_size, slot(m_height));
+        push();
+        return true;
+    case Instructions::memory_grow.value():
+        emit(LoweredOpCode::memory_grow, slot(m_height - 1), slot(m_height - 1));
+        return true;
+    case Instructions::i32_const.value():
+        emit(LoweredOpCode::constant, slot(m_height), 0, 0, static_cast<u32>(instruction.arguments().get<i32>()));
+        push();
+        return true;
+    case Instructions::i64_const.value():
+        emit(LoweredOpCode::constant, slot(m_height), 0, 0, static_cast<u64>(instruction.arguments().get<i64>()));
+        push();
+        return true;
+    case Instructions::f32_const.value():
+        emit(LoweredOpCode::constant, slot(m_height), 0, 0, bit_cast<u32>(instruction.arguments().get<float>()));
+        push();
+        return true;
+    case Instructions::f64_const.value():
+        emit(LoweredOpCode::constant, slot(m_height), 0, 0, bit_cast<u64>(instruction.arguments().get<double>()));
+        push();
+        return true;
+    case Instructions::ref_null.value():
+        // Null references are encoded as zero, see BytecodeInterpreter::reference_to_slot().
+        emit(LoweredOpCode::constant, slot(m_height));
+        push();
+        return true;
+    case Instructions::ref_func.value():
+        emit(LoweredOpCode::ref_func, slot(m_height), 0, 0, instruction.arguments().get<FunctionIndex>().value());
+        push();
+        return true;
+    case Instructions::ref_is_null.value():
+        emit_unary(LoweredOpCode::ref_is_null);
+        return true;
+#define __ENUMERATE_LOWERED_OPCODE(name, ...) \
+    case Instructions::name.value():          \
+        emit_unary(LoweredOpCode::name);      \
+        return true;
+        ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+#define __ENUMERATE_LOWERED_OPCODE(name, ...) \
+    case Instructions::name.value():          \
+        emit_binary(LoweredOpCode::name);     \
+        return true;
+        ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+#define __ENUMERATE_LOWERED_OPCODE(name, ...)                                                                       \
+    case Instructions::name.value():                                                                                \
+        emit_memory_access(LoweredOpCode::name, instruction.arguments().get<Instruction::MemoryArgument>(), false); \
+        return true;
+        ENUMERATE_LOWERED_LOADS(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+#define __ENUMERATE_LOWERED_OPCODE(name, ...)                                                                      \
+    case Instructions::name.value():                                                                               \
+        emit_memory_access(LoweredOpCode::name, instruction.arguments().get<Instruction::MemoryArgument>(), true); \
+        return true;
+        ENUMERATE_LOWERED_STORES(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+    default:
+        // Table and bulk memory instructions are left to the stack-based interpreter.
+        return false;
+    }
+}
+
+}
+
+void lower_functions(Module& module)
+{
+    // Functions are indexed by imports first, followed by the functions defined in the module.
+    Vector<FunctionType const*> function_types;
+    module.for_each_section_of_type<ImportSection>([&](ImportSection const& section) {
+        for (auto& import_ : section.imports()) {
+            import_.description().visit(
+                [&](TypeIndex const& index) { function_types.append(&module.type(index)); },
+                [&](FunctionType const& type) { function_types.append(&type); },
+                [](auto const&) {});
+        }
+    });
+    for (auto& function : module.functions())
+        function_types.append(&module.type(function.type()));
+
+    for (auto& function : module.functions())
+        function.set_lowered(FunctionLowering { module, function_types, function }.lower());
+}
+
+}
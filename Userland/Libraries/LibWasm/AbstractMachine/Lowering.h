@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+// After validation, function bodies are lowered to a register-based form (see LoweredFunction):
+// - Every value lives in a 64-bit slot whose type is known statically, so no Variant is involved at runtime.
+// - Stack heights are resolved at lowering time, so instructions name their operand slots directly.
+// - Branch targets and the values that have to be moved along with a branch are precomputed,
+//   so control flow never has to look for labels.
+// Functions that use instructions which are not lowered keep running on the stack-based interpreter.
+
+// M(name, PopType, PushType, Operator)
+#define ENUMERATE_LOWERED_UNARY_OPERATIONS(M)                               \
+    M(i32_eqz, i32, i32, Operators::EqualsZero)                             \
+    M(i64_eqz, i64, i32, Operators::EqualsZero)                             \
+    M(i32_clz, i32, i32, Operators::CountLeadingZeros)                      \
+    M(i32_ctz, i32, i32, Operators::CountTrailingZeros)                     \
+    M(i32_popcnt, i32, i32, Operators::PopCount)                            \
+    M(i64_clz, i64, i64, Operators::CountLeadingZeros)                      \
+    M(i64_ctz, i64, i64, Operators::CountTrailingZeros)                     \
+    M(i64_popcnt, i64, i64, Operators::PopCount)                            \
+    M(f32_abs, float, float, Operators::Absolute)                           \
+    M(f32_neg, float, float, Operators::Negate)                             \
+    M(f32_ceil, float, float, Operators::Ceil)                              \
+    M(f32_floor, float, float, Operators::Floor)                            \
+    M(f32_trunc, float, float, Operators::Truncate)                         \
+    M(f32_nearest, float, float, Operators::NearbyIntegral)                 \
+    M(f32_sqrt, float, float, Operators::SquareRoot)                        \
+    M(f64_abs, double, double, Operators::Absolute)                         \
+    M(f64_neg, double, double, Operators::Negate)                           \
+    M(f64_ceil, double, double, Operators::Ceil)                            \
+    M(f64_floor, double, double, Operators::Floor)                          \
+    M(f64_trunc, double, double, Operators::Truncate)                       \
+    M(f64_nearest, double, double, Operators::NearbyIntegral)               \
+    M(f64_sqrt, double, double, Operators::SquareRoot)                      \
+    M(i32_wrap_i64, i64, i32, Operators::Wrap<i32>)                         \
+    M(i32_trunc_sf32, float, i32, Operators::CheckedTruncate<i32>)          \
+    M(i32_trunc_uf32, float, i32, Operators::CheckedTruncate<u32>)          \
+    M(i32_trunc_sf64, double, i32, Operators::CheckedTruncate<i32>)         \
+    M(i32_trunc_uf64, double, i32, Operators::CheckedTruncate<u32>)         \
+    M(i64_trunc_sf32, float, i64, Operators::CheckedTruncate<i64>)          \
+    M(i64_trunc_uf32, float, i64, Operators::CheckedTruncate<u64>)          \
+    M(i64_trunc_sf64, double, i64, Operators::CheckedTruncate<i64>)         \
+    M(i64_trunc_uf64, double, i64, Operators::CheckedTruncate<u64>)         \
+    M(i64_extend_si32, i32, i64, Operators::Extend<i64>)                    \
+    M(i64_extend_ui32, u32, i64, Operators::Extend<i64>)                    \
+    M(f32_convert_si32, i32, float, Operators::Convert<float>)              \
+    M(f32_convert_ui32, u32, float, Operators::Convert<float>)              \
+    M(f32_convert_si64, i64, float, Operators::Convert<float>)              \
+    M(f32_convert_ui64, u64, float, Operators::Convert<float>)              \
+    M(f32_demote_f64, double, float, Operators::Demote)                     \
+    M(f64_convert_si32, i32, double, Operators::Convert<double>)            \
+    M(f64_convert_ui32, u32, double, Operators::Convert<double>)            \
+    M(f64_convert_si64, i64, double, Operators::Convert<double>)            \
+    M(f64_convert_ui64, u64, double, Operators::Convert<double>)            \
+    M(f64_promote_f32, float, double, Operators::Promote)                   \
+    M(i32_reinterpret_f32, float, i32, Operators::Reinterpret<i32>)         \
+    M(i64_reinterpret_f64, double, i64, Operators::Reinterpret<i64>)        \
+    M(f32_reinterpret_i32, i32, float, Operators::Reinterpret<float>)       \
+    M(f64_reinterpret_i64, i64, double, Operators::Reinterpret<double>)     \
+    M(i32_extend8_s, i32, i32, Operators::SignExtend<i8>)                   \
+    M(i32_extend16_s, i32, i32, Operators::SignExtend<i16>)                 \
+    M(i64_extend8_s, i64, i64, Operators::SignExtend<i8>)                   \
+    M(i64_extend16_s, i64, i64, Operators::SignExtend<i16>)                 \
+    M(i64_extend32_s, i64, i64, Operators::SignExtend<i32>)                 \
+    M(i32_trunc_sat_f32_s, float, i32, Operators::SaturatingTruncate<i32>)  \
+    M(i32_trunc_sat_f32_u, float, i32, Operators::SaturatingTruncate<u32>)  \
+    M(i32_trunc_sat_f64_s, double, i32, Operators::SaturatingTruncate<i32>) \
+    M(i32_trunc_sat_f64_u, double, i32, Operators::SaturatingTruncate<u32>) \
+    M(i64_trunc_sat_f32_s, float, i64, Operators::SaturatingTruncate<i64>)  \
+    M(i64_trunc_sat_f32_u, float, i64, Operators::SaturatingTruncate<u64>)  \
+    M(i64_trunc_sat_f64_s, double, i64, Operators::SaturatingTruncate<i64>) \
+    M(i64_trunc_sat_f64_u, double, i64, Operators::SaturatingTruncate<u64>)
+
+// M(name, PopType, PushType, Operator)
+#define ENUMERATE_LOWERED_BINARY_OPERATIONS(M)             \
+    M(i32_eq, i32, i32, Operators::Equals)                 \
+    M(i32_ne, i32, i32, Operators::NotEquals)              \
+    M(i32_lts, i32, i32, Operators::LessThan)              \
+    M(i32_ltu, u32, i32, Operators::LessThan)              \
+    M(i32_gts, i32, i32, Operators::GreaterThan)           \
+    M(i32_gtu, u32, i32, Operators::GreaterThan)           \
+    M(i32_les, i32, i32, Operators::LessThanOrEquals)      \
+    M(i32_leu, u32, i32, Operators::LessThanOrEquals)      \
+    M(i32_ges, i32, i32, Operators::GreaterThanOrEquals)   \
+    M(i32_geu, u32, i32, Operators::GreaterThanOrEquals)   \
+    M(i64_eq, i64, i32, Operators::Equals)                 \
+    M(i64_ne, i64, i32, Operators::NotEquals)              \
+    M(i64_lts, i64, i32, Operators::LessThan)              \
+    M(i64_ltu, u64, i32, Operators::LessThan)              \
+    M(i64_gts, i64, i32, Operators::GreaterThan)           \
+    M(i64_gtu, u64, i32, Operators::GreaterThan)           \
+    M(i64_les, i64, i32, Operators::LessThanOrEquals)      \
+    M(i64_leu, u64, i32, Operators::LessThanOrEquals)      \
+    M(i64_ges, i64, i32, Operators::GreaterThanOrEquals)   \
+    M(i64_geu, u64, i32, Operators::GreaterThanOrEquals)   \
+    M(f32_eq, float, i32, Operators::Equals)               \
+    M(f32_ne, float, i32, Operators::NotEquals)            \
+    M(f32_lt, float, i32, Operators::LessThan)             \
+    M(f32_gt, float, i32, Operators::GreaterThan)          \
+    M(f32_le, float, i32, Operators::LessThanOrEquals)     \
+    M(f32_ge, float, i32, Operators::GreaterThanOrEquals)  \
+    M(f64_eq, double, i32, Operators::Equals)              \
+    M(f64_ne, double, i32, Operators::NotEquals)           \
+    M(f64_lt, double, i32, Operators::LessThan)            \
+    M(f64_gt, double, i32, Operators::GreaterThan)         \
+    M(f64_le, double, i32, Operators::LessThanOrEquals)    \
+    M(f64_ge, double, i32, Operators::GreaterThanOrEquals) \
+    M(i32_add, u32, i32, Operators::Add)                   \
+    M(i32_sub, u32, i32, Operators::Subtract)              \
+    M(i32_mul, u32, i32, Operators::Multiply)              \
+    M(i32_divs, i32, i32, Operators::Divide)               \
+    M(i32_divu, u32, i32, Operators::Divide)               \
+    M(i32_rems, i32, i32, Operators::Modulo)               \
+    M(i32_remu, u32, i32, Operators::Modulo)               \
+    M(i32_and, i32, i32, Operators::BitAnd)                \
+    M(i32_or, i32, i32, Operators::BitOr)                  \
+    M(i32_xor, i32, i32, Operators::BitXor)                \
+    M(i32_shl, u32, i32, Operators::BitShiftLeft)          \
+    M(i32_shrs, i32, i32, Operators::BitShiftRight)        \
+    M(i32_shru, u32, i32, Operators::BitShiftRight)        \
+    M(i32_rotl, u32, i32, Operators::BitRotateLeft)        \
+    M(i32_rotr, u32, i32, Operators::BitRotateRight)       \
+    M(i64_add, u64, i64, Operators::Add)                   \
+    M(i64_sub, u64, i64, Operators::Subtract)              \
+    M(i64_mul, u64, i64, Operators::Multiply)              \
+    M(i64_divs, i64, i64, Operators::Divide)               \
+    M(i64_divu, u64, i64, Operators::Divide)               \
+    M(i64_rems, i64, i64, Operators::Modulo)               \
+    M(i64_remu, u64, i64, Operators::Modulo)               \
+    M(i64_and, i64, i64, Operators::BitAnd)                \
+    M(i64_or, i64, i64, Operators::BitOr)                  \
+    M(i64_xor, i64, i64, Operators::BitXor)                \
+    M(i64_shl, u64, i64, Operators::BitShiftLeft)          \
+    M(i64_shrs, i64, i64, Operators::BitShiftRight)        \
+    M(i64_shru, u64, i64, Operators::BitShiftRight)        \
+    M(i64_rotl, u64, i64, Operators::BitRotateLeft)        \
+    M(i64_rotr, u64, i64, Operators::BitRotateRight)       \
+    M(f32_add, float, float, Operators::Add)               \
+    M(f32_sub, float, float, Operators::Subtract)          \
+    M(f32_mul, float, float, Operators::Multiply)          \
+    M(f32_div, float, float, Operators::Divide)            \
+    M(f32_min, float, float, Operators::Minimum)           \
+    M(f32_max, float, float, Operators::Maximum)           \
+    M(f32_copysign, float, float, Operators::CopySign)     \
+    M(f64_add, double, double, Operators::Add)             \
+    M(f64_sub, double, double, Operators::Subtract)        \
+    M(f64_mul, double, double, Operators::Multiply)        \
+    M(f64_div, double, double, Operators::Divide)          \
+    M(f64_min, double, double, Operators::Minimum)         \
+    M(f64_max, double, double, Operators::Maximum)         \
+    M(f64_copysign, double, double, Operators::CopySign)
+
+// M(name, ReadType, PushType)
+#define ENUMERATE_LOWERED_LOADS(M) \
+    M(i32_load, i32, i32)          \
+    M(i64_load, i64, i64)          \
+    M(f32_load, float, float)      \
+    M(f64_load, double, double)    \
+    M(i32_load8_s, i8, i32)        \
+    M(i32_load8_u, u8, i32)        \
+    M(i32_load16_s, i16, i32)      \
+    M(i32_load16_u, u16, i32)      \
+    M(i64_load8_s, i8, i64)        \
+    M(i64_load8_u, u8, i64)        \
+    M(i64_load16_s, i16, i64)      \
+    M(i64_load16_u, u16, i64)      \
+    M(i64_load32_s, i32, i64)      \
+    M(i64_load32_u, u32, i64)
+
+// M(name, PopType, StoreType)
+#define ENUMERATE_LOWERED_STORES(M) \
+    M(i32_store, i32, i32)          \
+    M(i64_store, i64, i64)          \
+    M(f32_store, float, float)      \
+    M(f64_store, double, double)    \
+    M(i32_store8, i32, i8)          \
+    M(i32_store16, i32, i16)        \
+    M(i64_store8, i64, i8)          \
+    M(i64_store16, i64, i16)        \
+    M(i64_store32, i64, i32)
+
+// Operand usage of the remaining instructions:
+// - copy:             destination <- lhs
+// - constant:         destination <- immediate
+// - jump:             goto immediate
+// - jump_if_zero:     if lhs == 0 goto immediate
+// - jump_if_not_zero: if lhs != 0 goto immediate
+// - branch:           move rhs values from lhs to destination, goto immediate
+// - branch_table:     pick one of the rhs + 1 branch targets starting at immediate by lhs
+// - return_:          move rhs values from lhs to the frame base and return
+// - call:             call function immediate with the arguments (and results) starting at lhs
+// - call_indirect:    call element lhs of table rhs, of type immediate, with the arguments starting at destination
+// - select:           destination <- immediate != 0 ? lhs : rhs
+// - global_get:       destination <- global immediate
+// - global_set:       global immediate <- lhs
+#define ENUMERATE_LOWERED_CONTROL_INSTRUCTIONS(M) \
+    M(unreachable)                                \
+    M(copy)                                       \
+    M(constant)                                   \
+    M(jump)                                       \
+    M(jump_if_zero)                               \
+    M(jump_if_not_zero)                           \
+    M(branch)                                     \
+    M(branch_table)                               \
+    M(return_)                                    \
+    M(call)                                       \
+    M(call_indirect)                              \
+    M(select)                                     \
+    M(global_get)                                 \
+    M(global_set)                                 \
+    M(memory_size)                                \
+    M(memory_grow)                                \
+    M(ref_is_null)                                \
+    M(ref_func)
+
+enum class LoweredOpCode : u32 {
+#define __ENUMERATE_LOWERED_OPCODE(name, ...) name,
+    ENUMERATE_LOWERED_CONTROL_INSTRUCTIONS(__ENUMERATE_LOWERED_OPCODE)
+    ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_LOWERED_OPCODE)
+    ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_LOWERED_OPCODE)
+    ENUMERATE_LOWERED_LOADS(__ENUMERATE_LOWERED_OPCODE)
+    ENUMERATE_LOWERED_STORES(__ENUMERATE_LOWERED_OPCODE)
+#undef __ENUMERATE_LOWERED_OPCODE
+};
+
+// Lowers all function bodies of a module that has passed validation.
+void lower_functions(Module&);
+
+}
@@ -42,5 +42,6 @@ static constexpr auto minimum_stack_space_to_keep_free = 256 * KiB; // Note: Val
 static constexpr auto max_allowed_executed_instructions_per_call = 256 * 1024 * 1024;
 static constexpr auto max_allowed_vector_size = 500 * MiB;
 static constexpr auto max_allowed_function_locals_per_type = 42069; // Note: VERY arbitrary.
+static constexpr auto max_allowed_lowered_frame_slots = 1 * MiB; // Note: Shared by all active lowered frames, 8 bytes each.
 
 }
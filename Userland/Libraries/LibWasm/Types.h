@@ -11,6 +11,8 @@
 #include <AK/DistinctNumeric.h>
 #include <AK/MemoryStream.h>
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/Result.h>
 #include <AK/String.h>
 #include <AK/Variant.h>
@@ -955,6 +957,52 @@ private:
     Optional<u32> m_count;
 };
 
+// A function body lowered to register-based code after validation, see AbstractMachine/Lowering.h.
+// All operands live in untyped 64-bit slots of the function's frame, indexed relative to the frame base:
+// the locals (parameters first) come first, followed by the operand stack at heights precomputed during lowering.
+struct LoweredInstruction {
+    u32 opcode { 0 };
+    u32 destination { 0 };
+    u32 lhs { 0 };
+    u32 rhs { 0 };
+    u64 immediate { 0 };
+};
+
+struct LoweredBranchTarget {
+    u32 target { 0 };
+    u32 destination { 0 };
+    u32 source { 0 };
+    u32 count { 0 };
+};
+
+class LoweredFunction : public RefCounted<LoweredFunction> {
+public:
+    LoweredFunction(Vector<LoweredInstruction> instructions, Vector<LoweredBranchTarget> branch_targets, Vector<ValueType> result_types, size_t parameter_count, size_t local_count, size_t frame_size)
+        : m_instructions(move(instructions))
+        , m_branch_targets(move(branch_targets))
+        , m_result_types(move(result_types))
+        , m_parameter_count(parameter_count)
+        , m_local_count(local_count)
+        , m_frame_size(frame_size)
+    {
+    }
+
+    auto& instructions() const { return m_instructions; }
+    auto& branch_targets() const { return m_branch_targets; }
+    auto& result_types() const { return m_result_types; }
+    auto parameter_count() const { return m_parameter_count; }
+    auto local_count() const { return m_local_count; }
+    auto frame_size() const { return m_frame_size; }
+
+private:
+    Vector<LoweredInstruction> m_instructions;
+    Vector<LoweredBranchTarget> m_branch_targets;
+    Vector<ValueType> m_result_types;
+    size_t m_parameter_count { 0 };
+    size_t m_local_count { 0 };
+    size_t m_frame_size { 0 };
+};
+
 class Module {
 public:
     enum class ValidationStatus {
@@ -975,11 +1023,14 @@ public:
         auto& type() const { return m_type; }
         auto& locals() const { return m_local_types; }
         auto& body() const { return m_body; }
+        LoweredFunction const* lowered() const { return m_lowered.ptr(); }
+        void set_lowered(RefPtr<LoweredFunction> lowered) { m_lowered = move(lowered); }
 
     private:
         TypeIndex m_type;
         Vector<ValueType> m_local_types;
         Expression m_body;
+        RefPtr<LoweredFunction> m_lowered;
     };
 
     using AnySection = Variant<
@@ -1011,6 +1062,7 @@ public:
 
     auto& sections() const { return m_sections; }
     auto& functions() const { return m_functions; }
+    auto& functions() { return m_functions; }
     auto& type(TypeIndex index) const
     {
         FunctionType const* type = nullptr;
@@ -681,6 +681,8 @@ void Document::tear_down_layout_tree()
     if (!m_layout_root)
         return;
 
+    m_layout_state = nullptr;
+
     // Gather up all the layout nodes in a vector and detach them from parents
     // while the vector keeps them alive.
 
@@ -811,7 +813,8 @@ void Document::update_layout()
 
     update_style();
 
-    if (!m_needs_layout && m_layout_root)
+    bool has_dirty_layout_nodes = m_layout_root && (m_layout_root->needs_layout() || m_layout_root->child_needs_layout());
+    if (!m_needs_layout && m_layout_root && !has_dirty_layout_nodes)
         return;
 
     // NOTE: If this is a document hosting <template> contents, layout is unnecessary.
@@ -821,6 +824,25 @@ void Document::update_layout()
     if (!browsing_context())
         return;
 
+    auto did_layout = [&](Vector<Gfx::IntRect> const* relaid_out_rects = nullptr) {
+        if (browsing_context()->is_top_level() && browsing_context()->active_document() == this) {
+            if (auto* page = this->page()) {
+                if (relaid_out_rects)
+                    page->client().page_did_partially_layout(*relaid_out_rects);
+                else
+                    page->client().page_did_layout();
+            }
+        }
+
+        m_needs_layout = false;
+        m_layout_update_timer->stop();
+    };
+
+    if (Vector<Gfx::IntRect> relaid_out_rects; !m_needs_layout && m_layout_root && relayout_dirty_layout_boundaries(relaid_out_rects)) {
+        did_layout(&relaid_out_rects);
+        return;
+    }
+
     auto viewport_rect = browsing_context()->viewport_rect();
 
     if (!m_layout_root) {
@@ -829,7 +851,8 @@ void Document::update_layout()
         m_layout_root = verify_cast<Layout::InitialContainingBlock>(*tree_builder.build(*this));
     }
 
-    Layout::LayoutState layout_state;
+    m_layout_state = make<Layout::LayoutState>();
+    auto& layout_state = *m_layout_state;
     layout_state.used_values_per_layout_node.resize(layout_node_count());
 
     {
@@ -850,15 +873,113 @@ void Document::update_layout()
 
     layout_state.commit();
 
+    m_layout_root->for_each_in_inclusive_subtree([](auto& layout_node) {
+        layout_node.clear_needs_layout();
+        return IterationDecision::Continue;
+    });
+
     browsing_context()->set_needs_display();
+    did_layout();
+}
+
+static void collect_layout_nodes_needing_layout(Layout::Node& node, Vector<Layout::Node&>& nodes)
+{
+    if (node.needs_layout())
+        nodes.append(node);
+    if (!node.child_needs_layout())
+        return;
+    node.for_each_child([&](auto& child) {
+        collect_layout_nodes_needing_layout(child, nodes);
+    });
+}
+
+// Lays out the subtrees of the layout boundaries containing dirty layout nodes again, on top of the results of
+// the previous layout pass. Returns false if that isn't possible and the whole document needs to be laid out.
+// The rects of the subtrees that were laid out again are appended to relaid_out_rects.
+bool Document::relayout_dirty_layout_boundaries(Vector<Gfx::IntRect>& relaid_out_rects)
+{
+    if (!m_layout_state)
+        return false;
+
+    Vector<Layout::Node&> dirty_nodes;
+    collect_layout_nodes_needing_layout(*m_layout_root, dirty_nodes);
 
-    if (browsing_context()->is_top_level() && browsing_context()->active_document() == this) {
-        if (auto* page = this->page())
-            page->client().page_did_layout();
+    HashTable<Layout::Box*> boundaries;
+    for (auto& node : dirty_nodes) {
+        Layout::Box* boundary = nullptr;
+        for (auto* ancestor = node.parent(); ancestor; ancestor = ancestor->parent()) {
+            if (is<Layout::Box>(*ancestor) && static_cast<Layout::Box&>(*ancestor).is_layout_boundary()) {
+                boundary = static_cast<Layout::Box*>(ancestor);
+                break;
+            }
+        }
+        if (!boundary)
+            return false;
+        boundaries.set(boundary);
+    }
+
+    // Boundaries nested inside other dirty boundaries are laid out along with them.
+    Vector<Layout::Box&> relayout_roots;
+    for (auto* boundary : boundaries) {
+        bool is_nested = false;
+        for (auto* ancestor = boundary->parent(); ancestor && !is_nested; ancestor = ancestor->parent())
+            is_nested = is<Layout::Box>(*ancestor) && boundaries.contains(static_cast<Layout::Box*>(ancestor));
+        if (!is_nested)
+            relayout_roots.append(*boundary);
+    }
+
+    // Absolutely positioned descendants that are placed relative to a box outside the boundary escape it.
+    for (auto& root : relayout_roots) {
+        bool has_escaping_descendant = false;
+        root.for_each_in_subtree_of_type<Layout::Box>([&](auto& box) {
+            if (box.is_absolutely_positioned() && box.containing_block() != &root && !root.is_ancestor_of(*box.containing_block())) {
+                has_escaping_descendant = true;
+                return IterationDecision::Break;
+            }
+            return IterationDecision::Continue;
+        });
+        if (has_escaping_descendant)
+            return false;
     }
 
-    m_needs_layout = false;
-    m_layout_update_timer->stop();
+    for (auto& root : relayout_roots) {
+        // Intrinsic sizes cached for anything inside the boundary may have changed.
+        root.for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& box) {
+            m_layout_state->intrinsic_sizes.remove(&box);
+            return IterationDecision::Continue;
+        });
+
+        Layout::LayoutState layout_state(m_layout_state.ptr());
+        auto const& root_state = layout_state.get_mutable(root);
+        auto available_space = Layout::AvailableSpace(
+            Layout::AvailableSize::make_definite(root_state.content_width()),
+            Layout::AvailableSize::make_definite(root_state.content_height()));
+
+        {
+            Layout::BlockFormattingContext context(layout_state, verify_cast<Layout::BlockContainer>(root), nullptr);
+            context.run(root, Layout::LayoutMode::Normal, available_space);
+        }
+
+        layout_state.commit_into_parent(*m_layout_state);
+
+        root.for_each_in_inclusive_subtree([](auto& layout_node) {
+            layout_node.clear_needs_layout();
+            return IterationDecision::Continue;
+        });
+        auto rect = enclosing_int_rect(root.paint_box()->absolute_rect());
+        relaid_out_rects.append(rect);
+        browsing_context()->set_needs_display(rect);
+    }
+
+    // The ancestors of the boundaries only had their bits set because of nodes inside the boundaries.
+    for (auto& root : relayout_roots) {
+        for (auto* ancestor = root.parent(); ancestor && ancestor->child_needs_layout(); ancestor = ancestor->parent())
+            ancestor->clear_needs_layout();
+    }
+
+    // The paintables in the laid out subtrees were replaced, so the stacking context tree has to be rebuilt.
+    invalidate_stacking_context_tree();
+    return true;
 }
 
 [[nodiscard]] static bool update_style_recursively(DOM::Node& node)
@@ -453,6 +453,7 @@ private:
     virtual EventTarget& global_event_handlers_to_event_target(FlyString const&) final { return *this; }
 
     void tear_down_layout_tree();
+    bool relayout_dirty_layout_boundaries(Vector<Gfx::IntRect>& relaid_out_rects);
 
     void evaluate_media_rules();
 
@@ -472,6 +473,9 @@ private:
 
     JS::GCPtr<Layout::InitialContainingBlock> m_layout_root;
 
+    // The results of the last layout pass, kept around so that a dirty subtree can be laid out again on top of them.
+    OwnPtr<Layout::LayoutState> m_layout_state;
+
     Optional<Color> m_link_color;
     Optional<Color> m_active_link_color;
     Optional<Color> m_visited_link_color;
@@ -7,6 +7,7 @@
 
 #include <AK/Debug.h>
 #include <AK/OwnPtr.h>
+#include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/Quad.h>
 #include <LibGfx/Rect.h>
@@ -220,7 +221,8 @@ void CanvasRenderingContext2D::stroke_internal(Gfx::Path const& path)
 
     auto& drawing_state = this->drawing_state();
 
-    painter->stroke_path(path, drawing_state.stroke_style, drawing_state.line_width);
+    Gfx::AntiAliasingPainter aa_painter { *painter };
+    aa_painter.stroke_path(path, drawing_state.stroke_style, drawing_state.line_width);
     did_draw(path.bounding_box());
 }
 
@@ -251,7 +253,8 @@ void CanvasRenderingContext2D::fill_internal(Gfx::Path& path, String const& fill
     else
         dbgln("Unrecognized fillRule for CRC2D.fill() - this problem goes away once we pass an enum instead of a string");
 
-    painter->fill_path(path, drawing_state().fill_style, winding);
+    Gfx::AntiAliasingPainter aa_painter { *painter };
+    aa_painter.fill_path(path, drawing_state().fill_style, winding);
     did_draw(path.bounding_box());
 }
 
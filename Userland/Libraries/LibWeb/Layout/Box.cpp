@@ -40,6 +40,34 @@ bool Box::is_body() const
     return dom_node() && dom_node() == document().body();
 }
 
+bool Box::is_layout_boundary() const
+{
+    // Only block-level boxes that were laid out before, and that are sized by block layout, are considered.
+    // Flex, grid and table layout may size their children based on their contents.
+    if (!is_block_container() || is_initial_containing_block_box() || !paint_box())
+        return false;
+    if (!display().is_block_outside() || !(display().is_flow_inside() || display().is_flow_root_inside()))
+        return false;
+    if (is_floating() || is_absolutely_positioned() || is_flex_item())
+        return false;
+    if (!parent() || !(parent()->display().is_flow_inside() || parent()->display().is_flow_root_inside()))
+        return false;
+
+    auto const& computed_values = this->computed_values();
+    auto is_content_independent = [](CSS::Size const& size) {
+        return size.is_length() || size.is_auto() || size.is_none();
+    };
+    if (!computed_values.width().is_length() || !computed_values.height().is_length())
+        return false;
+    if (!is_content_independent(computed_values.min_width()) || !is_content_independent(computed_values.max_width()))
+        return false;
+    if (!is_content_independent(computed_values.min_height()) || !is_content_independent(computed_values.max_height()))
+        return false;
+
+    // Content that overflows the box must not contribute to the scrollable overflow of its ancestors.
+    return computed_values.overflow_x() == CSS::Overflow::Hidden && computed_values.overflow_y() == CSS::Overflow::Hidden;
+}
+
 RefPtr<Painting::Paintable> Box::create_paintable() const
 {
     return Painting::PaintableBox::create(*this);
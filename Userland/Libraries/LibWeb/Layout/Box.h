@@ -27,6 +27,10 @@ public:
 
     bool is_body() const;
 
+    // A layout boundary is a box whose size and position can't be affected by anything inside it,
+    // so changes within its subtree can be laid out again without touching the rest of the tree.
+    bool is_layout_boundary() const;
+
     virtual Optional<float> intrinsic_width() const { return {}; }
     virtual Optional<float> intrinsic_height() const { return {}; }
     virtual Optional<float> intrinsic_aspect_ratio() const { return {}; }
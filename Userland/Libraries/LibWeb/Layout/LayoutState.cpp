@@ -56,6 +56,24 @@ void LayoutState::commit()
     // Only the top-level LayoutState should ever be committed.
     VERIFY(!m_parent);
 
+    transfer_used_values_to_layout_tree();
+}
+
+void LayoutState::commit_into_parent(LayoutState& parent)
+{
+    VERIFY(m_parent == &parent);
+    VERIFY(!parent.m_parent);
+
+    transfer_used_values_to_layout_tree();
+
+    for (size_t i = 0; i < used_values_per_layout_node.size(); ++i) {
+        if (used_values_per_layout_node[i])
+            parent.used_values_per_layout_node[i] = move(used_values_per_layout_node[i]);
+    }
+}
+
+void LayoutState::transfer_used_values_to_layout_tree()
+{
     HashTable<Layout::TextNode*> text_nodes;
 
     for (auto& used_values_ptr : used_values_per_layout_node) {
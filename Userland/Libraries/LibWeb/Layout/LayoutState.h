@@ -147,6 +147,10 @@ struct LayoutState {
 
     void commit();
 
+    // Commits a state that laid out part of the tree again on top of the committed results of `parent`,
+    // and moves its used values into `parent` so that it reflects the layout tree again.
+    void commit_into_parent(LayoutState& parent);
+
     // NOTE: get_mutable() will CoW the UsedValues if it's inherited from an ancestor state;
     UsedValues& get_mutable(NodeWithStyleAndBoxModelMetrics const&);
 
@@ -175,6 +179,9 @@ struct LayoutState {
 
     LayoutState const* m_parent { nullptr };
     LayoutState const& m_root;
+
+private:
+    void transfer_used_values_to_layout_tree();
 };
 
 Gfx::FloatRect absolute_content_rect(Box const&, LayoutState const&);
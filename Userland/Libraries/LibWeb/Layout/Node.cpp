@@ -164,6 +164,14 @@ void Node::set_needs_display()
     });
 }
 
+void Node::set_needs_layout()
+{
+    m_needs_layout = true;
+    for (auto* ancestor = parent(); ancestor && !ancestor->m_child_needs_layout; ancestor = ancestor->parent())
+        ancestor->m_child_needs_layout = true;
+    document().schedule_layout_update();
+}
+
 Gfx::FloatPoint Node::box_type_agnostic_position() const
 {
     if (is<Box>(*this))
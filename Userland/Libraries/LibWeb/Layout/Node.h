@@ -125,6 +125,17 @@ public:
 
     virtual void set_needs_display();
 
+    // Marks this node as needing layout, so that the next layout pass only has to lay out the
+    // subtree of the nearest layout boundary containing it, see Document::update_layout().
+    void set_needs_layout();
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+    void clear_needs_layout()
+    {
+        m_needs_layout = false;
+        m_child_needs_layout = false;
+    }
+
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
@@ -164,6 +175,9 @@ private:
 
     bool m_is_flex_item { false };
     bool m_generated { false };
+
+    bool m_needs_layout { false };
+    bool m_child_needs_layout { false };
 };
 
 class NodeWithStyle : public Node {
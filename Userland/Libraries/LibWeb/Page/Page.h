@@ -122,6 +122,8 @@ public:
     virtual void page_did_invalidate(Gfx::IntRect const&) { }
     virtual void page_did_change_favicon(Gfx::Bitmap const&) { }
     virtual void page_did_layout() { }
+    // Only the subtrees covering the given rects were laid out again, the rest of the layout is unchanged.
+    virtual void page_did_partially_layout(Vector<Gfx::IntRect> const&) { page_did_layout(); }
     virtual void page_did_request_scroll(i32, i32) { }
     virtual void page_did_request_scroll_to(Gfx::IntPoint const&) { }
     virtual void page_did_request_scroll_into_view(Gfx::IntRect const&) { }
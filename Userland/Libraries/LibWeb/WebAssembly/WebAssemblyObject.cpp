@@ -11,7 +11,9 @@
 #include "WebAssemblyModulePrototype.h"
 #include "WebAssemblyTableObject.h"
 #include "WebAssemblyTablePrototype.h"
+#include <AK/Hex.h>
 #include <AK/ScopeGuard.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -68,6 +70,7 @@ void WebAssemblyObject::initialize(JS::Realm& realm)
 }
 
 NonnullOwnPtrVector<WebAssemblyObject::CompiledWebAssemblyModule> WebAssemblyObject::s_compiled_modules;
+HashMap<String, size_t> WebAssemblyObject::s_compiled_module_indices;
 NonnullOwnPtrVector<Wasm::ModuleInstance> WebAssemblyObject::s_instantiated_modules;
 Vector<WebAssemblyObject::ModuleCache> WebAssemblyObject::s_module_caches;
 WebAssemblyObject::GlobalModuleCache WebAssemblyObject::s_global_cache;
@@ -94,15 +97,19 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyObject::validate)
     auto buffer = TRY(vm.argument(0).to_object(vm));
 
     // 2. Compile stableBytes as a WebAssembly module and store the results as module.
+    auto compiled_module_count = s_compiled_modules.size();
     auto maybe_module = parse_module(vm, buffer);
 
     // 3. If module is error, return false.
     if (maybe_module.is_error())
         return JS::Value(false);
 
-    // Drop the module from the cache, we're never going to refer to it.
+    // Drop the module from the cache if it was compiled just now, we're never going to refer to it.
     ScopeGuard drop_from_cache {
         [&] {
+            if (maybe_module.value() != compiled_module_count)
+                return;
+            s_compiled_module_indices.remove_all_matching([&](auto&, auto index) { return index == compiled_module_count; });
             (void)s_compiled_modules.take_last();
         }
     };
@@ -130,6 +137,14 @@ JS::ThrowCompletionOr<size_t> parse_module(JS::VM& vm, JS::Object* buffer_object
     } else {
         return vm.throw_completion<JS::TypeError>("Not a BufferSource");
     }
+
+    // Validating a module is far more expensive than hashing it, so compiling the same bytes again reuses the
+    // module compiled the first time.
+    auto digest = ::Crypto::Hash::SHA256::hash(data.data(), data.size());
+    auto cache_key = encode_hex(digest.bytes());
+    if (auto index = WebAssemblyObject::s_compiled_module_indices.get(cache_key); index.has_value())
+        return *index;
+
     InputMemoryStream stream { data };
     auto module_result = Wasm::Module::parse(stream);
     ScopeGuard drain_errors {
@@ -148,7 +163,9 @@ JS::ThrowCompletionOr<size_t> parse_module(JS::VM& vm, JS::Object* buffer_object
     }
 
     WebAssemblyObject::s_compiled_modules.append(make<WebAssemblyObject::CompiledWebAssemblyModule>(module_result.release_value()));
-    return WebAssemblyObject::s_compiled_modules.size() - 1;
+    auto index = WebAssemblyObject::s_compiled_modules.size() - 1;
+    WebAssemblyObject::s_compiled_module_indices.set(move(cache_key), index);
+    return index;
 }
 
 JS_DEFINE_NATIVE_FUNCTION(WebAssemblyObject::compile)
@@ -321,7 +338,8 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyObject::instantiate)
     // FIXME: This shouldn't block!
     auto buffer_or_error = vm.argument(0).to_object(vm);
     auto promise = JS::Promise::create(realm);
-    bool should_return_module = false;
+    // Only set when the module was compiled from bytes here, and should be returned along with the instance.
+    Optional<size_t> compiled_module_index;
     if (buffer_or_error.is_error()) {
         auto rejection_value = *buffer_or_error.throw_completion().value();
         promise->reject(rejection_value);
@@ -336,8 +354,8 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyObject::instantiate)
             promise->reject(*result.release_error().value());
             return promise;
         }
-        module = &WebAssemblyObject::s_compiled_modules.at(result.release_value()).module;
-        should_return_module = true;
+        compiled_module_index = result.release_value();
+        module = &WebAssemblyObject::s_compiled_modules.at(*compiled_module_index).module;
     } else if (is<WebAssemblyModuleObject>(buffer)) {
         module = &static_cast<WebAssemblyModuleObject*>(buffer)->module();
     } else {
@@ -352,9 +370,9 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyObject::instantiate)
         promise->reject(*result.release_error().value());
     } else {
         auto instance_object = vm.heap().allocate<WebAssemblyInstanceObject>(realm, realm, result.release_value());
-        if (should_return_module) {
+        if (compiled_module_index.has_value()) {
             auto object = JS::Object::create(realm, nullptr);
-            object->define_direct_property("module", vm.heap().allocate<WebAssemblyModuleObject>(realm, realm, s_compiled_modules.size() - 1), JS::default_attributes);
+            object->define_direct_property("module", vm.heap().allocate<WebAssemblyModuleObject>(realm, realm, *compiled_module_index), JS::default_attributes);
             object->define_direct_property("instance", instance_object, JS::default_attributes);
             promise->fulfill(object);
         } else {
@@ -53,6 +53,8 @@ public:
     };
 
     static NonnullOwnPtrVector<CompiledWebAssemblyModule> s_compiled_modules;
+    // Indices into s_compiled_modules, keyed by the SHA-256 of the module's bytes.
+    static HashMap<String, size_t> s_compiled_module_indices;
     static NonnullOwnPtrVector<Wasm::ModuleInstance> s_instantiated_modules;
     static Vector<ModuleCache> s_module_caches;
     static GlobalModuleCache s_global_cache;
@@ -202,15 +202,24 @@ void OutOfProcessWebView::screen_rects_change_event(GUI::ScreenRectsChangeEvent&
     client().async_update_screen_rects(event.rects(), event.main_screen_index());
 }
 
-void OutOfProcessWebView::notify_server_did_paint(Badge<WebContentClient>, i32 bitmap_id)
+void OutOfProcessWebView::notify_server_did_paint(Badge<WebContentClient>, i32 bitmap_id, Vector<Gfx::IntRect> const& damage_rects)
 {
     if (m_client_state.back_bitmap.id == bitmap_id) {
+        // The damage is relative to the previous front bitmap, so it doesn't apply if we've been showing something else.
+        bool can_update_damage_only = m_client_state.has_usable_bitmap;
+
         m_client_state.has_usable_bitmap = true;
         m_client_state.back_bitmap.pending_paints--;
         swap(m_client_state.back_bitmap, m_client_state.front_bitmap);
         // We don't need the backup bitmap anymore, so drop it.
         m_backup_bitmap = nullptr;
-        update();
+
+        if (can_update_damage_only) {
+            for (auto& rect : damage_rects)
+                update(rect.translated(frame_thickness(), frame_thickness()));
+        } else {
+            update();
+        }
 
         if (m_client_state.got_repaint_requests_while_painting) {
             m_client_state.got_repaint_requests_while_painting = false;
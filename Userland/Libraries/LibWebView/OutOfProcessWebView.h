@@ -136,7 +136,7 @@ private:
 
     // ^WebView::ViewImplementation
     virtual void notify_server_did_layout(Badge<WebContentClient>, Gfx::IntSize const& content_size) override;
-    virtual void notify_server_did_paint(Badge<WebContentClient>, i32 bitmap_id) override;
+    virtual void notify_server_did_paint(Badge<WebContentClient>, i32 bitmap_id, Vector<Gfx::IntRect> const& damage_rects) override;
     virtual void notify_server_did_invalidate_content_rect(Badge<WebContentClient>, Gfx::IntRect const&) override;
     virtual void notify_server_did_change_selection(Badge<WebContentClient>) override;
     virtual void notify_server_did_request_cursor_change(Badge<WebContentClient>, Gfx::StandardCursor cursor) override;
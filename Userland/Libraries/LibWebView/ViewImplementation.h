@@ -19,7 +19,8 @@ public:
     virtual ~ViewImplementation() { }
 
     virtual void notify_server_did_layout(Badge<WebContentClient>, Gfx::IntSize const& content_size) = 0;
-    virtual void notify_server_did_paint(Badge<WebContentClient>, i32 bitmap_id) = 0;
+    // The damage rects are in bitmap coordinates, and cover everything that changed since the previously painted bitmap.
+    virtual void notify_server_did_paint(Badge<WebContentClient>, i32 bitmap_id, Vector<Gfx::IntRect> const& damage_rects) = 0;
     virtual void notify_server_did_invalidate_content_rect(Badge<WebContentClient>, Gfx::IntRect const&) = 0;
     virtual void notify_server_did_change_selection(Badge<WebContentClient>) = 0;
     virtual void notify_server_did_request_cursor_change(Badge<WebContentClient>, Gfx::StandardCursor cursor) = 0;
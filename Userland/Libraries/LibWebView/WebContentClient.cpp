@@ -15,6 +15,8 @@ WebContentClient::WebContentClient(NonnullOwnPtr<Core::Stream::LocalSocket> sock
     : IPC::ConnectionToServer<WebContentClientEndpoint, WebContentServerEndpoint>(*this, move(socket))
     , m_view(view)
 {
+    if (auto result = enable_shared_memory_transport(); result.is_error())
+        dbgln("WebContentClient: Couldn't enable shared memory transport: {}", result.error());
 }
 
 void WebContentClient::die()
@@ -23,9 +25,13 @@ void WebContentClient::die()
     on_web_content_process_crash();
 }
 
-void WebContentClient::did_paint(Gfx::IntRect const&, i32 bitmap_id)
+void WebContentClient::did_paint(Gfx::IntRect const& content_rect, i32 bitmap_id, Vector<Gfx::IntRect> const& damage_rects)
 {
-    m_view.notify_server_did_paint({}, bitmap_id);
+    Vector<Gfx::IntRect> bitmap_damage_rects;
+    bitmap_damage_rects.ensure_capacity(damage_rects.size());
+    for (auto& rect : damage_rects)
+        bitmap_damage_rects.unchecked_append(rect.translated(-content_rect.location()));
+    m_view.notify_server_did_paint({}, bitmap_id, bitmap_damage_rects);
 }
 
 void WebContentClient::did_finish_loading(AK::URL const& url)
@@ -29,7 +29,7 @@ public:
 private:
     virtual void die() override;
 
-    virtual void did_paint(Gfx::IntRect const&, i32) override;
+    virtual void did_paint(Gfx::IntRect const&, i32, Vector<Gfx::IntRect> const&) override;
     virtual void did_finish_loading(AK::URL const&) override;
     virtual void did_invalidate_content_rect(Gfx::IntRect const&) override;
     virtual void did_change_selection() override;
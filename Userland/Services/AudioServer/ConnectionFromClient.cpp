@@ -82,6 +82,22 @@ void ConnectionFromClient::set_sample_rate(u32 sample_rate)
     m_mixer.audiodevice_set_sample_rate(sample_rate);
 }
 
+Messages::AudioServer::GetPeriodSizeResponse ConnectionFromClient::get_period_size()
+{
+    return { m_mixer.period_size() };
+}
+
+void ConnectionFromClient::set_period_size(u32 period_size)
+{
+    m_mixer.set_period_size(period_size);
+}
+
+Messages::AudioServer::GetMixerStatisticsResponse ConnectionFromClient::get_mixer_statistics()
+{
+    auto statistics = m_mixer.statistics();
+    return { statistics.underrun_count, statistics.last_mix_time_us, statistics.max_mix_time_us };
+}
+
 Messages::AudioServer::GetSelfVolumeResponse ConnectionFromClient::get_self_volume()
 {
     return m_queue->volume().target();
@@ -48,6 +48,9 @@ private:
     virtual void set_self_muted(bool) override;
     virtual void set_sample_rate(u32 sample_rate) override;
     virtual Messages::AudioServer::GetSampleRateResponse get_sample_rate() override;
+    virtual void set_period_size(u32 period_size) override;
+    virtual Messages::AudioServer::GetPeriodSizeResponse get_period_size() override;
+    virtual Messages::AudioServer::GetMixerStatisticsResponse get_mixer_statistics() override;
 
     Mixer& m_mixer;
     RefPtr<ClientAudioStream> m_queue;
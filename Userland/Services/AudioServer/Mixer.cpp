@@ -7,9 +7,11 @@
 
 #include "Mixer.h"
 #include <AK/Array.h>
+#include <AK/Endian.h>
 #include <AK/Format.h>
-#include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/Time.h>
 #include <AudioServer/ConnectionFromClient.h>
 #include <AudioServer/Mixer.h>
 #include <LibCore/ConfigFile.h>
@@ -38,6 +40,8 @@ Mixer::Mixer(NonnullRefPtr<Core::ConfigFile> config)
 
     m_muted = m_config->read_bool_entry("Master", "Mute", false);
     m_main_volume = static_cast<double>(m_config->read_num_entry("Master", "Volume", 100)) / 100.0;
+    auto period_size = m_config->read_num_entry("Master", "PeriodSize", HARDWARE_BUFFER_SIZE);
+    m_period_size = clamp<size_t>(period_size, MINIMUM_PERIOD_SIZE, HARDWARE_BUFFER_SIZE);
 
     m_sound_thread->start();
 }
@@ -45,37 +49,111 @@ Mixer::Mixer(NonnullRefPtr<Core::ConfigFile> config)
 NonnullRefPtr<ClientAudioStream> Mixer::create_queue(ConnectionFromClient& client)
 {
     auto queue = adopt_ref(*new ClientAudioStream(client));
+    auto* pending = new PendingStream { queue };
+    auto* head = m_pending_streams.load(AK::MemoryOrder::memory_order_relaxed);
+    do {
+        pending->next = head;
+    } while (!m_pending_streams.compare_exchange_strong(head, pending, AK::MemoryOrder::memory_order_release));
+
+    // Signal the mixer thread to start back up, in case nobody was connected before.
+    // The mixer only holds the lock while it goes to sleep, so this never waits for a period to be mixed.
     {
-        Threading::MutexLocker const locker(m_pending_mutex);
-        m_pending_mixing.append(*queue);
+        Threading::MutexLocker const locker(m_idle_mutex);
     }
-    // Signal the mixer thread to start back up, in case nobody was connected before.
     m_mixing_necessary.signal();
 
     return queue;
 }
 
+void Mixer::take_pending_streams(Vector<NonnullRefPtr<ClientAudioStream>>& active_streams)
+{
+    auto* pending = m_pending_streams.exchange(nullptr, AK::MemoryOrder::memory_order_acquire);
+    while (pending) {
+        active_streams.append(move(pending->stream));
+        delete exchange(pending, pending->next);
+    }
+}
+
+static_assert(sizeof(Audio::Sample) == 2 * sizeof(float));
+
+// Adds the samples, scaled by the gain, onto the mixed samples. Each vector holds two stereo samples.
+static void mix_samples(Span<Audio::Sample> mixed_samples, Span<Audio::Sample const> samples, float gain)
+{
+    using AK::SIMD::f32x4;
+
+    VERIFY(samples.size() <= mixed_samples.size());
+    auto* mixed = reinterpret_cast<u8*>(mixed_samples.data());
+    auto const* input = reinterpret_cast<u8 const*>(samples.data());
+    auto byte_count = samples.size() * sizeof(Audio::Sample);
+
+    size_t offset = 0;
+    for (; offset + sizeof(f32x4) <= byte_count; offset += sizeof(f32x4)) {
+        f32x4 mixed_vector;
+        f32x4 input_vector;
+        __builtin_memcpy(&mixed_vector, mixed + offset, sizeof(f32x4));
+        __builtin_memcpy(&input_vector, input + offset, sizeof(f32x4));
+        mixed_vector += input_vector * gain;
+        __builtin_memcpy(mixed + offset, &mixed_vector, sizeof(f32x4));
+    }
+    if (offset < byte_count)
+        mixed_samples[samples.size() - 1] += samples.last() * gain;
+}
+
+// Applies the main volume gain, clips and converts to the 16-bit samples the hardware expects.
+static void convert_to_device_samples(Span<Audio::Sample const> mixed_samples, Span<LittleEndian<i16>> output, float gain)
+{
+    using AK::SIMD::f32x4;
+    using AK::SIMD::i32x4;
+
+    VERIFY(output.size() == mixed_samples.size() * 2);
+    auto const* mixed = reinterpret_cast<u8 const*>(mixed_samples.data());
+    constexpr auto max_sample = static_cast<float>(NumericLimits<i16>::max());
+
+    for (size_t i = 0; i < output.size(); i += 4) {
+        f32x4 values;
+        if (i + 4 <= output.size()) {
+            __builtin_memcpy(&values, mixed + i * sizeof(float), sizeof(f32x4));
+        } else {
+            auto const& sample = mixed_samples.last();
+            values = f32x4 { sample.left, sample.right, 0, 0 };
+        }
+        values *= gain;
+        values = values > 1.0f ? 1.0f : values;
+        values = values < -1.0f ? -1.0f : values;
+        auto device_values = __builtin_convertvector(values * max_sample, i32x4);
+        for (size_t j = 0; j < 4 && i + j < output.size(); ++j)
+            output[i + j] = static_cast<i16>(device_values[j]);
+    }
+}
+
 void Mixer::mix()
 {
-    decltype(m_pending_mixing) active_mix_queues;
+    Vector<NonnullRefPtr<ClientAudioStream>> active_mix_queues;
+    // Log-scaled volumes are multiplicative, so the headroom can be applied together with each stream's volume.
+    auto const headroom_gain = Audio::Sample { 1 }.log_multiply(SAMPLE_HEADROOM).left;
 
     for (;;) {
-        {
-            Threading::MutexLocker const locker(m_pending_mutex);
+        take_pending_streams(active_mix_queues);
+        if (active_mix_queues.is_empty()) {
+            Threading::MutexLocker const locker(m_idle_mutex);
             // While we have nothing to mix, wait on the condition.
-            m_mixing_necessary.wait_while([this, &active_mix_queues]() { return m_pending_mixing.is_empty() && active_mix_queues.is_empty(); });
-            if (!m_pending_mixing.is_empty()) {
-                active_mix_queues.extend(move(m_pending_mixing));
-                m_pending_mixing.clear();
-            }
+            m_mixing_necessary.wait_while([this]() { return m_pending_streams.load(AK::MemoryOrder::memory_order_relaxed) == nullptr; });
+            continue;
         }
 
+        auto mix_start_time = Time::now_monotonic();
+
         active_mix_queues.remove_all_matching([&](auto& entry) { return !entry->client(); });
 
-        Array<Audio::Sample, HARDWARE_BUFFER_SIZE> mixed_buffer;
+        size_t const period_size = this->period_size();
+        Array<Audio::Sample, HARDWARE_BUFFER_SIZE> mixed_buffer_storage;
+        Array<Audio::Sample, HARDWARE_BUFFER_SIZE> stream_buffer_storage;
+        auto mixed_buffer = mixed_buffer_storage.span().trim(period_size);
+        auto stream_buffer = stream_buffer_storage.span().trim(period_size);
 
         m_main_volume.advance_time();
 
+        bool had_underrun = false;
         // Mix the buffers together into the output
         for (auto& queue : active_mix_queues) {
             if (!queue->client()) {
@@ -84,46 +162,64 @@ void Mixer::mix()
             }
             queue->volume().advance_time();
 
-            for (auto& mixed_sample : mixed_buffer) {
-                Audio::Sample sample;
-                if (!queue->get_next_sample(sample))
-                    break;
-                if (queue->is_muted())
-                    continue;
-                sample.log_multiply(SAMPLE_HEADROOM);
-                sample.log_multiply(static_cast<float>(queue->volume()));
-                mixed_sample += sample;
-            }
+            bool was_playing = queue->was_playing();
+            auto read_count = queue->read_samples(stream_buffer);
+            // A client that had nothing queued in the previous period is idle, not late.
+            if (read_count < period_size && was_playing && !queue->is_paused())
+                had_underrun = true;
+            if (read_count == 0 || queue->is_muted())
+                continue;
+
+            auto gain = headroom_gain * Audio::Sample { 1 }.log_multiply(static_cast<float>(queue->volume())).left;
+            mix_samples(mixed_buffer, stream_buffer.trim(read_count), gain);
         }
 
+        if (had_underrun)
+            m_underrun_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+
         if (m_muted) {
-            m_device->write(m_zero_filled_buffer.data(), static_cast<int>(m_zero_filled_buffer.size()));
+            record_mix_time(mix_start_time);
+            m_device->write(m_zero_filled_buffer.data(), static_cast<int>(period_size * 2 * sizeof(i16)));
         } else {
-            Array<u8, HARDWARE_BUFFER_SIZE_BYTES> buffer;
-            OutputMemoryStream stream { buffer };
+            Array<LittleEndian<i16>, HARDWARE_BUFFER_SIZE * 2> buffer;
+            auto output = buffer.span().trim(period_size * 2);
+
+            // Even though it's not realistic, the user expects no sound at 0%.
+            float main_gain = 0;
+            if (m_main_volume >= 0.01)
+                main_gain = Audio::Sample { 1 }.log_multiply(static_cast<float>(m_main_volume)).left;
+            convert_to_device_samples(mixed_buffer, output, main_gain);
 
-            for (auto& mixed_sample : mixed_buffer) {
+            record_mix_time(mix_start_time);
+            m_device->write(reinterpret_cast<u8 const*>(output.data()), static_cast<int>(output.size() * sizeof(i16)));
+        }
+    }
+}
 
-                // Even though it's not realistic, the user expects no sound at 0%.
-                if (m_main_volume < 0.01)
-                    mixed_sample = Audio::Sample { 0 };
-                else
-                    mixed_sample.log_multiply(static_cast<float>(m_main_volume));
-                mixed_sample.clip();
+void Mixer::record_mix_time(Time start_time)
+{
+    auto mix_time_us = static_cast<u32>((Time::now_monotonic() - start_time).to_microseconds());
+    m_last_mix_time_us.store(mix_time_us, AK::MemoryOrder::memory_order_relaxed);
+    if (mix_time_us > m_max_mix_time_us.load(AK::MemoryOrder::memory_order_relaxed))
+        m_max_mix_time_us.store(mix_time_us, AK::MemoryOrder::memory_order_relaxed);
+}
 
-                LittleEndian<i16> out_sample;
-                out_sample = static_cast<i16>(mixed_sample.left * NumericLimits<i16>::max());
-                stream << out_sample;
+Mixer::Statistics Mixer::statistics() const
+{
+    return {
+        .underrun_count = m_underrun_count.load(AK::MemoryOrder::memory_order_relaxed),
+        .last_mix_time_us = m_last_mix_time_us.load(AK::MemoryOrder::memory_order_relaxed),
+        .max_mix_time_us = m_max_mix_time_us.load(AK::MemoryOrder::memory_order_relaxed),
+    };
+}
 
-                out_sample = static_cast<i16>(mixed_sample.right * NumericLimits<i16>::max());
-                stream << out_sample;
-            }
+void Mixer::set_period_size(u32 period_size)
+{
+    period_size = clamp<size_t>(period_size, MINIMUM_PERIOD_SIZE, HARDWARE_BUFFER_SIZE);
+    m_period_size.store(period_size, AK::MemoryOrder::memory_order_relaxed);
 
-            VERIFY(stream.is_end());
-            VERIFY(!stream.has_any_error());
-            m_device->write(stream.data(), static_cast<int>(stream.size()));
-        }
-    }
+    m_config->write_num_entry("Master", "PeriodSize", static_cast<int>(period_size));
+    request_setting_sync();
 }
 
 void Mixer::set_main_volume(double volume)
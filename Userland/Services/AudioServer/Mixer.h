@@ -15,6 +15,8 @@
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/Queue.h>
 #include <AK/RefCounted.h>
+#include <AK/Time.h>
+#include <AK/TypedTransfer.h>
 #include <AK/WeakPtr.h>
 #include <LibAudio/Queue.h>
 #include <LibCore/File.h>
@@ -30,9 +32,12 @@ namespace AudioServer {
 // This is to prevent clipping when two streams with low headroom (e.g. normalized & compressed) are playing.
 constexpr double SAMPLE_HEADROOM = 0.95;
 // The size of the buffer in samples that the hardware receives through write() calls to the audio device.
+// This is the default and the maximum mixing period.
 constexpr size_t HARDWARE_BUFFER_SIZE = 512;
 // The hardware buffer size in bytes; there's two channels of 16-bit samples.
 constexpr size_t HARDWARE_BUFFER_SIZE_BYTES = HARDWARE_BUFFER_SIZE * 2 * sizeof(i16);
+// Shorter periods lower the latency, at the cost of waking up the mixer more often.
+constexpr size_t MINIMUM_PERIOD_SIZE = 64;
 
 class ConnectionFromClient;
 
@@ -41,30 +46,39 @@ public:
     explicit ClientAudioStream(ConnectionFromClient&);
     ~ClientAudioStream() = default;
 
-    bool get_next_sample(Audio::Sample& sample)
+    // Returns the number of samples that were read, which is less than requested if the client can't keep up.
+    size_t read_samples(Span<Audio::Sample> samples)
     {
-        if (m_paused)
-            return false;
-
-        if (m_in_chunk_location >= m_current_audio_chunk.size()) {
-            // FIXME: We should send a did_misbehave to the client if the queue is empty,
-            //        but the lifetimes involved mean that we segfault if we try to do that.
-            auto result = m_buffer->try_dequeue();
-            if (result.is_error()) {
-                if (result.error() == Audio::AudioQueue::QueueStatus::Empty)
-                    dbgln("Audio client can't keep up!");
-
-                return false;
-            }
-            m_current_audio_chunk = result.release_value();
-            m_in_chunk_location = 0;
+        if (m_paused) {
+            m_was_playing = false;
+            return 0;
         }
 
-        sample = m_current_audio_chunk[m_in_chunk_location++];
+        size_t read_count = 0;
+        while (read_count < samples.size()) {
+            if (m_in_chunk_location >= m_current_audio_chunk.size()) {
+                // FIXME: We should send a did_misbehave to the client if the queue is empty,
+                //        but the lifetimes involved mean that we segfault if we try to do that.
+                auto result = m_buffer->try_dequeue();
+                if (result.is_error())
+                    break;
+                m_current_audio_chunk = result.release_value();
+                m_in_chunk_location = 0;
+            }
 
-        return true;
+            auto count = min(samples.size() - read_count, m_current_audio_chunk.size() - m_in_chunk_location);
+            AK::TypedTransfer<Audio::Sample>::copy(samples.offset(read_count), m_current_audio_chunk.data() + m_in_chunk_location, count);
+            m_in_chunk_location += count;
+            read_count += count;
+        }
+
+        m_was_playing = read_count > 0;
+        return read_count;
     }
 
+    // Whether the previous read got any samples, which means that the client is in the middle of playing something.
+    bool was_playing() const { return m_was_playing; }
+
     ConnectionFromClient* client() { return m_client.ptr(); }
 
     void set_buffer(OwnPtr<Audio::AudioQueue> buffer) { m_buffer = move(buffer); }
@@ -77,6 +91,7 @@ public:
         } while (result.is_error() && result.error() != Audio::AudioQueue::QueueStatus::Empty);
     }
 
+    bool is_paused() const { return m_paused; }
     void set_paused(bool paused) { m_paused = paused; }
 
     FadingProperty<double>& volume() { return m_volume; }
@@ -88,10 +103,11 @@ public:
 private:
     OwnPtr<Audio::AudioQueue> m_buffer;
     Array<Audio::Sample, Audio::AUDIO_BUFFER_SIZE> m_current_audio_chunk;
-    size_t m_in_chunk_location;
+    size_t m_in_chunk_location { Audio::AUDIO_BUFFER_SIZE };
 
     bool m_paused { true };
     bool m_muted { false };
+    bool m_was_playing { false };
 
     WeakPtr<ConnectionFromClient> m_client;
     FadingProperty<double> m_volume { 1 };
@@ -114,14 +130,39 @@ public:
     int audiodevice_set_sample_rate(u32 sample_rate);
     u32 audiodevice_get_sample_rate() const;
 
+    u32 period_size() const { return m_period_size.load(AK::MemoryOrder::memory_order_relaxed); }
+    void set_period_size(u32);
+
+    struct Statistics {
+        // Number of periods in which a playing client didn't provide enough samples.
+        u64 underrun_count { 0 };
+        u32 last_mix_time_us { 0 };
+        u32 max_mix_time_us { 0 };
+    };
+    Statistics statistics() const;
+
 private:
     Mixer(NonnullRefPtr<Core::ConfigFile> config);
 
     void request_setting_sync();
 
-    Vector<NonnullRefPtr<ClientAudioStream>> m_pending_mixing;
-    Threading::Mutex m_pending_mutex;
-    Threading::ConditionVariable m_mixing_necessary { m_pending_mutex };
+    // New streams are pushed onto this list without taking a lock, so that registering a client
+    // never makes the mixer wait. The mixer takes over the whole list at the start of each period.
+    struct PendingStream {
+        NonnullRefPtr<ClientAudioStream> stream;
+        PendingStream* next { nullptr };
+    };
+    Atomic<PendingStream*> m_pending_streams { nullptr };
+    // Only used to put the mixer to sleep while there is nothing to mix.
+    Threading::Mutex m_idle_mutex;
+    Threading::ConditionVariable m_mixing_necessary { m_idle_mutex };
+
+    Atomic<u32> m_period_size { HARDWARE_BUFFER_SIZE };
+
+    // These are only written by the mixer thread.
+    Atomic<u64> m_underrun_count { 0 };
+    Atomic<u32> m_last_mix_time_us { 0 };
+    Atomic<u32> m_max_mix_time_us { 0 };
 
     RefPtr<Core::File> m_device;
 
@@ -136,6 +177,8 @@ private:
     Array<u8, HARDWARE_BUFFER_SIZE_BYTES> m_zero_filled_buffer;
 
     void mix();
+    void take_pending_streams(Vector<NonnullRefPtr<ClientAudioStream>>&);
+    void record_mix_time(Time start_time);
 };
 
 // Interval in ms when the server tries to save its configuration to disk.
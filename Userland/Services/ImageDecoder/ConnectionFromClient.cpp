@@ -22,14 +22,14 @@ void ConnectionFromClient::die()
     Core::EventLoop::current().quit(0);
 }
 
-Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer)
+Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(ReadonlyBytes encoded_data)
 {
-    if (!encoded_buffer.is_valid()) {
-        dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is invalid");
+    if (encoded_data.is_empty()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is empty");
         return nullptr;
     }
 
-    auto decoder = Gfx::ImageDecoder::try_create(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() });
+    auto decoder = Gfx::ImageDecoder::try_create(encoded_data);
 
     if (!decoder) {
         dbgln_if(IMAGE_DECODER_DEBUG, "Could not find suitable image decoder plugin for data");
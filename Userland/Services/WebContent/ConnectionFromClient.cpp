@@ -52,6 +52,8 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::Stream::LocalSock
     , m_page_host(PageHost::create(*this))
 {
     m_paint_flush_timer = Web::Platform::Timer::create_single_shot(0, [this] { flush_pending_paint_requests(); });
+    if (auto result = enable_shared_memory_transport(); result.is_error())
+        dbgln("WebContent: Couldn't enable shared memory transport: {}", result.error());
 }
 
 void ConnectionFromClient::die()
@@ -124,7 +126,10 @@ void ConnectionFromClient::add_backing_store(i32 backing_store_id, Gfx::Shareabl
 
 void ConnectionFromClient::remove_backing_store(i32 backing_store_id)
 {
-    m_backing_stores.remove(backing_store_id);
+    if (auto it = m_backing_stores.find(backing_store_id); it != m_backing_stores.end()) {
+        m_page_host->did_remove_backing_store(*it->value);
+        m_backing_stores.remove(it);
+    }
     m_pending_paint_requests.remove_all_matching([backing_store_id](auto& pending_repaint_request) { return pending_repaint_request.bitmap_id == backing_store_id; });
 }
 
@@ -151,8 +156,8 @@ void ConnectionFromClient::paint(Gfx::IntRect const& content_rect, i32 backing_s
 void ConnectionFromClient::flush_pending_paint_requests()
 {
     for (auto& pending_paint : m_pending_paint_requests) {
-        m_page_host->paint(pending_paint.content_rect, *pending_paint.bitmap);
-        async_did_paint(pending_paint.content_rect, pending_paint.bitmap_id);
+        auto damage_rects = m_page_host->paint_damaged_areas(pending_paint.content_rect, *pending_paint.bitmap);
+        async_did_paint(pending_paint.content_rect, pending_paint.bitmap_id, move(damage_rects));
     }
     m_pending_paint_requests.clear();
 }
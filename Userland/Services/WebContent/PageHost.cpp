@@ -7,6 +7,7 @@
 
 #include "PageHost.h"
 #include "ConnectionFromClient.h"
+#include <AK/AnyOf.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/ShareableBitmap.h>
 #include <LibGfx/SystemTheme.h>
@@ -33,6 +34,13 @@ PageHost::PageHost(ConnectionFromClient& client)
 void PageHost::set_has_focus(bool has_focus)
 {
     m_has_focus = has_focus;
+    invalidate_all_painted_content();
+}
+
+void PageHost::set_should_show_line_box_borders(bool b)
+{
+    m_should_show_line_box_borders = b;
+    invalidate_all_painted_content();
 }
 
 void PageHost::setup_palette()
@@ -57,6 +65,8 @@ void PageHost::set_palette_impl(Gfx::PaletteImpl const& impl)
     m_palette_impl = impl;
     if (auto* document = page().top_level_browsing_context().active_document())
         document->invalidate_style();
+    // Palette colors are used while painting, so the painted content is stale even if the style doesn't change.
+    invalidate_all_painted_content();
 }
 
 void PageHost::set_preferred_color_scheme(Web::CSS::PreferredColorScheme color_scheme)
@@ -96,23 +106,133 @@ Web::Layout::InitialContainingBlock* PageHost::layout_root()
 
 void PageHost::paint(Gfx::IntRect const& content_rect, Gfx::Bitmap& target)
 {
-    Gfx::Painter painter(target);
-    Gfx::IntRect bitmap_rect { {}, content_rect.size() };
-
     if (auto* document = page().top_level_browsing_context().active_document())
         document->update_layout();
 
-    auto* layout_root = this->layout_root();
-    if (!layout_root) {
-        painter.fill_rect(bitmap_rect, palette().base());
+    if (!layout_root()) {
+        Gfx::Painter painter(target);
+        painter.fill_rect({ {}, content_rect.size() }, palette().base());
+        return;
+    }
+
+    // Tiles are painted independently of the viewport, so anything that is positioned relative to it has to be painted directly.
+    if (has_viewport_dependent_content()) {
+        m_tile_cache.invalidate_all();
+        paint_content(content_rect, target);
         return;
     }
 
+    paint_from_tile_cache(content_rect, target, {});
+}
+
+Vector<Gfx::IntRect> PageHost::paint_damaged_areas(Gfx::IntRect const& content_rect, Gfx::Bitmap& target)
+{
+    if (auto* document = page().top_level_browsing_context().active_document())
+        document->update_layout();
+
+    auto damage_since_previous_frame = move(m_damage);
+    bool is_fully_damaged = exchange(m_is_fully_damaged, false);
+
+    auto previous_frame = move(m_previous_frame);
+    auto previous_frame_content_rect = m_previous_frame_content_rect;
+    m_previous_frame = target;
+    m_previous_frame_content_rect = content_rect;
+
+    bool can_reuse_previous_frame = previous_frame
+        && previous_frame != &target
+        && previous_frame->size() == target.size()
+        && !is_fully_damaged
+        && layout_root()
+        && !has_viewport_dependent_content();
+
+    if (!can_reuse_previous_frame) {
+        paint(content_rect, target);
+        return { content_rect };
+    }
+
+    // Copy over whatever is still visible from the previous frame, then paint the areas that were damaged or scrolled into view.
+    Gfx::DisjointIntRectSet rects_to_paint;
+    for (auto& rect : damage_since_previous_frame.rects()) {
+        auto damaged_rect = rect.intersected(content_rect);
+        if (!damaged_rect.is_empty())
+            rects_to_paint.add(damaged_rect);
+    }
+
+    auto reused_rect = content_rect.intersected(previous_frame_content_rect);
+    if (!reused_rect.is_empty()) {
+        Gfx::Painter painter(target);
+        painter.blit(reused_rect.location() - content_rect.location(), *previous_frame, reused_rect.translated(-previous_frame_content_rect.location()));
+    }
+    for (auto& exposed_rect : content_rect.shatter(reused_rect))
+        rects_to_paint.add(exposed_rect);
+
+    for (auto& rect : rects_to_paint.rects())
+        paint_from_tile_cache(rect, target, rect.location() - content_rect.location());
+
+    // If we scrolled, every pixel of the frame moved, even if we didn't have to paint it again.
+    if (content_rect.location() != previous_frame_content_rect.location())
+        return { content_rect };
+
+    Vector<Gfx::IntRect> damage;
+    damage.extend(rects_to_paint.rects());
+    return damage;
+}
+
+void PageHost::did_remove_backing_store(Gfx::Bitmap const& backing_store)
+{
+    if (m_previous_frame == &backing_store)
+        m_previous_frame = nullptr;
+}
+
+void PageHost::paint_from_tile_cache(Gfx::IntRect const& content_rect, Gfx::Bitmap& target, Gfx::IntPoint const& target_position)
+{
+    auto result = m_tile_cache.paint(content_rect, target, target_position, [this](auto& tile_rect, auto& tile) {
+        paint_content(tile_rect, tile);
+    });
+    if (result.is_error()) {
+        dbgln("PageHost: Failed to paint from the tile cache: {}", result.error());
+        m_tile_cache.invalidate_all();
+        paint_content(content_rect, target, target_position);
+    }
+}
+
+void PageHost::paint_content(Gfx::IntRect const& content_rect, Gfx::Bitmap& target, Gfx::IntPoint const& target_position)
+{
+    Gfx::Painter painter(target);
+    painter.add_clip_rect({ target_position, content_rect.size() });
+    painter.translate(target_position);
     Web::PaintContext context(painter, palette(), content_rect.top_left());
     context.set_should_show_line_box_borders(m_should_show_line_box_borders);
     context.set_viewport_rect(content_rect);
     context.set_has_focus(m_has_focus);
-    layout_root->paint_all_phases(context);
+    layout_root()->paint_all_phases(context);
+}
+
+void PageHost::invalidate_all_painted_content()
+{
+    m_tile_cache.invalidate_all();
+    m_is_fully_damaged = true;
+}
+
+bool PageHost::has_viewport_dependent_content()
+{
+    if (!m_viewport_dependency_is_stale)
+        return m_has_viewport_dependent_content;
+
+    m_has_viewport_dependent_content = false;
+    layout_root()->for_each_in_inclusive_subtree_of_type<Web::Layout::Box>([&](auto& box) {
+        auto const& background_layers = box.computed_values().background_layers();
+        bool has_fixed_background = any_of(background_layers, [](auto& layer) {
+            return layer.attachment == Web::CSS::BackgroundAttachment::Fixed;
+        });
+        if (box.is_fixed_position() || has_fixed_background) {
+            m_has_viewport_dependent_content = true;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    m_viewport_dependency_is_stale = false;
+    return m_has_viewport_dependent_content;
 }
 
 void PageHost::set_viewport_rect(Gfx::IntRect const& rect)
@@ -122,6 +242,9 @@ void PageHost::set_viewport_rect(Gfx::IntRect const& rect)
 
 void PageHost::page_did_invalidate(Gfx::IntRect const& content_rect)
 {
+    m_tile_cache.invalidate(content_rect);
+    m_damage.add(content_rect);
+
     m_invalidation_rect = m_invalidation_rect.united(content_rect);
     if (!m_invalidation_coalescing_timer->is_active())
         m_invalidation_coalescing_timer->start();
@@ -129,6 +252,7 @@ void PageHost::page_did_invalidate(Gfx::IntRect const& content_rect)
 
 void PageHost::page_did_change_selection()
 {
+    invalidate_all_painted_content();
     m_client.async_did_change_selection();
 }
 
@@ -139,6 +263,22 @@ void PageHost::page_did_request_cursor_change(Gfx::StandardCursor cursor)
 
 void PageHost::page_did_layout()
 {
+    invalidate_all_painted_content();
+    did_change_layout();
+}
+
+void PageHost::page_did_partially_layout(Vector<Gfx::IntRect> const& relaid_out_rects)
+{
+    // The visible parts of these were already invalidated, but the tile cache also holds content outside the viewport.
+    for (auto& rect : relaid_out_rects)
+        m_tile_cache.invalidate(rect);
+    did_change_layout();
+}
+
+void PageHost::did_change_layout()
+{
+    m_viewport_dependency_is_stale = true;
+
     auto* layout_root = this->layout_root();
     VERIFY(layout_root);
     if (layout_root->paint_box()->has_overflow())
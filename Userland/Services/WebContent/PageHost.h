@@ -7,8 +7,10 @@
 
 #pragma once
 
+#include <LibGfx/DisjointRectSet.h>
 #include <LibGfx/Rect.h>
 #include <LibWeb/Page/Page.h>
+#include <WebContent/TileCache.h>
 
 namespace WebContent {
 
@@ -27,11 +29,17 @@ public:
 
     void paint(Gfx::IntRect const& content_rect, Gfx::Bitmap&);
 
+    // Paints content_rect into target, copying everything that didn't change from the previously painted frame,
+    // and returns the rects that differ from that frame.
+    Vector<Gfx::IntRect> paint_damaged_areas(Gfx::IntRect const& content_rect, Gfx::Bitmap& target);
+    // Stops keeping a backing store alive that the client got rid of.
+    void did_remove_backing_store(Gfx::Bitmap const&);
+
     void set_palette_impl(Gfx::PaletteImpl const&);
     void set_viewport_rect(Gfx::IntRect const&);
     void set_screen_rects(Vector<Gfx::IntRect, 4> const& rects, size_t main_screen_index) { m_screen_rect = rects[main_screen_index]; };
     void set_preferred_color_scheme(Web::CSS::PreferredColorScheme);
-    void set_should_show_line_box_borders(bool b) { m_should_show_line_box_borders = b; }
+    void set_should_show_line_box_borders(bool);
     void set_has_focus(bool);
     void set_is_scripting_enabled(bool);
     void set_is_webdriver_active(bool);
@@ -49,6 +57,7 @@ private:
     virtual void page_did_change_selection() override;
     virtual void page_did_request_cursor_change(Gfx::StandardCursor) override;
     virtual void page_did_layout() override;
+    virtual void page_did_partially_layout(Vector<Gfx::IntRect> const&) override;
     virtual void page_did_change_title(String const&) override;
     virtual void page_did_request_scroll(i32, i32) override;
     virtual void page_did_request_scroll_to(Gfx::IntPoint const&) override;
@@ -78,6 +87,11 @@ private:
 
     Web::Layout::InitialContainingBlock* layout_root();
     void setup_palette();
+    void paint_content(Gfx::IntRect const& content_rect, Gfx::Bitmap&, Gfx::IntPoint const& target_position = {});
+    void paint_from_tile_cache(Gfx::IntRect const& content_rect, Gfx::Bitmap&, Gfx::IntPoint const& target_position);
+    void invalidate_all_painted_content();
+    void did_change_layout();
+    bool has_viewport_dependent_content();
 
     ConnectionFromClient& m_client;
     NonnullOwnPtr<Web::Page> m_page;
@@ -89,6 +103,18 @@ private:
 
     RefPtr<Web::Platform::Timer> m_invalidation_coalescing_timer;
     Gfx::IntRect m_invalidation_rect;
+
+    TileCache m_tile_cache;
+
+    // The backing store we painted last, and everything that was invalidated since.
+    RefPtr<Gfx::Bitmap> m_previous_frame;
+    Gfx::IntRect m_previous_frame_content_rect;
+    Gfx::DisjointIntRectSet m_damage;
+    bool m_is_fully_damaged { true };
+
+    bool m_has_viewport_dependent_content { false };
+    bool m_viewport_dependency_is_stale { true };
+
     Web::CSS::PreferredColorScheme m_preferred_color_scheme { Web::CSS::PreferredColorScheme::Auto };
 };
 
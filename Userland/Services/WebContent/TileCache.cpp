@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibGfx/Painter.h>
+#include <WebContent/TileCache.h>
+
+namespace WebContent {
+
+static int floor_div(int value, int divisor)
+{
+    auto quotient = value / divisor;
+    if (value % divisor != 0 && value < 0)
+        --quotient;
+    return quotient;
+}
+
+Gfx::IntPoint TileCache::tile_index_for(Gfx::IntPoint const& position)
+{
+    return { floor_div(position.x(), tile_size), floor_div(position.y(), tile_size) };
+}
+
+Gfx::IntRect TileCache::tile_rect(Gfx::IntPoint const& tile_index)
+{
+    return { tile_index.x() * tile_size, tile_index.y() * tile_size, tile_size, tile_size };
+}
+
+void TileCache::invalidate(Gfx::IntRect const& content_rect)
+{
+    for (auto& it : m_tiles) {
+        if (tile_rect(it.key).intersects(content_rect))
+            it.value.is_valid = false;
+    }
+}
+
+void TileCache::invalidate_all()
+{
+    for (auto& it : m_tiles)
+        it.value.is_valid = false;
+}
+
+ErrorOr<void> TileCache::paint(Gfx::IntRect const& content_rect, Gfx::Bitmap& target, Gfx::IntPoint const& target_position, PaintTileCallback const& paint_tile)
+{
+    if (content_rect.is_empty())
+        return {};
+
+    ++m_paint_generation;
+
+    Gfx::Painter painter(target);
+    painter.add_clip_rect({ target_position, content_rect.size() });
+    painter.translate(target_position - content_rect.location());
+
+    auto first_tile = tile_index_for(content_rect.location());
+    auto last_tile = tile_index_for({ content_rect.right(), content_rect.bottom() });
+
+    for (int y = first_tile.y(); y <= last_tile.y(); ++y) {
+        for (int x = first_tile.x(); x <= last_tile.x(); ++x) {
+            Gfx::IntPoint tile_index { x, y };
+            auto rect = tile_rect(tile_index);
+
+            auto& tile = m_tiles.ensure(tile_index);
+            if (!tile.bitmap)
+                tile.bitmap = TRY(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, rect.size()));
+            if (!tile.is_valid) {
+                paint_tile(rect, *tile.bitmap);
+                tile.is_valid = true;
+            }
+            tile.last_used = m_paint_generation;
+
+            painter.blit(rect.location(), *tile.bitmap, tile.bitmap->rect());
+        }
+    }
+
+    evict_least_recently_used_tiles();
+    return {};
+}
+
+void TileCache::evict_least_recently_used_tiles()
+{
+    if (m_tiles.size() <= max_tile_count)
+        return;
+
+    Vector<Gfx::IntPoint> eviction_candidates;
+    for (auto& it : m_tiles) {
+        // Never throw away what we just painted, even if a single paint needed more tiles than we'd like to keep.
+        if (it.value.last_used != m_paint_generation)
+            eviction_candidates.append(it.key);
+    }
+
+    quick_sort(eviction_candidates, [&](auto& a, auto& b) {
+        return m_tiles.find(a)->value.last_used < m_tiles.find(b)->value.last_used;
+    });
+
+    for (auto& tile_index : eviction_candidates) {
+        if (m_tiles.size() <= max_tile_count)
+            break;
+        m_tiles.remove(tile_index);
+    }
+}
+
+}
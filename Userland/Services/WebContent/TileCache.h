@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Point.h>
+#include <LibGfx/Rect.h>
+
+namespace WebContent {
+
+// Keeps the rendered page around as a grid of fixed-size tiles in content coordinates.
+// Painting a rect only has to rasterize the tiles that were invalidated since they were last painted,
+// everything else is copied from the cache. This makes scrolling, and small invalidations like a
+// blinking caret, independent of how expensive the rest of the page is to paint.
+//
+// Stale tiles are painted from the layout tree on the main thread. There is no recorded display list to
+// replay them from, as LibWeb paints through Gfx::Painter directly.
+class TileCache {
+public:
+    static constexpr int tile_size = 256;
+    static constexpr size_t max_tile_count = 128;
+
+    using PaintTileCallback = Function<void(Gfx::IntRect const& tile_rect, Gfx::Bitmap& tile)>;
+
+    void invalidate(Gfx::IntRect const& content_rect);
+    void invalidate_all();
+
+    // Copies content_rect into target at target_position, calling paint_tile for every tile that is missing or stale first.
+    ErrorOr<void> paint(Gfx::IntRect const& content_rect, Gfx::Bitmap& target, Gfx::IntPoint const& target_position, PaintTileCallback const& paint_tile);
+
+private:
+    struct Tile {
+        RefPtr<Gfx::Bitmap> bitmap;
+        bool is_valid { false };
+        u64 last_used { 0 };
+    };
+
+    static Gfx::IntPoint tile_index_for(Gfx::IntPoint const&);
+    static Gfx::IntRect tile_rect(Gfx::IntPoint const& tile_index);
+
+    void evict_least_recently_used_tiles();
+
+    HashMap<Gfx::IntPoint, Tile> m_tiles;
+    u64 m_paint_generation { 0 };
+};
+
+}
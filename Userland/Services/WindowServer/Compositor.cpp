@@ -102,6 +102,8 @@ void CompositorScreenData::init_bitmaps(Compositor& compositor, Screen& screen)
     m_flush_rects.clear_with_capacity();
     m_flush_transparent_rects.clear_with_capacity();
     m_flush_special_rects.clear_with_capacity();
+    m_flush_direct_rects.clear_with_capacity();
+    m_stale_back_rects.clear_with_capacity();
 
     auto size = screen.size();
     m_front_bitmap = nullptr;
@@ -177,6 +179,12 @@ void Compositor::compose()
         return;
     }
 
+    auto compose_start_time = Time::now_monotonic();
+    ScopeGuard update_compose_statistics = [&] {
+        m_total_compose_time += Time::now_monotonic() - compose_start_time;
+        ++m_composed_frame_count;
+    };
+
     if (m_occlusions_dirty) {
         m_occlusions_dirty = false;
         recompute_occlusions();
@@ -191,6 +199,12 @@ void Compositor::compose()
 
     // Mark window regions as dirty that need to be re-rendered
     wm.for_each_visible_window_from_back_to_front([&](Window& window) {
+        if (window.screens().is_empty()) {
+            // This window is completely covered or off-screen, so it won't be rendered at all. Anything
+            // that uncovers it invalidates the screen underneath, which will mark it as dirty again.
+            window.clear_dirty_rects();
+            return IterationDecision::Continue;
+        }
         auto transition_offset = window_transition_offset(window);
         auto frame_rect = window.frame().render_rect();
         auto frame_rect_on_screen = frame_rect.translated(transition_offset);
@@ -244,12 +258,23 @@ void Compositor::compose()
 
     auto& cursor_screen = ScreenInput::the().cursor_location_screen();
 
+    // An opaque fullscreen window is all there is to see, so unless something has to be drawn on top of it
+    // we can render it straight into the front buffer instead of copying it there from the back buffer.
+    auto* fullscreen_window = wm.active_fullscreen_window();
+    Window* direct_scanout_window = nullptr;
+    if (fullscreen_window && fullscreen_window->is_opaque() && m_overlay_list.is_empty() && m_animations.is_empty() && !m_flash_flush && !window_stack_transition_in_progress)
+        direct_scanout_window = fullscreen_window;
+
     Screen::for_each([&](auto& screen) {
         auto& screen_data = screen.compositor_screen_data();
         screen_data.m_have_flush_rects = false;
         screen_data.m_flush_rects.clear_with_capacity();
         screen_data.m_flush_transparent_rects.clear_with_capacity();
         screen_data.m_flush_special_rects.clear_with_capacity();
+        screen_data.m_flush_direct_rects.clear_with_capacity();
+        // Everything but the cursor is composed in the back buffer again, so bring it up to date
+        if (!direct_scanout_window)
+            screen_data.copy_stale_back_rects_from_front(screen, screen.rect());
         return IterationDecision::Continue;
     });
 
@@ -284,6 +309,8 @@ void Compositor::compose()
         VERIFY(!screen_data.m_flush_transparent_rects.intersects(rect));
         screen_data.m_have_flush_rects = true;
         screen_data.m_flush_rects.add(rect);
+        if (!screen_data.m_stale_back_rects.is_empty())
+            screen_data.m_stale_back_rects = screen_data.m_stale_back_rects.shatter(rect);
         check_restore_cursor_back(screen, rect);
     };
 
@@ -298,6 +325,8 @@ void Compositor::compose()
 
         screen_data.m_have_flush_rects = true;
         screen_data.m_flush_transparent_rects.add(rect);
+        if (!screen_data.m_stale_back_rects.is_empty())
+            screen_data.m_stale_back_rects = screen_data.m_stale_back_rects.shatter(rect);
         check_restore_cursor_back(screen, rect);
     };
 
@@ -305,24 +334,16 @@ void Compositor::compose()
         check_restore_cursor_back(cursor_screen, cursor_rect);
 
     auto paint_wallpaper = [&](Screen& screen, Gfx::Painter& painter, Gfx::IntRect const& rect, Gfx::IntRect const& screen_rect) {
-        if (m_wallpaper) {
-            if (m_wallpaper_mode == WallpaperMode::Center) {
-                Gfx::IntPoint offset { (screen.width() - m_wallpaper->width()) / 2, (screen.height() - m_wallpaper->height()) / 2 };
-
-                // FIXME: If the wallpaper is opaque and covers the whole rect, no need to fill with color!
-                painter.fill_rect(rect, background_color);
-                painter.blit_offset(rect.location(), *m_wallpaper, rect.translated(-screen_rect.location()), offset);
-            } else if (m_wallpaper_mode == WallpaperMode::Tile) {
-                painter.draw_tiled_bitmap(rect, *m_wallpaper);
-            } else if (m_wallpaper_mode == WallpaperMode::Stretch) {
-                VERIFY(screen.compositor_screen_data().m_wallpaper_bitmap);
-                painter.blit(rect.location(), *screen.compositor_screen_data().m_wallpaper_bitmap, rect);
-            } else {
-                VERIFY_NOT_REACHED();
-            }
-        } else {
+        if (!m_wallpaper) {
             painter.fill_rect(rect, background_color);
+            return;
         }
+
+        // The wallpaper is rendered for the whole screen only once, after which we just copy from it
+        auto& screen_data = screen.compositor_screen_data();
+        if (!screen_data.m_wallpaper_bitmap)
+            screen_data.init_wallpaper_bitmap(*this, screen, background_color);
+        painter.blit(rect.location(), *screen_data.m_wallpaper_bitmap, rect.translated(-screen_rect.location()));
     };
 
     {
@@ -471,7 +492,46 @@ void Compositor::compose()
                 dbgln("    transparent: {}", r);
         }
 
-        // Render opaque portions directly to the back buffer
+        auto render_opaque_rect = [&](Screen& screen, Gfx::IntRect const& screen_render_rect) {
+            dbgln_if(COMPOSE_DEBUG, "    render opaque: {} on screen #{}", screen_render_rect, screen.index());
+
+            prepare_rect(screen, screen_render_rect);
+            auto& back_painter = *screen.compositor_screen_data().m_back_painter;
+            Gfx::PainterStateSaver saver(back_painter);
+            back_painter.add_clip_rect(screen_render_rect);
+            compose_window_rect(screen, back_painter, screen_render_rect);
+        };
+
+        auto render_opaque_rect_directly = [&](Screen& screen, Gfx::IntRect const& screen_render_rect) {
+            auto& screen_data = screen.compositor_screen_data();
+
+            // The cursor is drawn into the back buffer and copied from there, and so is whatever gets
+            // restored from underneath it. Any area it touches has to be rendered the usual way.
+            Gfx::DisjointIntRectSet cursor_rects;
+            if (&screen == &cursor_screen)
+                cursor_rects.add(cursor_rect.intersected(screen_render_rect));
+            if (&screen == previous_cursor_screen)
+                cursor_rects.add(previous_cursor_rect.intersected(screen_render_rect));
+            if (screen_data.m_cursor_back_is_valid)
+                cursor_rects.add(screen_data.m_last_cursor_rect.intersected(screen_render_rect));
+            for (auto& rect : cursor_rects.rects())
+                render_opaque_rect(screen, rect);
+
+            Gfx::DisjointIntRectSet direct_rects { screen_render_rect };
+            for (auto& rect : direct_rects.shatter(cursor_rects).rects()) {
+                dbgln_if(COMPOSE_DEBUG, "    render opaque directly: {} on screen #{}", rect, screen.index());
+
+                screen_data.m_have_flush_rects = true;
+                screen_data.m_flush_direct_rects.add(rect);
+                screen_data.m_stale_back_rects.add(rect);
+                auto& front_painter = *screen_data.m_front_painter;
+                Gfx::PainterStateSaver saver(front_painter);
+                front_painter.add_clip_rect(rect);
+                compose_window_rect(screen, front_painter, rect);
+            }
+        };
+
+        // Render opaque portions directly to the back buffer, or even the front buffer if we can
         auto& opaque_rects = window.opaque_rects();
         if (!opaque_rects.is_empty()) {
             opaque_rects.for_each_intersected(dirty_rects, [&](const Gfx::IntRect& render_rect) {
@@ -479,13 +539,12 @@ void Compositor::compose()
                     auto screen_render_rect = render_rect.intersected(screen->rect());
                     if (screen_render_rect.is_empty())
                         continue;
-                    dbgln_if(COMPOSE_DEBUG, "    render opaque: {} on screen #{}", screen_render_rect, screen->index());
 
-                    prepare_rect(*screen, screen_render_rect);
-                    auto& back_painter = *screen->compositor_screen_data().m_back_painter;
-                    Gfx::PainterStateSaver saver(back_painter);
-                    back_painter.add_clip_rect(screen_render_rect);
-                    compose_window_rect(*screen, back_painter, screen_render_rect);
+                    // With buffer flipping, the front buffer becomes the back buffer that the next frame is rendered into
+                    if (&window == direct_scanout_window && !screen->compositor_screen_data().m_screen_can_set_buffer)
+                        render_opaque_rect_directly(*screen, screen_render_rect);
+                    else
+                        render_opaque_rect(*screen, screen_render_rect);
                 }
                 return IterationDecision::Continue;
             });
@@ -534,7 +593,6 @@ void Compositor::compose()
 
     // Paint the window stack.
     if (m_invalidated_window) {
-        auto* fullscreen_window = wm.active_fullscreen_window();
         if (fullscreen_window && fullscreen_window->is_opaque()) {
             compose_window(*fullscreen_window);
             fullscreen_window->clear_dirty_rects();
@@ -601,6 +659,8 @@ void Compositor::compose()
 
     if (need_to_draw_cursor) {
         auto& screen_data = cursor_screen.compositor_screen_data();
+        // The cursor saves what's underneath it from the back buffer
+        screen_data.copy_stale_back_rects_from_front(cursor_screen, cursor_rect);
         screen_data.draw_cursor(cursor_screen, cursor_rect);
     }
 
@@ -720,6 +780,11 @@ void Compositor::flush(Screen& screen)
         do_flush(rect);
     for (auto& rect : screen_data.m_flush_special_rects.rects())
         do_flush(rect);
+    if (device_can_flush_buffers) {
+        // These are already in the front buffer, but the device still needs to know about them
+        for (auto& rect : screen_data.m_flush_direct_rects.rects())
+            screen.queue_flush_display_rect(rect.translated(-screen_rect.location()));
+    }
     if (device_can_flush_buffers && !screen_data.m_screen_can_set_buffer) {
         // If we also support flipping buffers we don't really need to flush these areas right now.
         // Instead, we skip this step and just keep track of them until shortly before the next flip.
@@ -792,7 +857,7 @@ bool Compositor::set_background_color(String const& background_color)
     bool succeeded = !wm.config()->sync().is_error();
 
     if (succeeded) {
-        update_wallpaper_bitmap();
+        invalidate_wallpaper_bitmaps();
         Compositor::invalidate_screen();
     }
 
@@ -807,7 +872,7 @@ bool Compositor::set_wallpaper_mode(String const& mode)
 
     if (succeeded) {
         m_wallpaper_mode = mode_to_enum(mode);
-        update_wallpaper_bitmap();
+        invalidate_wallpaper_bitmaps();
         Compositor::invalidate_screen();
     }
 
@@ -820,45 +885,68 @@ bool Compositor::set_wallpaper(RefPtr<Gfx::Bitmap> bitmap)
         m_wallpaper = nullptr;
     else
         m_wallpaper = bitmap;
-    update_wallpaper_bitmap();
+    invalidate_wallpaper_bitmaps();
     invalidate_screen();
 
     return true;
 }
 
-void Compositor::update_wallpaper_bitmap()
+void Compositor::invalidate_wallpaper_bitmaps()
 {
+    // The wallpaper bitmaps are rendered again as soon as they are needed
     Screen::for_each([&](Screen& screen) {
-        auto& screen_data = screen.compositor_screen_data();
-        if (m_wallpaper_mode != WallpaperMode::Stretch || !m_wallpaper) {
-            screen_data.clear_wallpaper_bitmap();
-            return IterationDecision::Continue;
-        }
-        if (!screen_data.m_wallpaper_bitmap)
-            screen_data.init_wallpaper_bitmap(screen);
-
-        auto rect = screen_data.m_wallpaper_bitmap->rect();
-        auto& painter = *screen_data.m_wallpaper_painter;
-
-        painter.draw_scaled_bitmap(rect, *m_wallpaper, m_wallpaper->rect());
-
+        screen.compositor_screen_data().clear_wallpaper_bitmap();
         return IterationDecision::Continue;
     });
 }
 
-void CompositorScreenData::init_wallpaper_bitmap(Screen& screen)
+void CompositorScreenData::init_wallpaper_bitmap(Compositor& compositor, Screen& screen, Color background_color)
 {
+    VERIFY(compositor.m_wallpaper);
+    auto& wallpaper = *compositor.m_wallpaper;
+
     m_wallpaper_bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, screen.size(), screen.scale_factor()).release_value_but_fixme_should_propagate_errors();
-    m_wallpaper_painter = make<Gfx::Painter>(*m_wallpaper_bitmap);
-    m_wallpaper_painter->translate(-screen.rect().location());
+    Gfx::Painter painter(*m_wallpaper_bitmap);
+    painter.translate(-screen.rect().location());
+
+    auto screen_rect = screen.rect();
+    painter.fill_rect(screen_rect, background_color);
+    switch (compositor.m_wallpaper_mode) {
+    case WallpaperMode::Center: {
+        Gfx::IntPoint offset { (screen.width() - wallpaper.width()) / 2, (screen.height() - wallpaper.height()) / 2 };
+        painter.blit_offset(screen_rect.location(), wallpaper, { {}, screen_rect.size() }, offset);
+        break;
+    }
+    case WallpaperMode::Tile:
+        painter.draw_tiled_bitmap(screen_rect, wallpaper);
+        break;
+    case WallpaperMode::Stretch:
+        painter.draw_scaled_bitmap(screen_rect, wallpaper, wallpaper.rect());
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
 }
 
 void CompositorScreenData::clear_wallpaper_bitmap()
 {
-    m_wallpaper_painter = nullptr;
     m_wallpaper_bitmap = nullptr;
 }
 
+void CompositorScreenData::copy_stale_back_rects_from_front(Screen& screen, Gfx::IntRect const& rect)
+{
+    if (!m_stale_back_rects.intersects(rect))
+        return;
+
+    auto screen_rect = screen.rect();
+    for (auto& stale_rect : m_stale_back_rects.rects()) {
+        auto copy_rect = stale_rect.intersected(rect);
+        if (!copy_rect.is_empty())
+            m_back_painter->blit(copy_rect.location(), *m_front_bitmap, copy_rect.translated(-screen_rect.location()));
+    }
+    m_stale_back_rects = m_stale_back_rects.shatter(rect);
+}
+
 void CompositorScreenData::flip_buffers(Screen& screen)
 {
     VERIFY(m_screen_can_set_buffer);
@@ -876,7 +964,7 @@ void Compositor::screen_resolution_changed()
     init_bitmaps();
     invalidate_occlusions();
     overlay_rects_changed();
-    update_wallpaper_bitmap();
+    invalidate_wallpaper_bitmaps();
     compose();
 }
 
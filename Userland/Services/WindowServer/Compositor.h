@@ -8,6 +8,7 @@
 
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
+#include <AK/Time.h>
 #include <LibCore/Object.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/DisjointRectSet.h>
@@ -40,7 +41,6 @@ struct CompositorScreenData {
     OwnPtr<Gfx::Painter> m_back_painter;
     OwnPtr<Gfx::Painter> m_front_painter;
     OwnPtr<Gfx::Painter> m_temp_painter;
-    OwnPtr<Gfx::Painter> m_wallpaper_painter;
     RefPtr<Gfx::Bitmap> m_cursor_back_bitmap;
     OwnPtr<Gfx::Painter> m_cursor_back_painter;
     Gfx::IntRect m_last_cursor_rect;
@@ -55,6 +55,10 @@ struct CompositorScreenData {
     Gfx::DisjointIntRectSet m_flush_rects;
     Gfx::DisjointIntRectSet m_flush_transparent_rects;
     Gfx::DisjointIntRectSet m_flush_special_rects;
+    // Rects that were rendered straight into the front buffer during this compose pass
+    Gfx::DisjointIntRectSet m_flush_direct_rects;
+    // Rects where the front buffer is newer than the back buffer
+    Gfx::DisjointIntRectSet m_stale_back_rects;
 
     Gfx::Painter& overlay_painter() { return *m_temp_painter; }
 
@@ -62,8 +66,9 @@ struct CompositorScreenData {
     void flip_buffers(Screen&);
     void draw_cursor(Screen&, Gfx::IntRect const&);
     bool restore_cursor_back(Screen&, Gfx::IntRect&);
-    void init_wallpaper_bitmap(Screen&);
+    void init_wallpaper_bitmap(Compositor&, Screen&, Color background_color);
     void clear_wallpaper_bitmap();
+    void copy_stale_back_rects_from_front(Screen&, Gfx::IntRect const& rect);
 
     template<typename F>
     IterationDecision for_each_intersected_flushing_rect(Gfx::IntRect const& intersecting_rect, F f)
@@ -127,6 +132,7 @@ public:
     void invalidate_after_theme_or_font_change()
     {
         update_fonts();
+        invalidate_wallpaper_bitmaps();
         invalidate_occlusions();
         overlays_theme_changed();
         invalidate_screen();
@@ -187,6 +193,9 @@ public:
 
     void set_flash_flush(bool b) { m_flash_flush = b; }
 
+    u64 composed_frame_count() const { return m_composed_frame_count; }
+    Time total_compose_time() const { return m_total_compose_time; }
+
     static NonnullOwnPtr<CompositorScreenData> create_screen_data(Badge<Screen>)
     {
         return adopt_own(*new CompositorScreenData());
@@ -215,7 +224,7 @@ private:
     void stop_window_stack_switch_overlay_timer();
     void start_window_stack_switch_overlay_timer();
     void finish_window_stack_switch();
-    void update_wallpaper_bitmap();
+    void invalidate_wallpaper_bitmaps();
 
     RefPtr<Core::Timer> m_compose_timer;
     RefPtr<Core::Timer> m_immediate_compose_timer;
@@ -252,6 +261,9 @@ private:
     Optional<Gfx::Color> m_custom_background_color;
 
     HashTable<Animation*> m_animations;
+
+    u64 m_composed_frame_count { 0 };
+    Time m_total_compose_time;
 };
 
 }
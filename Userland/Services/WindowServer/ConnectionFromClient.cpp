@@ -1295,6 +1295,12 @@ void ConnectionFromClient::set_flash_flush(bool enabled)
     Compositor::the().set_flash_flush(enabled);
 }
 
+Messages::WindowServer::GetCompositorStatisticsResponse ConnectionFromClient::get_compositor_statistics()
+{
+    auto& compositor = Compositor::the();
+    return { compositor.composed_frame_count(), static_cast<u64>(compositor.total_compose_time().to_microseconds()) };
+}
+
 void ConnectionFromClient::set_window_parent_from_client(i32 client_id, i32 parent_id, i32 child_id)
 {
     auto* child_window = window_from_id(child_id);
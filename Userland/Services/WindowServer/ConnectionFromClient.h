@@ -182,6 +182,7 @@ private:
     virtual Messages::WindowServer::IsWindowModifiedResponse is_window_modified(i32) override;
     virtual Messages::WindowServer::GetDesktopDisplayScaleResponse get_desktop_display_scale(u32) override;
     virtual void set_flash_flush(bool) override;
+    virtual Messages::WindowServer::GetCompositorStatisticsResponse get_compositor_statistics() override;
     virtual void set_window_parent_from_client(i32, i32, i32) override;
     virtual Messages::WindowServer::GetWindowRectFromClientResponse get_window_rect_from_client(i32, i32) override;
     virtual void add_window_stealing_for_client(i32, i32) override;
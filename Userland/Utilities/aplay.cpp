@@ -36,6 +36,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.parse(arguments);
 
     TRY(Core::System::unveil("/sys/kernel/processes", "r"));
+    TRY(Core::System::unveil("/sys/kernel/processes_binary", "r"));
     TRY(Core::System::unveil("/tmp/session/%sid/portal/audio", "rw"));
     TRY(Core::System::unveil(Core::File::absolute_path(path), "r"sv));
     TRY(Core::System::unveil(nullptr, nullptr));
@@ -60,7 +61,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         loader->num_channels() == 1 ? "Mono" : "Stereo");
     out("\033[34;1mProgress\033[0m: \033[s");
 
-    auto resampler = Audio::ResampleHelper<Audio::Sample>(loader->sample_rate(), audio_client->get_sample_rate());
+    auto resampler = TRY(Audio::PolyphaseResampler::try_create(loader->sample_rate(), audio_client->get_sample_rate()));
 
     // If we're downsampling, we need to appropriately load more samples at once.
     size_t const load_size = static_cast<size_t>(LOAD_CHUNK_SIZE * static_cast<double>(loader->sample_rate()) / static_cast<double>(audio_client->get_sample_rate()));
@@ -101,8 +102,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             if (samples.value().size() > 0) {
                 print_playback_update();
                 // We can read and enqueue more samples
-                resampler.reset();
-                auto resampled_samples = resampler.resample(move(samples.value()));
+                auto resampled_samples = TRY(resampler.resample(samples.value().span()));
                 TRY(audio_client->async_enqueue(move(resampled_samples)));
             } else if (should_loop) {
                 // We're done: now loop
@@ -111,9 +111,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                     outln();
                     outln("Error while resetting: {} (at {:x})", result.error().description, result.error().index);
                 }
-            } else if (samples.value().size() == 0 && audio_client->remaining_samples() == 0) {
-                // We're done and the server is done
-                break;
+            } else {
+                // The loader is out of samples, so play the ones still held back by the resampler.
+                // Flushing resets the resampler, so this yields nothing once they're enqueued.
+                auto remaining_samples = TRY(resampler.flush());
+                if (!remaining_samples.is_empty()) {
+                    TRY(audio_client->async_enqueue(move(remaining_samples)));
+                } else if (audio_client->remaining_samples() == 0) {
+                    // We're done and the server is done
+                    break;
+                }
             }
             while (audio_client->remaining_samples() > min_buffer_size) {
                 // The server has enough data for now
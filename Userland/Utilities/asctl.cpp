@@ -21,7 +21,10 @@
 enum AudioVariable : u32 {
     Volume,
     Mute,
-    SampleRate
+    SampleRate,
+    PeriodSize,
+    Underruns,
+    MixTime,
 };
 
 // asctl: audio server control utility
@@ -38,7 +41,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Core::ArgsParser args_parser;
     args_parser.set_general_help("Send control signals to the audio server and hardware.");
     args_parser.add_option(human_mode, "Print human-readable output", "human-readable", 'h');
-    args_parser.add_positional_argument(command, "Command, either (g)et or (s)et\n\n\tThe get command accepts a list of variables to print.\n\tThey are printed in the given order.\n\tIf no value is specified, all are printed.\n\n\tThe set command accepts a any number of variables\n\tfollowed by the value they should be set to.\n\n\tPossible variables are (v)olume, (m)ute, sample(r)ate.\n", "command");
+    args_parser.add_positional_argument(command, "Command, either (g)et or (s)et\n\n\tThe get command accepts a list of variables to print.\n\tThey are printed in the given order.\n\tIf no value is specified, all are printed.\n\n\tThe set command accepts a any number of variables\n\tfollowed by the value they should be set to.\n\n\tPossible variables are (v)olume, (m)ute, sample(r)ate, (p)eriod,\n\t(u)nderruns and mix(t)ime, where the last two can't be set.\n", "command");
     args_parser.add_positional_argument(command_arguments, "Arguments for the command", "args", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -52,6 +55,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             values_to_print.append(AudioVariable::Volume);
             values_to_print.append(AudioVariable::Mute);
             values_to_print.append(AudioVariable::SampleRate);
+            values_to_print.append(AudioVariable::PeriodSize);
+            values_to_print.append(AudioVariable::Underruns);
+            values_to_print.append(AudioVariable::MixTime);
         } else {
             for (auto& variable : command_arguments) {
                 if (variable.is_one_of("v"sv, "volume"sv))
@@ -60,6 +66,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                     values_to_print.append(AudioVariable::Mute);
                 else if (variable.is_one_of("r"sv, "samplerate"sv))
                     values_to_print.append(AudioVariable::SampleRate);
+                else if (variable.is_one_of("p"sv, "period"sv))
+                    values_to_print.append(AudioVariable::PeriodSize);
+                else if (variable.is_one_of("u"sv, "underruns"sv))
+                    values_to_print.append(AudioVariable::Underruns);
+                else if (variable.is_one_of("t"sv, "mixtime"sv))
+                    values_to_print.append(AudioVariable::MixTime);
                 else {
                     warnln("Error: Unrecognized variable {}", variable);
                     return 1;
@@ -93,6 +105,30 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                     out("{} ", sample_rate);
                 break;
             }
+            case AudioVariable::PeriodSize: {
+                u32 period_size = audio_client->get_period_size();
+                if (human_mode)
+                    outln("Period: {} samples", period_size);
+                else
+                    out("{} ", period_size);
+                break;
+            }
+            case AudioVariable::Underruns: {
+                auto statistics = audio_client->get_mixer_statistics();
+                if (human_mode)
+                    outln("Underruns: {}", statistics.underrun_count());
+                else
+                    out("{} ", statistics.underrun_count());
+                break;
+            }
+            case AudioVariable::MixTime: {
+                auto statistics = audio_client->get_mixer_statistics();
+                if (human_mode)
+                    outln("Mix time: {} us (max. {} us)", statistics.last_mix_time_us(), statistics.max_mix_time_us());
+                else
+                    out("{} {} ", statistics.last_mix_time_us(), statistics.max_mix_time_us());
+                break;
+            }
             }
         }
         if (!human_mode)
@@ -136,6 +172,20 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                     return 1;
                 }
                 values_to_set.set(AudioVariable::SampleRate, sample_rate.value());
+            } else if (variable.is_one_of("p"sv, "period"sv)) {
+                auto period_size = command_arguments[++i].to_int();
+                if (!period_size.has_value()) {
+                    warnln("Error: {} is not an integer period size", command_arguments[i]);
+                    return 1;
+                }
+                if (period_size.value() < 64 || period_size.value() > 512) {
+                    warnln("Error: {} is not between 64 and 512", command_arguments[i]);
+                    return 1;
+                }
+                values_to_set.set(AudioVariable::PeriodSize, period_size.value());
+            } else if (variable.is_one_of("u"sv, "underruns"sv, "t"sv, "mixtime"sv)) {
+                warnln("Error: {} can't be set", variable);
+                return 1;
             } else {
                 warnln("Error: Unrecognized variable {}", command_arguments[i]);
                 return 1;
@@ -159,6 +209,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 audio_client->set_sample_rate(sample_rate);
                 break;
             }
+            case AudioVariable::PeriodSize: {
+                int& period_size = to_set.value.get<int>();
+                audio_client->set_period_size(period_size);
+                break;
+            }
+            case AudioVariable::Underruns:
+            case AudioVariable::MixTime:
+                VERIFY_NOT_REACHED();
             }
         }
     }
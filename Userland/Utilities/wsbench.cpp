@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NonnullRefPtrVector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/System.h>
+#include <LibCore/Timer.h>
+#include <LibGUI/Application.h>
+#include <LibGUI/ConnectionToWindowServer.h>
+#include <LibGUI/Painter.h>
+#include <LibGUI/Widget.h>
+#include <LibGUI/Window.h>
+#include <LibMain/Main.h>
+
+class ChangingColorWidget final : public GUI::Widget {
+    C_OBJECT(ChangingColorWidget)
+public:
+    void next_frame()
+    {
+        ++m_frame;
+        update();
+    }
+
+private:
+    explicit ChangingColorWidget(int index)
+        : m_index(index)
+    {
+    }
+
+    virtual void paint_event(GUI::PaintEvent& event) override
+    {
+        GUI::Painter painter(*this);
+        painter.add_clip_rect(event.rect());
+        auto hue = (m_index * 37 + m_frame * 3) % 360;
+        painter.fill_rect(rect(), Color::from_hsv(hue, 0.6, 0.9));
+    }
+
+    int m_index { 0 };
+    int m_frame { 0 };
+};
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    auto app = TRY(GUI::Application::try_create(arguments));
+
+    TRY(Core::System::pledge("stdio recvfd sendfd rpath"));
+    TRY(Core::System::unveil("/res", "r"));
+    TRY(Core::System::unveil(nullptr, nullptr));
+
+    int window_count = 50;
+    int duration_in_seconds = 5;
+    bool fullscreen = false;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Benchmark the WindowServer compositor with many overlapping windows");
+    args_parser.add_option(window_count, "Number of overlapping windows to open", "windows", 'w', "count");
+    args_parser.add_option(duration_in_seconds, "How long to keep the windows changing", "duration", 'd', "seconds");
+    args_parser.add_option(fullscreen, "Use a single fullscreen window instead", "fullscreen", 'f');
+    args_parser.parse(arguments);
+
+    if (fullscreen)
+        window_count = 1;
+
+    NonnullRefPtrVector<GUI::Window> windows;
+    NonnullRefPtrVector<ChangingColorWidget> widgets;
+    for (int i = 0; i < window_count; ++i) {
+        auto window = TRY(GUI::Window::try_create());
+        window->set_title(String::formatted("wsbench #{}", i + 1));
+        window->set_rect(40 + (i % 20) * 24, 40 + (i % 15) * 24, 480, 360);
+        window->set_fullscreen(fullscreen);
+        auto widget = TRY(window->try_set_main_widget<ChangingColorWidget>(i));
+        widgets.append(move(widget));
+        window->show();
+        windows.append(move(window));
+    }
+
+    auto& connection = GUI::ConnectionToWindowServer::the();
+    auto statistics_at_start = connection.get_compositor_statistics();
+
+    auto frame_timer = Core::Timer::create_repeating(1, [&] {
+        for (auto& widget : widgets)
+            widget.next_frame();
+    });
+    frame_timer->start();
+
+    auto stop_timer = Core::Timer::create_single_shot(duration_in_seconds * 1000, [&] {
+        app->quit();
+    });
+    stop_timer->start();
+
+    auto result = app->exec();
+
+    auto statistics_at_end = connection.get_compositor_statistics();
+    auto frame_count = statistics_at_end.composed_frame_count() - statistics_at_start.composed_frame_count();
+    auto compose_time = statistics_at_end.total_compose_time_in_microseconds() - statistics_at_start.total_compose_time_in_microseconds();
+
+    outln("Windows: {}{}", window_count, fullscreen ? " (fullscreen)" : "");
+    outln("Composed frames: {} ({:.1} per second)", frame_count, static_cast<double>(frame_count) / duration_in_seconds);
+    if (frame_count > 0)
+        outln("Average compose time: {} µs", compose_time / frame_count);
+    return result;
+}